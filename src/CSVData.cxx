@@ -0,0 +1,182 @@
+#include "CSVData.h"
+
+#include <cmath>
+#include <limits>
+
+//#include <QDebug>
+
+CSVData::CSVData()
+{
+    Clear();
+}
+
+
+bool CSVData::IsEmpty() const
+{
+    return m_nbrRows == 0;
+}
+
+void CSVData::Clear()
+{
+    m_filePath.clear();
+    m_header.clear();
+    m_values.clear();
+    m_textColumns.clear();
+    m_nbrRows = 0;
+    m_nbrColumns = 0;
+    m_isMatrixDimensionOK = false;
+    m_isSubMatrix = false;
+    m_raggedRows.clear();
+    m_duplicates.clear();
+    m_nanColumns.clear();
+    m_rowBegins.clear();
+    m_rowEnds.clear();
+    m_text.clear();
+    m_separator.clear();
+    m_sourceSize = 0;
+}
+
+
+QString CSVData::GetFilePath() const
+{
+    return m_filePath;
+}
+
+int CSVData::GetNbrRows() const
+{
+    return m_nbrRows;
+}
+
+int CSVData::GetNbrColumns() const
+{
+    return m_nbrColumns;
+}
+
+QStringList CSVData::GetHeader() const
+{
+    return m_header;
+}
+
+
+bool CSVData::IsMatrixDimensionOK() const
+{
+    return m_isMatrixDimensionOK;
+}
+
+bool CSVData::IsSubMatrix() const
+{
+    return m_isSubMatrix;
+}
+
+bool CSVData::IsTextColumn( int column ) const
+{
+    return m_textColumns.contains( column );
+}
+
+
+QList< int > CSVData::GetRaggedRows() const
+{
+    return m_raggedRows;
+}
+
+QStringList CSVData::GetDuplicates() const
+{
+    return m_duplicates;
+}
+
+bool CSVData::IsNANColumn( int column ) const
+{
+    return column >= 0 && column < m_nanColumns.size() && m_nanColumns.testBit( column );
+}
+
+QBitArray CSVData::GetNANColumns() const
+{
+    return m_nanColumns;
+}
+
+
+double CSVData::GetValue( int row, int column ) const
+{
+    if( row < 1 || row >= m_nbrRows || column < 0 || column >= m_nbrColumns )
+    {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+
+    return m_values.at( ( row - 1 ) * m_nbrColumns + column );
+}
+
+QStringList CSVData::GetColumnText( int column ) const
+{
+    return m_textColumns.value( column );
+}
+
+MatrixView CSVData::GetValues() const
+{
+    return MatrixView::RowMajor( m_values.constData(), qMax( m_nbrRows - 1, 0 ), m_nbrColumns );
+}
+
+QList< double > CSVData::GetRowValues( int row ) const
+{
+    return GetValues().GetRow( row - 1 ).Mid( 1 ).ToList();
+}
+
+QList< double > CSVData::GetColumnValues( int column ) const
+{
+    return GetValues().GetColumn( column ).ToList();
+}
+
+QList< QList< double > > CSVData::GetDataByRow() const
+{
+    QList< QList< double > > dataByRow;
+    MatrixView values = GetValues();
+    for( int row = 0; row < values.GetNbrRows(); row++ )
+    {
+        dataByRow.append( values.GetRow( row ).Mid( 1 ).ToList() );
+    }
+
+    return dataByRow;
+}
+
+QList< QList< double > > CSVData::GetDataByColumn() const
+{
+    /** Columns read as the rows of the transposed view, 1st column excluded as in GetDataByRow() **/
+    QList< QList< double > > dataByColumn;
+    MatrixView valuesByColumn = GetValues().Transposed();
+    for( int column = 1; column < valuesByColumn.GetNbrRows(); column++ )
+    {
+        dataByColumn.append( valuesByColumn.GetRow( column ).ToList() );
+    }
+
+    return dataByColumn;
+}
+
+
+bool CSVData::operator==( const CSVData& other ) const
+{
+    /** Only the data parsed is compared, not where its rows are read from **/
+    if( m_nbrRows != other.m_nbrRows || m_nbrColumns != other.m_nbrColumns ||
+            m_isMatrixDimensionOK != other.m_isMatrixDimensionOK || m_isSubMatrix != other.m_isSubMatrix ||
+            m_header != other.m_header || m_textColumns != other.m_textColumns || m_values.size() != other.m_values.size() ||
+            m_raggedRows != other.m_raggedRows || m_duplicates != other.m_duplicates || m_nanColumns != other.m_nanColumns )
+    {
+        return false;
+    }
+
+    /** nan and -nan are both missing values and compare equal **/
+    for( int i = 0; i < m_values.size(); i++ )
+    {
+        double value = m_values.at( i );
+        double otherValue = other.m_values.at( i );
+        if( value != otherValue && !( std::isnan( value ) && std::isnan( otherValue ) ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CSVData::operator!=( const CSVData& other ) const
+{
+    return !( *this == other );
+}
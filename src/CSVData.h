@@ -0,0 +1,115 @@
+#ifndef CSVDATA_H
+#define CSVDATA_H
+
+#include "MatrixView.h"
+
+#include <QMap>
+#include <QList>
+#include <QVector>
+#include <QByteArray>
+#include <QBitArray>
+#include <QStringList>
+
+class CSVData
+{
+    friend class CSVReader;
+    friend class CSVSidecar;
+    friend class CSVWriter;
+
+public:
+    explicit CSVData();
+
+
+    bool IsEmpty() const; // Tested
+
+    void Clear(); // Tested
+
+
+    QString GetFilePath() const; // Tested
+
+    /** Number of rows and columns as found in the file, header included **/
+    int GetNbrRows() const; // Tested
+
+    int GetNbrColumns() const; // Tested
+
+    QStringList GetHeader() const; // Tested
+
+
+    bool IsMatrixDimensionOK() const; // Tested
+
+    bool IsSubMatrix() const; // Tested
+
+    bool IsTextColumn( int column ) const; // Tested
+
+
+    /** Validation report, filled while the file is parsed **/
+    /** Rows whose number of cells differs from the header **/
+    QList< int > GetRaggedRows() const; // Tested
+
+    /** Subjects found more than once: header of a profile file, subject column of a SubMatrix file **/
+    QStringList GetDuplicates() const; // Tested
+
+    /** Columns with at least one nan or missing value **/
+    bool IsNANColumn( int column ) const; // Tested
+
+    QBitArray GetNANColumns() const; // Tested
+
+
+    /** Rows are indexed as in the file: row 0 is the header, data starts at row 1 **/
+    double GetValue( int row, int column ) const; // Tested
+
+    /** Data rows, every column included: GetValues().At( row - 1, column ) == GetValue( row, column ) **/
+    MatrixView GetValues() const; // Tested
+
+    QStringList GetColumnText( int column ) const; // Tested
+
+    QList< double > GetRowValues( int row ) const; // Tested
+
+    QList< double > GetColumnValues( int column ) const; // Tested
+
+    QList< QList< double > > GetDataByRow() const; // Tested
+
+    QList< QList< double > > GetDataByColumn() const; // Tested
+
+
+    bool operator==( const CSVData& other ) const; // Tested
+
+    bool operator!=( const CSVData& other ) const; // Tested
+
+
+private:
+    QString m_filePath;
+
+    QStringList m_header;
+
+    /** Data rows stored contiguously, row after row, m_nbrColumns values per row **/
+    QVector< double > m_values;
+
+    /** Columns kept as text: 1st column (arc length) and all columns of a SubMatrix file **/
+    QMap< int, QStringList > m_textColumns;
+
+    int m_nbrRows, m_nbrColumns;
+
+    bool m_isMatrixDimensionOK, m_isSubMatrix;
+
+    QList< int > m_raggedRows;
+
+    QStringList m_duplicates;
+
+    QBitArray m_nanColumns;
+
+    /** Where each row lies, header included: row r spans m_rowBegins[ r ] to m_rowEnds[ r ], end of line excluded.
+     *  The rows of a file are read again from the file when needed (see CSVWriter), only their positions are kept.
+     *  With no file to read them from, the rows of a content or of a selection are kept in m_text,
+     *  the cells of a selection joined by m_separator. **/
+    QVector< qint64 > m_rowBegins, m_rowEnds;
+
+    QByteArray m_text;
+
+    QByteArray m_separator;
+
+    /** Size of the file when parsed: the rows are not read again from a file changed since **/
+    qint64 m_sourceSize;
+};
+
+#endif // CSVDATA_H
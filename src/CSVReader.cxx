@@ -0,0 +1,961 @@
+#include "CSVReader.h"
+
+#include <QtEndian>
+
+#include <cmath>
+#include <limits>
+
+//#include <QDebug>
+
+
+namespace
+{
+    /** Powers of ten exactly representable as double **/
+    const double s_powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    inline bool IsDigit( char c )
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    /** Eight characters are handled at once as the eight bytes of a 64-bit integer (SWAR).
+     *  Profiles are mostly written with 6 to 10 decimals: most values are read in one or two steps. **/
+    inline quint64 LoadEightCharacters( const char *begin )
+    {
+        return qFromLittleEndian< quint64 >( reinterpret_cast< const uchar* >( begin ) );
+    }
+
+    inline bool AreEightDigits( quint64 characters )
+    {
+        return ( ( characters & Q_UINT64_C( 0xF0F0F0F0F0F0F0F0 ) ) |
+                 ( ( ( characters + Q_UINT64_C( 0x0606060606060606 ) ) & Q_UINT64_C( 0xF0F0F0F0F0F0F0F0 ) ) >> 4 ) ) == Q_UINT64_C( 0x3333333333333333 );
+    }
+
+    inline quint32 ParseEightDigits( quint64 characters )
+    {
+        characters -= Q_UINT64_C( 0x3030303030303030 );
+        characters = ( characters * 10 ) + ( characters >> 8 );
+        characters = ( ( ( characters & Q_UINT64_C( 0x000000FF000000FF ) ) * Q_UINT64_C( 0x000F424000000064 ) ) +
+                       ( ( ( characters >> 16 ) & Q_UINT64_C( 0x000000FF000000FF ) ) * Q_UINT64_C( 0x0000271000000001 ) ) ) >> 32;
+        return static_cast< quint32 >( characters );
+    }
+
+    /** Same as eight calls to the digit by digit accumulation, leading zeros not being counted as significant **/
+    inline bool AccumulateEightDigits( const char *current, const char *end, quint64& mantissa, int& nbrDigits )
+    {
+        if( nbrDigits > 11 || end - current < 8 )
+        {
+            return false;
+        }
+        quint64 characters = LoadEightCharacters( current );
+        if( !AreEightDigits( characters ) )
+        {
+            return false;
+        }
+
+        quint32 eightDigits = ParseEightDigits( characters );
+        if( mantissa != 0 )
+        {
+            nbrDigits += 8;
+        }
+        else
+        {
+            for( quint32 rest = eightDigits; rest != 0; rest /= 10 )
+            {
+                nbrDigits++;
+            }
+        }
+        mantissa = mantissa * 100000000 + eightDigits;
+        return true;
+    }
+}
+
+
+const qint64 CSVReader::m_minChunkSize = 256 * 1024;
+
+CSVReader::CSVReader( const QString& separator )
+{
+    m_separator = separator.toUtf8();
+    m_nbrThreads = 1;
+    m_streamBlockSize = 1024 * 1024;
+}
+
+
+CSVData CSVReader::Read( QString filePath )
+{
+    if( CompressedFile::IsCompressed( filePath ) )
+    {
+        return ReadCompressed( filePath );
+    }
+
+    CSVData csvData;
+    QFile file( filePath );
+    if( file.open( QIODevice::ReadOnly ) )
+    {
+        /** The file is mapped in memory and tokenized in place.
+         *  If mapping is not possible (e.g. special file), the content is read in a buffer. **/
+        qint64 fileSize = file.size();
+        uchar *mappedFile = fileSize > 0 ? file.map( 0, fileSize ) : 0;
+        QByteArray buffer;
+        const char *begin;
+        const char *end;
+        if( mappedFile )
+        {
+            begin = reinterpret_cast< const char* >( mappedFile );
+            end = begin + fileSize;
+        }
+        else
+        {
+            buffer = file.readAll();
+            begin = buffer.constData();
+            end = begin + buffer.size();
+        }
+
+        Parse( begin, end, csvData );
+        csvData.m_filePath = filePath;
+        csvData.m_sourceSize = fileSize;
+
+        if( mappedFile )
+        {
+            file.unmap( mappedFile );
+        }
+        file.close();
+    }
+
+    return csvData;
+}
+
+CSVData CSVReader::ReadContent( const QByteArray& content )
+{
+    /** No file to read the rows from: the content is kept, shared with the caller **/
+    CSVData csvData;
+    Parse( content.constData(), content.constData() + content.size(), csvData );
+    if( !csvData.IsEmpty() )
+    {
+        csvData.m_text = content;
+    }
+
+    return csvData;
+}
+
+QList< QStringList > CSVReader::ReadText( QString filePath )
+{
+    /** Compressed file read line by line as it is decompressed **/
+    QFile file( filePath );
+    CompressedFileDevice decompressedFile( filePath );
+    QIODevice *device = &file;
+    if( CompressedFile::IsCompressed( filePath ) )
+    {
+        device = &decompressedFile;
+    }
+
+    QList< QStringList > fileData;
+    if( device->open( QIODevice::ReadOnly ) )
+    {
+        QTextStream ts( device );
+        QStringList tempRows;
+
+        /** Read all the file line by line **/
+        while( !ts.atEnd() )
+        {
+            tempRows.append( ts.readLine() );
+        }
+        device->close();
+
+        /** Truncated or corrupted file: handled as a file that cannot be read **/
+        if( decompressedFile.HasError() )
+        {
+            return fileData;
+        }
+
+        /** If only one line read, check for the carriage return character "\r" **/
+        if( tempRows.size() == 1 )
+        {
+            tempRows = tempRows.first().split( "\r" );
+        }
+        tempRows.removeAll( "" );
+
+        /** For each line (== row), dispatch data in columns **/
+        QString separator = QString::fromUtf8( m_separator );
+        foreach( QString dataRow, tempRows )
+        {
+            QStringList tempRow = dataRow.split( separator );
+            tempRow.removeAll( "" );
+
+            fileData.append( tempRow );
+        }
+    }
+
+    return fileData;
+}
+
+
+CSVData CSVReader::ReadSelection( QString filePath, const QStringList& subjects, int subjectColumnID, int startProfile, int endProfile )
+{
+    Selection selection;
+    selection.subjects = subjects.toSet();
+    selection.subjectColumnID = subjectColumnID;
+    selection.startProfile = startProfile;
+    selection.endProfile = endProfile;
+
+    CSVData csvData;
+    if( ReadSelectedRows( filePath, selection, csvData ) )
+    {
+        /** No data row to tell the type of the file: header of a profile file **/
+        if( selection.nbrDataRows == 0 && !selection.fileHeader.isEmpty() )
+        {
+            InitSelection( QVector< Token >(), selection, csvData );
+        }
+        csvData.m_filePath = filePath;
+    }
+
+    return csvData;
+}
+
+QStringList CSVReader::ReadHeader( QString filePath )
+{
+    Selection selection;
+    selection.isHeaderOnly = true;
+
+    CSVData csvData;
+    ReadSelectedRows( filePath, selection, csvData );
+
+    return selection.fileHeader;
+}
+
+
+void CSVReader::SetNbrThreads( int nbrThreads )
+{
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+int CSVReader::GetNbrThreads() const
+{
+    return m_nbrThreads;
+}
+
+
+CSVData CSVReader::ReadCompressed( QString filePath ) const
+{
+    CSVData csvData;
+    qint64 fileSize = QFileInfo( filePath ).size();
+    CompressedFile compressedFile( filePath );
+    if( !compressedFile.Open() )
+    {
+        return csvData;
+    }
+
+    /** Rows are parsed in this thread as soon as their block is decompressed.
+     *  A row may be split between two blocks: the end of a block after its last complete row is kept for the next one.
+     *  The positions of the rows are the ones in the decompressed file. **/
+    QByteArray buffer;
+    qint64 bufferPosition = 0;
+    qint64 rowLength = 1;
+    bool isAtEnd = false;
+    while( !isAtEnd )
+    {
+        QByteArray block = compressedFile.Read();
+        isAtEnd = block.isEmpty();
+        buffer.append( block );
+
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        const char *rowsEnd = end;
+        if( !isAtEnd )
+        {
+            while( rowsEnd > begin && rowsEnd[ -1 ] != '\n' && rowsEnd[ -1 ] != '\r' )
+            {
+                rowsEnd--;
+            }
+        }
+        if( rowsEnd == begin )
+        {
+            continue;
+        }
+
+        const char *rowsBegin = ParseHeader( begin, rowsEnd, bufferPosition, rowLength, csvData );
+        if( rowsBegin < rowsEnd )
+        {
+            ParseRows( rowsBegin, rowsEnd, bufferPosition + ( rowsBegin - begin ), &csvData );
+        }
+        buffer.remove( 0, static_cast< int >( rowsEnd - begin ) );
+        bufferPosition += rowsEnd - begin;
+    }
+
+    /** Truncated or corrupted file: handled as a file that cannot be read **/
+    if( compressedFile.HasError() )
+    {
+        return CSVData();
+    }
+    FindDuplicates( csvData );
+    csvData.m_filePath = filePath;
+    csvData.m_sourceSize = fileSize;
+
+    return csvData;
+}
+
+
+void CSVReader::Parse( const char *begin, const char *end, CSVData& csvData ) const
+{
+    qint64 rowLength = 1;
+    const char *lineBegin = ParseHeader( begin, end, 0, rowLength, csvData );
+    if( lineBegin < end )
+    {
+        ParseChunks( lineBegin, end, lineBegin - begin, rowLength, csvData );
+    }
+
+    FindDuplicates( csvData );
+}
+
+const char* CSVReader::ParseHeader( const char *begin, const char *end, qint64 position, qint64& rowLength, CSVData& csvData ) const
+{
+    /** Skip UTF-8 byte order mark **/
+    if( csvData.m_nbrRows == 0 && end - begin >= 3 && begin[ 0 ] == '\xEF' && begin[ 1 ] == '\xBB' && begin[ 2 ] == '\xBF' )
+    {
+        begin += 3;
+        position += 3;
+    }
+
+    /** The header and the 1st data row give the number of columns, the type of file and the length of a row **/
+    QVector< Token > tokens;
+    const char *lineBegin = begin;
+    while( lineBegin < end && csvData.m_nbrRows < 2 )
+    {
+        const char *lineEnd = FindLineEnd( lineBegin, end );
+        Tokenize( lineBegin, lineEnd, tokens );
+        const char *currentLineBegin = lineBegin;
+        lineBegin = lineEnd + 1;
+        if( tokens.isEmpty() )
+        {
+            continue;
+        }
+        csvData.m_rowBegins.append( position + ( currentLineBegin - begin ) );
+        csvData.m_rowEnds.append( position + ( lineEnd - begin ) );
+
+        /** 1st row: column names (arc length and subjects, or covariates) **/
+        if( csvData.m_nbrRows == 0 )
+        {
+            foreach( Token token, tokens )
+            {
+                csvData.m_header.append( ToString( token ) );
+            }
+            csvData.m_separator = m_separator;
+            csvData.m_nbrColumns = tokens.size();
+            csvData.m_nanColumns = QBitArray( tokens.size() );
+            csvData.m_nbrRows = 1;
+            csvData.m_isMatrixDimensionOK = true;
+            csvData.m_textColumns.insert( 0, QStringList() );
+            continue;
+        }
+
+        /** Size of the matrix estimated from the length of the 1st data row **/
+        int nbrColumns = csvData.m_nbrColumns;
+        rowLength = lineEnd - currentLineBegin + 1;
+        qint64 estimatedNbrRows = ( end - currentLineBegin ) / rowLength + 1;
+        csvData.m_values.reserve( static_cast< int >( qMin( estimatedNbrRows * nbrColumns, qint64( std::numeric_limits< int >::max() / 2 ) ) ) );
+        csvData.m_rowBegins.reserve( static_cast< int >( qMin( estimatedNbrRows + 1, qint64( std::numeric_limits< int >::max() / 2 ) ) ) );
+        csvData.m_rowEnds.reserve( csvData.m_rowBegins.capacity() );
+
+        /** As in Processing::IsSubMatrix(), a non numerical value in the 1st data row
+         *  means the subjects are stored by row: every column is then also kept as text **/
+        if( !ParseRow( tokens, csvData ) )
+        {
+            csvData.m_isSubMatrix = true;
+            for( int column = 1; column < nbrColumns; column++ )
+            {
+                csvData.m_textColumns.insert( column, QStringList() << ( column < tokens.size() ? ToString( tokens.at( column ) ) : QString() ) );
+            }
+        }
+    }
+
+    return lineBegin;
+}
+
+void CSVReader::ParseChunks( const char *begin, const char *end, qint64 position, qint64 rowLength, CSVData& csvData ) const
+{
+    int nbrChunks = GetNbrChunks( end - begin );
+    if( nbrChunks == 1 )
+    {
+        ParseRows( begin, end, position, &csvData );
+        return;
+    }
+
+    /** The remaining rows are split in chunks ending at a row boundary. Chunks are parsed at the same time
+     *  and appended in the order of the file: the result is identical to the one of a single thread. **/
+    QVector< CSVData > chunks( nbrChunks );
+    QList< QFuture< void > > futures;
+    qint64 chunkSize = ( end - begin ) / nbrChunks;
+    const char *chunkBegin = begin;
+    for( int i = 0; i < nbrChunks; i++ )
+    {
+        const char *chunkEnd = end;
+        if( i < nbrChunks - 1 )
+        {
+            chunkEnd = FindLineEnd( chunkBegin + qMin( chunkSize, qint64( end - chunkBegin ) ), end );
+            chunkEnd = chunkEnd < end ? chunkEnd + 1 : end;
+        }
+
+        CSVData& chunk = chunks[ i ];
+        chunk.m_nbrColumns = csvData.m_nbrColumns;
+        chunk.m_isMatrixDimensionOK = true;
+        chunk.m_nanColumns = QBitArray( chunk.m_nbrColumns );
+        chunk.m_values.reserve( static_cast< int >( qMin( ( ( chunkEnd - chunkBegin ) / rowLength + 1 ) * chunk.m_nbrColumns,
+                                                          qint64( std::numeric_limits< int >::max() / 2 ) ) ) );
+        chunk.m_rowBegins.reserve( static_cast< int >( qMin( ( chunkEnd - chunkBegin ) / rowLength + 1, qint64( std::numeric_limits< int >::max() / 2 ) ) ) );
+        chunk.m_rowEnds.reserve( chunk.m_rowBegins.capacity() );
+        foreach( int column, csvData.m_textColumns.keys() )
+        {
+            chunk.m_textColumns.insert( column, QStringList() );
+        }
+
+        /** The last chunk is parsed by the calling thread while the others are running **/
+        if( i < nbrChunks - 1 )
+        {
+            futures.append( QtConcurrent::run( this, &CSVReader::ParseRows, chunkBegin, chunkEnd, position + ( chunkBegin - begin ), &chunk ) );
+        }
+        else
+        {
+            ParseRows( chunkBegin, chunkEnd, position + ( chunkBegin - begin ), &chunk );
+        }
+        chunkBegin = chunkEnd;
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+
+    for( int i = 0; i < chunks.size(); i++ )
+    {
+        const CSVData& chunk = chunks.at( i );
+        csvData.m_values += chunk.m_values;
+        QMap< int, QStringList >::Iterator iterTextColumn = csvData.m_textColumns.begin();
+        while( iterTextColumn != csvData.m_textColumns.end() )
+        {
+            iterTextColumn.value() += chunk.m_textColumns.value( iterTextColumn.key() );
+            ++iterTextColumn;
+        }
+        foreach( int row, chunk.m_raggedRows )
+        {
+            csvData.m_raggedRows.append( csvData.m_nbrRows + row );
+        }
+        csvData.m_nanColumns |= chunk.m_nanColumns;
+        csvData.m_rowBegins += chunk.m_rowBegins;
+        csvData.m_rowEnds += chunk.m_rowEnds;
+        csvData.m_nbrRows += chunk.m_nbrRows;
+        csvData.m_isMatrixDimensionOK = csvData.m_isMatrixDimensionOK && chunk.m_isMatrixDimensionOK;
+    }
+}
+
+void CSVReader::ParseRows( const char *begin, const char *end, qint64 position, CSVData *csvData ) const
+{
+    QVector< Token > tokens;
+    const char *lineBegin = begin;
+    while( lineBegin < end )
+    {
+        /** Both "\n" and "\r" end a row, empty rows are ignored **/
+        const char *lineEnd = FindLineEnd( lineBegin, end );
+        Tokenize( lineBegin, lineEnd, tokens );
+        if( !tokens.isEmpty() )
+        {
+            csvData->m_rowBegins.append( position + ( lineBegin - begin ) );
+            csvData->m_rowEnds.append( position + ( lineEnd - begin ) );
+            ParseRow( tokens, *csvData );
+        }
+        lineBegin = lineEnd + 1;
+    }
+}
+
+bool CSVReader::ParseRow( const QVector< Token >& tokens, CSVData& csvData ) const
+{
+    int nbrColumns = csvData.m_nbrColumns;
+    if( tokens.size() != nbrColumns )
+    {
+        csvData.m_isMatrixDimensionOK = false;
+        csvData.m_raggedRows.append( csvData.m_nbrRows );
+    }
+
+    int offset = csvData.m_values.size();
+    csvData.m_values.resize( offset + nbrColumns );
+    double *rowValues = csvData.m_values.data() + offset;
+    bool isRowNumeric = true;
+    for( int column = 0; column < nbrColumns; column++ )
+    {
+        double value = std::numeric_limits< double >::quiet_NaN();
+        if( column < tokens.size() && !ParseNumber( tokens.at( column ).begin, tokens.at( column ).end, value ) )
+        {
+            value = std::numeric_limits< double >::quiet_NaN();
+            isRowNumeric = false;
+        }
+        if( value != value )
+        {
+            csvData.m_nanColumns.setBit( column );
+        }
+        rowValues[ column ] = value;
+    }
+
+    QMap< int, QStringList >::Iterator iterTextColumn = csvData.m_textColumns.begin();
+    while( iterTextColumn != csvData.m_textColumns.end() )
+    {
+        int column = iterTextColumn.key();
+        iterTextColumn.value().append( column < tokens.size() ? ToString( tokens.at( column ) ) : QString() );
+        ++iterTextColumn;
+    }
+
+    csvData.m_nbrRows++;
+
+    return isRowNumeric;
+}
+
+void CSVReader::AppendTextRow( const QVector< Token >& tokens, CSVData& csvData ) const
+{
+    csvData.m_rowBegins.append( csvData.m_text.size() );
+    for( int i = 0; i < tokens.size(); i++ )
+    {
+        if( i != 0 )
+        {
+            csvData.m_text.append( m_separator );
+        }
+        csvData.m_text.append( tokens.at( i ).begin, static_cast< int >( tokens.at( i ).end - tokens.at( i ).begin ) );
+    }
+    csvData.m_rowEnds.append( csvData.m_text.size() );
+}
+
+void CSVReader::FindDuplicates( CSVData& csvData ) const
+{
+    /** Same subjects as in Processing::GetSubjectsFromData(), with the column name **/
+    QStringList subjects = csvData.m_header;
+    if( csvData.m_isSubMatrix && !subjects.isEmpty() )
+    {
+        subjects = QStringList() << subjects.first() << csvData.m_textColumns.value( 0 );
+    }
+
+    QSet< QString > foundSubjects;
+    QSet< QString > duplicates;
+    foundSubjects.reserve( subjects.size() );
+    foreach( QString subject, subjects )
+    {
+        if( foundSubjects.contains( subject ) )
+        {
+            if( !duplicates.contains( subject ) )
+            {
+                duplicates.insert( subject );
+                csvData.m_duplicates.append( subject );
+            }
+        }
+        else
+        {
+            foundSubjects.insert( subject );
+        }
+    }
+}
+
+bool CSVReader::ReadSelectedRows( QString filePath, Selection& selection, CSVData& csvData ) const
+{
+    QFile file( filePath );
+    CompressedFile compressedFile( filePath );
+    bool isCompressed = CompressedFile::IsCompressed( filePath );
+    if( isCompressed ? !compressedFile.Open() : !file.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+
+    /** A row may be split between two blocks: the end of a block after its last complete row is kept for the next one **/
+    QByteArray buffer;
+    QVector< Token > tokens;
+    bool isFirstBlock = true;
+    bool isReading = true;
+    while( isReading )
+    {
+        QByteArray block = isCompressed ? compressedFile.Read() : file.read( m_streamBlockSize );
+        bool isAtEnd = block.isEmpty();
+        buffer.append( block );
+
+        /** Skip UTF-8 byte order mark **/
+        if( isFirstBlock )
+        {
+            if( buffer.size() < 3 && !isAtEnd )
+            {
+                continue;
+            }
+            if( buffer.startsWith( "\xEF\xBB\xBF" ) )
+            {
+                buffer.remove( 0, 3 );
+            }
+            isFirstBlock = false;
+        }
+
+        const char *begin = buffer.constData();
+        const char *end = begin + buffer.size();
+        const char *lineBegin = begin;
+        while( isReading && lineBegin < end )
+        {
+            const char *lineEnd = FindLineEnd( lineBegin, end );
+            if( lineEnd == end && !isAtEnd )
+            {
+                break;
+            }
+            Tokenize( lineBegin, lineEnd, tokens );
+            lineBegin = lineEnd + 1;
+            if( !tokens.isEmpty() )
+            {
+                isReading = ParseSelectedRow( tokens, selection, csvData );
+            }
+        }
+        buffer.remove( 0, static_cast< int >( qMin( lineBegin, end ) - begin ) );
+        isReading = isReading && !isAtEnd;
+    }
+    file.close();
+    compressedFile.Close();
+
+    return !compressedFile.HasError();
+}
+
+bool CSVReader::ParseSelectedRow( const QVector< Token >& tokens, Selection& selection, CSVData& csvData ) const
+{
+    /** 1st row: column names of the file. The columns kept are known with the 1st data row. **/
+    if( selection.fileHeader.isEmpty() )
+    {
+        foreach( Token token, tokens )
+        {
+            selection.fileHeader.append( ToString( token ) );
+            selection.fileHeaderText.append( QByteArray( token.begin, static_cast< int >( token.end - token.begin ) ) );
+        }
+        selection.nbrFileColumns = tokens.size();
+        return !selection.isHeaderOnly;
+    }
+
+    int dataRow = selection.nbrDataRows++;
+    if( dataRow == 0 )
+    {
+        InitSelection( tokens, selection, csvData );
+    }
+
+    bool isRowSelected = false;
+    if( csvData.m_isSubMatrix )
+    {
+        QString subject = selection.subjectColumnID < tokens.size() ? ToString( tokens.at( selection.subjectColumnID ) ) : QString();
+        if( selection.subjects.contains( subject ) )
+        {
+            isRowSelected = !selection.foundSubjects.contains( subject );
+            if( !isRowSelected && !csvData.m_duplicates.contains( subject ) )
+            {
+                csvData.m_duplicates.append( subject );
+            }
+            selection.foundSubjects.insert( subject );
+        }
+    }
+    else
+    {
+        /** Rows after the last arc length selected are not read **/
+        if( selection.endProfile != -1 && dataRow > selection.endProfile )
+        {
+            return false;
+        }
+        isRowSelected = selection.startProfile == -1 || dataRow >= selection.startProfile;
+    }
+    if( !isRowSelected )
+    {
+        return true;
+    }
+
+    /** Empty cells being skipped, the cells missing in a short row are the last ones **/
+    selection.selectedTokens.clear();
+    foreach( int column, selection.columns )
+    {
+        if( column >= tokens.size() )
+        {
+            break;
+        }
+        selection.selectedTokens.append( tokens.at( column ) );
+    }
+
+    int nbrRaggedRows = csvData.m_raggedRows.size();
+    ParseRow( selection.selectedTokens, csvData );
+    AppendTextRow( selection.selectedTokens, csvData );
+    if( tokens.size() != selection.nbrFileColumns && csvData.m_raggedRows.size() == nbrRaggedRows )
+    {
+        csvData.m_isMatrixDimensionOK = false;
+        csvData.m_raggedRows.append( csvData.m_nbrRows - 1 );
+    }
+
+    return true;
+}
+
+void CSVReader::InitSelection( const QVector< Token >& tokens, Selection& selection, CSVData& csvData ) const
+{
+    /** As in Parse(), a non numerical value in the 1st data row means the subjects are stored by row **/
+    bool isSubMatrix = false;
+    for( int column = 0; column < qMin( tokens.size(), selection.nbrFileColumns ) && !isSubMatrix; column++ )
+    {
+        double value;
+        isSubMatrix = !ParseNumber( tokens.at( column ).begin, tokens.at( column ).end, value );
+    }
+
+    /** Every column of a SubMatrix file. For a profile file, the arc length and the 1st column of each subject selected. **/
+    QSet< QString > foundSubjects;
+    QVector< Token > headerTokens;
+    for( int column = 0; column < selection.nbrFileColumns; column++ )
+    {
+        QString columnName = selection.fileHeader.at( column );
+        bool isColumnSelected = isSubMatrix || column == 0;
+        if( !isColumnSelected && selection.subjects.contains( columnName ) )
+        {
+            isColumnSelected = !foundSubjects.contains( columnName );
+            if( !isColumnSelected && !csvData.m_duplicates.contains( columnName ) )
+            {
+                csvData.m_duplicates.append( columnName );
+            }
+            foundSubjects.insert( columnName );
+        }
+
+        if( isColumnSelected )
+        {
+            selection.columns.append( column );
+            csvData.m_header.append( columnName );
+            const QByteArray& columnText = selection.fileHeaderText.at( column );
+            Token token = { columnText.constData(), columnText.constData() + columnText.size() };
+            headerTokens.append( token );
+        }
+    }
+    AppendTextRow( headerTokens, csvData );
+    csvData.m_separator = m_separator;
+
+    csvData.m_nbrColumns = csvData.m_header.size();
+    csvData.m_nanColumns = QBitArray( csvData.m_nbrColumns );
+    csvData.m_nbrRows = 1;
+    csvData.m_isMatrixDimensionOK = true;
+    csvData.m_isSubMatrix = isSubMatrix;
+    for( int column = 0; column < ( isSubMatrix ? csvData.m_nbrColumns : 1 ); column++ )
+    {
+        csvData.m_textColumns.insert( column, QStringList() );
+    }
+}
+
+int CSVReader::GetNbrChunks( qint64 size ) const
+{
+    int nbrThreads = m_nbrThreads > 0 ? m_nbrThreads : QThread::idealThreadCount();
+
+    return static_cast< int >( qBound( qint64( 1 ), size / m_minChunkSize, qint64( qMax( nbrThreads, 1 ) ) ) );
+}
+
+const char* CSVReader::FindLineEnd( const char *begin, const char *end )
+{
+    const char *lineEnd = begin;
+    while( lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r' )
+    {
+        lineEnd++;
+    }
+
+    return lineEnd;
+}
+
+void CSVReader::Tokenize( const char *begin, const char *end, QVector< Token >& tokens ) const
+{
+    tokens.clear();
+
+    const char *separator = m_separator.constData();
+    int separatorSize = m_separator.size();
+    const char *tokenBegin = begin;
+    const char *current = begin;
+    while( current <= end )
+    {
+        bool isTokenEnd = current == end ||
+                ( separatorSize == 1 ? *current == *separator :
+                                       ( end - current >= separatorSize && qstrncmp( current, separator, separatorSize ) == 0 ) );
+        if( isTokenEnd )
+        {
+            /** Empty cells are ignored, as in ReadText() **/
+            if( current != tokenBegin )
+            {
+                Token token = { tokenBegin, current };
+                tokens.append( token );
+            }
+            if( current == end )
+            {
+                break;
+            }
+            current += separatorSize;
+            tokenBegin = current;
+        }
+        else
+        {
+            current++;
+        }
+    }
+}
+
+bool CSVReader::ParseNumber( const char *begin, const char *end, double& value )
+{
+    while( begin < end && ( *begin == ' ' || *begin == '\t' || *begin == '"' ) )
+    {
+        begin++;
+    }
+    while( end > begin && ( end[ -1 ] == ' ' || end[ -1 ] == '\t' || end[ -1 ] == '"' ) )
+    {
+        end--;
+    }
+    if( begin == end )
+    {
+        return false;
+    }
+
+    const char *current = begin;
+    bool isNegative = false;
+    if( *current == '-' || *current == '+' )
+    {
+        isNegative = *current == '-';
+        current++;
+    }
+
+    /** nan, -nan and inf as written by C/C++ programs and MATLAB **/
+    if( current < end && !IsDigit( *current ) && *current != '.' )
+    {
+        int length = end - current;
+        if( length == 3 && qstrnicmp( current, "nan", 3 ) == 0 )
+        {
+            value = std::numeric_limits< double >::quiet_NaN();
+            return true;
+        }
+        if( ( length == 3 && qstrnicmp( current, "inf", 3 ) == 0 ) || ( length == 8 && qstrnicmp( current, "infinity", 8 ) == 0 ) )
+        {
+            value = isNegative ? -std::numeric_limits< double >::infinity() : std::numeric_limits< double >::infinity();
+            return true;
+        }
+        return false;
+    }
+
+    /** Up to 19 significant digits are accumulated in an integer mantissa **/
+    quint64 mantissa = 0;
+    int nbrDigits = 0;
+    int exponent = 0;
+    bool isDigitFound = false;
+    bool isTruncated = false;
+    while( current < end && IsDigit( *current ) )
+    {
+        if( AccumulateEightDigits( current, end, mantissa, nbrDigits ) )
+        {
+            isDigitFound = true;
+            current += 8;
+            continue;
+        }
+
+        int digit = *current - '0';
+        isDigitFound = true;
+        if( nbrDigits < 19 )
+        {
+            if( mantissa != 0 || digit != 0 )
+            {
+                mantissa = mantissa * 10 + digit;
+                nbrDigits++;
+            }
+        }
+        else
+        {
+            exponent++;
+            isTruncated = isTruncated || digit != 0;
+        }
+        current++;
+    }
+    if( current < end && *current == '.' )
+    {
+        current++;
+        while( current < end && IsDigit( *current ) )
+        {
+            if( AccumulateEightDigits( current, end, mantissa, nbrDigits ) )
+            {
+                isDigitFound = true;
+                exponent -= 8;
+                current += 8;
+                continue;
+            }
+
+            int digit = *current - '0';
+            isDigitFound = true;
+            if( nbrDigits < 19 )
+            {
+                if( mantissa != 0 || digit != 0 )
+                {
+                    mantissa = mantissa * 10 + digit;
+                    nbrDigits++;
+                }
+                exponent--;
+            }
+            else
+            {
+                isTruncated = isTruncated || digit != 0;
+            }
+            current++;
+        }
+    }
+    if( !isDigitFound )
+    {
+        return false;
+    }
+    if( current < end && ( *current == 'e' || *current == 'E' ) )
+    {
+        current++;
+        bool isExponentNegative = false;
+        if( current < end && ( *current == '-' || *current == '+' ) )
+        {
+            isExponentNegative = *current == '-';
+            current++;
+        }
+        if( current == end || !IsDigit( *current ) )
+        {
+            return false;
+        }
+        int writtenExponent = 0;
+        while( current < end && IsDigit( *current ) )
+        {
+            if( writtenExponent < 100000 )
+            {
+                writtenExponent = writtenExponent * 10 + ( *current - '0' );
+            }
+            current++;
+        }
+        exponent += isExponentNegative ? -writtenExponent : writtenExponent;
+    }
+    if( current != end )
+    {
+        return false;
+    }
+
+    if( mantissa == 0 )
+    {
+        value = isNegative ? -0.0 : 0.0;
+        return true;
+    }
+
+    /** The mantissa and the power of ten are both exact doubles: a single multiplication
+     *  or division gives the correctly rounded result, identical to QString::toDouble() **/
+    if( !isTruncated && mantissa <= ( Q_UINT64_C( 1 ) << 53 ) && exponent >= -22 && exponent <= 22 )
+    {
+        double result = static_cast< double >( mantissa );
+        result = exponent < 0 ? result / s_powersOfTen[ -exponent ] : result * s_powersOfTen[ exponent ];
+        value = isNegative ? -result : result;
+        return true;
+    }
+
+    bool ok;
+    value = QByteArray( begin, end - begin ).toDouble( &ok );
+    return ok;
+}
+
+QString CSVReader::ToString( const Token& token )
+{
+    const char *begin = token.begin;
+    const char *end = token.end;
+
+    /** Remove quotes if element quoted **/
+    if( end > begin && end[ -1 ] == '"' )
+    {
+        end--;
+    }
+    if( end > begin && *begin == '"' )
+    {
+        begin++;
+    }
+
+    return QString::fromUtf8( begin, end - begin );
+}
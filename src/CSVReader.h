@@ -0,0 +1,130 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include "CSVData.h"
+#include "CompressedFileDevice.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QTextStream>
+#include <QThread>
+#include <QFuture>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+
+class CSVReader
+{
+    friend class CSVWriter;
+    friend class TestCSVReader; /** For unit tests **/
+
+public:
+    explicit CSVReader( const QString& separator );
+
+
+    /** gzip and zstd files (see CompressedFile) are read as they are decompressed **/
+    CSVData Read( QString filePath ); // Tested
+
+    CSVData ReadContent( const QByteArray& content ); // Tested
+
+    /** Cells kept as written, for the files copied as they are (MATLAB inputs, file edition) **/
+    QList< QStringList > ReadText( QString filePath ); // Tested
+
+    /** The file is read block by block and only the selected part is kept, so memory follows the selection, not the file.
+     *  Profile file: arc length column and the columns of the subjects, rows startProfile to endProfile (-1: no limit).
+     *  SubMatrix file: every column, rows of the subjects found in the column subjectColumnID.
+     *  A subject found twice is only kept once, the validation report covers the data kept. **/
+    CSVData ReadSelection( QString filePath, const QStringList& subjects, int subjectColumnID, int startProfile, int endProfile ); // Tested
+
+    /** Only the 1st row of the file is read **/
+    QStringList ReadHeader( QString filePath ); // Tested
+
+
+    /** Big files are split at row boundaries and the parts are parsed at the same time.
+     *  0 uses one thread per core, 1 parses in the calling thread. Values read are the same whatever the number. **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+    int GetNbrThreads() const; // Tested
+
+
+private:
+    struct Token
+    {
+        const char *begin;
+        const char *end;
+    };
+
+    /** Part of the file kept by ReadSelection(), and what is known of the file so far **/
+    struct Selection
+    {
+        Selection() : subjectColumnID( 0 ), startProfile( -1 ), endProfile( -1 ), isHeaderOnly( false ),
+            nbrFileColumns( 0 ), nbrDataRows( 0 ) {}
+
+        QSet< QString > subjects;
+        int subjectColumnID, startProfile, endProfile;
+        bool isHeaderOnly;
+
+        QStringList fileHeader;
+        QList< QByteArray > fileHeaderText;
+        int nbrFileColumns, nbrDataRows;
+        QVector< int > columns;
+        QSet< QString > foundSubjects;
+        QVector< Token > selectedTokens;
+    };
+
+    /** Smallest part of a file given to a thread **/
+    static const qint64 m_minChunkSize;
+
+
+    QByteArray m_separator;
+
+    int m_nbrThreads;
+
+    /** Size of the blocks read by ReadSelection() **/
+    qint64 m_streamBlockSize;
+
+
+    /** Rows parsed while the following blocks are decompressed **/
+    CSVData ReadCompressed( QString filePath ) const; // Tested
+
+    void Parse( const char *begin, const char *end, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Parses the header and the 1st data row if not done yet, returns the beginning of the next row.
+     *  position: position of begin in the file, from which the positions of the rows are kept (see CSVData::m_rowBegins) **/
+    const char* ParseHeader( const char *begin, const char *end, qint64 position, qint64& rowLength, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Parses the data rows in parallel chunks if the file is big enough **/
+    void ParseChunks( const char *begin, const char *end, qint64 position, qint64 rowLength, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Appends the data rows found between begin and end. A pointer is used so the rows can be parsed in another thread **/
+    void ParseRows( const char *begin, const char *end, qint64 position, CSVData *csvData ) const; // Not Directly Tested
+
+    /** Appends one data row, returns false if a cell is not a number **/
+    bool ParseRow( const QVector< Token >& tokens, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Keeps the cells of a selected row as written, joined by the separator, see CSVData::m_text **/
+    void AppendTextRow( const QVector< Token >& tokens, CSVData& csvData ) const; // Not Directly Tested
+
+    void FindDuplicates( CSVData& csvData ) const; // Not Directly Tested
+
+    /** Reads the file block by block, returns false if the file cannot be opened **/
+    bool ReadSelectedRows( QString filePath, Selection& selection, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Keeps the row if selected, returns false once the rest of the file is not needed **/
+    bool ParseSelectedRow( const QVector< Token >& tokens, Selection& selection, CSVData& csvData ) const; // Not Directly Tested
+
+    /** Columns kept and validation report, set from the header and the 1st data row **/
+    void InitSelection( const QVector< Token >& tokens, Selection& selection, CSVData& csvData ) const; // Not Directly Tested
+
+    int GetNbrChunks( qint64 size ) const; // Not Directly Tested
+
+    static const char* FindLineEnd( const char *begin, const char *end ); // Not Directly Tested
+
+    void Tokenize( const char *begin, const char *end, QVector< Token >& tokens ) const; // Not Directly Tested
+
+    static bool ParseNumber( const char *begin, const char *end, double& value ); // Tested
+
+    static QString ToString( const Token& token ); // Not Directly Tested
+};
+
+#endif // CSVREADER_H
@@ -0,0 +1,224 @@
+#include "CSVSidecar.h"
+
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+//#include <QDebug>
+
+
+const quint64 CSVSidecar::m_magicNumber = Q_UINT64_C( 0x5349445354544446 ); /** "FDTTSDIS" **/
+const quint32 CSVSidecar::m_version = 4;
+const qint64 CSVSidecar::m_hashedBlockSize = 64 * 1024;
+
+CSVSidecar::CSVSidecar()
+{
+}
+
+
+QString CSVSidecar::GetSidecarPath( const QString& filePath )
+{
+    QFileInfo fileInfo( filePath );
+    return fileInfo.absolutePath() + "/." + fileInfo.fileName() + ".fadtts";
+}
+
+bool CSVSidecar::Read( const QString& filePath, CSVData& csvData )
+{
+    Source source;
+    QFile sidecarFile( GetSidecarPath( filePath ) );
+    if( !GetSource( filePath, source ) || !sidecarFile.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+    qint64 sidecarSize = sidecarFile.size();
+    uchar *mappedSidecar = sidecarSize > 0 ? sidecarFile.map( 0, sidecarSize ) : 0;
+    if( !mappedSidecar )
+    {
+        return false;
+    }
+
+    /** Only the header is read through the stream, the values are copied from the mapped file **/
+    QByteArray rawData = QByteArray::fromRawData( reinterpret_cast< const char* >( mappedSidecar ),
+                                                  static_cast< int >( qMin( sidecarSize, qint64( std::numeric_limits< int >::max() ) ) ) );
+    QDataStream stream( rawData );
+    stream.setVersion( QDataStream::Qt_5_0 );
+    stream.setByteOrder( QDataStream::LittleEndian );
+
+    quint64 magicNumber = 0;
+    quint32 version = 0;
+    Source sidecarSource;
+    stream >> magicNumber >> version >> sidecarSource.size >> sidecarSource.lastModified >> sidecarSource.hash;
+    bool isUpToDate = stream.status() == QDataStream::Ok && magicNumber == m_magicNumber && version == m_version &&
+            sidecarSource.size == source.size && sidecarSource.lastModified == source.lastModified && sidecarSource.hash == source.hash;
+
+    CSVData sidecarData;
+    qint32 nbrRows = 0;
+    qint32 nbrColumns = 0;
+    qint64 nbrValues = -1;
+    if( isUpToDate )
+    {
+        stream >> nbrRows >> nbrColumns >> sidecarData.m_isMatrixDimensionOK >> sidecarData.m_isSubMatrix
+               >> sidecarData.m_header >> sidecarData.m_textColumns
+               >> sidecarData.m_raggedRows >> sidecarData.m_duplicates >> sidecarData.m_nanColumns >> sidecarData.m_separator >> nbrValues;
+    }
+    qint64 valuesOffset = ( stream.device()->pos() + 7 ) / 8 * 8;
+    qint64 rowBeginsOffset = valuesOffset + nbrValues * qint64( sizeof( double ) );
+    qint64 rowEndsOffset = rowBeginsOffset + nbrRows * qint64( sizeof( qint64 ) );
+    bool isValid = isUpToDate && stream.status() == QDataStream::Ok && nbrRows > 0 && nbrColumns >= 0 &&
+            nbrValues == qint64( nbrRows - 1 ) * nbrColumns && nbrValues <= std::numeric_limits< int >::max() &&
+            rowEndsOffset + nbrRows * qint64( sizeof( qint64 ) ) == sidecarSize;
+
+    if( isValid )
+    {
+        sidecarData.m_filePath = filePath;
+        sidecarData.m_sourceSize = source.size;
+        sidecarData.m_nbrRows = nbrRows;
+        sidecarData.m_nbrColumns = nbrColumns;
+        sidecarData.m_values.resize( static_cast< int >( nbrValues ) );
+
+        /** Values are stored in little-endian order **/
+        const uchar *values = mappedSidecar + valuesOffset;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+        std::memcpy( sidecarData.m_values.data(), values, nbrValues * sizeof( double ) );
+#else
+        for( int i = 0; i < sidecarData.m_values.size(); i++ )
+        {
+            quint64 bits = qFromLittleEndian< quint64 >( values + i * sizeof( double ) );
+            std::memcpy( sidecarData.m_values.data() + i, &bits, sizeof( double ) );
+        }
+#endif
+        /** Positions of the rows after the values, the text being read again from the source file when needed **/
+        sidecarData.m_rowBegins = ReadPositions( mappedSidecar + rowBeginsOffset, nbrRows );
+        sidecarData.m_rowEnds = ReadPositions( mappedSidecar + rowEndsOffset, nbrRows );
+    }
+    if( isValid )
+    {
+        csvData = sidecarData;
+    }
+
+    sidecarFile.unmap( mappedSidecar );
+    sidecarFile.close();
+
+    return isValid;
+}
+
+bool CSVSidecar::Write( const QString& filePath, const CSVData& csvData, const Source& source )
+{
+    if( csvData.IsEmpty() || !QFileInfo( filePath ).isFile() )
+    {
+        return false;
+    }
+
+    QByteArray header;
+    QDataStream stream( &header, QIODevice::WriteOnly );
+    stream.setVersion( QDataStream::Qt_5_0 );
+    stream.setByteOrder( QDataStream::LittleEndian );
+    stream << m_magicNumber << m_version << source.size << source.lastModified << source.hash;
+    stream << qint32( csvData.m_nbrRows ) << qint32( csvData.m_nbrColumns ) << csvData.m_isMatrixDimensionOK << csvData.m_isSubMatrix
+           << csvData.m_header << csvData.m_textColumns
+           << csvData.m_raggedRows << csvData.m_duplicates << csvData.m_nanColumns << csvData.m_separator << qint64( csvData.m_values.size() );
+
+    /** Values aligned on 8 bytes so they can be copied straight from the mapped sidecar **/
+    header.append( QByteArray( ( 8 - header.size() % 8 ) % 8, '\0' ) );
+
+    /** Written in a temporary file renamed at the end: a sidecar is never read half written **/
+    QSaveFile sidecarFile( GetSidecarPath( filePath ) );
+    if( !sidecarFile.open( QIODevice::WriteOnly ) )
+    {
+        return false;
+    }
+    sidecarFile.write( header );
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    sidecarFile.write( reinterpret_cast< const char* >( csvData.m_values.constData() ), csvData.m_values.size() * qint64( sizeof( double ) ) );
+#else
+    QByteArray values( csvData.m_values.size() * sizeof( double ), Qt::Uninitialized );
+    for( int i = 0; i < csvData.m_values.size(); i++ )
+    {
+        quint64 bits;
+        std::memcpy( &bits, csvData.m_values.constData() + i, sizeof( double ) );
+        qToLittleEndian< quint64 >( bits, reinterpret_cast< uchar* >( values.data() + i * sizeof( double ) ) );
+    }
+    sidecarFile.write( values );
+#endif
+    sidecarFile.write( WritePositions( csvData.m_rowBegins ) );
+    sidecarFile.write( WritePositions( csvData.m_rowEnds ) );
+
+    return sidecarFile.commit();
+}
+
+
+bool CSVSidecar::GetSource( const QString& filePath, Source& source )
+{
+    QFile file( filePath );
+    if( !file.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+    source.size = file.size();
+    source.lastModified = QFileInfo( filePath ).lastModified().toMSecsSinceEpoch();
+
+    /** Only the beginning and the end of the file are hashed, so a big file is checked in no time **/
+    source.hash = Q_UINT64_C( 14695981039346656037 );
+    qint64 headSize = qMin( source.size, m_hashedBlockSize );
+    qint64 tailOffset = qMax( headSize, source.size - m_hashedBlockSize );
+    QList< QPair< qint64, qint64 > > blocks;
+    blocks.append( qMakePair( qint64( 0 ), headSize ) );
+    blocks.append( qMakePair( tailOffset, source.size - tailOffset ) );
+    for( int i = 0; i < blocks.size(); i++ )
+    {
+        if( blocks.at( i ).second == 0 )
+        {
+            continue;
+        }
+        uchar *mappedBlock = file.map( blocks.at( i ).first, blocks.at( i ).second );
+        if( mappedBlock )
+        {
+            source.hash = ComputeHash( mappedBlock, blocks.at( i ).second, source.hash );
+            file.unmap( mappedBlock );
+        }
+        else
+        {
+            file.seek( blocks.at( i ).first );
+            QByteArray block = file.read( blocks.at( i ).second );
+            source.hash = ComputeHash( reinterpret_cast< const uchar* >( block.constData() ), block.size(), source.hash );
+        }
+    }
+    file.close();
+
+    return true;
+}
+
+QVector< qint64 > CSVSidecar::ReadPositions( const uchar *data, int nbrPositions )
+{
+    QVector< qint64 > positions( nbrPositions );
+    for( int i = 0; i < nbrPositions; i++ )
+    {
+        positions[ i ] = qFromLittleEndian< qint64 >( data + i * sizeof( qint64 ) );
+    }
+
+    return positions;
+}
+
+QByteArray CSVSidecar::WritePositions( const QVector< qint64 >& positions )
+{
+    QByteArray data( positions.size() * static_cast< int >( sizeof( qint64 ) ), Qt::Uninitialized );
+    for( int i = 0; i < positions.size(); i++ )
+    {
+        qToLittleEndian< qint64 >( positions.at( i ), reinterpret_cast< uchar* >( data.data() + i * sizeof( qint64 ) ) );
+    }
+
+    return data;
+}
+
+quint64 CSVSidecar::ComputeHash( const uchar *data, qint64 size, quint64 hash )
+{
+    /** 64-bit FNV-1a **/
+    for( qint64 i = 0; i < size; i++ )
+    {
+        hash ^= data[ i ];
+        hash *= Q_UINT64_C( 1099511628211 );
+    }
+
+    return hash;
+}
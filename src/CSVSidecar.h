@@ -0,0 +1,61 @@
+#ifndef CSVSIDECAR_H
+#define CSVSIDECAR_H
+
+#include "CSVData.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDataStream>
+
+/** Binary copy of a parsed input file, written next to it as ".<file name>.fadtts".
+ *  Loading it maps the file and copies the values: the text is not parsed again, and the validation
+ *  report of the file and the positions of its rows (see CSVData::m_rowBegins) are stored with the values.
+ *  The size, the last modification time and a hash of the source file are stored in the header:
+ *  a sidecar no longer matching its source file is ignored, and can be written again. **/
+class CSVSidecar
+{
+    friend class TestCSVSidecar; /** For unit tests **/
+
+public:
+    /** Size, last modification time and hash of a source file **/
+    struct Source
+    {
+        qint64 size;
+        qint64 lastModified;
+        quint64 hash;
+    };
+
+
+    explicit CSVSidecar();
+
+
+    static QString GetSidecarPath( const QString& filePath ); // Tested
+
+    /** Returns false if there is no sidecar, if it is outdated or if it cannot be read **/
+    bool Read( const QString& filePath, CSVData& csvData ); // Tested
+
+    /** source: taken before the file was parsed, so a file modified during the parse does not get a sidecar matching it **/
+    bool Write( const QString& filePath, const CSVData& csvData, const Source& source ); // Tested
+
+    /** Returns false if the file cannot be opened **/
+    bool GetSource( const QString& filePath, Source& source ); // Tested
+
+
+private:
+    static const quint64 m_magicNumber;
+    static const quint32 m_version;
+
+    /** Size of the beginning and of the end of the source file used to compute its hash **/
+    static const qint64 m_hashedBlockSize;
+
+
+    quint64 ComputeHash( const uchar *data, qint64 size, quint64 hash ); // Not Directly Tested
+
+    /** Positions of the rows, stored as little-endian 64-bit integers **/
+    static QVector< qint64 > ReadPositions( const uchar *data, int nbrPositions ); // Not Directly Tested
+
+    static QByteArray WritePositions( const QVector< qint64 >& positions ); // Not Directly Tested
+};
+
+#endif // CSVSIDECAR_H
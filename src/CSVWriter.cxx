@@ -0,0 +1,205 @@
+#include "CSVWriter.h"
+
+#include <QFileInfo>
+#include <QPair>
+
+#include <algorithm>
+#include <limits>
+
+//#include <QDebug>
+
+
+CSVWriter::CSVWriter( const QString& separator )
+{
+    m_separator = separator.toUtf8();
+}
+
+
+bool CSVWriter::Gather( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer ) const
+{
+    /** Buffer sized from the average length of the cells of the file **/
+    qint64 nbrBytesPerCell = 1;
+    if( !data.m_rowBegins.isEmpty() && data.m_nbrColumns > 0 )
+    {
+        nbrBytesPerCell = ( data.m_rowEnds.last() - data.m_rowBegins.first() ) / ( qint64( data.m_rowBegins.size() ) * data.m_nbrColumns ) + 1;
+    }
+    buffer.clear();
+    buffer.reserve( static_cast< int >( qMin( rowPlan.size() * ( columnPlan.size() * ( nbrBytesPerCell + m_separator.size() ) + 1 ),
+                                              qint64( std::numeric_limits< int >::max() / 2 ) ) ) );
+
+    /** The rows of a content or of a selection are kept by the data, the rows of a file are read again from the file **/
+    bool isGathered = false;
+    if( !data.m_text.isEmpty() || data.m_rowBegins.isEmpty() )
+    {
+        isGathered = GatherRows( data, data.m_text.constData(), data.m_text.size(), rowPlan, columnPlan, buffer );
+    }
+    else if( QFileInfo( data.m_filePath ).size() == data.m_sourceSize )
+    {
+        /** A file changed since it was parsed is not read: the positions of its rows no longer match **/
+        if( CompressedFile::IsCompressed( data.m_filePath ) )
+        {
+            isGathered = GatherCompressedRows( data, rowPlan, columnPlan, buffer );
+        }
+        else
+        {
+            /** As in CSVReader::Read(), the content is read in a buffer if the file cannot be mapped **/
+            QFile file( data.m_filePath );
+            if( file.open( QIODevice::ReadOnly ) )
+            {
+                qint64 fileSize = file.size();
+                uchar *mappedFile = fileSize > 0 ? file.map( 0, fileSize ) : 0;
+                if( mappedFile )
+                {
+                    isGathered = GatherRows( data, reinterpret_cast< const char* >( mappedFile ), fileSize, rowPlan, columnPlan, buffer );
+                    file.unmap( mappedFile );
+                }
+                else
+                {
+                    QByteArray content = file.readAll();
+                    isGathered = GatherRows( data, content.constData(), content.size(), rowPlan, columnPlan, buffer );
+                }
+                file.close();
+            }
+        }
+    }
+
+    if( !isGathered )
+    {
+        buffer.clear();
+    }
+
+    return isGathered;
+}
+
+bool CSVWriter::Write( QIODevice& device, const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan ) const
+{
+    QByteArray buffer;
+    if( !Gather( data, rowPlan, columnPlan, buffer ) )
+    {
+        return false;
+    }
+
+    return device.write( buffer ) == buffer.size();
+}
+
+
+bool CSVWriter::GatherRows( const CSVData& data, const char *text, qint64 textSize, const QVector< int >& rowPlan,
+                            const QVector< int >& columnPlan, QByteArray& buffer ) const
+{
+    CSVReader csvReader( QString::fromUtf8( data.m_separator ) );
+    QVector< CSVReader::Token > tokens;
+    foreach( int row, rowPlan )
+    {
+        const char *rowBegin = 0;
+        const char *rowEnd = 0;
+        if( row >= 0 && row < data.m_rowBegins.size() )
+        {
+            qint64 begin = data.m_rowBegins.at( row );
+            qint64 end = data.m_rowEnds.at( row );
+            if( begin < 0 || begin > end || end > textSize )
+            {
+                return false;
+            }
+            rowBegin = text + begin;
+            rowEnd = text + end;
+        }
+        AppendRow( csvReader, rowBegin, rowEnd, columnPlan, tokens, buffer );
+    }
+
+    return true;
+}
+
+bool CSVWriter::GatherCompressedRows( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer ) const
+{
+    CompressedFile compressedFile( data.m_filePath );
+    if( !compressedFile.Open() )
+    {
+        return false;
+    }
+
+    /** Position in the file of each row of the plan, -1 for the rows out of the data **/
+    QVector< QPair< qint64, int > > rowOrder;
+    rowOrder.reserve( rowPlan.size() );
+    for( int i = 0; i < rowPlan.size(); i++ )
+    {
+        int row = rowPlan.at( i );
+        rowOrder.append( qMakePair( row >= 0 && row < data.m_rowBegins.size() ? data.m_rowBegins.at( row ) : qint64( -1 ), i ) );
+    }
+    std::sort( rowOrder.begin(), rowOrder.end() );
+
+    /** Only the decompressed blocks holding the row being read are kept **/
+    CSVReader csvReader( QString::fromUtf8( data.m_separator ) );
+    QVector< CSVReader::Token > tokens;
+    QVector< QByteArray > lines( rowPlan.size() );
+    QByteArray rowBuffer;
+    qint64 rowBufferPosition = 0;
+    bool isAtEnd = false;
+    bool isRead = true;
+    for( int i = 0; i < rowOrder.size(); i++ )
+    {
+        qint64 begin = rowOrder.at( i ).first;
+        int planIndex = rowOrder.at( i ).second;
+        const char *rowBegin = 0;
+        const char *rowEnd = 0;
+        if( begin != -1 )
+        {
+            qint64 end = data.m_rowEnds.at( rowPlan.at( planIndex ) );
+            while( rowBufferPosition + rowBuffer.size() < end && !isAtEnd )
+            {
+                QByteArray block = compressedFile.Read();
+                isAtEnd = block.isEmpty();
+                if( rowBufferPosition + rowBuffer.size() + block.size() <= begin )
+                {
+                    /** Block before the row: skipped **/
+                    rowBufferPosition += rowBuffer.size() + block.size();
+                    rowBuffer.clear();
+                }
+                else
+                {
+                    rowBuffer.append( block );
+                }
+            }
+            isRead = begin >= rowBufferPosition && begin <= end && end <= rowBufferPosition + rowBuffer.size();
+            if( !isRead )
+            {
+                break;
+            }
+            rowBuffer.remove( 0, static_cast< int >( begin - rowBufferPosition ) );
+            rowBufferPosition = begin;
+            rowBegin = rowBuffer.constData();
+            rowEnd = rowBegin + ( end - begin );
+        }
+        AppendRow( csvReader, rowBegin, rowEnd, columnPlan, tokens, lines[ planIndex ] );
+    }
+    compressedFile.Close();
+
+    if( isRead )
+    {
+        foreach( const QByteArray& line, lines )
+        {
+            buffer.append( line );
+        }
+    }
+
+    return isRead;
+}
+
+void CSVWriter::AppendRow( const CSVReader& csvReader, const char *begin, const char *end, const QVector< int >& columnPlan,
+                           QVector< CSVReader::Token >& tokens, QByteArray& buffer ) const
+{
+    csvReader.Tokenize( begin, end, tokens );
+    for( int i = 0; i < columnPlan.size(); i++ )
+    {
+        if( i != 0 )
+        {
+            buffer.append( m_separator );
+        }
+
+        int column = columnPlan.at( i );
+        if( column >= 0 && column < tokens.size() )
+        {
+            buffer.append( tokens.at( column ).begin, static_cast< int >( tokens.at( column ).end - tokens.at( column ).begin ) );
+        }
+    }
+    buffer.append( '\n' );
+}
@@ -0,0 +1,48 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include "CSVData.h"
+#include "CSVReader.h"
+
+#include <QIODevice>
+#include <QVector>
+
+/** Writes a selection of the cells of a file already parsed (see DatasetCache::GetData() and CSVReader::ReadSelection()),
+ *  the rows and the columns kept being given as index plans (see SelectionPlan::GetIndices()).
+ *  The rows of a file are read again from the file mapped in memory, or as it is decompressed, at the positions kept by CSVData.
+ *  The cells are copied byte for byte into one buffer sized ahead and written in one call:
+ *  no value is formatted again and no line is translated or flushed on its own. **/
+class CSVWriter
+{
+    friend class TestCSVWriter; /** For unit tests **/
+
+public:
+    explicit CSVWriter( const QString& separator );
+
+
+    /** Rows and columns written in the order of the plans, rows indexed as in CSVData (row 0 is the header).
+     *  Cells missing from a row are written empty. Each row ends with "\n", the last one included.
+     *  Returns false if the rows cannot be read again, e.g. the file changed since it was parsed. **/
+    bool Gather( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer ) const; // Tested
+
+    /** Returns false if the rows cannot be read again or if the buffer could not be entirely written to device **/
+    bool Write( QIODevice& device, const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan ) const; // Tested
+
+
+private:
+    QByteArray m_separator;
+
+
+    /** Rows read from text holding all the rows: the text of a content or of a selection, or a file mapped in memory **/
+    bool GatherRows( const CSVData& data, const char *text, qint64 textSize, const QVector< int >& rowPlan,
+                     const QVector< int >& columnPlan, QByteArray& buffer ) const; // Not Directly Tested
+
+    /** Rows read in the order of the file as it is decompressed, so the file is decompressed once whatever the order of the plan **/
+    bool GatherCompressedRows( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer ) const; // Not Directly Tested
+
+    /** Splits the row as the reader did and appends its cells in the order of columnPlan **/
+    void AppendRow( const CSVReader& csvReader, const char *begin, const char *end, const QVector< int >& columnPlan,
+                    QVector< CSVReader::Token >& tokens, QByteArray& buffer ) const; // Not Directly Tested
+};
+
+#endif // CSVWRITER_H
@@ -0,0 +1,312 @@
+#include "CompressedFile.h"
+
+#include <QMutexLocker>
+
+#include <zlib.h>
+#ifdef FADTTS_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <cstring>
+
+//#include <QDebug>
+
+
+const int CompressedFile::m_blockSize = 256 * 1024;
+const int CompressedFile::m_maxNbrBlocks = 8;
+
+CompressedFile::CompressedFile( const QString& filePath ) :
+    m_file( filePath ),
+    m_decompressionThread( this )
+{
+    m_filePath = filePath;
+    m_format = None;
+    m_isFinished = true;
+    m_isClosed = false;
+    m_hasError = false;
+}
+
+CompressedFile::~CompressedFile()
+{
+    Close();
+}
+
+
+CompressedFile::Format CompressedFile::GetFormat( const QString& filePath )
+{
+    QFile file( filePath );
+    if( !file.open( QIODevice::ReadOnly ) )
+    {
+        return None;
+    }
+    QByteArray magicNumber = file.read( 4 );
+    file.close();
+
+    if( magicNumber.startsWith( QByteArray( "\x1F\x8B", 2 ) ) )
+    {
+        return Gzip;
+    }
+    if( magicNumber == QByteArray( "\x28\xB5\x2F\xFD", 4 ) )
+    {
+        return Zstd;
+    }
+
+    return None;
+}
+
+bool CompressedFile::IsCompressed( const QString& filePath )
+{
+    return GetFormat( filePath ) != None;
+}
+
+bool CompressedFile::IsFormatSupported( Format format )
+{
+#ifndef FADTTS_USE_ZSTD
+    if( format == Zstd )
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+QStringList CompressedFile::GetNameFilters()
+{
+    QStringList nameFilters = QStringList() << "*.csv" << "*.csv.gz";
+    if( IsFormatSupported( Zstd ) )
+    {
+        nameFilters.append( "*.csv.zst" );
+    }
+
+    return nameFilters;
+}
+
+QString CompressedFile::GetUncompressedName( const QString& fileName )
+{
+    if( fileName.endsWith( ".gz", Qt::CaseInsensitive ) )
+    {
+        return fileName.left( fileName.size() - 3 );
+    }
+    if( fileName.endsWith( ".zst", Qt::CaseInsensitive ) )
+    {
+        return fileName.left( fileName.size() - 4 );
+    }
+
+    return fileName;
+}
+
+QByteArray CompressedFile::ReadAll( const QString& filePath )
+{
+    CompressedFile compressedFile( filePath );
+    QByteArray content;
+    if( compressedFile.Open() )
+    {
+        for( QByteArray block = compressedFile.Read(); !block.isEmpty(); block = compressedFile.Read() )
+        {
+            content.append( block );
+        }
+        if( compressedFile.HasError() )
+        {
+            content.clear();
+        }
+    }
+
+    return content;
+}
+
+
+bool CompressedFile::Open()
+{
+    Close();
+
+    m_format = GetFormat( m_filePath );
+    if( m_format == None || !IsFormatSupported( m_format ) || !m_file.open( QIODevice::ReadOnly ) )
+    {
+        return false;
+    }
+
+    m_blocks.clear();
+    m_isFinished = false;
+    m_isClosed = false;
+    m_hasError = false;
+    m_decompressionThread.start();
+
+    return true;
+}
+
+QByteArray CompressedFile::Read()
+{
+    QMutexLocker locker( &m_mutex );
+    while( m_blocks.isEmpty() && !m_isFinished && !m_isClosed )
+    {
+        m_blockAdded.wait( &m_mutex );
+    }
+    if( m_blocks.isEmpty() )
+    {
+        return QByteArray();
+    }
+
+    QByteArray block = m_blocks.dequeue();
+    m_blockRemoved.wakeOne();
+
+    return block;
+}
+
+bool CompressedFile::HasError() const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_hasError;
+}
+
+void CompressedFile::Close()
+{
+    {
+        QMutexLocker locker( &m_mutex );
+        m_isClosed = true;
+        m_blocks.clear();
+        m_blockRemoved.wakeAll();
+        m_blockAdded.wakeAll();
+    }
+    m_decompressionThread.wait();
+
+    if( m_file.isOpen() )
+    {
+        m_file.close();
+    }
+}
+
+
+void CompressedFile::Decompress()
+{
+    bool isDecompressed = m_format == Gzip ? InflateGzip() : DecompressZstd();
+
+    QMutexLocker locker( &m_mutex );
+    m_hasError = !isDecompressed && !m_isClosed;
+    m_isFinished = true;
+    m_blockAdded.wakeAll();
+}
+
+bool CompressedFile::InflateGzip()
+{
+    z_stream stream;
+    std::memset( &stream, 0, sizeof( stream ) );
+    /** 15 + 32: window of 32 KiB, gzip or zlib header detected **/
+    if( inflateInit2( &stream, 15 + 32 ) != Z_OK )
+    {
+        return false;
+    }
+
+    QByteArray input;
+    QByteArray output( m_blockSize, Qt::Uninitialized );
+    int status = Z_OK;
+    bool isDecompressing = true;
+    while( isDecompressing )
+    {
+        if( stream.avail_in == 0 )
+        {
+            input = m_file.read( m_blockSize );
+            if( input.isEmpty() )
+            {
+                break;
+            }
+            stream.next_in = reinterpret_cast< Bytef* >( input.data() );
+            stream.avail_in = static_cast< uInt >( input.size() );
+        }
+
+        stream.next_out = reinterpret_cast< Bytef* >( output.data() );
+        stream.avail_out = static_cast< uInt >( output.size() );
+        status = inflate( &stream, Z_NO_FLUSH );
+        if( status != Z_OK && status != Z_STREAM_END )
+        {
+            isDecompressing = false;
+            break;
+        }
+
+        int nbrBytes = output.size() - static_cast< int >( stream.avail_out );
+        if( nbrBytes > 0 )
+        {
+            isDecompressing = AddBlock( output.constData(), nbrBytes );
+        }
+
+        /** Files written by pigz or concatenated with cat hold several gzip members **/
+        if( status == Z_STREAM_END )
+        {
+            inflateReset( &stream );
+        }
+    }
+    inflateEnd( &stream );
+
+    /** Truncated file: the last member is not complete **/
+    return isDecompressing && status == Z_STREAM_END;
+}
+
+bool CompressedFile::DecompressZstd()
+{
+#ifdef FADTTS_USE_ZSTD
+    ZSTD_DStream *stream = ZSTD_createDStream();
+    if( stream == 0 || ZSTD_isError( ZSTD_initDStream( stream ) ) )
+    {
+        ZSTD_freeDStream( stream );
+        return false;
+    }
+
+    QByteArray input;
+    QByteArray output( static_cast< int >( ZSTD_DStreamOutSize() ), Qt::Uninitialized );
+    ZSTD_inBuffer inBuffer = { 0, 0, 0 };
+    size_t status = 0;
+    bool isDecompressing = true;
+    while( isDecompressing )
+    {
+        if( inBuffer.pos == inBuffer.size )
+        {
+            input = m_file.read( m_blockSize );
+            if( input.isEmpty() )
+            {
+                break;
+            }
+            inBuffer.src = input.constData();
+            inBuffer.size = static_cast< size_t >( input.size() );
+            inBuffer.pos = 0;
+        }
+
+        /** Consecutive frames are decompressed one after the other **/
+        ZSTD_outBuffer outBuffer = { output.data(), static_cast< size_t >( output.size() ), 0 };
+        status = ZSTD_decompressStream( stream, &outBuffer, &inBuffer );
+        if( ZSTD_isError( status ) )
+        {
+            isDecompressing = false;
+            break;
+        }
+
+        if( outBuffer.pos > 0 )
+        {
+            isDecompressing = AddBlock( output.constData(), static_cast< int >( outBuffer.pos ) );
+        }
+    }
+    ZSTD_freeDStream( stream );
+
+    /** 0: the last frame is complete and flushed **/
+    return isDecompressing && status == 0;
+#else
+    return false;
+#endif
+}
+
+bool CompressedFile::AddBlock( const char *data, int size )
+{
+    QMutexLocker locker( &m_mutex );
+    while( m_blocks.size() >= m_maxNbrBlocks && !m_isClosed )
+    {
+        m_blockRemoved.wait( &m_mutex );
+    }
+    if( m_isClosed )
+    {
+        return false;
+    }
+
+    m_blocks.enqueue( QByteArray( data, size ) );
+    m_blockAdded.wakeOne();
+
+    return true;
+}
@@ -0,0 +1,106 @@
+#ifndef COMPRESSEDFILE_H
+#define COMPRESSEDFILE_H
+
+#include <QFile>
+#include <QByteArray>
+#include <QStringList>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+
+/** Input file compressed with gzip (.csv.gz) or zstd (.csv.zst), the format being told by the first bytes of the file.
+ *  A thread decompresses the file block by block while the blocks already decompressed are read:
+ *  decompression overlaps with parsing, and only a few blocks are held in memory.
+ *  zstd files are only supported when built with FADTTS_USE_ZSTD. **/
+class CompressedFile
+{
+    friend class TestCompressedFile; /** For unit tests **/
+
+public:
+    enum Format { None, Gzip, Zstd };
+
+    explicit CompressedFile( const QString& filePath );
+
+    ~CompressedFile();
+
+
+    static Format GetFormat( const QString& filePath ); // Tested
+
+    static bool IsCompressed( const QString& filePath ); // Tested
+
+    /** False for zstd when not built with FADTTS_USE_ZSTD **/
+    static bool IsFormatSupported( Format format ); // Tested
+
+    /** Patterns of the input files that can be read, e.g. for the file dialogs: "*.csv", "*.csv.gz", and "*.csv.zst" if supported **/
+    static QStringList GetNameFilters(); // Tested
+
+    /** File name without its compression extension, e.g. "ad_fiber.csv" for "ad_fiber.csv.gz" **/
+    static QString GetUncompressedName( const QString& fileName ); // Tested
+
+    /** Whole decompressed content, empty if the file cannot be decompressed **/
+    static QByteArray ReadAll( const QString& filePath ); // Tested
+
+
+    /** Starts the decompression, returns false if the file cannot be opened or if its format is not supported **/
+    bool Open(); // Tested
+
+    /** Next decompressed block, empty once the end of the file is reached **/
+    QByteArray Read(); // Tested
+
+    /** True if the file is truncated or corrupted, known once Read() returned an empty block **/
+    bool HasError() const; // Tested
+
+    /** Stops the decompression when the rest of the file is not needed **/
+    void Close(); // Tested
+
+
+private:
+    class DecompressionThread : public QThread
+    {
+    public:
+        explicit DecompressionThread( CompressedFile *compressedFile ) : m_compressedFile( compressedFile ) {}
+
+    protected:
+        void run() { m_compressedFile->Decompress(); }
+
+    private:
+        CompressedFile *m_compressedFile;
+    };
+
+    /** Size of the compressed blocks read and of the decompressed blocks given to Read() **/
+    static const int m_blockSize;
+
+    /** Decompressed blocks waiting to be read: the decompression pauses once reached **/
+    static const int m_maxNbrBlocks;
+
+
+    QString m_filePath;
+
+    Format m_format;
+
+    QFile m_file;
+
+    DecompressionThread m_decompressionThread;
+
+    mutable QMutex m_mutex;
+
+    QWaitCondition m_blockAdded, m_blockRemoved;
+
+    QQueue< QByteArray > m_blocks;
+
+    bool m_isFinished, m_isClosed, m_hasError;
+
+
+    /** Run in the decompression thread **/
+    void Decompress(); // Not Directly Tested
+
+    bool InflateGzip(); // Not Directly Tested
+
+    bool DecompressZstd(); // Not Directly Tested
+
+    /** Waits for room in the queue, returns false if the file was closed meanwhile **/
+    bool AddBlock( const char *data, int size ); // Not Directly Tested
+};
+
+#endif // COMPRESSEDFILE_H
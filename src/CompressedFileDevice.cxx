@@ -0,0 +1,89 @@
+#include "CompressedFileDevice.h"
+
+#include <cstring>
+
+//#include <QDebug>
+
+
+CompressedFileDevice::CompressedFileDevice( const QString& filePath ) :
+    m_compressedFile( filePath )
+{
+    m_blockPosition = 0;
+    m_isAtEnd = false;
+}
+
+CompressedFileDevice::~CompressedFileDevice()
+{
+    close();
+}
+
+
+bool CompressedFileDevice::open( OpenMode mode )
+{
+    if( ( mode & WriteOnly ) || !( mode & ReadOnly ) || !m_compressedFile.Open() )
+    {
+        return false;
+    }
+    m_block.clear();
+    m_blockPosition = 0;
+    m_isAtEnd = false;
+
+    return QIODevice::open( mode );
+}
+
+void CompressedFileDevice::close()
+{
+    m_compressedFile.Close();
+    m_block.clear();
+    m_blockPosition = 0;
+    QIODevice::close();
+}
+
+bool CompressedFileDevice::isSequential() const
+{
+    return true;
+}
+
+bool CompressedFileDevice::atEnd() const
+{
+    return m_isAtEnd && QIODevice::atEnd();
+}
+
+qint64 CompressedFileDevice::bytesAvailable() const
+{
+    return m_block.size() - m_blockPosition + QIODevice::bytesAvailable();
+}
+
+bool CompressedFileDevice::HasError() const
+{
+    return m_compressedFile.HasError();
+}
+
+
+qint64 CompressedFileDevice::readData( char *data, qint64 maxSize )
+{
+    if( m_blockPosition >= m_block.size() && !m_isAtEnd )
+    {
+        m_block = m_compressedFile.Read();
+        m_blockPosition = 0;
+        m_isAtEnd = m_block.isEmpty();
+    }
+    if( m_isAtEnd )
+    {
+        return m_compressedFile.HasError() ? -1 : 0;
+    }
+
+    qint64 size = qMin( maxSize, qint64( m_block.size() - m_blockPosition ) );
+    std::memcpy( data, m_block.constData() + m_blockPosition, static_cast< size_t >( size ) );
+    m_blockPosition += static_cast< int >( size );
+
+    return size;
+}
+
+qint64 CompressedFileDevice::writeData( const char *data, qint64 maxSize )
+{
+    Q_UNUSED( data );
+    Q_UNUSED( maxSize );
+
+    return -1;
+}
@@ -0,0 +1,53 @@
+#ifndef COMPRESSEDFILEDEVICE_H
+#define COMPRESSEDFILEDEVICE_H
+
+#include "CompressedFile.h"
+
+#include <QIODevice>
+
+/** Read only, sequential device giving the content of a compressed file (see CompressedFile) as it is decompressed,
+ *  e.g. to a QTextStream reading it line by line: only the blocks being read are held in memory. **/
+class CompressedFileDevice : public QIODevice
+{
+    friend class TestCompressedFile; /** For unit tests **/
+
+public:
+    explicit CompressedFileDevice( const QString& filePath );
+
+    ~CompressedFileDevice();
+
+
+    /** Returns false if mode is not read only, or if the file cannot be decompressed (see CompressedFile::Open()) **/
+    bool open( OpenMode mode ); // Tested
+
+    void close(); // Tested
+
+    bool isSequential() const; // Tested
+
+    /** True once the last block is read, not before the first one **/
+    bool atEnd() const; // Tested
+
+    qint64 bytesAvailable() const; // Tested
+
+    /** True if the file is truncated or corrupted, known once the end is reached **/
+    bool HasError() const; // Tested
+
+
+protected:
+    /** Waits for the next block once the current one is read **/
+    qint64 readData( char *data, qint64 maxSize ); // Not Directly Tested
+
+    qint64 writeData( const char *data, qint64 maxSize ); // Not Directly Tested
+
+
+private:
+    CompressedFile m_compressedFile;
+
+    QByteArray m_block;
+
+    int m_blockPosition;
+
+    bool m_isAtEnd;
+};
+
+#endif // COMPRESSEDFILEDEVICE_H
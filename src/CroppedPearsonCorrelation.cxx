@@ -0,0 +1,183 @@
+#include "CroppedPearsonCorrelation.h"
+
+#include <cmath>
+#include <limits>
+
+//#include <QDebug>
+
+
+CroppedPearsonCorrelation::CroppedPearsonCorrelation()
+{
+    m_nbrProfiles = 0;
+    m_nbrPoints = 0;
+}
+
+
+void CroppedPearsonCorrelation::SetProfiles( const QList< double >& reference, const QList< QList< double > >& profiles )
+{
+    m_nbrProfiles = profiles.size();
+    m_nbrPoints = reference.size();
+
+    /** Pearson correlation is not changed by shifting a profile: the sums are taken on values minus the mean of the whole profile,
+     *  so that subtracting them over a window does not cancel out the digits that matter.
+     *  NAN values are left out of the means and add 0 to the sums, they are counted instead so only the windows holding one are NAN **/
+    QVector< double > centeredReference = QVector< double >::fromList( reference );
+    double meanReference = GetMean( centeredReference.constData(), m_nbrPoints );
+
+    m_referenceSums.resize( 2 * ( m_nbrPoints + 1 ) );
+    m_referenceSums[ 0 ] = 0;
+    m_referenceSums[ 1 ] = 0;
+    m_referenceNANCounts.resize( m_nbrPoints + 1 );
+    m_referenceNANCounts[ 0 ] = 0;
+    for( int point = 0; point < m_nbrPoints; point++ )
+    {
+        bool isNAN = std::isnan( centeredReference.at( point ) );
+        centeredReference[ point ] = isNAN ? 0 : centeredReference.at( point ) - meanReference;
+        m_referenceSums[ 2 * point + 2 ] = m_referenceSums.at( 2 * point ) + centeredReference.at( point );
+        m_referenceSums[ 2 * point + 3 ] = m_referenceSums.at( 2 * point + 1 ) + centeredReference.at( point ) * centeredReference.at( point );
+        m_referenceNANCounts[ point + 1 ] = m_referenceNANCounts.at( point ) + ( isNAN ? 1 : 0 );
+    }
+
+    QVector< double > values( m_nbrPoints );
+    m_profileSums.resize( 3 * m_nbrProfiles * ( m_nbrPoints + 1 ) );
+    m_profileNANCounts.resize( m_nbrProfiles * ( m_nbrPoints + 1 ) );
+    double *sums = m_profileSums.data();
+    int *nanCounts = m_profileNANCounts.data();
+    foreach( const QList< double >& profile, profiles )
+    {
+        QList< double >::ConstIterator iterValue = profile.constBegin();
+        for( int point = 0; point < m_nbrPoints; point++ )
+        {
+            values[ point ] = *iterValue;
+            ++iterValue;
+        }
+        double meanProfile = GetMean( values.constData(), m_nbrPoints );
+
+        sums[ 0 ] = 0;
+        sums[ 1 ] = 0;
+        sums[ 2 ] = 0;
+        nanCounts[ 0 ] = 0;
+        for( int point = 0; point < m_nbrPoints; point++ )
+        {
+            bool isNAN = std::isnan( values.at( point ) );
+            double value = isNAN ? 0 : values.at( point ) - meanProfile;
+            sums[ 3 ] = sums[ 0 ] + value;
+            sums[ 4 ] = sums[ 1 ] + value * value;
+            sums[ 5 ] = sums[ 2 ] + value * centeredReference.at( point );
+            nanCounts[ 1 ] = nanCounts[ 0 ] + ( isNAN ? 1 : 0 );
+            sums += 3;
+            nanCounts++;
+        }
+        sums += 3;
+        nanCounts++;
+    }
+}
+
+void CroppedPearsonCorrelation::Clear()
+{
+    m_profileSums.clear();
+    m_referenceSums.clear();
+    m_profileNANCounts.clear();
+    m_referenceNANCounts.clear();
+    m_nbrProfiles = 0;
+    m_nbrPoints = 0;
+}
+
+int CroppedPearsonCorrelation::GetNbrProfiles() const
+{
+    return m_nbrProfiles;
+}
+
+int CroppedPearsonCorrelation::GetNbrPoints() const
+{
+    return m_nbrPoints;
+}
+
+
+QVector< double > CroppedPearsonCorrelation::Correlate( int first, int last ) const
+{
+    QVector< double > correlations( m_nbrProfiles, 1.0 );
+    if( !GetWindow( first, last ) )
+    {
+        return correlations;
+    }
+
+    int nbrPoints = last - first + 1;
+    const double *firstReferenceSums = m_referenceSums.constData() + 2 * first;
+    const double *lastReferenceSums = m_referenceSums.constData() + 2 * ( last + 1 );
+    double sumReference = lastReferenceSums[ 0 ] - firstReferenceSums[ 0 ];
+    double referenceSumSquares = ( lastReferenceSums[ 1 ] - firstReferenceSums[ 1 ] ) - sumReference * sumReference / nbrPoints;
+    int nbrReferenceNANs = m_referenceNANCounts.at( last + 1 ) - m_referenceNANCounts.at( first );
+
+    const double *firstSums = m_profileSums.constData() + 3 * first;
+    const double *lastSums = m_profileSums.constData() + 3 * ( last + 1 );
+    const int *firstNANCounts = m_profileNANCounts.constData() + first;
+    const int *lastNANCounts = m_profileNANCounts.constData() + last + 1;
+    int profileStride = 3 * ( m_nbrPoints + 1 );
+    for( int profile = 0; profile < m_nbrProfiles; profile++ )
+    {
+        double sum = lastSums[ 0 ] - firstSums[ 0 ];
+        double sumSquares = ( lastSums[ 1 ] - firstSums[ 1 ] ) - sum * sum / nbrPoints;
+        double sumProducts = ( lastSums[ 2 ] - firstSums[ 2 ] ) - sum * sumReference / nbrPoints;
+        bool isNAN = nbrReferenceNANs + *lastNANCounts - *firstNANCounts != 0;
+        correlations[ profile ] = isNAN ? std::numeric_limits< double >::quiet_NaN() : sumProducts / std::sqrt( referenceSumSquares * sumSquares );
+
+        firstSums += profileStride;
+        lastSums += profileStride;
+        firstNANCounts += m_nbrPoints + 1;
+        lastNANCounts += m_nbrPoints + 1;
+    }
+
+    return correlations;
+}
+
+double CroppedPearsonCorrelation::Correlate( int profile, int first, int last ) const
+{
+    if( !GetWindow( first, last ) )
+    {
+        return 1.0;
+    }
+
+    const int *nanCounts = m_profileNANCounts.constData() + profile * ( m_nbrPoints + 1 );
+    if( m_referenceNANCounts.at( last + 1 ) - m_referenceNANCounts.at( first ) + nanCounts[ last + 1 ] - nanCounts[ first ] != 0 )
+    {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+
+    int nbrPoints = last - first + 1;
+    const double *referenceSums = m_referenceSums.constData();
+    double sumReference = referenceSums[ 2 * ( last + 1 ) ] - referenceSums[ 2 * first ];
+    double referenceSumSquares = ( referenceSums[ 2 * ( last + 1 ) + 1 ] - referenceSums[ 2 * first + 1 ] ) - sumReference * sumReference / nbrPoints;
+
+    const double *sums = m_profileSums.constData() + 3 * profile * ( m_nbrPoints + 1 );
+    double sum = sums[ 3 * ( last + 1 ) ] - sums[ 3 * first ];
+    double sumSquares = ( sums[ 3 * ( last + 1 ) + 1 ] - sums[ 3 * first + 1 ] ) - sum * sum / nbrPoints;
+    double sumProducts = ( sums[ 3 * ( last + 1 ) + 2 ] - sums[ 3 * first + 2 ] ) - sum * sumReference / nbrPoints;
+
+    return sumProducts / std::sqrt( referenceSumSquares * sumSquares );
+}
+
+
+bool CroppedPearsonCorrelation::GetWindow( int& first, int& last ) const
+{
+    first = qMax( first, 0 );
+    last = qMin( last, m_nbrPoints - 1 );
+
+    return last - first + 1 >= 2;
+}
+
+double CroppedPearsonCorrelation::GetMean( const double *values, int nbrValues )
+{
+    double mean = 0;
+    int nbrNumbers = 0;
+    for( int i = 0; i < nbrValues; i++ )
+    {
+        if( !std::isnan( values[ i ] ) )
+        {
+            mean += values[ i ];
+            nbrNumbers++;
+        }
+    }
+
+    return nbrNumbers > 0 ? mean / nbrNumbers : 0;
+}
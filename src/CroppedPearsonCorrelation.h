@@ -0,0 +1,56 @@
+#ifndef CROPPEDPEARSONCORRELATION_H
+#define CROPPEDPEARSONCORRELATION_H
+
+#include <QVector>
+#include <QList>
+
+/** Pearson correlation of profiles with a reference profile over any window of arc lengths, as used by the QC threshold
+ *  once the profiles are cropped. The running sums of x, x², x·reference for each profile, and of the reference and its
+ *  squares, are computed once: the correlation over a window is then given by the sums at both ends of the window,
+ *  whatever its length, and moving the cropping sliders does not read the profiles again. **/
+class CroppedPearsonCorrelation
+{
+    friend class TestCroppedPearsonCorrelation; /** For unit tests **/
+
+public:
+    CroppedPearsonCorrelation();
+
+
+    /** Only the first reference.size() values of the profiles are correlated **/
+    void SetProfiles( const QList< double >& reference, const QList< QList< double > >& profiles ); // Tested
+
+    void Clear(); // Tested
+
+    int GetNbrProfiles() const; // Tested
+
+    int GetNbrPoints() const; // Tested
+
+
+    /** Correlations between the indexes first and last included, in the order of the profiles, 1.0 if the window has less than 2 points.
+     *  NAN if the profile or the reference has a NAN value in the window, the values out of the window do not matter **/
+    QVector< double > Correlate( int first, int last ) const; // Tested
+
+    double Correlate( int profile, int first, int last ) const; // Tested
+
+
+private:
+    /** Running sums of the profiles, one after the other: x, x², x·reference for the first 0, 1, ..., GetNbrPoints() points **/
+    QVector< double > m_profileSums;
+
+    /** Running sums of the reference: reference, reference² **/
+    QVector< double > m_referenceSums;
+
+    /** Running counts of the NAN values, laid out as the sums **/
+    QVector< int > m_profileNANCounts, m_referenceNANCounts;
+
+    int m_nbrProfiles, m_nbrPoints;
+
+
+    /** Window clamped to the points available, false if it has less than 2 points **/
+    bool GetWindow( int& first, int& last ) const; // Not Directly Tested
+
+    /** Mean of the values that are not NAN, 0 if there is none **/
+    static double GetMean( const double *values, int nbrValues ); // Not Directly Tested
+};
+
+#endif // CROPPEDPEARSONCORRELATION_H
@@ -12,7 +12,10 @@ void Data::InitData()
     foreach( int diffusionPropertyIndex, GetDiffusionPropertiesIndices() )
     {
         m_filenameMap[ diffusionPropertyIndex ];
-        m_fileDataMap[ diffusionPropertyIndex ];
+        if( diffusionPropertyIndex != SubMatrix )
+        {
+            m_profileDataMap[ diffusionPropertyIndex ] = DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix() );
+        }
         m_nbrRowsMap[ diffusionPropertyIndex ];
         m_nbrColumnsMap[ diffusionPropertyIndex ];
         m_subjectMap[ diffusionPropertyIndex ];
@@ -81,12 +84,28 @@ QString Data::GetFilename( int diffusionPropertyIndex ) const
     return m_filenameMap[ diffusionPropertyIndex ];
 }
 
-QList< QStringList > Data::GetFileData( int diffusionPropertyIndex ) const
+DiffusionProfileMatrix::ConstPointer Data::GetProfileData( int diffusionPropertyIndex ) const
 {
-    return m_fileDataMap[ diffusionPropertyIndex ];
+    DiffusionProfileMatrix::ConstPointer profileData = m_profileDataMap.value( diffusionPropertyIndex );
+    return profileData.isNull() ? DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix() ) : profileData;
 }
 
-QStringList Data::GetAtlas() const
+CSVData Data::GetSubMatrixData() const
+{
+    return m_subMatrixData;
+}
+
+bool Data::IsFileDataEmpty( int diffusionPropertyIndex ) const
+{
+    return diffusionPropertyIndex == SubMatrix ? m_subMatrixData.IsEmpty() : GetProfileData( diffusionPropertyIndex )->IsEmpty();
+}
+
+QString Data::GetFileDataPath( int diffusionPropertyIndex ) const
+{
+    return diffusionPropertyIndex == SubMatrix ? m_subMatrixData.GetFilePath() : GetProfileData( diffusionPropertyIndex )->GetFilePath();
+}
+
+QList< double > Data::GetAtlas() const
 {
     return m_atlas;
 }
@@ -135,12 +154,29 @@ QString& Data::SetFilename( int diffusionPropertyIndex )
     return m_filenameMap[ diffusionPropertyIndex ];
 }
 
-QList< QStringList >& Data::SetFileData( int diffusionPropertyIndex )
+DiffusionProfileMatrix::ConstPointer& Data::SetProfileData( int diffusionPropertyIndex )
+{
+    return m_profileDataMap[ diffusionPropertyIndex ];
+}
+
+CSVData& Data::SetSubMatrixData()
 {
-    return m_fileDataMap[ diffusionPropertyIndex ];
+    return m_subMatrixData;
 }
 
-QStringList& Data::SetAtlas()
+void Data::SetFileData( int diffusionPropertyIndex, const CSVData& fileData )
+{
+    if( diffusionPropertyIndex == SubMatrix )
+    {
+        m_subMatrixData = fileData;
+    }
+    else
+    {
+        m_profileDataMap[ diffusionPropertyIndex ] = DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( fileData ) );
+    }
+}
+
+QList< double >& Data::SetAtlas()
 {
     return m_atlas;
 }
@@ -186,7 +222,14 @@ QString& Data::SetOutputDir()
 void Data::ClearData( int diffusionPropertyIndex )
 {
     m_filenameMap[ diffusionPropertyIndex ].clear();
-    m_fileDataMap[ diffusionPropertyIndex ].clear();
+    if( diffusionPropertyIndex == SubMatrix )
+    {
+        m_subMatrixData.Clear();
+    }
+    else
+    {
+        m_profileDataMap[ diffusionPropertyIndex ] = DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix() );
+    }
     m_nbrRowsMap[ diffusionPropertyIndex ] = 0;
     m_nbrColumnsMap[ diffusionPropertyIndex ] = 0;
     m_subjectMap[ diffusionPropertyIndex ].clear();
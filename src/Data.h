@@ -1,6 +1,8 @@
 #ifndef DATA_H
 #define DATA_H
 
+#include "DiffusionProfileMatrix.h"
+
 #include <QMap>
 
 class Data
@@ -33,9 +35,15 @@ public:
 
     QString GetFilename( int diffusionPropertyIndex ) const; // Tested
 
-    QList< QStringList > GetFileData( int diffusionPropertyIndex ) const; // Tested
+    DiffusionProfileMatrix::ConstPointer GetProfileData( int diffusionPropertyIndex ) const; // Tested
+
+    CSVData GetSubMatrixData() const; // Tested
+
+    bool IsFileDataEmpty( int diffusionPropertyIndex ) const; // Tested
+
+    QString GetFileDataPath( int diffusionPropertyIndex ) const; // Tested
 
-    QStringList GetAtlas() const; // Tested
+    QList< double > GetAtlas() const; // Tested
 
     int GetNbrRows( int diffusionPropertyIndex ) const; // Tested
 
@@ -57,9 +65,14 @@ public:
     /*************** Setters ***************/
     QString& SetFilename( int diffusionPropertyIndex ); // Tested
 
-    QList< QStringList >& SetFileData( int diffusionPropertyIndex ); // Tested
+    DiffusionProfileMatrix::ConstPointer& SetProfileData( int diffusionPropertyIndex ); // Tested
 
-    QStringList& SetAtlas(); // Tested
+    CSVData& SetSubMatrixData(); // Tested
+
+    /** Stores the SubMatrix as it is, AD, RD, MD and FA files as profile matrices **/
+    void SetFileData( int diffusionPropertyIndex, const CSVData& fileData ); // Tested
+
+    QList< double >& SetAtlas(); // Tested
 
     int& SetNbrRows( int diffusionPropertyIndex ); // Tested
 
@@ -91,7 +104,9 @@ public:
 private:
     enum diffusionProperties { AD, RD, MD, FA, SubMatrix };
 
-    QMap< int, QList< QStringList > > m_fileDataMap;
+    QMap< int, DiffusionProfileMatrix::ConstPointer > m_profileDataMap;
+
+    CSVData m_subMatrixData;
 
     QMap< int, QStringList > m_subjectMap;
 
@@ -99,7 +114,7 @@ private:
 
     QMap< int, int > m_nbrRowsMap, m_nbrColumnsMap, m_nbrSubjectsMap;
 
-    QStringList m_atlas;
+    QList< double > m_atlas;
 
     QString m_outputDir;
 
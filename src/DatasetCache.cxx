@@ -0,0 +1,217 @@
+#include "DatasetCache.h"
+#include "CSVReader.h"
+
+#include <QLocale>
+#include <QMutexLocker>
+
+//#include <QDebug>
+
+
+const QString DatasetCache::m_csvSeparator = QLocale().groupSeparator();
+
+DatasetCache::DatasetCache()
+{
+    m_nbrHits = 0;
+    m_nbrMisses = 0;
+    m_nbrSidecarLoads = 0;
+    m_nbrThreads = 0;
+    m_minSidecarFileSize = 1024 * 1024;
+}
+
+
+DatasetCache& DatasetCache::GetInstance()
+{
+    static DatasetCache datasetCache;
+    return datasetCache;
+}
+
+
+CSVData DatasetCache::GetData( const QString& filePath )
+{
+    QFileInfo fileInfo( filePath );
+    if( !fileInfo.isFile() )
+    {
+        return CSVData();
+    }
+
+    /** Size and last modification time of the file before it is parsed **/
+    qint64 size;
+    QDateTime lastModified;
+    {
+        QMutexLocker locker( &m_mutex );
+        Entry& entry = GetEntry( fileInfo );
+        if( entry.isDataLoaded )
+        {
+            m_nbrHits++;
+            return entry.data;
+        }
+        m_nbrMisses++;
+        size = entry.size;
+        lastModified = entry.lastModified;
+    }
+
+    /** Parsing is done without holding the lock so different files can be read at the same time **/
+    CSVData data = LoadData( filePath, size );
+
+    /** A file modified while it was parsed does not match the data parsed: the data is not cached **/
+    QMutexLocker locker( &m_mutex );
+    Entry& entry = GetEntry( fileInfo );
+    if( entry.size != size || entry.lastModified != lastModified )
+    {
+        return data;
+    }
+    if( !entry.isDataLoaded )
+    {
+        entry.data = data;
+        entry.isDataLoaded = true;
+    }
+
+    return entry.data;
+}
+
+DiffusionProfileMatrix::ConstPointer DatasetCache::GetProfileData( const QString& filePath )
+{
+    QFileInfo fileInfo( filePath );
+    if( !fileInfo.isFile() )
+    {
+        return DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix() );
+    }
+
+    {
+        QMutexLocker locker( &m_mutex );
+        DiffusionProfileMatrix::ConstPointer profileData = GetEntry( fileInfo ).profileData.toStrongRef();
+        if( !profileData.isNull() )
+        {
+            m_nbrHits++;
+            return profileData;
+        }
+    }
+
+    DiffusionProfileMatrix::ConstPointer profileData( new DiffusionProfileMatrix( GetData( filePath ) ) );
+
+    QMutexLocker locker( &m_mutex );
+    Entry& entry = GetEntry( fileInfo );
+    DiffusionProfileMatrix::ConstPointer sharedProfileData = entry.profileData.toStrongRef();
+    if( sharedProfileData.isNull() )
+    {
+        entry.profileData = profileData;
+        return profileData;
+    }
+
+    return sharedProfileData;
+}
+
+QList< QStringList > DatasetCache::GetTextData( const QString& filePath )
+{
+    /** Not kept: the text is read from the file each time, so the cache holds no second copy of it **/
+    return CSVReader( m_csvSeparator ).ReadText( filePath );
+}
+
+void DatasetCache::Remove( const QString& filePath )
+{
+    /** A file already deleted has no canonical path anymore **/
+    QFileInfo fileInfo( filePath );
+    QString canonicalFilePath = fileInfo.canonicalFilePath();
+    QMutexLocker locker( &m_mutex );
+    m_entries.remove( canonicalFilePath.isEmpty() ? fileInfo.absoluteFilePath() : canonicalFilePath );
+}
+
+
+void DatasetCache::SetNbrThreads( int nbrThreads )
+{
+    QMutexLocker locker( &m_mutex );
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+int DatasetCache::GetNbrThreads() const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_nbrThreads;
+}
+
+
+int DatasetCache::GetNbrHits() const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_nbrHits;
+}
+
+int DatasetCache::GetNbrMisses() const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_nbrMisses;
+}
+
+int DatasetCache::GetNbrSidecarLoads() const
+{
+    QMutexLocker locker( &m_mutex );
+    return m_nbrSidecarLoads;
+}
+
+void DatasetCache::Clear()
+{
+    QMutexLocker locker( &m_mutex );
+    m_entries.clear();
+    m_nbrHits = 0;
+    m_nbrMisses = 0;
+    m_nbrSidecarLoads = 0;
+}
+
+
+DatasetCache::Entry& DatasetCache::GetEntry( const QFileInfo& fileInfo )
+{
+    /** Fresh information: QFileInfo caches the file attributes **/
+    QFileInfo currentFileInfo( fileInfo.absoluteFilePath() );
+    qint64 size = currentFileInfo.size();
+    QDateTime lastModified = currentFileInfo.lastModified();
+
+    /** Same entry whatever the path used to reach the file **/
+    Entry& entry = m_entries[ currentFileInfo.canonicalFilePath() ];
+    if( entry.size != size || entry.lastModified != lastModified )
+    {
+        entry.size = size;
+        entry.lastModified = lastModified;
+        entry.isDataLoaded = false;
+        entry.data.Clear();
+        entry.profileData.clear();
+    }
+
+    return entry;
+}
+
+CSVData DatasetCache::LoadData( const QString& filePath, qint64 fileSize )
+{
+    qint64 minSidecarFileSize;
+    int nbrThreads;
+    {
+        QMutexLocker locker( &m_mutex );
+        minSidecarFileSize = m_minSidecarFileSize;
+        nbrThreads = m_nbrThreads;
+    }
+
+    CSVData data;
+    CSVSidecar csvSidecar;
+    bool isSidecarUsed = fileSize >= minSidecarFileSize;
+    if( isSidecarUsed && csvSidecar.Read( filePath, data ) )
+    {
+        QMutexLocker locker( &m_mutex );
+        m_nbrSidecarLoads++;
+        return data;
+    }
+
+    /** Source taken before the parse: if the file changes meanwhile, the sidecar does not match the new file **/
+    CSVSidecar::Source source;
+    isSidecarUsed = isSidecarUsed && csvSidecar.GetSource( filePath, source );
+
+    CSVReader csvReader( m_csvSeparator );
+    csvReader.SetNbrThreads( nbrThreads );
+    data = csvReader.Read( filePath );
+
+    /** No sidecar if the directory is not writable: the file is parsed every time, as before **/
+    if( isSidecarUsed && !data.IsEmpty() )
+    {
+        csvSidecar.Write( filePath, data, source );
+    }
+
+    return data;
+}
@@ -0,0 +1,89 @@
+#ifndef DATASETCACHE_H
+#define DATASETCACHE_H
+
+#include "DiffusionProfileMatrix.h"
+#include "CSVSidecar.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QWeakPointer>
+#include <QDateTime>
+#include <QFileInfo>
+
+/** Process-wide cache of the input files: each file is parsed once and the parsed form is shared.
+ *  Only the parsed file (CSVData: values, validation report and positions of the rows) is kept. The profile matrix is derived
+ *  on demand: it is shared while in use, but the cache does not keep it alive. The text rows are read from the file on demand.
+ *  An entry is dropped as soon as the size or the last modification time of its file changes, or when its file is removed.
+ *  Big files also get a binary sidecar (see CSVSidecar), loaded instead of the text by later sessions. **/
+class DatasetCache
+{
+    friend class TestDatasetCache; /** For unit tests **/
+
+public:
+    static DatasetCache& GetInstance(); // Tested
+
+
+    CSVData GetData( const QString& filePath ); // Tested
+
+    DiffusionProfileMatrix::ConstPointer GetProfileData( const QString& filePath ); // Tested
+
+    /** Cells of the file as written, see CSVReader::ReadText() **/
+    QList< QStringList > GetTextData( const QString& filePath ); // Tested
+
+    /** Drops the entry of a file no longer used, e.g. an input replaced by another file **/
+    void Remove( const QString& filePath ); // Tested
+
+
+    /** Number of threads used to parse a file, see CSVReader::SetNbrThreads() **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+    int GetNbrThreads() const; // Tested
+
+
+    int GetNbrHits() const; // Tested
+
+    int GetNbrMisses() const; // Tested
+
+    /** Misses served by a binary sidecar instead of parsing the file **/
+    int GetNbrSidecarLoads() const; // Tested
+
+    void Clear(); // Tested
+
+
+private:
+    struct Entry
+    {
+        Entry() : size( -1 ), isDataLoaded( false ) {}
+
+        qint64 size;
+        QDateTime lastModified;
+
+        bool isDataLoaded;
+        CSVData data;
+        QWeakPointer< const DiffusionProfileMatrix > profileData;
+    };
+
+    static const QString m_csvSeparator;
+
+    mutable QMutex m_mutex;
+
+    QHash< QString, Entry > m_entries;
+
+    int m_nbrHits, m_nbrMisses, m_nbrSidecarLoads;
+
+    /** Small files are parsed faster than a sidecar is checked **/
+    qint64 m_minSidecarFileSize;
+
+    int m_nbrThreads;
+
+
+    explicit DatasetCache();
+
+    /** Returns the entry of the file, reset if the file changed since it was cached **/
+    Entry& GetEntry( const QFileInfo& fileInfo ); // Not Directly Tested
+
+    /** Loads the sidecar of the file if up to date, otherwise parses the file and writes its sidecar **/
+    CSVData LoadData( const QString& filePath, qint64 fileSize ); // Not Directly Tested
+};
+
+#endif // DATASETCACHE_H
@@ -0,0 +1,165 @@
+#include "DiffusionProfileMatrix.h"
+#include "SubjectRegistry.h"
+
+#include <limits>
+
+//#include <QDebug>
+
+
+DiffusionProfileMatrix::DiffusionProfileMatrix()
+{
+    m_nbrArcLengths = 0;
+    m_isMatrixDimensionOK = false;
+}
+
+DiffusionProfileMatrix::DiffusionProfileMatrix( const CSVData& profileData )
+{
+    m_filePath = profileData.GetFilePath();
+    m_isMatrixDimensionOK = profileData.IsMatrixDimensionOK();
+    m_nbrArcLengths = qMax( profileData.GetNbrRows() - 1, 0 );
+
+    QStringList header = profileData.GetHeader();
+    if( !header.isEmpty() )
+    {
+        m_arcLengthName = header.first();
+        SubjectRegistry& registry = SubjectRegistry::GetInstance();
+        m_subjectIDs = registry.GetIDs( header.mid( 1 ) );
+        m_subjects = registry.GetNames( m_subjectIDs );
+    }
+    m_arcLengthLabels = profileData.GetColumnText( 0 );
+
+    QBitArray nanColumns = profileData.GetNANColumns();
+    m_nanSubjects = QBitArray( m_subjects.size() );
+    for( int subjectIndex = 0; subjectIndex < m_subjects.size(); subjectIndex++ )
+    {
+        m_nanSubjects.setBit( subjectIndex, subjectIndex + 1 < nanColumns.size() && nanColumns.testBit( subjectIndex + 1 ) );
+    }
+
+    /** Names pooled by SubjectRegistry, shared by the list and the index **/
+    m_subjectIndices.reserve( m_subjects.size() );
+    for( int i = 0; i < m_subjects.size(); i++ )
+    {
+        m_subjectIndices.insert( m_subjects.at( i ), i );
+    }
+
+    /** The file is stored row by row, profiles are stored subject by subject **/
+    m_arcLength.resize( m_nbrArcLengths );
+    m_values.resize( m_nbrArcLengths * m_subjects.size() );
+    for( int arcLengthIndex = 0; arcLengthIndex < m_nbrArcLengths; arcLengthIndex++ )
+    {
+        m_arcLength[ arcLengthIndex ] = profileData.GetValue( arcLengthIndex + 1, 0 );
+        for( int subjectIndex = 0; subjectIndex < m_subjects.size(); subjectIndex++ )
+        {
+            m_values[ subjectIndex * m_nbrArcLengths + arcLengthIndex ] = profileData.GetValue( arcLengthIndex + 1, subjectIndex + 1 );
+        }
+    }
+}
+
+
+bool DiffusionProfileMatrix::IsEmpty() const
+{
+    return m_arcLengthName.isEmpty() && m_subjects.isEmpty();
+}
+
+QString DiffusionProfileMatrix::GetFilePath() const
+{
+    return m_filePath;
+}
+
+bool DiffusionProfileMatrix::IsMatrixDimensionOK() const
+{
+    return m_isMatrixDimensionOK;
+}
+
+int DiffusionProfileMatrix::GetNbrRows() const
+{
+    return IsEmpty() ? 0 : m_nbrArcLengths + 1;
+}
+
+int DiffusionProfileMatrix::GetNbrColumns() const
+{
+    return IsEmpty() ? 0 : m_subjects.size() + 1;
+}
+
+
+QString DiffusionProfileMatrix::GetArcLengthName() const
+{
+    return m_arcLengthName;
+}
+
+QStringList DiffusionProfileMatrix::GetArcLengthLabels() const
+{
+    return m_arcLengthLabels;
+}
+
+DiffusionProfileMatrix::View DiffusionProfileMatrix::GetArcLength() const
+{
+    return View( m_arcLength.constData(), m_nbrArcLengths, 1 );
+}
+
+int DiffusionProfileMatrix::GetNbrArcLengths() const
+{
+    return m_nbrArcLengths;
+}
+
+
+QStringList DiffusionProfileMatrix::GetSubjects() const
+{
+    return m_subjects;
+}
+
+QVector< int > DiffusionProfileMatrix::GetSubjectIDs() const
+{
+    return m_subjectIDs;
+}
+
+int DiffusionProfileMatrix::GetNbrSubjects() const
+{
+    return m_subjects.size();
+}
+
+int DiffusionProfileMatrix::GetSubjectIndex( const QString& subject ) const
+{
+    return m_subjectIndices.value( subject, -1 );
+}
+
+bool DiffusionProfileMatrix::HasAtlas() const
+{
+    return !m_subjects.isEmpty() && m_subjects.last().contains( "atlas", Qt::CaseInsensitive );
+}
+
+DiffusionProfileMatrix::View DiffusionProfileMatrix::GetAtlas() const
+{
+    return HasAtlas() ? GetSubjectProfile( m_subjects.size() - 1 ) : View();
+}
+
+bool DiffusionProfileMatrix::HasNAN( int subjectIndex ) const
+{
+    return subjectIndex >= 0 && subjectIndex < m_nanSubjects.size() && m_nanSubjects.testBit( subjectIndex );
+}
+
+
+double DiffusionProfileMatrix::GetValue( int arcLengthIndex, int subjectIndex ) const
+{
+    if( arcLengthIndex < 0 || arcLengthIndex >= m_nbrArcLengths || subjectIndex < 0 || subjectIndex >= m_subjects.size() )
+    {
+        return std::numeric_limits< double >::quiet_NaN();
+    }
+
+    return m_values.at( subjectIndex * m_nbrArcLengths + arcLengthIndex );
+}
+
+MatrixView DiffusionProfileMatrix::GetProfiles() const
+{
+    return MatrixView::ColumnMajor( m_values.constData(), m_nbrArcLengths, m_subjects.size() );
+}
+
+DiffusionProfileMatrix::View DiffusionProfileMatrix::GetSubjectProfile( int subjectIndex ) const
+{
+    return GetProfiles().GetColumn( subjectIndex );
+}
+
+DiffusionProfileMatrix::View DiffusionProfileMatrix::GetArcLengthValues( int arcLengthIndex ) const
+{
+    return GetProfiles().GetRow( arcLengthIndex );
+}
@@ -0,0 +1,98 @@
+#ifndef DIFFUSIONPROFILEMATRIX_H
+#define DIFFUSIONPROFILEMATRIX_H
+
+#include "CSVData.h"
+#include "MatrixView.h"
+
+#include <QHash>
+#include <QSharedPointer>
+
+class DiffusionProfileMatrix
+{
+public:
+    /** Once loaded, a profile matrix is never modified: Data, Processing, Plot and QCThresholdDialog
+     *  all share the same instance through this handle **/
+    typedef QSharedPointer< const DiffusionProfileMatrix > ConstPointer;
+
+    /** Read-only access to a row or a column of the matrix, without copy **/
+    typedef VectorView View;
+
+
+    explicit DiffusionProfileMatrix();
+
+    /** profileData: AD, RD, MD or FA file, 1st column: arc length, 1st row: subjects **/
+    explicit DiffusionProfileMatrix( const CSVData& profileData );
+
+
+    bool IsEmpty() const; // Tested
+
+    QString GetFilePath() const; // Tested
+
+    bool IsMatrixDimensionOK() const; // Tested
+
+    /** Number of rows and columns as found in the file, header included **/
+    int GetNbrRows() const; // Tested
+
+    int GetNbrColumns() const; // Tested
+
+
+    QString GetArcLengthName() const; // Tested
+
+    QStringList GetArcLengthLabels() const; // Tested
+
+    View GetArcLength() const; // Tested
+
+    int GetNbrArcLengths() const; // Tested
+
+
+    /** Every column name but the arc length, atlas included if present **/
+    QStringList GetSubjects() const; // Tested
+
+    /** SubjectRegistry IDs of the subjects, in the same order **/
+    QVector< int > GetSubjectIDs() const; // Tested
+
+    int GetNbrSubjects() const; // Tested
+
+    int GetSubjectIndex( const QString& subject ) const; // Tested
+
+    bool HasAtlas() const; // Tested
+
+    View GetAtlas() const; // Tested
+
+    /** True if the profile of the subject has at least one nan or missing value **/
+    bool HasNAN( int subjectIndex ) const; // Tested
+
+
+    double GetValue( int arcLengthIndex, int subjectIndex ) const; // Tested
+
+    /** Arc lengths in rows and subjects in columns, as in the file. Transposed(): one profile per row **/
+    MatrixView GetProfiles() const; // Tested
+
+    View GetSubjectProfile( int subjectIndex ) const; // Tested
+
+    View GetArcLengthValues( int arcLengthIndex ) const; // Tested
+
+
+private:
+    QString m_filePath, m_arcLengthName;
+
+    QStringList m_arcLengthLabels, m_subjects;
+
+    QVector< int > m_subjectIDs;
+
+    QHash< QString, int > m_subjectIndices;
+
+    QVector< double > m_arcLength;
+
+    /** One profile after the other: m_nbrArcLengths contiguous values per subject **/
+    QVector< double > m_values;
+
+    /** Bit i set if the profile of subject i has a nan, from the validation report of the file **/
+    QBitArray m_nanSubjects;
+
+    int m_nbrArcLengths;
+
+    bool m_isMatrixDimensionOK;
+};
+
+#endif // DIFFUSIONPROFILEMATRIX_H
@@ -274,7 +274,8 @@ void EditInputDialog::UpdateNAN()
 
 void EditInputDialog::LoadData()
 {
-    QList< QStringList > fileData = m_data->GetFileData( m_diffusionPropertyIndex );
+    /** Data is edited as text: cells are reloaded from the file they were parsed from **/
+    QList< QStringList > fileData = m_processing.GetDataFromFile( m_data->GetFileDataPath( m_diffusionPropertyIndex ) );
     int nbrRows = 0;
     int nbrColumns = 0;
 
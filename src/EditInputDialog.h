@@ -72,6 +72,8 @@ private:
 
     Data *m_data;
 
+    Processing m_processing;
+
     QStringList firstOccurrences;
 
     QList< int > indexSecondeOccurrences;
@@ -1,4 +1,7 @@
 #include "FADTTSWindow.h"
+#include "DatasetCache.h"
+#include "CompressedFile.h"
+#include "SubjectRegistry.h"
 
 //#include <QDebug>
 
@@ -58,6 +61,8 @@ void FADTTSWindow::LoadParaConfiguration( QString filename )
         {
             m_inputTabInputFileLineEditMap.value( i )->setText( inputFiles.value( m_data.GetDiffusionPropertyName( i ) ).toString() );
         }
+        /** Covariates and subjects below need the files parsed **/
+        WaitForInputFiles();
         OnUpdatingSubjectColumnID( inputFiles.value( "subjectColumnID" ).toInt( 0 ) );
 
         QJsonObject covariates = inputTab.value( "covariates" ).toObject();
@@ -79,8 +84,7 @@ void FADTTSWindow::LoadParaConfiguration( QString filename )
         para_subjectTab_endArcLength_value_label->clear();
         if( para_subjectTab_faFile_checkBox->isEnabled() )
         {
-            QStringList arcLength = m_processing.Transpose( m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() ) ).first();
-            arcLength.removeFirst();
+            QStringList arcLength = m_data.GetProfileData( m_data.GetFractionalAnisotropyIndex() )->GetArcLengthLabels();
 
             if( !arcLength.isEmpty() )
             {
@@ -151,6 +155,8 @@ void FADTTSWindow::LoadSoftConfiguration( QString filename )
 
         soft_executionTab_runMatlab_checkBox->setChecked( matlabSpecifications.value( "runMatlab" ).toBool() );
         soft_executionTab_matlabExe_lineEdit->setText( matlabSpecifications.value( "matlabExe" ).toString() );
+
+        soft_executionTab_nbrParsingThreads_spinBox->setValue( executionTab.value( "nbrParsingThreads" ).toInt() );
     }
     else
     {
@@ -345,6 +351,7 @@ void FADTTSWindow::SaveSoftConfiguration( QString filename )
     matlabSpecifications.insert( "runMatlab", soft_executionTab_runMatlab_checkBox->isChecked() );
     matlabSpecifications.insert( "matlabExe", soft_executionTab_matlabExe_lineEdit->text() );
     executionTab.insert( "matlabSpecifications", matlabSpecifications );
+    executionTab.insert( "nbrParsingThreads", soft_executionTab_nbrParsingThreads_spinBox->value() );
 
     jsonObject_soft.insert( "executionTab", executionTab );
     jsonObject.insert( "softConfiguration", jsonObject_soft );
@@ -408,6 +415,20 @@ void FADTTSWindow::SaveNoGUIConfiguration( QString filename )
     qcThreshold.insert( "apply", !m_failedQCThresholdSubjects.isEmpty() );
     qcThreshold.insert( "useAtlas", para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() );
     qcThreshold.insert( "value", para_subjectTab_qcThreshold_doubleSpinBox->value() );
+    qcThreshold.insert( "fpcaValue", m_fpcaQCThresholds.value( "FA", QCThreshold::GetDefaultFPCAQCThreshold() ) );
+    qcThreshold.insert( "rule", QCThreshold::GetRuleName( m_qcThresholdRule ) );
+    qcThreshold.insert( "reference", QCThresholdReference::GetTypeName( m_qcThresholdReference ) );
+    qcThreshold.insert( "metric", QCThreshold::GetMetricName( m_qcThresholdMetric ) );
+    QJsonObject qcThresholdProperties;
+    foreach( QString property, m_qcThresholds.keys() )
+    {
+        QJsonObject qcThresholdProperty;
+        qcThresholdProperty.insert( "value", property == "FA" ? para_subjectTab_qcThreshold_doubleSpinBox->value() : m_qcThresholds.value( property ) );
+        qcThresholdProperty.insert( "fpcaValue", m_fpcaQCThresholds.value( property, QCThreshold::GetDefaultFPCAQCThreshold() ) );
+        qcThresholdProperty.insert( "useAtlas", para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() );
+        qcThresholdProperties.insert( property, qcThresholdProperty );
+    }
+    qcThreshold.insert( "properties", qcThresholdProperties );
     subjects.insert( "qcThreshold", qcThreshold );
 
     /******   Profile   ******/
@@ -421,6 +442,7 @@ void FADTTSWindow::SaveNoGUIConfiguration( QString filename )
     settings.insert( "pvalueThreshold", para_executionTab_pvalueThreshold_doubleSpinBox->value() );
     settings.insert( "omnibus", para_executionTab_omnibus_checkBox->isChecked() );
     settings.insert( "posthoc", para_executionTab_postHoc_checkBox->isChecked() );
+    settings.insert( "nbrParsingThreads", soft_executionTab_nbrParsingThreads_spinBox->value() );
 
     /******  Output Dir  ******/
     jsonObject_noGUI.insert( "outputDir", para_executionTab_outputDir_lineEdit->text() );
@@ -510,6 +532,31 @@ void FADTTSWindow::InitInputTab()
     m_inputTabIconLabelMap.insert( m_data.GetFractionalAnisotropyIndex(), inputTab_iconFAFile_label );
     m_inputTabIconLabelMap.insert( m_data.GetSubMatrixIndex(), inputTab_iconSubMatrixFile_label );
 
+    /** Map of FutureWatchers parsing each file in a worker thread and
+     *  SignalMapper to link them to the slot OnInputFileLoaded().
+     *  A busy bar is shown in place of the icon while the file is parsed. **/
+    QSignalMapper *signalMapperInputFileLoaded = new QSignalMapper( this );
+    connect( signalMapperInputFileLoaded, SIGNAL( mapped( int ) ), this, SLOT( OnInputFileLoaded( int ) ) );
+    foreach( int diffusionPropertyIndex, m_data.GetDiffusionPropertiesIndices() )
+    {
+        QFutureWatcher< LoadedInputFile > *inputFileLoader = new QFutureWatcher< LoadedInputFile >( this );
+        connect( inputFileLoader, SIGNAL( finished() ), signalMapperInputFileLoaded, SLOT( map() ) );
+        signalMapperInputFileLoaded->setMapping( inputFileLoader, diffusionPropertyIndex );
+        m_inputFileLoaderMap.insert( diffusionPropertyIndex, inputFileLoader );
+
+        QProgressBar *loadingProgressBar = new QProgressBar( this );
+        loadingProgressBar->setMinimum( 0 );
+        loadingProgressBar->setMaximum( 0 );
+        loadingProgressBar->setTextVisible( false );
+        loadingProgressBar->setFixedSize( 3 * m_iconSize, m_iconSize );
+        loadingProgressBar->hide();
+        int row, column, rowSpan, columnSpan;
+        inputTab_inputFiles_gridLayout->getItemPosition( inputTab_inputFiles_gridLayout->indexOf( m_inputTabIconLabelMap.value( diffusionPropertyIndex ) ),
+                                                         &row, &column, &rowSpan, &columnSpan );
+        inputTab_inputFiles_gridLayout->addWidget( loadingProgressBar, row, column );
+        m_inputTabLoadingProgressBarMap.insert( diffusionPropertyIndex, loadingProgressBar );
+    }
+
     m_editInputDialog = QSharedPointer< EditInputDialog >( new EditInputDialog( this ) );
     m_editInputDialog->SetData( &m_data );
     connect( m_editInputDialog.data(), SIGNAL( UpdateInputFile( const int&, const QString& ) ), this, SLOT( OnUpdatingInputFile( const int&, const QString& ) ) );
@@ -578,14 +625,22 @@ void FADTTSWindow::InitSubjectsTab()
     /*** Subjects Lists ***/
     m_areSubjectsLoaded = false;
 
-    m_matchedSubjectListWidget = new QListWidget();
-    m_matchedSubjectListWidget = subjectTab_matchedSubjectsInformation_listWidget;
-    connect( m_matchedSubjectListWidget, SIGNAL( itemClicked( QListWidgetItem * ) ), this, SLOT( OnSubjectClicked( QListWidgetItem * ) ) );
+    m_matchedSubjectModel = new SubjectListModel( true, this );
+    m_matchedSubjectModel->SetColors( m_green, m_grey );
+    m_matchedSubjectProxyModel = new SubjectFilterProxyModel( this );
+    m_matchedSubjectProxyModel->setSourceModel( m_matchedSubjectModel );
+    m_matchedSubjectListView = subjectTab_matchedSubjectsInformation_listView;
+    m_matchedSubjectListView->setModel( m_matchedSubjectProxyModel );
+    connect( m_matchedSubjectListView, SIGNAL( clicked( const QModelIndex& ) ), this, SLOT( OnSubjectClicked( const QModelIndex& ) ) );
     connect( subjectTab_checkAllVisible_pushButton, SIGNAL( clicked() ), this, SLOT( OnCheckAllVisibleSubjects() ) );
     connect( subjectTab_unCheckAllVisible_pushButton, SIGNAL( clicked() ), this, SLOT( OnUnCheckAllVisibleSubjects() ) );
 
-    m_unmatchedSubjectListWidget = new QListWidget();
-    m_unmatchedSubjectListWidget = subjectTab_unmatchedSubjectsInformation_listWidget;
+    m_unmatchedSubjectModel = new SubjectListModel( false, this );
+    m_unmatchedSubjectModel->SetColors( m_red, m_red, m_lightBlack );
+    m_unmatchedSubjectProxyModel = new SubjectFilterProxyModel( this );
+    m_unmatchedSubjectProxyModel->setSourceModel( m_unmatchedSubjectModel );
+    m_unmatchedSubjectListView = subjectTab_unmatchedSubjectsInformation_listView;
+    m_unmatchedSubjectListView->setModel( m_unmatchedSubjectProxyModel );
 
     /*** Search Subjects ***/
     m_caseSensitivity = Qt::CaseInsensitive;
@@ -595,7 +650,11 @@ void FADTTSWindow::InitSubjectsTab()
     /*** QC Threshold ***/
     m_qcThresholdDialog = QSharedPointer< QCThresholdDialog >( new QCThresholdDialog( this ) );
     connect( subjectTab_applyQCThreshold_pushButton, SIGNAL( clicked() ), this, SLOT( OnApplyQCThreshold() ) );
-    connect( m_qcThresholdDialog.data(), SIGNAL( ApplyQCThreshold( const QStringList&, const QStringList&, double, bool ) ), this, SLOT( OnQCThresholdApplied( const QStringList&, const QStringList&, double, bool ) ) );
+    connect( m_qcThresholdDialog.data(), SIGNAL( ApplyQCThreshold( const QStringList&, const QStringList&, const QMap< QString, double >&, const QMap< QString, double >&, const QString&, const QString&, const QString&, bool ) ),
+             this, SLOT( OnQCThresholdApplied( const QStringList&, const QStringList&, const QMap< QString, double >&, const QMap< QString, double >&, const QString&, const QString&, const QString&, bool ) ) );
+    m_qcThresholdRule = QCThreshold::AnyFail;
+    m_qcThresholdReference = QCThresholdReference::Mean;
+    m_qcThresholdMetric = QCThreshold::Correlation;
     connect( m_qcThresholdDialog.data(), SIGNAL( NanSujects( const QStringList& ) ), this, SLOT( OnNanSujects( const QStringList& ) ) );
 
     connect( m_qcThresholdDialog.data(), SIGNAL( UpdateStartArcLength( const QString& ) ), this, SLOT( OnUpdatingStartArcLength( const QString& ) ) );
@@ -627,6 +686,8 @@ void FADTTSWindow::InitExecutionTab()
     connect( executionTab_matlabExe_pushButton, SIGNAL( clicked() ), this, SLOT( OnBrowsingMatlabExe() ) );
     connect( soft_executionTab_matlabExe_lineEdit, SIGNAL( textChanged( const QString& ) ), this, SLOT( OnSettingMatlabExe( const QString& ) ) );
 
+    connect( soft_executionTab_nbrParsingThreads_spinBox, SIGNAL( valueChanged( int ) ), this, SLOT( OnSettingNbrParsingThreads( int ) ) );
+
     /*** Run ***/
     m_progressBar = new QProgressBar();
     m_progressBar = executionTab_progressBar;
@@ -819,6 +880,21 @@ void FADTTSWindow::DisplayIcon( QLabel *label , const QPixmap& icon )
 /***********************  Private slots  ***********************/
 void FADTTSWindow::OnSettingInputFile( int diffusionPropertyIndex )
 {
+    /** The file replaced is dropped from the cache, unless another input still uses it **/
+    QString previousFilePath = m_data.GetFileDataPath( diffusionPropertyIndex );
+    if( !previousFilePath.isEmpty() && previousFilePath != m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ]->text() )
+    {
+        bool isFileUsed = false;
+        foreach( int index, m_data.GetDiffusionPropertiesIndices() )
+        {
+            isFileUsed = isFileUsed || ( index != diffusionPropertyIndex && m_data.GetFileDataPath( index ) == previousFilePath );
+        }
+        if( !isFileUsed )
+        {
+            DatasetCache::GetInstance().Remove( previousFilePath );
+        }
+    }
+
     m_data.ClearData( diffusionPropertyIndex );
     if( diffusionPropertyIndex == m_data.GetFractionalAnisotropyIndex() )
     {
@@ -830,6 +906,10 @@ void FADTTSWindow::OnSettingInputFile( int diffusionPropertyIndex )
         executionTab_croppedProfileWarningInfo_label->hide();
     }
 
+    /** The file previously set may still be parsed: its result is ignored **/
+    m_loadingInputFiles.remove( diffusionPropertyIndex );
+    DisplayInputFileLoading( diffusionPropertyIndex, false );
+
     QLineEdit *lineEdit = m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ];
     QString filePath = lineEdit->text();
     QFile file( filePath );
@@ -844,59 +924,90 @@ void FADTTSWindow::OnSettingInputFile( int diffusionPropertyIndex )
         {
             DisplayInputLineEditIcon( diffusionPropertyIndex, m_koPixmap );
         }
+        else if( !CompressedFile::IsFormatSupported( CompressedFile::GetFormat( filePath ) ) )
+        {
+            file.close();
+            DisplayInputLineEditIcon( diffusionPropertyIndex, m_koPixmap );
+
+            QString criticalMessage = m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper()
+                    + " data file not supported:<br><i>" + filePath
+                    + "</i><br>FADTTSter was built without zstd: zstd compressed files cannot be read.<br>"
+                    + "Decompress the file, or build FADTTSter with USE_ZSTD.";
+            CriticalPopUp( criticalMessage );
+        }
         else
         {
             file.close();
-            QList< QStringList > fileData = m_processing.GetDataFromFile( filePath );
-            if( m_processing.IsMatrixDimensionOK( fileData ) )
-            {
-                if( !m_processing.AreDuplicatesFound( fileData ) )
-                {
-                    DisplayInputLineEditIcon( diffusionPropertyIndex, m_okPixmap );
+            UpdateCurrentDir( filePath, m_currentInputFileDir );
 
-                    m_data.SetFilename( diffusionPropertyIndex ) = filePath;
-                    m_data.SetFileData( diffusionPropertyIndex ) = fileData;
+            /** The file is parsed in a worker thread, so the window stays responsive and files set together are parsed at the same time.
+             *  Until OnInputFileLoaded() registers it, the input is displayed as empty. **/
+            m_loadingInputFiles.insert( diffusionPropertyIndex );
+            DisplayInputFileLoading( diffusionPropertyIndex, true );
+            m_inputFileLoaderMap[ diffusionPropertyIndex ]->setFuture( QtConcurrent::run( &FADTTSWindow::LoadInputFile, filePath,
+                                                                                           diffusionPropertyIndex == m_data.GetSubMatrixIndex() ) );
 
-                    if( diffusionPropertyIndex == m_data.GetFractionalAnisotropyIndex() )
-                    {
-                        AddAtlas( fileData );
-                    }
-                }
-                else
-                {
-                    DisplayInputLineEditIcon( diffusionPropertyIndex, m_warningPixmap );
-                    m_data.SetFileData( diffusionPropertyIndex ) = fileData;
-                }
-            }
-            else
-            {
-                DisplayInputLineEditIcon( diffusionPropertyIndex, m_koPixmap );
+            UpdateInputFileInformation( diffusionPropertyIndex );
+            OnInputToggled();
+            return;
+        }
+    }
 
-                QString criticalMessage = m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper()
-                        + " data file corrupted:<br><i>" + m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ]->text()
-                        + "</i><br>For each row, the number of columns is not constant.<br>Check the data file provided.";
-                CriticalPopUp( criticalMessage );
-            }
+    UpdateInputTab( diffusionPropertyIndex );
+}
 
-            UpdateCurrentDir( filePath, m_currentInputFileDir );
-        }
+void FADTTSWindow::OnInputFileLoaded( int diffusionPropertyIndex )
+{
+    QFutureWatcher< LoadedInputFile > *inputFileLoader = m_inputFileLoaderMap.value( diffusionPropertyIndex );
+    if( !m_loadingInputFiles.contains( diffusionPropertyIndex ) || !inputFileLoader->future().isFinished() )
+    {
+        return;
     }
-    UpdateInputFileInformation( diffusionPropertyIndex );
+    m_loadingInputFiles.remove( diffusionPropertyIndex );
+    DisplayInputFileLoading( diffusionPropertyIndex, false );
 
-    if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() )
+    LoadedInputFile loadedFile = inputFileLoader->result();
+    CSVData fileData = loadedFile.fileData;
+    QString filePath = m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ]->text();
+    if( fileData.IsMatrixDimensionOK() )
     {
-        if( !m_afterEdition )
+        if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() )
         {
-            m_editInputDialog->ResetSubjectColumnID(); /** By default Subjects are on the 1st column. **/
+            m_data.SetFileData( diffusionPropertyIndex, fileData );
         }
         else
         {
-            m_afterEdition = false;
+            m_data.SetProfileData( diffusionPropertyIndex ) = loadedFile.profileData;
+        }
+
+        if( !m_processing.AreDuplicatesFound( fileData ) )
+        {
+            DisplayInputLineEditIcon( diffusionPropertyIndex, m_okPixmap );
+
+            m_data.SetFilename( diffusionPropertyIndex ) = filePath;
+
+            if( diffusionPropertyIndex == m_data.GetFractionalAnisotropyIndex() )
+            {
+                AddAtlas( m_data.GetProfileData( diffusionPropertyIndex ) );
+            }
+        }
+        else
+        {
+            DisplayInputLineEditIcon( diffusionPropertyIndex, m_warningPixmap );
         }
-        SetInfoSubjectColumnID();
     }
+    else
+    {
+        DisplayInputLineEditIcon( diffusionPropertyIndex, m_koPixmap );
 
-    OnInputToggled();
+        QString criticalMessage = m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper()
+                + " data file corrupted:<br><i>" + filePath
+                + "</i><br>For each row, the number of columns is not constant.<br>" + GetRaggedRowsText( fileData )
+                + "Check the data file provided.";
+        CriticalPopUp( criticalMessage );
+    }
+
+    UpdateInputTab( diffusionPropertyIndex );
 }
 
 
@@ -904,7 +1015,7 @@ void FADTTSWindow::OnAddInputFiles()
 {
     QString dir = m_currentInputFileDir;
     QStringList fileList;
-    fileList = QFileDialog::getOpenFileNames( this, tr( "Choose Input Files" ), dir, tr( ".csv( *.csv ) ;; .*( * )" ) );
+    fileList = QFileDialog::getOpenFileNames( this, tr( "Choose Input Files" ), dir, tr( qPrintable( ".csv( " + CompressedFile::GetNameFilters().join( " " ) + " ) ;; .*( * )" ) ) );
     if( !fileList.isEmpty() )
     {
         UpdateLineEditsAfterAddingMultipleFiles( fileList );
@@ -916,7 +1027,7 @@ void FADTTSWindow::OnAddInputFile( int diffusionPropertyIndex )
     QLineEdit *lineEdit = m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ];
     QString filePath = lineEdit->text();
     QDir dir = SetDir( filePath, m_currentInputFileDir );
-    QString file = QFileDialog::getOpenFileName( this, tr( qPrintable( "Choose " + m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper() + " File" ) ), dir.absolutePath(), tr( ".csv( *.csv ) ;; .*( * )" ) );
+    QString file = QFileDialog::getOpenFileName( this, tr( qPrintable( "Choose " + m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper() + " File" ) ), dir.absolutePath(), tr( qPrintable( ".csv( " + CompressedFile::GetNameFilters().join( " " ) + " ) ;; .*( * )" ) ) );
     if( !file.isEmpty() )
     {
         lineEdit->setText( file );
@@ -925,7 +1036,7 @@ void FADTTSWindow::OnAddInputFile( int diffusionPropertyIndex )
 
 void FADTTSWindow::OnEditInputFile( int diffusionPropertyIndex )
 {
-    if( m_data.GetFileData( diffusionPropertyIndex ).isEmpty() )
+    if( m_data.IsFileDataEmpty( diffusionPropertyIndex ) )
     {
         QString warningMessage = "<b>File Edition Unable</b><br>";
         warningMessage.append( m_inputTabInputFileLineEditMap[ diffusionPropertyIndex ]->text().isEmpty() ?
@@ -1031,16 +1142,11 @@ void FADTTSWindow::SetCovariateListWidget()
     }
 }
 
-void FADTTSWindow::AddAtlas( const QList< QStringList >& fileData )
+void FADTTSWindow::AddAtlas( const DiffusionProfileMatrix::ConstPointer& faData )
 {
-    if( fileData.first().last().contains( "atlas", Qt::CaseInsensitive ) )
+    if( faData->HasAtlas() )
     {
-        QStringList atlas;
-        for( int i = 1; i < fileData.size(); i++ )
-        {
-            atlas.append( fileData.at( i ).last() );
-        }
-        m_data.SetAtlas() = atlas;
+        m_data.SetAtlas() = faData->GetAtlas().ToList();
     }
 }
 
@@ -1088,25 +1194,53 @@ void FADTTSWindow::DisplayInputLineEditIcon( int diffusionPropertyIndex, const Q
 
 void FADTTSWindow::SetProfileCropping()
 {
-    QStringList arcLength = m_processing.Transpose( m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() ) ).first();
-    arcLength.removeFirst();
+    QStringList arcLength = m_data.GetProfileData( m_data.GetFractionalAnisotropyIndex() )->GetArcLengthLabels();
 
     para_subjectTab_startArcLength_value_label->setText( arcLength.first() );
     para_subjectTab_endArcLength_value_label->setText( arcLength.last() );
 }
 
+QString FADTTSWindow::GetRaggedRowsText( const CSVData& fileData )
+{
+    /** Rows counted from 1, header included **/
+    QList< int > raggedRows = fileData.GetRaggedRows();
+    QStringList rows;
+    for( int i = 0; i < raggedRows.size() && i < 10; i++ )
+    {
+        rows.append( QString::number( raggedRows.at( i ) + 1 ) );
+    }
+    if( raggedRows.size() > 10 )
+    {
+        rows.append( "..." );
+    }
+
+    return rows.isEmpty() ? QString() : "Rows concerned: " + rows.join( ", " ) + "<br>";
+}
+
 void FADTTSWindow::UpdateInputFileInformation( int diffusionPropertyIndex )
 {
-    QList< QStringList > fileData = m_data.GetFileData( diffusionPropertyIndex );
     QString filePath = m_data.SetFilename( diffusionPropertyIndex );
 
-    if( !fileData.isEmpty() && !filePath.isEmpty() )
+    if( !m_data.IsFileDataEmpty( diffusionPropertyIndex ) && !filePath.isEmpty() )
     {
-        m_data.SetNbrRows( diffusionPropertyIndex ) = fileData.count();
-        m_data.SetNbrColumns( diffusionPropertyIndex ) = fileData.first().count();
+        QStringList subjects;
+        if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() )
+        {
+            CSVData subMatrixData = m_data.GetSubMatrixData();
+            m_data.SetNbrRows( diffusionPropertyIndex ) = subMatrixData.GetNbrRows();
+            m_data.SetNbrColumns( diffusionPropertyIndex ) = subMatrixData.GetNbrColumns();
+            subjects = m_processing.GetSubjectsFromData( subMatrixData, m_data.GetSubjectColumnID() );
+        }
+        else
+        {
+            DiffusionProfileMatrix::ConstPointer profileData = m_data.GetProfileData( diffusionPropertyIndex );
+            m_data.SetNbrRows( diffusionPropertyIndex ) = profileData->GetNbrRows();
+            m_data.SetNbrColumns( diffusionPropertyIndex ) = profileData->GetNbrColumns();
+            subjects = profileData->GetSubjects();
+            subjects.sort();
+        }
 
         m_data.ClearSubjects( diffusionPropertyIndex );
-        QStringList subjects = m_processing.GetSubjectsFromData( fileData, m_data.GetSubjectColumnID() );
         m_data.SetSubjects( diffusionPropertyIndex ) = subjects;
         m_data.SetNbrSubjects( diffusionPropertyIndex ) = subjects.count();
 
@@ -1118,7 +1252,7 @@ void FADTTSWindow::UpdateInputFileInformation( int diffusionPropertyIndex )
         if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() )
         {
             m_data.ClearCovariates();
-            m_data.SetCovariates() = m_processing.GetCovariatesFromData( fileData, m_data.GetSubjectColumnID() );
+            m_data.SetCovariates() = m_processing.GetCovariatesFromData( m_data.GetSubMatrixData(), m_data.GetSubjectColumnID() );
             /** Intercept representes everything that has not been classified in one of the previous
              *  covariates. It is important to add it as 1st element of m_covariatesList **/
             m_data.AddInterceptToCovariates();
@@ -1140,7 +1274,7 @@ void FADTTSWindow::UpdateLineEditsAfterAddingMultipleFiles( const QStringList& f
     {
         foreach( QString file, fileList )
         {
-            QString filename = QFileInfo( QFile( file ) ).fileName();
+            QString filename = CompressedFile::GetUncompressedName( QFileInfo( QFile( file ) ).fileName() );
             if( filename.contains( "_" + m_data.GetDiffusionPropertyName( diffusionPropertyIndex ) + "_", Qt::CaseInsensitive ) ||
                     filename.startsWith( m_data.GetDiffusionPropertyName( diffusionPropertyIndex ) + "_", Qt::CaseInsensitive ) ||
                     filename.endsWith( "_" + m_data.GetDiffusionPropertyName( diffusionPropertyIndex ) + ".csv", Qt::CaseInsensitive ) )
@@ -1165,9 +1299,68 @@ void FADTTSWindow::UpdateLineEditsAfterAddingMultipleFiles( const QStringList& f
 }
 
 
+void FADTTSWindow::UpdateInputTab( int diffusionPropertyIndex )
+{
+    UpdateInputFileInformation( diffusionPropertyIndex );
+
+    if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() )
+    {
+        if( !m_afterEdition )
+        {
+            m_editInputDialog->ResetSubjectColumnID(); /** By default Subjects are on the 1st column. **/
+        }
+        else
+        {
+            m_afterEdition = false;
+        }
+        SetInfoSubjectColumnID();
+    }
+
+    OnInputToggled();
+}
+
+FADTTSWindow::LoadedInputFile FADTTSWindow::LoadInputFile( QString filePath, bool isSubMatrix )
+{
+    LoadedInputFile loadedFile;
+    loadedFile.fileData = DatasetCache::GetInstance().GetData( filePath );
+
+    /** Profiles are reordered subject by subject here too, not in the GUI thread **/
+    if( !isSubMatrix && loadedFile.fileData.IsMatrixDimensionOK() )
+    {
+        loadedFile.profileData = DatasetCache::GetInstance().GetProfileData( filePath );
+    }
+
+    return loadedFile;
+}
+
+void FADTTSWindow::DisplayInputFileLoading( int diffusionPropertyIndex, bool isLoading )
+{
+    if( isLoading )
+    {
+        m_inputTabIconLabelMap[ diffusionPropertyIndex ]->clear();
+        m_inputTabIconLabelMap[ diffusionPropertyIndex ]->hide();
+        m_inputTabLoadingProgressBarMap[ diffusionPropertyIndex ]->show();
+    }
+    else
+    {
+        m_inputTabLoadingProgressBarMap[ diffusionPropertyIndex ]->hide();
+        m_inputTabIconLabelMap[ diffusionPropertyIndex ]->show();
+    }
+}
+
+void FADTTSWindow::WaitForInputFiles()
+{
+    foreach( int diffusionPropertyIndex, m_loadingInputFiles.toList() )
+    {
+        m_inputFileLoaderMap[ diffusionPropertyIndex ]->waitForFinished();
+        OnInputFileLoaded( diffusionPropertyIndex );
+    }
+}
+
+
 void FADTTSWindow::SetInfoSubjectColumnID()
 {
-    inputTab_subjectColumnID_label->setText( !m_data.GetFileData( m_data.GetSubMatrixIndex() ).isEmpty() ?
+    inputTab_subjectColumnID_label->setText( !m_data.IsFileDataEmpty( m_data.GetSubMatrixIndex() ) ?
                                                        tr( qPrintable( "<b><i><span style=""font-size:7pt;"">" + QString::number( m_data.GetSubjectColumnID() + 1 ) + "</span></i></b>" ) ) :
                                                        "" );
 }
@@ -1201,26 +1394,48 @@ void FADTTSWindow::SetCheckStateAllCovariates( Qt::CheckState checkState )
 void FADTTSWindow::OnApplyQCThreshold()
 {
     QStringList matchedSubjects = GetCheckedMatchedSubjects();
-    QList< QStringList > rawData = m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() );
-    QStringList atlas = para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() ? m_data.GetAtlas() : QStringList();
+    bool useAtlas = para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked();
 
-    if( matchedSubjects.isEmpty() || ( para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() && atlas.isEmpty() ) )
+    /** Every diffusion property used, with an atlas in its file if the QC threshold is based on the atlas **/
+    QMap< QString, DiffusionProfileMatrix::ConstPointer > rawData;
+    QMap< QString, double > qcThresholds, fpcaQCThresholds;
+    foreach( int diffusionPropertyIndex, m_data.GetDiffusionPropertiesIndices() )
+    {
+        if( diffusionPropertyIndex == m_data.GetSubMatrixIndex() ||
+                !( m_paramTabFileCheckBoxMap[ diffusionPropertyIndex ]->isChecked() && m_paramTabFileCheckBoxMap[ diffusionPropertyIndex ]->isEnabled() ) )
+        {
+            continue;
+        }
+
+        DiffusionProfileMatrix::ConstPointer propertyData = m_data.GetProfileData( diffusionPropertyIndex );
+        if( !propertyData->IsEmpty() && ( !useAtlas || propertyData->HasAtlas() ) )
+        {
+            QString property = m_data.GetDiffusionPropertyName( diffusionPropertyIndex );
+            rawData.insert( property, propertyData );
+            qcThresholds.insert( property, diffusionPropertyIndex == m_data.GetFractionalAnisotropyIndex() ?
+                                     para_subjectTab_qcThreshold_doubleSpinBox->value() : m_qcThresholds.value( property, para_subjectTab_qcThreshold_doubleSpinBox->value() ) );
+            fpcaQCThresholds.insert( property, m_fpcaQCThresholds.value( property, QCThreshold::GetDefaultFPCAQCThreshold() ) );
+        }
+    }
+
+    if( matchedSubjects.isEmpty() || ( useAtlas && rawData.isEmpty() ) )
     {
         QString warningMessage = "<b>Unable to apply QC Threshold</b><br>";
         if( matchedSubjects.isEmpty() )
         {
             warningMessage.append( QString( "<br>- No subjects selected<br>" ) );
         }
-        if( para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() && atlas.isEmpty() )
+        if( useAtlas && rawData.isEmpty() )
         {
             warningMessage.append( QString( "<br>- No atlas detected" ) );
         }
         WarningPopUp( warningMessage );
     }
 
-    if( !matchedSubjects.isEmpty() && !rawData.isEmpty() && ( para_subjectTab_qcThresoldOnAtlas_radioButton->isChecked() ? !atlas.isEmpty() : true ) )
+    if( !matchedSubjects.isEmpty() && !rawData.isEmpty() )
     {
-        bool initDiaolog = m_qcThresholdDialog->InitPlot( rawData, atlas, matchedSubjects, para_subjectTab_qcThreshold_doubleSpinBox->value(), para_subjectTab_startArcLength_value_label->text(), para_subjectTab_endArcLength_value_label->text() );
+        bool initDiaolog = m_qcThresholdDialog->InitPlot( rawData, useAtlas, matchedSubjects, qcThresholds, fpcaQCThresholds, m_qcThresholdRule, m_qcThresholdReference, m_qcThresholdMetric,
+                                                          para_subjectTab_startArcLength_value_label->text(), para_subjectTab_endArcLength_value_label->text() );
 
         if( initDiaolog )
         {
@@ -1231,7 +1446,8 @@ void FADTTSWindow::OnApplyQCThreshold()
     }
 }
 
-void FADTTSWindow::OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, double qcThreshold, bool windowClosed )
+void FADTTSWindow::OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, const QMap< QString, double >& qcThresholds,
+                                         const QMap< QString, double >& fpcaQCThresholds, const QString& rule, const QString& reference, const QString& metric, bool windowClosed )
 {
     if( windowClosed )
     {
@@ -1240,39 +1456,26 @@ void FADTTSWindow::OnQCThresholdApplied( const QStringList& subjectsCorrelated,
         m_failedQCThresholdSubjects.sort();
     }
 
+    /** The spin box keeps the correlation threshold, the FPCA thresholds only being set in the dialog **/
+    double qcThreshold = qcThresholds.value( "FA", para_subjectTab_qcThreshold_doubleSpinBox->value() );
     para_subjectTab_qcThreshold_doubleSpinBox->setValue( qcThreshold );
-    m_qcThreshold = qcThreshold;
-
-    for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
-    {
-        QListWidgetItem *currentItem = m_matchedSubjectListWidget->item( i );
-        if( subjectsNotCorrelated.contains( currentItem->text() ) )
-        {
-            currentItem->setCheckState( Qt::Unchecked );
-            currentItem->setBackgroundColor( m_grey );
-        }
+    m_qcThresholds = qcThresholds;
+    m_fpcaQCThresholds = fpcaQCThresholds;
+    QCThreshold::GetRule( rule, m_qcThresholdRule );
+    QCThresholdReference::GetType( reference, m_qcThresholdReference );
+    QCThreshold::GetMetric( metric, m_qcThresholdMetric );
+    m_qcThreshold = m_qcThresholdMetric == QCThreshold::FPCA ? fpcaQCThresholds.value( "FA", QCThreshold::GetDefaultFPCAQCThreshold() ) : qcThreshold;
 
-        if( subjectsCorrelated.contains( currentItem->text() ) )
-        {
-            currentItem->setCheckState( Qt::Checked );
-            currentItem->setBackgroundColor( m_green );
-        }
-    }
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    m_matchedSubjectModel->SetChecked( registry.GetIDSet( subjectsNotCorrelated ), false );
+    m_matchedSubjectModel->SetChecked( registry.GetIDSet( subjectsCorrelated ), true );
 
     DisplayNbrSubjectSelected();
 }
 
 void FADTTSWindow::OnNanSujects( const QStringList& nanSubjects )
 {
-    for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
-    {
-        QListWidgetItem *currentItem = m_matchedSubjectListWidget->item( i );
-        if( nanSubjects.contains( currentItem->text() ) )
-        {
-            currentItem->setCheckState( Qt::Unchecked );
-            currentItem->setBackgroundColor( m_grey );
-        }
-    }
+    m_matchedSubjectModel->SetChecked( SubjectRegistry::GetInstance().GetIDSet( nanSubjects ), false );
 
     DisplayNbrSubjectSelected();
 }
@@ -1301,7 +1504,7 @@ void FADTTSWindow::OnUpdatingEndArcLength( const QString& valueEnd )
 
 void FADTTSWindow::OnSearch()
 {
-    int nbrSubjectFind = SearchSubjects( m_matchedSubjectListWidget ) + SearchSubjects( m_unmatchedSubjectListWidget );
+    int nbrSubjectFind = SearchSubjects( m_matchedSubjectProxyModel ) + SearchSubjects( m_unmatchedSubjectProxyModel );
     subjectTab_nbrFound_label->
             setText( !subjectTab_search_lineEdit->text().isEmpty() ? "found " + QString::number( nbrSubjectFind ) : "" );
 }
@@ -1311,8 +1514,14 @@ void FADTTSWindow::OnInputToggled()
     SetSelectedInputFiles();
     UpdateSubjectList();
 
-    bool isFAEnable = m_paramTabFileCheckBoxMap[ m_data.GetFractionalAnisotropyIndex() ]->isChecked() && m_paramTabFileCheckBoxMap[ m_data.GetFractionalAnisotropyIndex() ]->isEnabled();
-    subjectTab_qcThreshold_widget->setEnabled( isFAEnable );
+    /** QC threshold available as soon as one diffusion property is used **/
+    bool isPropertyEnable = false;
+    foreach( int diffusionPropertyIndex, m_data.GetDiffusionPropertiesIndices() )
+    {
+        isPropertyEnable = isPropertyEnable || ( diffusionPropertyIndex != m_data.GetSubMatrixIndex() &&
+                                                 m_paramTabFileCheckBoxMap[ diffusionPropertyIndex ]->isChecked() && m_paramTabFileCheckBoxMap[ diffusionPropertyIndex ]->isEnabled() );
+    }
+    subjectTab_qcThreshold_widget->setEnabled( isPropertyEnable );
 }
 
 void FADTTSWindow::OnSetCaseSensitivityToggled( bool checked )
@@ -1322,16 +1531,18 @@ void FADTTSWindow::OnSetCaseSensitivityToggled( bool checked )
 }
 
 
-void FADTTSWindow::OnSubjectClicked( QListWidgetItem *item )
+void FADTTSWindow::OnSubjectClicked( const QModelIndex& index )
 {
-    if( item->flags() == Qt::ItemIsEnabled )
+    int subjectID = m_matchedSubjectModel->GetSubjectID( m_matchedSubjectProxyModel->mapToSource( index ).row() );
+    if( subjectID != -1 )
     {
-        item->setCheckState( item->checkState() == Qt::Checked ? Qt::Unchecked : Qt::Checked );
-        item->setBackgroundColor( item->checkState() == Qt::Checked ? m_green : m_grey );
+        bool isChecked = !m_matchedSubjectModel->IsChecked( subjectID );
+        m_matchedSubjectModel->SetChecked( subjectID, isChecked );
 
-        if( ( item->checkState() == Qt::Checked ) && m_failedQCThresholdSubjects.contains( item->text() ) )
+        QString subject = SubjectRegistry::GetInstance().GetName( subjectID );
+        if( isChecked && m_failedQCThresholdSubjects.contains( subject ) )
         {
-            m_failedQCThresholdSubjects.removeAll( item->text() );
+            m_failedQCThresholdSubjects.removeAll( subject );
         }
     }
 
@@ -1455,8 +1666,8 @@ void FADTTSWindow::DisplaySubjectInformation()
 
     QString textMatchedSubjectsInformation;
     QString textUnmatchedSubjectsInformation;
-    int nbrMatchedSubjects = m_matchedSubjectListWidget->count();
-    int nbrUnmatchedSubjects = m_unmatchedSubjectListWidget->count();
+    int nbrMatchedSubjects = m_matchedSubjectModel->GetNbrSubjects();
+    int nbrUnmatchedSubjects = m_unmatchedSubjectModel->GetNbrSubjects();
     int nbrTotalSubjects = nbrMatchedSubjects + nbrUnmatchedSubjects;
     if( ( nbrMatchedSubjects != 0 ) || ( nbrUnmatchedSubjects != 0 ) )
     {
@@ -1491,21 +1702,10 @@ void FADTTSWindow::DisplaySubjectInformation()
 void FADTTSWindow::DisplayNbrSubjectSelected()
 {
     subjectTab_checkedSubjectsInformation_label->clear();
-    int nbrSubjectsSelected = 0;
-
-    if( m_matchedSubjectListWidget->count() != 0 )
+    if( m_matchedSubjectModel->GetNbrSubjects() != 0 )
     {
-        for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
-        {
-            QListWidgetItem *item = m_matchedSubjectListWidget->item( i );
-
-            if( item->checkState() == Qt::Checked )
-            {
-                nbrSubjectsSelected++;
-            }
-        }
-
-        subjectTab_checkedSubjectsInformation_label->setText( tr( qPrintable( QString::number( nbrSubjectsSelected ) + "/" + QString::number( m_matchedSubjectListWidget->count() ) + " subjects selected") ) );
+        int nbrSubjectsSelected = m_matchedSubjectModel->GetNbrChecked();
+        subjectTab_checkedSubjectsInformation_label->setText( tr( qPrintable( QString::number( nbrSubjectsSelected ) + "/" + QString::number( m_matchedSubjectModel->GetNbrSubjects() ) + " subjects selected") ) );
     }
 }
 
@@ -1513,46 +1713,59 @@ void FADTTSWindow::DisplaySortedSubjects( const QStringList& matchedSubjects, co
 {
     m_failedQCThresholdSubjects.clear();
 
-    m_matchedSubjectListWidget->clear();
-    m_matchedSubjectListWidget->setUpdatesEnabled( false );
-    m_matchedSubjectListWidget->setSelectionMode( QAbstractItemView::NoSelection );
-    foreach( QString subject, matchedSubjects )
-    {
-        QListWidgetItem *item = new QListWidgetItem( subject, m_matchedSubjectListWidget );
-        item->setCheckState( Qt::Checked );
-        item->setBackgroundColor( m_green );
-        item->setFlags( Qt::ItemIsEnabled );
-        m_matchedSubjectListWidget->addItem( item );
-    }
-    m_matchedSubjectListWidget->setUpdatesEnabled( true );
+    m_matchedSubjectModel->SetSubjects( matchedSubjects );
 
-    m_unmatchedSubjectListWidget->clear();
-    m_unmatchedSubjectListWidget->setUpdatesEnabled( false );
-    m_unmatchedSubjectListWidget->setSelectionMode( QAbstractItemView::NoSelection );
+    QStringList unmatchedTexts;
     QMap< QString, QList< int > >::ConstIterator iterUnmatchedSubjects = unMatchedSubjectMap.cbegin();
     while( iterUnmatchedSubjects != unMatchedSubjectMap.constEnd() )
     {
-        QStringList sortedText;
-        foreach( int index, iterUnmatchedSubjects.value() )
+        unmatchedTexts.append( GetUnmatchedSubjectText( iterUnmatchedSubjects.key(), iterUnmatchedSubjects.value() ) );
+        ++iterUnmatchedSubjects;
+    }
+    m_unmatchedSubjectModel->SetSubjects( unMatchedSubjectMap.keys(), unmatchedTexts );
+
+    DisplaySubjectInformation();
+    DisplayNbrSubjectSelected();
+}
+
+void FADTTSWindow::UpdateSortedSubjects( const QSet< int >& changedSubjectIDs )
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QSet< int > removedSubjectIDs;
+
+    foreach( int subjectID, changedSubjectIDs )
+    {
+        QString subject = registry.GetName( subjectID );
+        QList< int > sourceIndices = m_subjectMatcher.GetSubjectSources( subjectID );
+        bool isMatched = m_subjectMatcher.IsMatched( subjectID );
+
+        /** Subjects still matched keep their check state **/
+        bool isDisplayed = m_matchedSubjectModel->GetRow( subjectID ) != -1;
+        if( isDisplayed && !isMatched )
         {
-            if( index == -1 )
-            {
-                sortedText.append( "External List" );
-            }
-            else
-            {
-                sortedText.append( m_data.GetDiffusionPropertyName( index ) );
-            }
+            m_matchedSubjectModel->RemoveSubject( subjectID );
+            removedSubjectIDs.insert( subjectID );
+        }
+        else if( !isDisplayed && isMatched )
+        {
+            m_matchedSubjectModel->InsertSubject( subject, subject );
         }
 
-        QString text = tr( qPrintable( iterUnmatchedSubjects.key() + " --> " + sortedText.join( ", " ) ) );
-        QListWidgetItem *item = new QListWidgetItem( text, m_unmatchedSubjectListWidget );
-        item->setBackgroundColor( m_red );
-        item->setTextColor( m_lightBlack );
-        m_unmatchedSubjectListWidget->addItem( item );
-        ++iterUnmatchedSubjects;
+        if( isMatched || sourceIndices.isEmpty() )
+        {
+            m_unmatchedSubjectModel->RemoveSubject( subjectID );
+        }
+        else
+        {
+            m_unmatchedSubjectModel->InsertSubject( subject, GetUnmatchedSubjectText( subject, sourceIndices ) );
+        }
+    }
+
+    /** Subjects no longer matched no longer fail the QC threshold **/
+    if( !removedSubjectIDs.isEmpty() )
+    {
+        m_failedQCThresholdSubjects = registry.Exclude( m_failedQCThresholdSubjects, removedSubjectIDs );
     }
-    m_unmatchedSubjectListWidget->setUpdatesEnabled( true );
 
     DisplaySubjectInformation();
     DisplayNbrSubjectSelected();
@@ -1567,85 +1780,96 @@ void FADTTSWindow::UpdateSubjectList()
         allSubjects.insert( -1, m_loadedSubjects );
     }
 
-    QStringList allSubjectsList = m_processing.GetAllSubjects( allSubjects );
-
-    QMap< QString, QMap< int, bool > > sortedSubjects = m_processing.SortSubjects( allSubjectsList, allSubjects );
-
-    QStringList matchedSubjects;
-    QMap< QString, QList< int > > unMatchedSubjects;
-    m_processing.AssignSortedSubject( sortedSubjects, matchedSubjects, unMatchedSubjects );
+    /** Only the sources removed, added or changed since the last update are matched again **/
+    QSet< int > changedSubjectIDs;
+    foreach( int sourceIndex, m_subjectMatcher.GetSourceIndices() )
+    {
+        if( !allSubjects.contains( sourceIndex ) )
+        {
+            changedSubjectIDs.unite( m_subjectMatcher.RemoveSource( sourceIndex ) );
+        }
+    }
+    QMap< int, QStringList >::ConstIterator iterSource = allSubjects.cbegin();
+    while( iterSource != allSubjects.cend() )
+    {
+        changedSubjectIDs.unite( m_subjectMatcher.SetSource( iterSource.key(), iterSource.value() ) );
+        ++iterSource;
+    }
 
-    DisplaySortedSubjects( matchedSubjects, unMatchedSubjects );
+    /** Lists rebuilt if most of the rows change **/
+    int nbrRows = m_matchedSubjectModel->GetNbrSubjects() + m_unmatchedSubjectModel->GetNbrSubjects();
+    if( changedSubjectIDs.size() > nbrRows / 2 )
+    {
+        DisplaySortedSubjects( m_subjectMatcher.GetMatchedSubjects(), m_subjectMatcher.GetUnMatchedSubjects() );
+    }
+    else if( !changedSubjectIDs.isEmpty() )
+    {
+        UpdateSortedSubjects( changedSubjectIDs );
+    }
 
     OnSearch();
 }
 
-void FADTTSWindow::SetCheckStateAllVisibleSubjects( Qt::CheckState checkState )
+QString FADTTSWindow::GetUnmatchedSubjectText( const QString& subject, const QList< int >& sourceIndices )
 {
-    for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
+    QStringList sortedText;
+    foreach( int index, sourceIndices )
     {
-        QListWidgetItem* current = m_matchedSubjectListWidget->item( i );
-        if( !current->isHidden() && current->flags() == Qt::ItemIsEnabled )
+        if( index == -1 )
         {
-            current->setCheckState( checkState );
-            current->setBackgroundColor( checkState ? m_green : m_grey );
-
-            if( ( current->checkState() == Qt::Checked ) && m_failedQCThresholdSubjects.contains( current->text() ) )
-            {
-                m_failedQCThresholdSubjects.removeAll( current->text() );
-            }
+            sortedText.append( "External List" );
+        }
+        else
+        {
+            sortedText.append( m_data.GetDiffusionPropertyName( index ) );
         }
     }
 
-    DisplayNbrSubjectSelected();
+    return tr( qPrintable( subject + " --> " + sortedText.join( ", " ) ) );
 }
 
-int FADTTSWindow::SearchSubjects( QListWidget *list )
+void FADTTSWindow::SetCheckStateAllVisibleSubjects( Qt::CheckState checkState )
 {
-    int nbrFound = 0;
-    QLineEdit *lineEdit = subjectTab_search_lineEdit;
-    QString search = lineEdit->text();
-    QPalette palette;
-    if( !search.isEmpty() )
+    bool isChecked = checkState == Qt::Checked;
+    if( !m_matchedSubjectProxyModel->IsSearching() )
     {
-        if(  list->count() != 0  )
-        {
-            search.prepend( "*" );
-            search.append( "*" );
-            QRegExp regExp( search );
-            regExp.setPatternSyntax( QRegExp::Wildcard );
-            regExp.setCaseSensitivity( m_caseSensitivity );
-            for( int i = 0; i < list->count(); i++ )
-            {
-                QListWidgetItem* current = list->item( i );
-                if( regExp.exactMatch( current->text() ) )
-                {
-                    current->setHidden( false );
-                    nbrFound++;
-                }
-                else
-                {
-                    current->setHidden( true );
-                }
-            }
-        }
-        palette.setColor( QPalette::Base, m_yellow );
-        lineEdit->setPalette( palette );
+        /** Every subject visible: the whole bitset is set at once **/
+        m_matchedSubjectModel->SetAllChecked( isChecked );
     }
     else
     {
-        if( list->count() != 0 )
+        m_matchedSubjectModel->SetChecked( m_matchedSubjectProxyModel->GetFoundSubjectIDs().toSet(), isChecked );
+    }
+
+    /** Subjects checked again no longer count as failing the QC threshold **/
+    if( isChecked && !m_failedQCThresholdSubjects.isEmpty() )
+    {
+        SubjectRegistry& registry = SubjectRegistry::GetInstance();
+        QSet< int > checkedFailedIDs;
+        foreach( int subjectID, registry.GetIDSet( m_failedQCThresholdSubjects ) )
         {
-            for( int i = 0; i < list->count(); i++ )
+            if( m_matchedSubjectModel->IsChecked( subjectID ) )
             {
-                list->item( i )->setHidden( false );
+                checkedFailedIDs.insert( subjectID );
             }
         }
-        palette.setColor( QPalette::Base, Qt::white );
-        lineEdit->setPalette( palette );
+        m_failedQCThresholdSubjects = registry.Exclude( m_failedQCThresholdSubjects, checkedFailedIDs );
     }
 
-    return nbrFound;
+    DisplayNbrSubjectSelected();
+}
+
+int FADTTSWindow::SearchSubjects( SubjectFilterProxyModel *proxyModel )
+{
+    QLineEdit *lineEdit = subjectTab_search_lineEdit;
+    QString search = lineEdit->text();
+    proxyModel->SetSearch( search, m_caseSensitivity );
+
+    QPalette palette;
+    palette.setColor( QPalette::Base, search.isEmpty() ? QColor( Qt::white ) : m_yellow );
+    lineEdit->setPalette( palette );
+
+    return proxyModel->IsSearching() ? proxyModel->GetFoundSubjectIDs().size() : 0;
 }
 
 void FADTTSWindow::UseSavedSubjectList( QString filePath )
@@ -1687,11 +1911,12 @@ void FADTTSWindow::SaveCheckedSubjects( QString filePath )
     exportedTXT.open( QIODevice::WriteOnly );
     QTextStream ts( &exportedTXT );
 
-    for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
+    for( int row = 0; row < m_matchedSubjectProxyModel->rowCount(); row++ )
     {
-        if( m_matchedSubjectListWidget->item( i )->checkState() == Qt::Checked && !m_matchedSubjectListWidget->item( i )->isHidden() )
+        int subjectID = m_matchedSubjectModel->GetSubjectID( m_matchedSubjectProxyModel->mapToSource( m_matchedSubjectProxyModel->index( row, 0 ) ).row() );
+        if( m_matchedSubjectModel->IsChecked( subjectID ) )
         {
-            ts << m_matchedSubjectListWidget->item( i )->text() <<  endl;
+            ts << SubjectRegistry::GetInstance().GetName( subjectID ) <<  endl;
         }
     }
     exportedTXT.flush();
@@ -1700,27 +1925,17 @@ void FADTTSWindow::SaveCheckedSubjects( QString filePath )
 
 QStringList FADTTSWindow::GetCheckedMatchedSubjects()
 {
-    QStringList matchedSubjects;
-    QList< QListWidgetItem * > items = m_matchedSubjectListWidget->findItems( "*", Qt::MatchWrap | Qt::MatchWildcard );
-    foreach( QListWidgetItem *currentItem, items )
-    {
-        if( currentItem->checkState() == Qt::Checked )
-        {
-            matchedSubjects.append( currentItem->text() );
-        }
-    }
-
-    return matchedSubjects;
+    return m_matchedSubjectModel->GetCheckedSubjects();
 }
 
-QMap< QString, QList< QStringList > > FADTTSWindow::GetPropertyRawData()
+QMap< QString, DiffusionProfileMatrix::ConstPointer > FADTTSWindow::GetPropertyRawData()
 {
-    QMap< QString, QList< QStringList > > fileData;
+    QMap< QString, DiffusionProfileMatrix::ConstPointer > fileData;
     foreach( int diffusionPropertyIndex, m_propertySelected.keys() )
     {
         if( m_data.GetDiffusionPropertyName( diffusionPropertyIndex ) != "submatrix" )
         {
-            fileData.insert( m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper(), m_data.GetFileData( diffusionPropertyIndex ) );
+            fileData.insert( m_data.GetDiffusionPropertyName( diffusionPropertyIndex ).toUpper(), m_data.GetProfileData( diffusionPropertyIndex ) );
         }
     }
 
@@ -1735,18 +1950,11 @@ QMap< QString, QList< QStringList > > FADTTSWindow::GetPropertyRawData()
 /***********************  Private  slots  ***********************/
 void FADTTSWindow::OnCroppedProfileUpdated()
 {
-    QList< QStringList > faFile = m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() );
-    QStringList arcLength;
+    QStringList arcLength = m_data.GetProfileData( m_data.GetFractionalAnisotropyIndex() )->GetArcLengthLabels();
     QString startProfile = para_subjectTab_startArcLength_value_label->text();
     QString endProfile = para_subjectTab_endArcLength_value_label->text();
     bool showWarning = false;
 
-    if( !faFile.isEmpty() )
-    {
-        arcLength = m_processing.Transpose( m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() ) ).first();
-        arcLength.removeFirst();
-    }
-
 
     if( !arcLength.isEmpty() )
     {
@@ -1889,6 +2097,12 @@ void FADTTSWindow::OnSettingMatlabExe( const QString& executable )
 }
 
 
+void FADTTSWindow::OnSettingNbrParsingThreads( int nbrThreads )
+{
+    DatasetCache::GetInstance().SetNbrThreads( nbrThreads );
+}
+
+
 void FADTTSWindow::OnRunMatlabToggled( bool isChecked )
 {
 
@@ -1903,6 +2117,8 @@ void FADTTSWindow::OnRunMatlabToggled( bool isChecked )
 
 void FADTTSWindow::OnRun()
 { 
+    WaitForInputFiles();
+
     SetSelectedCovariates();
     SetFibername();
 
@@ -1977,10 +2193,10 @@ void FADTTSWindow::OnUsingWrongMatlabVersion()
 /*********************** Private function ***********************/
 void FADTTSWindow::GenerateNANSubjectFile( QString outputDir, QStringList selectedSubjects )
 {
-    QList< QStringList > faData = m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() );
-    if( !faData.isEmpty() )
+    DiffusionProfileMatrix::ConstPointer faData = m_data.GetProfileData( m_data.GetFractionalAnisotropyIndex() );
+    if( !faData->IsEmpty() )
     {
-        QStringList nanSubjects = m_processing.GetNANSubjects( faData, selectedSubjects );
+        QStringList nanSubjects = m_processing.GetNANSubjects( *faData, selectedSubjects );
 
         if( !nanSubjects.isEmpty() )
         {
@@ -2031,14 +2247,11 @@ QStringList FADTTSWindow::GenerateSelectedSubjectFile( QString outputDir )
     if( selectedSubjectFile.open( QIODevice::WriteOnly ) )
     {
         QTextStream tsSelectedSubjectFile( &selectedSubjectFile );
-        for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
+        selectedSubjects = m_matchedSubjectModel->GetCheckedSubjects();
+        m_nbrSelectedSubjects = selectedSubjects.size();
+        foreach( QString subject, selectedSubjects )
         {
-            if( m_matchedSubjectListWidget->item( i )->checkState() == Qt::Checked )
-            {
-                m_nbrSelectedSubjects++;
-                tsSelectedSubjectFile << m_matchedSubjectListWidget->item( i )->text() << endl;
-                selectedSubjects.append( m_matchedSubjectListWidget->item( i )->text() );
-            }
+            tsSelectedSubjectFile << subject << endl;
         }
         selectedSubjectFile.flush();
         selectedSubjectFile.close();
@@ -2086,15 +2299,7 @@ void FADTTSWindow::SetFibername()
 
 bool FADTTSWindow::IsAtLeastOneSubjectSelected()
 {
-    for( int i = 0; i < m_matchedSubjectListWidget->count(); i++ )
-    {
-        if( m_matchedSubjectListWidget->item( i )->checkState() == Qt::Checked )
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return m_matchedSubjectModel->GetNbrChecked() != 0;
 }
 
 bool FADTTSWindow::canFADTTSterBeRun()
@@ -2198,8 +2403,7 @@ void FADTTSWindow::SetMatlabScript()
     int endProfile = -1;
     if( m_paramTabFileCheckBoxMap.value( m_data.GetFractionalAnisotropyIndex() )->isChecked() )
     {
-        QStringList arcLength = m_processing.Transpose( m_data.GetFileData( m_data.GetFractionalAnisotropyIndex() ) ).first();
-        arcLength.removeFirst();
+        QStringList arcLength = m_data.GetProfileData( m_data.GetFractionalAnisotropyIndex() )->GetArcLengthLabels();
 
         startProfile = arcLength.indexOf( para_subjectTab_startArcLength_value_label->text(), 0 );
         endProfile = arcLength.indexOf( para_subjectTab_endArcLength_value_label->text(), 0 );
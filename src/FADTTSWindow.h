@@ -7,6 +7,9 @@
 #include "QCThresholdDialog.h"
 #include "Data.h"
 #include "Processing.h"
+#include "IncrementalSubjectMatcher.h"
+#include "SubjectListModel.h"
+#include "SubjectFilterProxyModel.h"
 #include "MatlabThread.h"
 #include "Plot.h"
 #include "Log.h"
@@ -16,7 +19,10 @@
 #include <QSignalMapper>
 #include <QFileSystemWatcher>
 #include <QScrollBar>
+#include <QListView>
 #include <QProgressBar>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -71,6 +77,9 @@ private slots:
 
     void OnEditInputFile( int diffusionPropertyID ); /// Not tested
 
+    /** Registers a file once parsed by its worker thread **/
+    void OnInputFileLoaded( int diffusionPropertyID ); // Tested
+
 
     void OnCovariateClicked( QListWidgetItem *item ); // Tested
 
@@ -87,7 +96,8 @@ private slots:
     /**************** Subjects Tab ****************/
     void OnApplyQCThreshold(); /// Not tested
 
-    void OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, double qcThreshold, bool windowClosed ); // Tested
+    void OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, const QMap< QString, double >& qcThresholds,
+                               const QMap< QString, double >& fpcaQCThresholds, const QString& rule, const QString& reference, const QString& metric, bool windowClosed ); // Tested
 
     void OnNanSujects( const QStringList& nanSubjects );
 
@@ -105,7 +115,7 @@ private slots:
     void OnSetCaseSensitivityToggled( bool checked ); // Tested
 
 
-    void OnSubjectClicked( QListWidgetItem *item ); // Tested
+    void OnSubjectClicked( const QModelIndex& index ); // Tested
 
     void OnCheckAllVisibleSubjects(); // Tested
 
@@ -136,6 +146,8 @@ private slots:
 
     void OnSettingMatlabExe( const QString& executable ); // Not Directly Tested
 
+    void OnSettingNbrParsingThreads( int nbrThreads ); // Not Directly Tested
+
 
     void OnRunMatlabToggled( bool isChecked ); // Not Directly Tested
 
@@ -242,6 +254,13 @@ private slots:
 
 
 private:
+    /** Result of the worker thread parsing an input file **/
+    struct LoadedInputFile
+    {
+        CSVData fileData;
+        DiffusionProfileMatrix::ConstPointer profileData;
+    };
+
     static const QColor m_green;
     static const QColor m_red;
     static const QColor m_grey;
@@ -260,6 +279,8 @@ private:
     typedef QMap< int, QLineEdit* > lineEditMapType;
     typedef QMap< int, QCheckBox* > checkBoxMapType;
     typedef QMap< int, QLabel* > labelMapType;
+    typedef QMap< int, QProgressBar* > progressBarMapType;
+    typedef QMap< int, QFutureWatcher< LoadedInputFile >* > inputFileLoaderMapType;
     typedef QMap< int, QPair< QString, QPair< bool, QString > > > displayMapType;
     typedef QMap< int, QPair< QString, QLabel* > > nameLabelMapType;
     typedef QMap< int, QPair< QString, QComboBox* > > comboBoxMapType;
@@ -279,6 +300,11 @@ private:
     pushButtonMapType m_inputTabAddInputFilePushButtonMap, m_inputTabEditInputFilePushButtonMap;
     lineEditMapType m_inputTabInputFileLineEditMap;
     labelMapType m_inputTabIconLabelMap, m_inputFileInformationLabelMap;
+    progressBarMapType m_inputTabLoadingProgressBarMap;
+    inputFileLoaderMapType m_inputFileLoaderMap;
+
+    /** Inputs whose file is being parsed **/
+    QSet< int > m_loadingInputFiles;
 
     QString m_currentInputFileDir;
 
@@ -290,7 +316,16 @@ private:
 
     Qt::CaseSensitivity m_caseSensitivity;
 
-    QListWidget *m_matchedSubjectListWidget, *m_unmatchedSubjectListWidget;
+    QListView *m_matchedSubjectListView, *m_unmatchedSubjectListView;
+
+    /** Subjects displayed: no item per subject, check states kept as bitsets **/
+    SubjectListModel *m_matchedSubjectModel, *m_unmatchedSubjectModel;
+
+    /** Subjects found by the search **/
+    SubjectFilterProxyModel *m_matchedSubjectProxyModel, *m_unmatchedSubjectProxyModel;
+
+    /** Sources matched so far: only the subjects of the sources toggled or loaded are matched again **/
+    IncrementalSubjectMatcher m_subjectMatcher;
 
     checkBoxMapType m_paramTabFileCheckBoxMap;
 
@@ -312,8 +347,21 @@ private:
 
     QString m_fibername, m_currentMatlabExeDir, m_mvcmPath;
 
+    /** FA's QC threshold of the metric last applied **/
     double m_qcThreshold;
 
+    /** QC threshold of each diffusion property, FA's being the one of the spin box **/
+    QMap< QString, double > m_qcThresholds;
+
+    /** QC threshold of each diffusion property for the FPCA metric **/
+    QMap< QString, double > m_fpcaQCThresholds;
+
+    QCThreshold::Rule m_qcThresholdRule;
+
+    QCThresholdReference::Type m_qcThresholdReference;
+
+    QCThreshold::Metric m_qcThresholdMetric;
+
     int m_nbrSelectedSubjects;
 
     bool m_isMatlabExeFound;
@@ -382,7 +430,7 @@ private:
 
     QString GetInputFileInformation( int diffusionPropertyID ) const; // Tested
 
-    void AddAtlas( const QList< QStringList >& fileData ); /// Not tested*
+    void AddAtlas( const DiffusionProfileMatrix::ConstPointer& faData ); /// Not tested*
 
     void DisplayFileInformation(); // Tested
 
@@ -390,10 +438,25 @@ private:
 
     void SetProfileCropping();
 
+    /** Ragged rows of the validation report, as displayed in the error message **/
+    QString GetRaggedRowsText( const CSVData& fileData ); // Not Directly Tested
+
     void UpdateInputFileInformation( int diffusionPropertyID ); // Tested
 
     void UpdateLineEditsAfterAddingMultipleFiles( const QStringList& fileList ); // Tested
 
+    /** Information, subject column ID and subject lists, once the input file is set **/
+    void UpdateInputTab( int diffusionPropertyID ); // Tested
+
+    /** Run in a worker thread: only the thread-safe DatasetCache is used **/
+    static LoadedInputFile LoadInputFile( QString filePath, bool isSubMatrix ); // Not Directly Tested
+
+    /** Busy bar shown in place of the icon while the file is parsed **/
+    void DisplayInputFileLoading( int diffusionPropertyID, bool isLoading ); // Tested
+
+    /** Blocks until the files being parsed are registered, for the steps that need all the inputs **/
+    void WaitForInputFiles(); // Tested
+
 
     void SetCheckStateAllCovariates( Qt::CheckState checkState );  // Tested
 
@@ -420,11 +483,16 @@ private:
 
     void DisplaySortedSubjects( const QStringList& matchedSubjectList, const QMap< QString, QList< int > >& unMatchedSubjectMap ); // Tested
 
+    /** Only the rows of the subjects changed are added, removed or updated **/
+    void UpdateSortedSubjects( const QSet< int >& changedSubjectIDs ); // Tested
+
     void UpdateSubjectList(); // Tested
 
+    QString GetUnmatchedSubjectText( const QString& subject, const QList< int >& sourceIndices ); // Not Directly Tested
+
     void SetCheckStateAllVisibleSubjects( Qt::CheckState checkState ); // Tested
 
-    int SearchSubjects( QListWidget *list ); // Tested
+    int SearchSubjects( SubjectFilterProxyModel *proxyModel ); // Tested
 
     void UseSavedSubjectList( QString filePath ); /// Not tested*
 
@@ -433,7 +501,7 @@ private:
 
     QStringList GetCheckedMatchedSubjects(); // Tested
 
-    QMap< QString, QList< QStringList > > GetPropertyRawData(); // Tested
+    QMap< QString, DiffusionProfileMatrix::ConstPointer > GetPropertyRawData(); // Tested
 
 
     /************** Execution Tab **************/
@@ -1,4 +1,6 @@
 #include "FADTTS_noGUI.h"
+#include "DatasetCache.h"
+#include "CompressedFile.h"
 
 //#include <QDebug>
 
@@ -27,15 +29,16 @@ int FADTTS_noGUI::RunFADTTSter_noGUI( const QJsonObject& jsonObject_noGUI )
     QJsonObject inputFiles = jsonObject_noGUI.value( "inputFiles" ).toObject();
     GetInputFiles( inputFiles );
 
+    /** Settings first: they tell how the input files are read **/
+    QJsonObject settings = jsonObject_noGUI.value( "settings" ).toObject();
+    GetSettings( settings );
+
     QJsonObject covariates = jsonObject_noGUI.value( "covariates" ).toObject();
     GetCovariates( covariates );
 
     QJsonObject subjects = jsonObject_noGUI.value( "subjects" ).toObject();
     GetSubjects( subjects );
 
-    QJsonObject settings = jsonObject_noGUI.value( "settings" ).toObject();
-    GetSettings( settings );
-
     QJsonObject matlabSpecifications = jsonObject_noGUI.value( "matlabSpecifications" ).toObject();
     GetMatlabSpecifications( matlabSpecifications );
 
@@ -47,6 +50,11 @@ int FADTTS_noGUI::RunFADTTSter_noGUI( const QJsonObject& jsonObject_noGUI )
 
         SetMatlabScript( profile );
 
+        DatasetCache& datasetCache = DatasetCache::GetInstance();
+        std::cout << "Input files: " << datasetCache.GetNbrMisses() - datasetCache.GetNbrSidecarLoads() << " parsed, "
+                  << datasetCache.GetNbrSidecarLoads() << " loaded from binary sidecar, "
+                  << datasetCache.GetNbrHits() << " reused from cache" << std::endl << std::endl;
+
         m_matlabThread->start();
         while( m_matlabThread->isRunning() )
         {
@@ -112,6 +120,7 @@ void FADTTS_noGUI::InitFADTTS_noGUI()
     m_failedQCThresholdSubjects.clear();
     m_nbrSelectedSubjects = -1;
     m_qcThreshold = -1;
+    m_faData = DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix() );
 
     /*** Settings ***/
     m_fibername.clear();
@@ -120,6 +129,8 @@ void FADTTS_noGUI::InitFADTTS_noGUI()
     m_pvalueThreshold = -1;
     m_omnibus = false;
     m_posthoc = false;
+    m_nbrParsingThreads = 0;
+    m_isStreamingIngest = false;
 
     /*** Output ***/
     m_outputDir.clear();
@@ -137,7 +148,11 @@ void FADTTS_noGUI::GetInputFiles( const QJsonObject& inputFiles )
     {
         QJsonObject currentPropertyObject = inputFiles.value( key ).toObject();
         QString currentPath = currentPropertyObject.value( "path" ).toString();
-        if( !currentPath.isEmpty() && QFile( currentPath ).exists() )
+        if( !currentPath.isEmpty() && !CompressedFile::IsFormatSupported( CompressedFile::GetFormat( currentPath ) ) )
+        {
+            std::cout << "/!\\ WARNING /!\\ " << currentPath.toStdString() << " not read: FADTTSter was built without zstd (USE_ZSTD)" << std::endl << std::endl;
+        }
+        else if( !currentPath.isEmpty() && QFile( currentPath ).exists() )
         {
             int currentIndex = currentPropertyObject.value( "index" ).toInt();
 
@@ -154,11 +169,11 @@ void FADTTS_noGUI::GetInputFiles( const QJsonObject& inputFiles )
 
 void FADTTS_noGUI::GetCovariates( const QJsonObject& covariates )
 {
-    QList< QStringList > subMatrixFile = m_processing.GetDataFromFile( m_inputs.value( SubMatrix ) );
+    CSVData subMatrixFile = m_processing.GetNumericDataFromFile( m_inputs.value( SubMatrix ) );
     QStringList expectedCovariates;
-    if( !subMatrixFile.isEmpty() )
+    if( !subMatrixFile.IsEmpty() )
     {
-        expectedCovariates = subMatrixFile.first();
+        expectedCovariates = subMatrixFile.GetHeader();
         expectedCovariates.removeAt( m_subjectColumnID );
         expectedCovariates.append( "Intercept" );
         expectedCovariates.sort();
@@ -169,7 +184,7 @@ void FADTTS_noGUI::GetCovariates( const QJsonObject& covariates )
     if( expectedCovariates != covariatesFound )
     {
         std::cout << "/!\\ Covariates provided mismatched the ones found in the submatrix file provided." << std::endl;
-        if( subMatrixFile.isEmpty() )
+        if( subMatrixFile.IsEmpty() )
         {
             std::cout << "     --> no data extracted from subMatrix file" << std::endl;
         }
@@ -205,20 +220,37 @@ QMap< int, QStringList > FADTTS_noGUI::GetInputSubjects()
     QMap< int, QString >::ConstIterator iterInput = m_inputs.cbegin();
     while( iterInput != m_inputs.cend() )
     {
-        QList< QStringList > fileData = m_processing.GetDataFromFile( iterInput.value() );
-        subjectMap.insert( iterInput.key(), m_processing.GetSubjectsFromData( fileData, m_subjectColumnID ) );
+        if( m_isStreamingIngest && iterInput.key() != SubMatrix )
+        {
+            subjectMap.insert( iterInput.key(), m_processing.GetSubjectsFromProfileFile( iterInput.value() ) );
+        }
+        else
+        {
+            CSVData fileData = m_processing.GetNumericDataFromFile( iterInput.value() );
+            subjectMap.insert( iterInput.key(), m_processing.GetSubjectsFromData( fileData, m_subjectColumnID ) );
+        }
         ++iterInput;
     }
 
     return subjectMap;
 }
 
+DiffusionProfileMatrix::ConstPointer FADTTS_noGUI::GetPropertyData( int diffusionProperty, const QStringList& subjects )
+{
+    if( m_isStreamingIngest )
+    {
+        /** Only the profiles of the subjects are kept **/
+        return m_processing.GetSelectedProfileDataFromFile( m_inputs.value( diffusionProperty ), subjects );
+    }
+
+    return m_processing.GetProfileDataFromFile( m_inputs.value( diffusionProperty ) );
+}
+
 void FADTTS_noGUI::NANSubjects( QStringList allSubjects )
 {
-    QList< QStringList > faData = m_processing.GetDataFromFile( m_inputs.value( FA ) );
-    if( !faData.isEmpty() )
+    if( !m_faData->IsEmpty() )
     {
-        QStringList nanSubjects = m_processing.GetNANSubjects( faData, allSubjects );
+        QStringList nanSubjects = m_processing.GetNANSubjects( *m_faData, allSubjects );
         if( !nanSubjects.isEmpty() )
         {
             std::cout << "/!\\ WARNING /!\\ subject(s) with -nan and/or nan values (FA file):" << std::endl;
@@ -235,27 +267,90 @@ void FADTTS_noGUI::SetQCThreshold( const QJsonObject& qcThresholdObject )
 {
     if( qcThresholdObject.value( "apply" ).toBool() )
     {
-        double qcThreshold = qcThresholdObject.value( "value" ).toDouble();
-        QList< QStringList > rawData = m_processing.GetDataFromFile( m_inputs.value( m_properties.key( "FA" ) ) );
+        QCThreshold qcThreshold;
+        QCThreshold::Rule rule = QCThreshold::AnyFail;
+        if( qcThresholdObject.contains( "rule" ) && !QCThreshold::GetRule( qcThresholdObject.value( "rule" ).toString(), rule ) )
+        {
+            std::cout << "/!\\ WARNING /!\\ unknown qc threshold rule, must be anyFail or allFail --> anyFail used" << std::endl << std::endl;
+        }
+        qcThreshold.SetRule( rule );
 
-        if( ( qcThreshold >= 0 ) && ( qcThreshold <= 1 ) && !rawData.isEmpty() )
+        /** Reference of the properties not using their atlas **/
+        QCThresholdReference reference;
+        QCThresholdReference::Type referenceType = QCThresholdReference::Mean;
+        if( qcThresholdObject.contains( "reference" ) && !QCThresholdReference::GetType( qcThresholdObject.value( "reference" ).toString(), referenceType ) )
         {
-            bool useAtlas = qcThresholdObject.value( "useAtlas" ).toBool();
-            m_qcThreshold = qcThreshold;
-            m_processing.ApplyQCThreshold_noGUI( rawData, useAtlas, m_subjects, m_failedQCThresholdSubjects, m_qcThreshold );
+            std::cout << "/!\\ WARNING /!\\ unknown qc threshold reference, must be mean, median, trimmedMean or reweighted --> mean used" << std::endl << std::endl;
         }
-        else
+        reference.SetType( referenceType );
+        reference.SetTrimmedProportion( qcThresholdObject.value( "trimmedProportion" ).toDouble( reference.GetTrimmedProportion() ) );
+        qcThreshold.SetReference( reference );
+
+        /** Score compared to the thresholds **/
+        QCThreshold::Metric metric = QCThreshold::Correlation;
+        if( qcThresholdObject.contains( "metric" ) && !QCThreshold::GetMetric( qcThresholdObject.value( "metric" ).toString(), metric ) )
+        {
+            std::cout << "/!\\ WARNING /!\\ unknown qc threshold metric, must be correlation or fpca --> correlation used" << std::endl << std::endl;
+        }
+        qcThreshold.SetMetric( metric );
+        FunctionalPCA functionalPCA;
+        functionalPCA.SetNbrComponents( qcThresholdObject.value( "nbrComponents" ).toInt( functionalPCA.GetNbrComponents() ) );
+        qcThreshold.SetFunctionalPCA( functionalPCA );
+
+        /** Outlier scores compared to "fpcaValue", the correlations to "value": the property's own if given, the one of the qc threshold otherwise **/
+        double fpcaQCThreshold = qcThresholdObject.value( "fpcaValue" ).toDouble( QCThreshold::GetDefaultFPCAQCThreshold() );
+
+        /** FA settable with "value" and "useAtlas", as before the other properties could be checked:
+         *  only for a configuration without "properties", or giving "value". Otherwise FA is checked only if listed in "properties". **/
+        QJsonObject propertiesObject = qcThresholdObject.value( "properties" ).toObject();
+        bool isFAFallback = !qcThresholdObject.contains( "properties" ) || qcThresholdObject.contains( "value" );
+        if( !propertiesObject.contains( "FA" ) && isFAFallback )
         {
-            std::cout << "... QC threshold not applied" << std::endl;
-            if( !( ( qcThreshold >= 0 ) && ( qcThreshold <= 1 ) ) )
+            QJsonObject faObject;
+            faObject.insert( "value", qcThresholdObject.value( "value" ) );
+            faObject.insert( "useAtlas", qcThresholdObject.value( "useAtlas" ) );
+            propertiesObject.insert( "FA", faObject );
+        }
+
+        for( int diffusionProperty = AD; diffusionProperty <= FA; diffusionProperty++ )
+        {
+            QString property = diffusionProperty == FA ? "FA" : m_properties.value( diffusionProperty );
+            QJsonObject propertyObject = propertiesObject.value( property ).toObject();
+            if( property.isEmpty() || !propertiesObject.contains( property ) || !propertyObject.value( "apply" ).toBool( true ) )
             {
-                std::cout << "    - qc threshold provided must be 0 <= .. <= 1" << std::endl;
+                continue;
             }
-            if( rawData.isEmpty() )
+
+            double propertyQCThreshold = propertyObject.value( "value" ).toDouble( -1 );
+            double propertyFPCAQCThreshold = propertyObject.value( "fpcaValue" ).toDouble( fpcaQCThreshold );
+            double metricQCThreshold = metric == QCThreshold::FPCA ? propertyFPCAQCThreshold : propertyQCThreshold;
+            DiffusionProfileMatrix::ConstPointer rawData = diffusionProperty == FA ? m_faData : GetPropertyData( diffusionProperty, m_subjects );
+            if( ( metricQCThreshold >= 0 ) && ( metricQCThreshold <= 1 ) && !rawData->IsEmpty() )
             {
-                std::cout << "    - no file found to base qt threshold on" << std::endl;
+                qcThreshold.AddProperty( property, rawData, propertyQCThreshold, propertyFPCAQCThreshold, propertyObject.value( "useAtlas" ).toBool() );
+            }
+            else
+            {
+                std::cout << "... QC threshold not applied on " << property.toStdString() << std::endl;
+                if( !( ( metricQCThreshold >= 0 ) && ( metricQCThreshold <= 1 ) ) )
+                {
+                    std::cout << "    - qc threshold provided " << ( metric == QCThreshold::FPCA ? "(fpcaValue) " : "(value) " ) << "must be 0 <= .. <= 1" << std::endl;
+                }
+                if( rawData->IsEmpty() )
+                {
+                    std::cout << "    - no file found to base qt threshold on" << std::endl;
+                }
+                std::cout << std::endl;
             }
-            std::cout << std::endl;
+        }
+
+        if( !qcThreshold.GetProperties().isEmpty() )
+        {
+            /** Properties correlated concurrently **/
+            qcThreshold.Apply( m_subjects );
+            m_subjects = qcThreshold.GetSubjectsCorrelated();
+            m_failedQCThresholdSubjects = qcThreshold.GetSubjectsNotCorrelated();
+            m_qcThreshold = qcThreshold.GetProperties().contains( "FA" ) ? qcThreshold.GetQCThreshold( "FA" ) : qcThreshold.GetQCThreshold( qcThreshold.GetProperties().first() );
         }
     }
 }
@@ -275,12 +370,11 @@ void FADTTS_noGUI::GetSubjects( const QJsonObject& subjects )
     }
 
     QStringList allSubjectsList = m_processing.GetAllSubjects( allSubjects );
-    QMap< QString, QMap< int, bool > > sortedSubjects = m_processing.SortSubjects( allSubjectsList, allSubjects );
-
     QStringList matchedSubjects;
     QMap< QString, QList< int > > unMatchedSubjects;
-    m_processing.AssignSortedSubject( sortedSubjects, matchedSubjects, unMatchedSubjects );
+    m_processing.MatchSubjects( allSubjectsList, allSubjects, matchedSubjects, unMatchedSubjects );
     m_subjects = matchedSubjects;
+    m_faData = GetPropertyData( FA, matchedSubjects );
 
     NANSubjects( matchedSubjects );
 
@@ -297,6 +391,11 @@ void FADTTS_noGUI::GetSettings( const QJsonObject& settings )
     m_pvalueThreshold = settings.value( "pvalueThreshold" ).toDouble();
     m_omnibus = settings.value( "omnibus" ).toBool();
     m_posthoc = settings.value( "posthoc" ).toBool();
+    m_nbrParsingThreads = settings.value( "nbrParsingThreads" ).toInt();
+    m_isStreamingIngest = settings.value( "streamingIngest" ).toBool();
+
+    DatasetCache::GetInstance().SetNbrThreads( m_nbrParsingThreads );
+    m_processing.SetStreamingIngest( m_isStreamingIngest );
 }
 
 void FADTTS_noGUI::GetMatlabSpecifications( const QJsonObject& matlabSpecifications )
@@ -447,11 +546,9 @@ void FADTTS_noGUI::SetMatlabScript( const QJsonObject& profile )
 
     int startProfile = -1;
     int endProfile = -1;
-    QList< QStringList > faData = m_processing.GetDataFromFile( m_inputs.value( FA ) );
-    if( !faData.isEmpty() )
+    if( !m_faData->IsEmpty() )
     {
-        QStringList arcLength = m_processing.Transpose( faData ).first();
-        arcLength.removeFirst();
+        QStringList arcLength = m_faData->GetArcLengthLabels();
 
         if( !arcLength.isEmpty() )
         {
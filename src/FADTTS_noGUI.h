@@ -2,6 +2,7 @@
 #define FADTTS_noGUI_H
 
 #include "Processing.h"
+#include "QCThreshold.h"
 #include "MatlabThread.h"
 #include "Log.h"
 
@@ -54,6 +55,9 @@ QString m_subjectFile;
 double m_qcThreshold;
 int m_nbrSelectedSubjects;
 
+/** FA profiles used for the nan check, the QC threshold and the arc lengths **/
+DiffusionProfileMatrix::ConstPointer m_faData;
+
 /*** Settings ***/
 QString m_fibername;
 int m_nbrPermutations;
@@ -61,6 +65,8 @@ double m_confidenceBandThreshold;
 double m_pvalueThreshold;
 bool m_omnibus;
 bool m_posthoc;
+int m_nbrParsingThreads;
+bool m_isStreamingIngest;
 
 /*** Output ***/
 QString m_outputDir;
@@ -80,6 +86,8 @@ void GetCovariates( const QJsonObject& covariates );
 
 QMap< int, QStringList > GetInputSubjects();
 
+DiffusionProfileMatrix::ConstPointer GetPropertyData( int diffusionProperty, const QStringList& subjects );
+
 void NANSubjects( QStringList allSubjects );
 
 void SetQCThreshold( const QJsonObject& qcThresholdObject );
@@ -0,0 +1,519 @@
+#include "FunctionalPCA.h"
+
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+//#include <QDebug>
+
+
+const int FunctionalPCA::m_nbrOversamplingComponents = 5;
+const int FunctionalPCA::m_nbrSubspaceIterations = 2;
+const unsigned int FunctionalPCA::m_seed = 12345;
+const int FunctionalPCA::m_minNbrValuesPerThread = 256 * 1024;
+
+FunctionalPCA::FunctionalPCA()
+{
+    m_nbrComponents = 3;
+    m_nbrThreads = 0;
+}
+
+
+void FunctionalPCA::SetNbrComponents( int nbrComponents )
+{
+    m_nbrComponents = qMax( nbrComponents, 1 );
+}
+
+int FunctionalPCA::GetNbrComponents() const
+{
+    return m_nbrComponents;
+}
+
+void FunctionalPCA::SetNbrThreads( int nbrThreads )
+{
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+
+QVector< double > FunctionalPCA::Score( const QList< VectorView >& profiles, int first, int last ) const
+{
+    QVector< double > scores( profiles.size(), std::numeric_limits< double >::quiet_NaN() );
+    first = qMax( first, 0 );
+    foreach( const VectorView& profile, profiles )
+    {
+        last = qMin( last, profile.Size() - 1 );
+    }
+    int nbrPoints = last - first + 1;
+    if( profiles.isEmpty() || nbrPoints < 1 )
+    {
+        return scores;
+    }
+
+    /*** Profiles without nan copied row by row, then centered ***/
+    QVector< int > profileIndexes;
+    QVector< double > centeredProfiles;
+    centeredProfiles.reserve( profiles.size() * nbrPoints );
+    for( int i = 0; i < profiles.size(); i++ )
+    {
+        const VectorView& profile = profiles.at( i );
+        bool hasNAN = false;
+        for( int point = 0; point < nbrPoints && !hasNAN; point++ )
+        {
+            hasNAN = std::isnan( profile.At( first + point ) );
+        }
+        if( !hasNAN )
+        {
+            profileIndexes.append( i );
+            for( int point = 0; point < nbrPoints; point++ )
+            {
+                centeredProfiles.append( profile.At( first + point ) );
+            }
+        }
+    }
+
+    /** Less than 2 profiles: none of them is an outlier **/
+    int nbrProfiles = profileIndexes.size();
+    int nbrComponents = qMin( m_nbrComponents, qMin( nbrPoints, nbrProfiles - 1 ) );
+    if( nbrComponents < 1 )
+    {
+        foreach( int i, profileIndexes )
+        {
+            scores[ i ] = 1.0;
+        }
+        return scores;
+    }
+
+    QVector< double > means( nbrPoints, 0.0 );
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        const double *profile = centeredProfiles.constData() + row * nbrPoints;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            means[ point ] += profile[ point ];
+        }
+    }
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        means[ point ] /= nbrProfiles;
+    }
+    QVector< double > sumSquares( nbrProfiles, 0.0 );
+    double totalSumSquares = 0;
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        double *profile = centeredProfiles.data() + row * nbrPoints;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile[ point ] -= means.at( point );
+            sumSquares[ row ] += profile[ point ] * profile[ point ];
+        }
+        totalSumSquares += sumSquares.at( row );
+    }
+
+    /*** Randomized truncated SVD: random basis of the arc lengths refined by subspace iterations ***/
+    int nbrColumns = qMin( nbrComponents + m_nbrOversamplingComponents, qMin( nbrPoints, nbrProfiles ) );
+    QVector< double > basis( nbrPoints * nbrColumns );
+    quint32 state = m_seed;
+    for( int i = 0; i < basis.size(); i++ )
+    {
+        state = state * 1664525u + 1013904223u;
+        basis[ i ] = 2.0 * state / 4294967296.0 - 1.0;
+    }
+    Orthonormalize( basis.data(), nbrPoints, nbrColumns );
+
+    QVector< double > projections( nbrProfiles * nbrColumns );
+    Product product;
+    product.profiles = centeredProfiles.constData();
+    product.nbrPoints = nbrPoints;
+    product.nbrColumns = nbrColumns;
+    for( int iteration = 0; iteration <= m_nbrSubspaceIterations; iteration++ )
+    {
+        product.matrix = basis.constData();
+        Multiply( product, nbrProfiles, projections.data() );
+        product.matrix = projections.constData();
+        MultiplyTransposed( product, nbrProfiles, basis.data() );
+        Orthonormalize( basis.data(), nbrPoints, nbrColumns );
+    }
+    product.matrix = basis.constData();
+    Multiply( product, nbrProfiles, projections.data() );
+
+    /** Components within the basis: eigenvectors of the Gram matrix of the projections **/
+    QVector< double > gram( nbrColumns * nbrColumns, 0.0 );
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        const double *projection = projections.constData() + row * nbrColumns;
+        for( int i = 0; i < nbrColumns; i++ )
+        {
+            for( int j = i; j < nbrColumns; j++ )
+            {
+                gram[ i * nbrColumns + j ] += projection[ i ] * projection[ j ];
+            }
+        }
+    }
+    for( int i = 0; i < nbrColumns; i++ )
+    {
+        for( int j = 0; j < i; j++ )
+        {
+            gram[ i * nbrColumns + j ] = gram.at( j * nbrColumns + i );
+        }
+    }
+    QVector< double > eigenvalues( nbrColumns );
+    QVector< double > eigenvectors( nbrColumns * nbrColumns );
+    GetEigenvectors( gram.data(), nbrColumns, eigenvalues.data(), eigenvectors.data() );
+
+    /** Components with no variance left out of the Mahalanobis distance **/
+    QVector< double > variances;
+    for( int component = 0; component < nbrComponents; component++ )
+    {
+        if( eigenvalues.at( component ) > 1e-12 * totalSumSquares )
+        {
+            variances.append( eigenvalues.at( component ) / ( nbrProfiles - 1 ) );
+        }
+    }
+
+    /*** Mahalanobis distance of the component scores, residual of the reconstruction ***/
+    QVector< double > squaredDistances( nbrProfiles, 0.0 );
+    QVector< double > residuals( nbrProfiles );
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        const double *projection = projections.constData() + row * nbrColumns;
+        double sumComponentSquares = 0;
+        for( int component = 0; component < variances.size(); component++ )
+        {
+            double componentScore = 0;
+            for( int i = 0; i < nbrColumns; i++ )
+            {
+                componentScore += projection[ i ] * eigenvectors.at( i * nbrColumns + component );
+            }
+            squaredDistances[ row ] += componentScore * componentScore / variances.at( component );
+            sumComponentSquares += componentScore * componentScore;
+        }
+        /** Cube root of the squared residual: close to normally distributed (Wilson-Hilferty) **/
+        residuals[ row ] = std::pow( qMax( sumSquares.at( row ) - sumComponentSquares, 0.0 ), 1.0 / 3 );
+    }
+
+    /** Squared Mahalanobis distance: chi-square with as many degrees of freedom as components (Wilson-Hilferty) **/
+    int nbrDegrees = variances.size();
+    double distanceMean = 1 - 2.0 / ( 9 * qMax( nbrDegrees, 1 ) );
+    double distanceScale = std::sqrt( 2.0 / ( 9 * qMax( nbrDegrees, 1 ) ) );
+
+    /** Residuals standardized with their median and median absolute deviation: the outliers do not hide themselves **/
+    double residualMedian = GetMedian( residuals );
+    QVector< double > deviations( nbrProfiles );
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        deviations[ row ] = std::abs( residuals.at( row ) - residualMedian );
+    }
+    double residualScale = 1.4826 * GetMedian( deviations );
+    bool isResidualChecked = residualScale > 1e-8 * std::pow( totalSumSquares / nbrProfiles, 1.0 / 3 );
+
+    for( int row = 0; row < nbrProfiles; row++ )
+    {
+        double distanceTail = nbrDegrees == 0 ? 1.0 :
+                GetUpperTail( ( std::pow( squaredDistances.at( row ) / nbrDegrees, 1.0 / 3 ) - distanceMean ) / distanceScale );
+        double residualTail = !isResidualChecked ? 1.0 : GetUpperTail( ( residuals.at( row ) - residualMedian ) / residualScale );
+        scores[ profileIndexes.at( row ) ] = qMin( distanceTail, residualTail );
+    }
+
+    return scores;
+}
+
+QVector< double > FunctionalPCA::Score( const QList< QList< double > >& profiles, int first, int last ) const
+{
+    if( profiles.isEmpty() )
+    {
+        return QVector< double >();
+    }
+
+    /** Window copied one profile after the other so every profile is contiguous **/
+    first = qMax( first, 0 );
+    last = qMin( last, profiles.first().size() - 1 );
+    int nbrPoints = qMax( last - first + 1, 0 );
+    QVector< double > values( profiles.size() * nbrPoints );
+    QList< VectorView > profileViews;
+    for( int i = 0; i < profiles.size(); i++ )
+    {
+        double *profile = values.data() + i * nbrPoints;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile[ point ] = profiles.at( i ).at( first + point );
+        }
+        profileViews.append( VectorView( profile, nbrPoints, 1 ) );
+    }
+
+    return Score( profileViews, 0, nbrPoints - 1 );
+}
+
+
+void FunctionalPCA::Multiply( const Product& product, int nbrProfiles, double *result ) const
+{
+    /** Chunks of profiles, the last one multiplied by the calling thread **/
+    int nbrChunks = GetNbrChunks( nbrProfiles, product.nbrPoints );
+    int nbrProfilesPerChunk = ( nbrProfiles + nbrChunks - 1 ) / nbrChunks;
+    QList< QFuture< void > > futures;
+    for( int first = 0; first < nbrProfiles; first += nbrProfilesPerChunk )
+    {
+        int last = qMin( first + nbrProfilesPerChunk, nbrProfiles );
+        if( last < nbrProfiles )
+        {
+            futures.append( QtConcurrent::run( this, &FunctionalPCA::MultiplyProfiles, &product, first, last, result ) );
+        }
+        else
+        {
+            MultiplyProfiles( &product, first, last, result );
+        }
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+}
+
+void FunctionalPCA::MultiplyTransposed( const Product& product, int nbrProfiles, double *result ) const
+{
+    /** Each chunk of profiles adds up its own products, summed once every chunk is done **/
+    int nbrChunks = GetNbrChunks( nbrProfiles, product.nbrPoints );
+    int nbrProfilesPerChunk = ( nbrProfiles + nbrChunks - 1 ) / nbrChunks;
+    int resultSize = product.nbrPoints * product.nbrColumns;
+    QVector< double > chunkResults( nbrChunks * resultSize, 0.0 );
+    QList< QFuture< void > > futures;
+    int chunk = 0;
+    for( int first = 0; first < nbrProfiles; first += nbrProfilesPerChunk )
+    {
+        int last = qMin( first + nbrProfilesPerChunk, nbrProfiles );
+        double *chunkResult = chunkResults.data() + chunk * resultSize;
+        if( last < nbrProfiles )
+        {
+            futures.append( QtConcurrent::run( this, &FunctionalPCA::MultiplyTransposedProfiles, &product, first, last, chunkResult ) );
+        }
+        else
+        {
+            MultiplyTransposedProfiles( &product, first, last, chunkResult );
+        }
+        chunk++;
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+
+    for( int i = 0; i < resultSize; i++ )
+    {
+        result[ i ] = 0;
+        for( int j = 0; j < chunk; j++ )
+        {
+            result[ i ] += chunkResults.at( j * resultSize + i );
+        }
+    }
+}
+
+void FunctionalPCA::MultiplyProfiles( const Product *product, int first, int last, double *result ) const
+{
+    int nbrPoints = product->nbrPoints;
+    int nbrColumns = product->nbrColumns;
+    for( int row = first; row < last; row++ )
+    {
+        const double *profile = product->profiles + row * nbrPoints;
+        double *resultRow = result + row * nbrColumns;
+        for( int column = 0; column < nbrColumns; column++ )
+        {
+            resultRow[ column ] = 0;
+        }
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            const double *matrixRow = product->matrix + point * nbrColumns;
+            double value = profile[ point ];
+            for( int column = 0; column < nbrColumns; column++ )
+            {
+                resultRow[ column ] += value * matrixRow[ column ];
+            }
+        }
+    }
+}
+
+void FunctionalPCA::MultiplyTransposedProfiles( const Product *product, int first, int last, double *result ) const
+{
+    int nbrPoints = product->nbrPoints;
+    int nbrColumns = product->nbrColumns;
+    for( int row = first; row < last; row++ )
+    {
+        const double *profile = product->profiles + row * nbrPoints;
+        const double *matrixRow = product->matrix + row * nbrColumns;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            double *resultRow = result + point * nbrColumns;
+            double value = profile[ point ];
+            for( int column = 0; column < nbrColumns; column++ )
+            {
+                resultRow[ column ] += value * matrixRow[ column ];
+            }
+        }
+    }
+}
+
+int FunctionalPCA::GetNbrChunks( int nbrProfiles, int nbrPoints ) const
+{
+    int nbrThreads = m_nbrThreads > 0 ? m_nbrThreads : QThread::idealThreadCount();
+    qint64 nbrValues = qint64( nbrProfiles ) * nbrPoints;
+
+    return static_cast< int >( qBound( qint64( 1 ), nbrValues / m_minNbrValuesPerThread, qint64( qMax( nbrThreads, 1 ) ) ) );
+}
+
+void FunctionalPCA::Orthonormalize( double *matrix, int nbrRows, int nbrColumns )
+{
+    /** Modified Gram-Schmidt, run twice so the columns stay orthogonal to the rounding errors **/
+    for( int column = 0; column < nbrColumns; column++ )
+    {
+        double initialNorm = 0;
+        for( int row = 0; row < nbrRows; row++ )
+        {
+            initialNorm += matrix[ row * nbrColumns + column ] * matrix[ row * nbrColumns + column ];
+        }
+        initialNorm = std::sqrt( initialNorm );
+
+        for( int pass = 0; pass < 2; pass++ )
+        {
+            for( int previousColumn = 0; previousColumn < column; previousColumn++ )
+            {
+                double dotProduct = 0;
+                for( int row = 0; row < nbrRows; row++ )
+                {
+                    dotProduct += matrix[ row * nbrColumns + column ] * matrix[ row * nbrColumns + previousColumn ];
+                }
+                for( int row = 0; row < nbrRows; row++ )
+                {
+                    matrix[ row * nbrColumns + column ] -= dotProduct * matrix[ row * nbrColumns + previousColumn ];
+                }
+            }
+        }
+
+        double norm = 0;
+        for( int row = 0; row < nbrRows; row++ )
+        {
+            norm += matrix[ row * nbrColumns + column ] * matrix[ row * nbrColumns + column ];
+        }
+        norm = std::sqrt( norm );
+        double scale = norm > 1e-10 * initialNorm ? 1 / norm : 0;
+        for( int row = 0; row < nbrRows; row++ )
+        {
+            matrix[ row * nbrColumns + column ] *= scale;
+        }
+    }
+}
+
+void FunctionalPCA::GetEigenvectors( double *matrix, int size, double *eigenvalues, double *eigenvectors )
+{
+    /** Cyclic Jacobi rotations: the matrix is small, as many rows as columns in the random basis **/
+    QVector< double > rotations( size * size, 0.0 );
+    for( int i = 0; i < size; i++ )
+    {
+        rotations[ i * size + i ] = 1;
+    }
+
+    for( int sweep = 0; sweep < 100; sweep++ )
+    {
+        double offDiagonal = 0;
+        double diagonal = 0;
+        for( int p = 0; p < size; p++ )
+        {
+            diagonal += matrix[ p * size + p ] * matrix[ p * size + p ];
+            for( int q = p + 1; q < size; q++ )
+            {
+                offDiagonal += matrix[ p * size + q ] * matrix[ p * size + q ];
+            }
+        }
+        if( offDiagonal <= 1e-30 * diagonal )
+        {
+            break;
+        }
+
+        for( int p = 0; p < size; p++ )
+        {
+            for( int q = p + 1; q < size; q++ )
+            {
+                double apq = matrix[ p * size + q ];
+                if( apq == 0 )
+                {
+                    continue;
+                }
+                double theta = ( matrix[ q * size + q ] - matrix[ p * size + p ] ) / ( 2 * apq );
+                double t = ( theta >= 0 ? 1.0 : -1.0 ) / ( std::abs( theta ) + std::sqrt( theta * theta + 1 ) );
+                double c = 1 / std::sqrt( t * t + 1 );
+                double s = t * c;
+                for( int k = 0; k < size; k++ )
+                {
+                    double akp = matrix[ k * size + p ];
+                    double akq = matrix[ k * size + q ];
+                    matrix[ k * size + p ] = c * akp - s * akq;
+                    matrix[ k * size + q ] = s * akp + c * akq;
+                }
+                for( int k = 0; k < size; k++ )
+                {
+                    double apk = matrix[ p * size + k ];
+                    double aqk = matrix[ q * size + k ];
+                    matrix[ p * size + k ] = c * apk - s * aqk;
+                    matrix[ q * size + k ] = s * apk + c * aqk;
+                }
+                for( int k = 0; k < size; k++ )
+                {
+                    double vkp = rotations[ k * size + p ];
+                    double vkq = rotations[ k * size + q ];
+                    rotations[ k * size + p ] = c * vkp - s * vkq;
+                    rotations[ k * size + q ] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    /** Sorted by decreasing eigenvalue **/
+    QVector< int > order( size );
+    for( int i = 0; i < size; i++ )
+    {
+        order[ i ] = i;
+    }
+    for( int i = 0; i < size; i++ )
+    {
+        int largest = i;
+        for( int j = i + 1; j < size; j++ )
+        {
+            if( matrix[ order.at( j ) * size + order.at( j ) ] > matrix[ order.at( largest ) * size + order.at( largest ) ] )
+            {
+                largest = j;
+            }
+        }
+        std::swap( order[ i ], order[ largest ] );
+    }
+    for( int i = 0; i < size; i++ )
+    {
+        eigenvalues[ i ] = matrix[ order.at( i ) * size + order.at( i ) ];
+        for( int k = 0; k < size; k++ )
+        {
+            eigenvectors[ k * size + i ] = rotations.at( k * size + order.at( i ) );
+        }
+    }
+}
+
+double FunctionalPCA::GetUpperTail( double z )
+{
+    return 0.5 * std::erfc( z / std::sqrt( 2.0 ) );
+}
+
+double FunctionalPCA::GetMedian( QVector< double > values )
+{
+    if( values.isEmpty() )
+    {
+        return 0;
+    }
+
+    double *middle = values.data() + values.size() / 2;
+    std::nth_element( values.data(), middle, values.data() + values.size() );
+    if( values.size() % 2 == 1 )
+    {
+        return *middle;
+    }
+
+    return ( *std::max_element( values.data(), middle ) + *middle ) / 2;
+}
@@ -0,0 +1,90 @@
+#ifndef FUNCTIONALPCA_H
+#define FUNCTIONALPCA_H
+
+#include "MatrixView.h"
+
+#include <QVector>
+#include <QList>
+
+/** Outlier score of profiles from their functional principal component analysis, as a QC metric alternative to the correlation
+ *  with a reference: a profile with the right shape but the wrong scale, or with a local bump, is far from the other profiles
+ *  along the leading components, or badly reconstructed by them.
+ *  The leading components are found by a randomized truncated SVD: a random basis of the arc lengths refined by a few subspace
+ *  iterations, so the profiles are only read a few times whatever their number. Each profile then gets the Mahalanobis distance
+ *  of its scores on the leading components and the residual of its reconstruction, both turned into upper tail probabilities.
+ *  Its score is the lower of the two: between 0 and 1, low for an outlier, it is compared to a QC threshold as a correlation is. **/
+class FunctionalPCA
+{
+    friend class TestFunctionalPCA; /** For unit tests **/
+
+public:
+    FunctionalPCA();
+
+
+    /** Number of leading components, 3 by default **/
+    void SetNbrComponents( int nbrComponents ); // Tested
+
+    int GetNbrComponents() const; // Tested
+
+    /** 0: as many threads as cores. Only large sets of profiles are split between threads. **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+
+    /** Scores in the order of the profiles, over the window between the indexes first and last included.
+     *  A profile with a nan value is left out of the analysis and gets a nan score, which satisfies every threshold. **/
+    QVector< double > Score( const QList< VectorView >& profiles, int first, int last ) const; // Tested
+
+    QVector< double > Score( const QList< QList< double > >& profiles, int first, int last ) const; // Tested
+
+
+private:
+    /** Matrix multiplied by the centered profiles, split between threads by rows of profiles **/
+    struct Product
+    {
+        const double *profiles;
+        int nbrPoints;
+        const double *matrix;
+        int nbrColumns;
+    };
+
+    /** Columns of the random basis beyond the number of components, and number of subspace iterations **/
+    static const int m_nbrOversamplingComponents;
+    static const int m_nbrSubspaceIterations;
+
+    /** Same random basis for every call: the scores of a dataset do not change from one call to the next **/
+    static const unsigned int m_seed;
+
+    /** Number of values below which the profiles are not split between threads **/
+    static const int m_minNbrValuesPerThread;
+
+
+    int m_nbrComponents;
+
+    int m_nbrThreads;
+
+
+    /** profiles: nbrProfiles x product.nbrPoints row by row, times product.matrix (nbrPoints x nbrColumns) **/
+    void Multiply( const Product& product, int nbrProfiles, double *result ) const; // Not Directly Tested
+
+    /** Transposed profiles times product.matrix (nbrProfiles x nbrColumns) **/
+    void MultiplyTransposed( const Product& product, int nbrProfiles, double *result ) const; // Not Directly Tested
+
+    void MultiplyProfiles( const Product *product, int first, int last, double *result ) const; // Not Directly Tested
+
+    void MultiplyTransposedProfiles( const Product *product, int first, int last, double *result ) const; // Not Directly Tested
+
+    int GetNbrChunks( int nbrProfiles, int nbrPoints ) const; // Not Directly Tested
+
+    /** Columns of matrix (nbrRows x nbrColumns, row by row) made orthonormal, the dependent ones set to 0 **/
+    static void Orthonormalize( double *matrix, int nbrRows, int nbrColumns ); // Not Directly Tested
+
+    /** Eigenvalues of the symmetric matrix in decreasing order, eigenvectors in the matching columns. matrix is overwritten. **/
+    static void GetEigenvectors( double *matrix, int size, double *eigenvalues, double *eigenvectors ); // Not Directly Tested
+
+    /** Probability for a standard normal variable to be larger than z **/
+    static double GetUpperTail( double z ); // Not Directly Tested
+
+    static double GetMedian( QVector< double > values ); // Not Directly Tested
+};
+
+#endif // FUNCTIONALPCA_H
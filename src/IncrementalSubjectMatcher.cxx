@@ -0,0 +1,168 @@
+#include "IncrementalSubjectMatcher.h"
+
+//#include <QDebug>
+
+
+IncrementalSubjectMatcher::IncrementalSubjectMatcher()
+{
+}
+
+
+QSet< int > IncrementalSubjectMatcher::SetSource( int sourceIndex, const QStringList& subjects )
+{
+    /** Lists shared with the data are compared without comparing the names **/
+    QMap< int, QStringList >::ConstIterator iterSource = m_sourceSubjects.constFind( sourceIndex );
+    if( iterSource != m_sourceSubjects.constEnd() && iterSource.value() == subjects )
+    {
+        return QSet< int >();
+    }
+
+    QSet< int > previousMatchedIDs = m_matchedIDs;
+    QSet< int > changedIDs = m_sources.value( sourceIndex );
+    RemoveSubjects( sourceIndex );
+
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QSet< int > ids = registry.GetIDSet( subjects );
+    if( m_counts.size() < registry.GetNbrSubjects() )
+    {
+        m_counts.resize( registry.GetNbrSubjects() );
+    }
+    foreach( int id, ids )
+    {
+        m_counts[ id ]++;
+        m_subjectIDs.insert( id );
+    }
+    m_sourceSubjects.insert( sourceIndex, subjects );
+    m_sources.insert( sourceIndex, ids );
+
+    /** The sources of the subjects removed from or added to the source changed **/
+    changedIDs.unite( ids );
+    changedIDs.unite( UpdateMatchedSubjects( previousMatchedIDs ) );
+
+    return changedIDs;
+}
+
+QSet< int > IncrementalSubjectMatcher::RemoveSource( int sourceIndex )
+{
+    if( !m_sources.contains( sourceIndex ) )
+    {
+        return QSet< int >();
+    }
+
+    QSet< int > previousMatchedIDs = m_matchedIDs;
+    QSet< int > changedIDs = m_sources.value( sourceIndex );
+    RemoveSubjects( sourceIndex );
+    changedIDs.unite( UpdateMatchedSubjects( previousMatchedIDs ) );
+
+    return changedIDs;
+}
+
+QList< int > IncrementalSubjectMatcher::GetSourceIndices() const
+{
+    return m_sources.keys();
+}
+
+
+bool IncrementalSubjectMatcher::IsMatched( int subjectID ) const
+{
+    return m_matchedIDs.contains( subjectID );
+}
+
+QList< int > IncrementalSubjectMatcher::GetSubjectSources( int subjectID ) const
+{
+    QList< int > sourceIndices;
+    QMap< int, QSet< int > >::ConstIterator iterSource = m_sources.cbegin();
+    while( iterSource != m_sources.cend() )
+    {
+        if( iterSource.value().contains( subjectID ) )
+        {
+            sourceIndices.append( iterSource.key() );
+        }
+        ++iterSource;
+    }
+
+    return sourceIndices;
+}
+
+QStringList IncrementalSubjectMatcher::GetMatchedSubjects() const
+{
+    QStringList matchedSubjects = SubjectRegistry::GetInstance().GetNames( m_matchedIDs.toList().toVector() );
+    matchedSubjects.sort();
+
+    return matchedSubjects;
+}
+
+QMap< QString, QList< int > > IncrementalSubjectMatcher::GetUnMatchedSubjects() const
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QMap< QString, QList< int > > unMatchedSubjects;
+    foreach( int id, m_subjectIDs )
+    {
+        if( !m_matchedIDs.contains( id ) )
+        {
+            unMatchedSubjects.insert( registry.GetName( id ), GetSubjectSources( id ) );
+        }
+    }
+
+    return unMatchedSubjects;
+}
+
+
+void IncrementalSubjectMatcher::RemoveSubjects( int sourceIndex )
+{
+    QMap< int, QSet< int > >::Iterator iterSource = m_sources.find( sourceIndex );
+    if( iterSource == m_sources.end() )
+    {
+        return;
+    }
+
+    foreach( int id, iterSource.value() )
+    {
+        if( --m_counts[ id ] == 0 )
+        {
+            m_subjectIDs.remove( id );
+        }
+    }
+    m_sources.erase( iterSource );
+    m_sourceSubjects.remove( sourceIndex );
+}
+
+QSet< int > IncrementalSubjectMatcher::UpdateMatchedSubjects( const QSet< int >& previousMatchedIDs )
+{
+    /** A subject held by every source is held by the smallest one **/
+    QSet< int > matchedIDs;
+    QMap< int, QSet< int > >::ConstIterator smallestSource = m_sources.cend();
+    QMap< int, QSet< int > >::ConstIterator iterSource = m_sources.cbegin();
+    while( iterSource != m_sources.cend() )
+    {
+        if( smallestSource == m_sources.cend() || iterSource.value().size() < smallestSource.value().size() )
+        {
+            smallestSource = iterSource;
+        }
+        ++iterSource;
+    }
+    if( smallestSource != m_sources.cend() )
+    {
+        foreach( int id, smallestSource.value() )
+        {
+            if( m_counts.at( id ) == m_sources.size() )
+            {
+                matchedIDs.insert( id );
+            }
+        }
+    }
+    m_matchedIDs = matchedIDs;
+
+    /** Subjects matched before and not anymore, and the other way around **/
+    QSet< int > changedIDs = previousMatchedIDs;
+    changedIDs.subtract( matchedIDs );
+    foreach( int id, matchedIDs )
+    {
+        if( !previousMatchedIDs.contains( id ) )
+        {
+            changedIDs.insert( id );
+        }
+    }
+
+    return changedIDs;
+}
@@ -0,0 +1,68 @@
+#ifndef INCREMENTALSUBJECTMATCHER_H
+#define INCREMENTALSUBJECTMATCHER_H
+
+#include "SubjectRegistry.h"
+
+#include <QStringList>
+#include <QMap>
+#include <QSet>
+#include <QVector>
+
+/** Matches the subjects of the input files and of the loaded subject list, one source at a time.
+ *  Each subject keeps the number of sources holding it: adding, replacing or removing a source only updates
+ *  the subjects of this source and the subjects matched before, and tells which subjects changed
+ *  so that the subject lists can be updated row by row.
+ *  Subjects are found in every source (matched) or in some of them (unmatched), as with SubjectMatcher. **/
+class IncrementalSubjectMatcher
+{
+    friend class TestIncrementalSubjectMatcher; /** For unit tests **/
+
+public:
+    explicit IncrementalSubjectMatcher();
+
+
+    /** Source index: diffusion property index of the file, -1 for the loaded subject list.
+     *  Adds the source or replaces its subjects, returns the IDs of the subjects whose state or sources changed.
+     *  Nothing is done if the subjects of the source did not change. **/
+    QSet< int > SetSource( int sourceIndex, const QStringList& subjects ); // Tested
+
+    /** Returns the IDs of the subjects whose state or sources changed **/
+    QSet< int > RemoveSource( int sourceIndex ); // Tested
+
+    QList< int > GetSourceIndices() const; // Tested
+
+
+    /** True if the subject is found in every source **/
+    bool IsMatched( int subjectID ) const; // Tested
+
+    /** Indices of the sources holding the subject, in increasing order **/
+    QList< int > GetSubjectSources( int subjectID ) const; // Tested
+
+    /** Matched subjects in alphabetical order **/
+    QStringList GetMatchedSubjects() const; // Tested
+
+    /** Subjects found in some of the sources only, with the indices of the sources holding them **/
+    QMap< QString, QList< int > > GetUnMatchedSubjects() const; // Tested
+
+
+private:
+    /** Subjects of each source, as given and as IDs **/
+    QMap< int, QStringList > m_sourceSubjects;
+
+    QMap< int, QSet< int > > m_sources;
+
+    /** Number of sources holding each subject, indexed by ID **/
+    QVector< int > m_counts;
+
+    /** Subjects held by at least one source, and by every source **/
+    QSet< int > m_subjectIDs, m_matchedIDs;
+
+
+    /** Removes the source without updating the matched subjects **/
+    void RemoveSubjects( int sourceIndex ); // Not Directly Tested
+
+    /** Subjects of the smallest source held by every source, returns the subjects matched before or now but not both **/
+    QSet< int > UpdateMatchedSubjects( const QSet< int >& previousMatchedIDs ); // Not Directly Tested
+};
+
+#endif // INCREMENTALSUBJECTMATCHER_H
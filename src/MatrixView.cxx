@@ -0,0 +1,168 @@
+#include "MatrixView.h"
+
+//#include <QDebug>
+
+
+/*************** VectorView ***************/
+VectorView::VectorView()
+{
+    m_data = 0;
+    m_size = 0;
+    m_stride = 1;
+}
+
+VectorView::VectorView( const double *data, int size, int stride )
+{
+    m_data = data;
+    m_size = size;
+    m_stride = stride;
+}
+
+
+int VectorView::Size() const
+{
+    return m_size;
+}
+
+bool VectorView::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+double VectorView::At( int index ) const
+{
+    return m_data[ index * m_stride ];
+}
+
+double VectorView::operator[]( int index ) const
+{
+    return m_data[ index * m_stride ];
+}
+
+VectorView VectorView::Mid( int position ) const
+{
+    if( position < 0 || position >= m_size )
+    {
+        return VectorView();
+    }
+
+    return VectorView( m_data + position * m_stride, m_size - position, m_stride );
+}
+
+QList< double > VectorView::ToList() const
+{
+    QList< double > values;
+    values.reserve( m_size );
+    for( int i = 0; i < m_size; i++ )
+    {
+        values.append( m_data[ i * m_stride ] );
+    }
+
+    return values;
+}
+
+const double* VectorView::Data() const
+{
+    return m_data;
+}
+
+int VectorView::Stride() const
+{
+    return m_stride;
+}
+
+
+
+/*************** MatrixView ***************/
+MatrixView::MatrixView()
+{
+    m_data = 0;
+    m_nbrRows = 0;
+    m_nbrColumns = 0;
+    m_rowStride = 0;
+    m_columnStride = 1;
+}
+
+MatrixView::MatrixView( const double *data, int nbrRows, int nbrColumns, int rowStride, int columnStride )
+{
+    m_data = data;
+    m_nbrRows = nbrRows;
+    m_nbrColumns = nbrColumns;
+    m_rowStride = rowStride;
+    m_columnStride = columnStride;
+}
+
+
+MatrixView MatrixView::RowMajor( const double *data, int nbrRows, int nbrColumns )
+{
+    return MatrixView( data, nbrRows, nbrColumns, nbrColumns, 1 );
+}
+
+MatrixView MatrixView::ColumnMajor( const double *data, int nbrRows, int nbrColumns )
+{
+    return MatrixView( data, nbrRows, nbrColumns, 1, nbrRows );
+}
+
+
+int MatrixView::GetNbrRows() const
+{
+    return m_nbrRows;
+}
+
+int MatrixView::GetNbrColumns() const
+{
+    return m_nbrColumns;
+}
+
+bool MatrixView::IsEmpty() const
+{
+    return m_nbrRows == 0 || m_nbrColumns == 0;
+}
+
+bool MatrixView::IsRowMajor() const
+{
+    return m_columnStride == 1;
+}
+
+
+double MatrixView::At( int row, int column ) const
+{
+    return m_data[ row * m_rowStride + column * m_columnStride ];
+}
+
+VectorView MatrixView::GetRow( int row ) const
+{
+    if( row < 0 || row >= m_nbrRows )
+    {
+        return VectorView();
+    }
+
+    return VectorView( m_data + row * m_rowStride, m_nbrColumns, m_columnStride );
+}
+
+VectorView MatrixView::GetColumn( int column ) const
+{
+    if( column < 0 || column >= m_nbrColumns )
+    {
+        return VectorView();
+    }
+
+    return VectorView( m_data + column * m_columnStride, m_nbrRows, m_rowStride );
+}
+
+MatrixView MatrixView::Transposed() const
+{
+    return MatrixView( m_data, m_nbrColumns, m_nbrRows, m_columnStride, m_rowStride );
+}
+
+QList< QList< double > > MatrixView::ToList() const
+{
+    QList< QList< double > > values;
+    values.reserve( m_nbrRows );
+    for( int row = 0; row < m_nbrRows; row++ )
+    {
+        values.append( GetRow( row ).ToList() );
+    }
+
+    return values;
+}
@@ -0,0 +1,86 @@
+#ifndef MATRIXVIEW_H
+#define MATRIXVIEW_H
+
+#include <QList>
+
+/** Read-only access to a row or a column of a matrix, without copy **/
+class VectorView
+{
+public:
+    explicit VectorView();
+
+    explicit VectorView( const double *data, int size, int stride );
+
+
+    int Size() const; // Tested
+
+    bool IsEmpty() const; // Tested
+
+    double At( int index ) const; // Tested
+
+    double operator[]( int index ) const; // Tested
+
+    /** Values from position to the end **/
+    VectorView Mid( int position ) const; // Tested
+
+    QList< double > ToList() const; // Tested
+
+    /** First value and distance between two values, for the loops that need the raw values **/
+    const double* Data() const; // Not Directly Tested
+
+    int Stride() const; // Not Directly Tested
+
+
+private:
+    const double *m_data;
+
+    int m_size, m_stride;
+};
+
+
+/** Read-only access to a matrix of values stored contiguously, row by row or column by column.
+ *  Transposing a view only swaps its dimensions and strides: the values are never copied. **/
+class MatrixView
+{
+public:
+    explicit MatrixView();
+
+    static MatrixView RowMajor( const double *data, int nbrRows, int nbrColumns ); // Tested
+
+    static MatrixView ColumnMajor( const double *data, int nbrRows, int nbrColumns ); // Tested
+
+
+    int GetNbrRows() const; // Tested
+
+    int GetNbrColumns() const; // Tested
+
+    bool IsEmpty() const; // Tested
+
+    bool IsRowMajor() const; // Tested
+
+
+    double At( int row, int column ) const; // Tested
+
+    /** Empty view if out of range **/
+    VectorView GetRow( int row ) const; // Tested
+
+    VectorView GetColumn( int column ) const; // Tested
+
+    MatrixView Transposed() const; // Tested
+
+    /** One list per row **/
+    QList< QList< double > > ToList() const; // Tested
+
+
+private:
+    const double *m_data;
+
+    int m_nbrRows, m_nbrColumns;
+
+    int m_rowStride, m_columnStride;
+
+
+    explicit MatrixView( const double *data, int nbrRows, int nbrColumns, int rowStride, int columnStride );
+};
+
+#endif // MATRIXVIEW_H
@@ -0,0 +1,229 @@
+#include "PearsonCorrelation.h"
+
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <cmath>
+
+//#include <QDebug>
+
+
+const int PearsonCorrelation::m_nbrProfilesPerBlock = 64;
+const int PearsonCorrelation::m_nbrPointsPerBlock = 2048;
+const int PearsonCorrelation::m_minNbrValuesPerThread = 256 * 1024;
+
+PearsonCorrelation::PearsonCorrelation( const VectorView& reference )
+{
+    m_nbrThreads = 1;
+    SetReference( reference );
+}
+
+PearsonCorrelation::PearsonCorrelation( const QList< double >& reference )
+{
+    m_nbrThreads = 1;
+    QVector< double > referenceValues = reference.toVector();
+    SetReference( VectorView( referenceValues.constData(), referenceValues.size(), 1 ) );
+}
+
+
+void PearsonCorrelation::SetNbrThreads( int nbrThreads )
+{
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+int PearsonCorrelation::GetNbrThreads() const
+{
+    return m_nbrThreads;
+}
+
+int PearsonCorrelation::GetNbrPoints() const
+{
+    return m_centeredReference.size();
+}
+
+
+QVector< double > PearsonCorrelation::Correlate( const QList< VectorView >& profiles ) const
+{
+    /** Profiles read in place if their values are contiguous, copied otherwise **/
+    int nbrPoints = GetNbrPoints();
+    QVector< const double* > profileData( profiles.size() );
+    QVector< double > copiedValues;
+    int nbrCopiedProfiles = 0;
+    foreach( const VectorView& profile, profiles )
+    {
+        nbrCopiedProfiles += profile.Stride() != 1 ? 1 : 0;
+    }
+    copiedValues.resize( nbrCopiedProfiles * nbrPoints );
+
+    double *copiedProfile = copiedValues.data();
+    for( int i = 0; i < profiles.size(); i++ )
+    {
+        const VectorView& profile = profiles.at( i );
+        if( profile.Stride() == 1 )
+        {
+            profileData[ i ] = profile.Data();
+        }
+        else
+        {
+            for( int point = 0; point < nbrPoints; point++ )
+            {
+                copiedProfile[ point ] = profile.At( point );
+            }
+            profileData[ i ] = copiedProfile;
+            copiedProfile += nbrPoints;
+        }
+    }
+
+    return Correlate( profileData );
+}
+
+QVector< double > PearsonCorrelation::Correlate( const QList< QList< double > >& profiles ) const
+{
+    /** Copied one after the other so every profile is contiguous **/
+    int nbrPoints = GetNbrPoints();
+    QVector< double > values( profiles.size() * nbrPoints );
+    QVector< const double* > profileData( profiles.size() );
+    for( int i = 0; i < profiles.size(); i++ )
+    {
+        double *profile = values.data() + i * nbrPoints;
+        QList< double >::ConstIterator iterValue = profiles.at( i ).constBegin();
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile[ point ] = *iterValue;
+            ++iterValue;
+        }
+        profileData[ i ] = profile;
+    }
+
+    return Correlate( profileData );
+}
+
+double PearsonCorrelation::Correlate( const VectorView& profile ) const
+{
+    return Correlate( QList< VectorView >() << profile ).first();
+}
+
+double PearsonCorrelation::Correlate( const QList< double >& profile ) const
+{
+    return Correlate( QList< QList< double > >() << profile ).first();
+}
+
+
+void PearsonCorrelation::SetReference( const VectorView& reference )
+{
+    int nbrPoints = reference.Size();
+    double sumReference = 0;
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        sumReference += reference.At( point );
+    }
+    double meanReference = nbrPoints > 0 ? sumReference / nbrPoints : 0;
+
+    m_centeredReference.resize( nbrPoints );
+    m_referenceSumSquares = 0;
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        m_centeredReference[ point ] = reference.At( point ) - meanReference;
+        m_referenceSumSquares += m_centeredReference.at( point ) * m_centeredReference.at( point );
+    }
+}
+
+QVector< double > PearsonCorrelation::Correlate( const QVector< const double* >& profiles ) const
+{
+    int nbrProfiles = profiles.size();
+    QVector< double > correlations( nbrProfiles, 1.0 );
+    if( GetNbrPoints() < 2 || nbrProfiles == 0 )
+    {
+        return correlations;
+    }
+
+    int nbrThreads = m_nbrThreads > 0 ? m_nbrThreads : QThread::idealThreadCount();
+    qint64 nbrValues = qint64( nbrProfiles ) * GetNbrPoints();
+    int nbrChunks = static_cast< int >( qBound( qint64( 1 ), nbrValues / m_minNbrValuesPerThread, qint64( qMax( nbrThreads, 1 ) ) ) );
+
+    /** Chunks made of whole blocks of profiles, the last one correlated by the calling thread **/
+    int nbrBlocks = ( nbrProfiles + m_nbrProfilesPerBlock - 1 ) / m_nbrProfilesPerBlock;
+    int nbrBlocksPerChunk = ( nbrBlocks + nbrChunks - 1 ) / nbrChunks;
+    QList< QFuture< void > > futures;
+    for( int first = 0; first < nbrProfiles; first += nbrBlocksPerChunk * m_nbrProfilesPerBlock )
+    {
+        int last = qMin( first + nbrBlocksPerChunk * m_nbrProfilesPerBlock, nbrProfiles );
+        if( last < nbrProfiles )
+        {
+            futures.append( QtConcurrent::run( this, &PearsonCorrelation::CorrelateProfiles, profiles.constData(), first, last, correlations.data() ) );
+        }
+        else
+        {
+            CorrelateProfiles( profiles.constData(), first, last, correlations.data() );
+        }
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+
+    return correlations;
+}
+
+void PearsonCorrelation::CorrelateProfiles( const double * const *profiles, int first, int last, double *correlations ) const
+{
+    int nbrPoints = GetNbrPoints();
+    const double *reference = m_centeredReference.constData();
+    double sums[ m_nbrProfilesPerBlock ];
+    double sumSquares[ m_nbrProfilesPerBlock ];
+    double sumProducts[ m_nbrProfilesPerBlock ];
+
+    for( int firstProfile = first; firstProfile < last; firstProfile += m_nbrProfilesPerBlock )
+    {
+        int nbrBlockProfiles = qMin( m_nbrProfilesPerBlock, last - firstProfile );
+        for( int i = 0; i < nbrBlockProfiles; i++ )
+        {
+            sums[ i ] = 0;
+            sumSquares[ i ] = 0;
+            sumProducts[ i ] = 0;
+        }
+
+        for( int firstPoint = 0; firstPoint < nbrPoints; firstPoint += m_nbrPointsPerBlock )
+        {
+            int lastPoint = qMin( firstPoint + m_nbrPointsPerBlock, nbrPoints );
+            for( int i = 0; i < nbrBlockProfiles; i++ )
+            {
+                /** Four independent lanes: the loop is not bound by the latency of one accumulator **/
+                const double *profile = profiles[ firstProfile + i ];
+                double sum[ 4 ] = { 0, 0, 0, 0 };
+                double sumSquare[ 4 ] = { 0, 0, 0, 0 };
+                double sumProduct[ 4 ] = { 0, 0, 0, 0 };
+                int point = firstPoint;
+                for( ; point + 4 <= lastPoint; point += 4 )
+                {
+                    for( int lane = 0; lane < 4; lane++ )
+                    {
+                        double value = profile[ point + lane ];
+                        sum[ lane ] += value;
+                        sumSquare[ lane ] += value * value;
+                        sumProduct[ lane ] += value * reference[ point + lane ];
+                    }
+                }
+                for( ; point < lastPoint; point++ )
+                {
+                    double value = profile[ point ];
+                    sum[ 0 ] += value;
+                    sumSquare[ 0 ] += value * value;
+                    sumProduct[ 0 ] += value * reference[ point ];
+                }
+
+                sums[ i ] += ( sum[ 0 ] + sum[ 1 ] ) + ( sum[ 2 ] + sum[ 3 ] );
+                sumSquares[ i ] += ( sumSquare[ 0 ] + sumSquare[ 1 ] ) + ( sumSquare[ 2 ] + sumSquare[ 3 ] );
+                sumProducts[ i ] += ( sumProduct[ 0 ] + sumProduct[ 1 ] ) + ( sumProduct[ 2 ] + sumProduct[ 3 ] );
+            }
+        }
+
+        /** Sum of ( reference - mean ) * profile: same numerator as sum( reference * profile ) - sum( reference ) * sum( profile ) / n **/
+        for( int i = 0; i < nbrBlockProfiles; i++ )
+        {
+            correlations[ firstProfile + i ] = sumProducts[ i ] /
+                    std::sqrt( m_referenceSumSquares * ( sumSquares[ i ] - sums[ i ] * sums[ i ] / nbrPoints ) );
+        }
+    }
+}
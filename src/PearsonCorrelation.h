@@ -0,0 +1,67 @@
+#ifndef PEARSONCORRELATION_H
+#define PEARSONCORRELATION_H
+
+#include "MatrixView.h"
+
+#include <QVector>
+#include <QList>
+
+/** Pearson correlation of profiles with a reference profile, as used by the QC threshold.
+ *  The statistics of the reference are computed once. The profiles are then correlated block by block:
+ *  a block of profiles is read one block of arc lengths at a time, so the matching part of the reference
+ *  stays in cache, and the sums of each profile are accumulated in a single pass with independent lanes
+ *  the compiler can vectorize. The blocks of profiles can be spread across threads. **/
+class PearsonCorrelation
+{
+    friend class TestPearsonCorrelation; /** For unit tests **/
+
+public:
+    /** Only the first reference.Size() values of the profiles are correlated **/
+    explicit PearsonCorrelation( const VectorView& reference );
+
+    explicit PearsonCorrelation( const QList< double >& reference );
+
+
+    /** 0: as many threads as cores. Only large sets of profiles are split between threads. **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+    int GetNbrThreads() const; // Tested
+
+    int GetNbrPoints() const; // Tested
+
+
+    /** Correlations in the order of the profiles, 1.0 if the reference has less than 2 points **/
+    QVector< double > Correlate( const QList< VectorView >& profiles ) const; // Tested
+
+    QVector< double > Correlate( const QList< QList< double > >& profiles ) const; // Tested
+
+    double Correlate( const VectorView& profile ) const; // Tested
+
+    double Correlate( const QList< double >& profile ) const; // Tested
+
+
+private:
+    static const int m_nbrProfilesPerBlock;
+    static const int m_nbrPointsPerBlock;
+
+    /** Number of values below which the profiles are not split between threads **/
+    static const int m_minNbrValuesPerThread;
+
+
+    /** Reference minus its mean, and sum of its squares **/
+    QVector< double > m_centeredReference;
+
+    double m_referenceSumSquares;
+
+    int m_nbrThreads;
+
+
+    void SetReference( const VectorView& reference ); // Not Directly Tested
+
+    /** profiles: first value of each profile, its GetNbrPoints() values contiguous **/
+    QVector< double > Correlate( const QVector< const double* >& profiles ) const; // Not Directly Tested
+
+    void CorrelateProfiles( const double * const *profiles, int first, int last, double *correlations ) const; // Not Directly Tested
+};
+
+#endif // PEARSONCORRELATION_H
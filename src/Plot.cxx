@@ -1,4 +1,5 @@
 #include "Plot.h"
+#include "SubjectRegistry.h"
 
 #include <QVTKWidget.h>
 
@@ -23,12 +24,22 @@ void CallbackUpdateSelectedLines( vtkObject* caller, long unsigned int eventId,
 
 
 const QMap< QString, QList< int > > Plot::m_allColors = InitColorMap();
+const int Plot::m_minRenderInterval = 33;
 /***************************************************************/
 /********************** Public functions ***********************/
 /***************************************************************/
 Plot::Plot( QObject *parent ) :
     QObject( parent )
 {
+    m_qcThresholdMetric = QCThreshold::Correlation;
+    m_qcThresholdWorker = new QCThresholdWorker( this );
+    connect( m_qcThresholdWorker, SIGNAL( CorrelationsComputed( const QVector< double >& ) ), this, SLOT( OnQCThresholdCorrelationsComputed( const QVector< double >& ) ) );
+
+    m_renderTimer = new QTimer( this );
+    m_renderTimer->setSingleShot( true );
+    m_renderTimer->setInterval( m_minRenderInterval );
+    connect( m_renderTimer, SIGNAL( timeout() ), this, SLOT( OnRenderTimeout() ) );
+    m_isRenderPending = false;
 }
 
 
@@ -70,19 +81,19 @@ bool Plot::InitPlot( QString directory, QString fibername, double pvalueThreshol
     return arePlotsAvailable;
 }
 
-bool Plot::InitQCThresholdPlot( QList< QStringList > rawData, QStringList matchedSubjects )
+bool Plot::InitQCThresholdPlot( const DiffusionProfileMatrix::ConstPointer& rawData, QStringList matchedSubjects, const QString& property )
 {
     ClearPlot();
     ResetPlotData();
 
     m_matchedSubjects = matchedSubjects;
-    m_subjects = rawData.first();
+    m_subjects = rawData->GetSubjects();
 
     m_plotSelected = "Raw Data";
-    m_propertySelected = "FA";
+    m_propertySelected = property;
     m_lineWidth = 0.75;
 
-    bool isPlottingEnabled = SetRawDataQCThreshold( rawData );
+    bool isPlottingEnabled = SetRawDataQCThreshold( *rawData );
 
     return isPlottingEnabled;
 }
@@ -204,6 +215,8 @@ void Plot::ResetPlotData()
 
     m_matchedSubjects.clear();
     m_atlasQCThreshold.clear();
+    m_qcThresholdCorrelations.Clear();
+    m_qcThresholdWorker->Cancel();
 }
 
 void Plot::ClearPlot()
@@ -805,11 +818,26 @@ double& Plot::SetQCThreshold()
     return m_qcThreshold;
 }
 
-QStringList& Plot::SetAtlasQCThreshold()
+QList< double >& Plot::SetAtlasQCThreshold()
 {
     return m_atlasQCThreshold;
 }
 
+QCThresholdReference& Plot::SetQCThresholdReference()
+{
+    return m_qcThresholdReference;
+}
+
+QCThreshold::Metric& Plot::SetQCThresholdMetric()
+{
+    return m_qcThresholdMetric;
+}
+
+FunctionalPCA& Plot::SetQCThresholdFunctionalPCA()
+{
+    return m_qcThresholdFunctionalPCA;
+}
+
 bool& Plot::SetCroppingEnabled()
 {
     return m_croppingEnabled;
@@ -964,10 +992,12 @@ void Plot::UpdateLineSelection()
 
 void Plot::UpdateNAN( const QStringList& nanSubjects )
 {
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QSet< int > nanSubjectIDs = registry.GetIDSet( nanSubjects );
     for( int plotIndex = m_chart->GetNumberOfPlots(); plotIndex > 0 ; plotIndex-- )
     {
         vtkSmartPointer< vtkPlot > currentLine = m_chart->GetPlot( plotIndex - 1 );
-        if( nanSubjects.contains( QString( currentLine->GetLabel() ) ) )
+        if( nanSubjectIDs.contains( registry.FindID( QString( currentLine->GetLabel() ) ) ) )
         {
             int currentIndex = m_chart->GetPlotIndex( currentLine );
             m_chart->RemovePlot( currentIndex );
@@ -976,58 +1006,50 @@ void Plot::UpdateNAN( const QStringList& nanSubjects )
     }
 
     m_nbrPlots = m_dataRawData[ m_propertySelected ].size();
+    m_qcThresholdCorrelations.Clear();
 
-    UpdateQCThreshold( m_qcThreshold, false );
+    /** New reference: the lines are restyled once the worker has correlated the remaining profiles **/
+    int first, last;
+    GetQCThresholdWindow( first, last );
+    m_qcThresholdWorker->SetProfiles( GetQCThresholdReference(), m_dataRawData.value( m_propertySelected ), first, last );
 
-    m_view->Render();
+    RequestRender();
 }
 
 void Plot::UpdateQCThreshold( double qcThreshold, bool emitSignal )
 {
+    double previousQCThreshold = m_qcThreshold;
     m_qcThreshold = qcThreshold;
-    QList< double > atlas = m_processing.QStringListToDouble( m_atlasQCThreshold );
-    QList< double > refLine = !atlas.isEmpty() ? atlas : m_processing.GetMean( m_dataRawData.value( m_propertySelected ), 0 );
-    QStringList subjectsCorrelated, subjectsNotCorrelated;
 
-    for( int i = 0; i < m_nbrPlots; i++ )
+    /** Correlations still computed by the worker: the lines are styled with the new threshold once they are posted **/
+    if( m_qcThresholdCorrelations.GetNbrLines() != m_nbrPlots )
     {
-        vtkSmartPointer< vtkPlot > currentLine = m_chart->GetPlot( i );
-        QList< int > color;
-
-        double pearsonCorrelation = m_processing.ApplyPearsonCorrelation( m_dataRawData.value( m_propertySelected ).at( i ), refLine, 0 );
-
-        if( pearsonCorrelation < m_qcThreshold )
-        {
-            subjectsNotCorrelated.append( QString( currentLine->GetLabel() ) );
-
-            color = m_allColors.value( "Red" );
-            currentLine->GetPen()->SetLineType( vtkPen::DASH_LINE );
-        }
-        else
-        {
-            subjectsCorrelated.append( QString( currentLine->GetLabel() ) );
-
-            color = m_allColors.value( "Carolina Blue" );
-            currentLine->GetPen()->SetLineType( vtkPen::SOLID_LINE );
-        }
+        return;
+    }
 
-        currentLine->SetColor(  color.first(), color.at( 1 ), color.at( 2 ), 255 );
-        currentLine->SetWidth( m_lineWidth );
+    /** Correlations kept while the lines and the reference do not change: only the lines crossing the threshold are restyled **/
+    foreach( int line, m_qcThresholdCorrelations.GetLinesCrossing( previousQCThreshold, m_qcThreshold ) )
+    {
+        SetQCThresholdLineStyle( m_chart->GetPlot( line ), m_qcThresholdCorrelations.IsCorrelated( line, m_qcThreshold ) );
     }
 
     if( emitSignal )
     {
-        emit UpdateSubjectsCorrelated( subjectsCorrelated, subjectsNotCorrelated );
+        EmitSubjectsCorrelated();
     }
 
-    m_view->Render();
+    RequestRender();
 }
 
 void Plot::UpdateCropping()
 {
     AddCrop( true );
 
-    m_view->Render();
+    int first, last;
+    GetQCThresholdWindow( first, last );
+    m_qcThresholdWorker->SetCropping( first, last );
+
+    RequestRender();
 }
 
 void Plot::ShowHideProfileCropping( bool show )
@@ -1035,7 +1057,16 @@ void Plot::ShowHideProfileCropping( bool show )
     m_chart->GetPlot( m_chart->GetNumberOfPlots() - 1 )->SetVisible( show );
     m_chart->GetPlot( m_chart->GetNumberOfPlots() - 2 )->SetVisible( show );
 
-    m_view->Render();
+    int first, last;
+    GetQCThresholdWindow( first, last );
+    m_qcThresholdWorker->SetCropping( first, last );
+
+    RequestRender();
+}
+
+void Plot::WaitForQCThresholdCorrelations()
+{
+    m_qcThresholdWorker->WaitForCorrelations();
 }
 
 
@@ -1149,68 +1180,64 @@ void Plot::SortFilesByProperties( QString directory, const QStringList& files, Q
 
         if( !index.isNull() )
         {
-            QList< QStringList > dataTemp = m_processing.GetDataFromFile( currentPath );
+            CSVData dataTemp = m_processing.GetNumericDataFromFile( currentPath );
 
-            if( dataTemp.first().first().contains( "arclength", Qt::CaseInsensitive ) || dataKind == RawData )
+            if( !dataTemp.IsEmpty() && ( dataTemp.GetHeader().first().contains( "arclength", Qt::CaseInsensitive ) || dataKind == RawData ) )
             {
+                QList< QList< double > > dataDouble;
                 if( dataKind == RawData )
                 {
                     if( index == "SUBMATRIX" )
                     {
-                        SetCovariates( dataTemp, RawData );
-                        dataTemp.removeFirst();
-                        dataTemp = m_processing.Transpose( dataTemp );
+                        /** Subjects by row, covariates by column **/
+                        SetBinaryCovariates( dataTemp );
+                        SetCovariates( dataTemp.GetHeader(), RawData );
                         SetSubjects( dataTemp );
-                        dataTemp.removeFirst();
-                        dataTemp = m_processing.Transpose( dataTemp );
+                        dataDouble = dataTemp.GetDataByRow();
                     }
                     else
                     {
-                        dataTemp.removeFirst();
-                        dataTemp = m_processing.Transpose( dataTemp );
+                        /** Arc length in the 1st column, subjects by column **/
                         if( m_abscissa.isEmpty() )
                         {
-                            m_abscissa = m_processing.QStringListToDouble( dataTemp.first() );
+                            m_abscissa = dataTemp.GetColumnValues( 0 );
                             m_nbrPoints = m_abscissa.size();
                         }
-                        dataTemp.removeFirst();
+                        dataDouble = dataTemp.GetDataByColumn();
                     }
                 }
 
                 if( dataKind == Betas || dataKind == ConfidenceBands )
                 {
-                    dataTemp = m_processing.Transpose( dataTemp );
+                    /** Arc length in the 1st row, covariates by row **/
                     if( m_allCovariates.isEmpty() )
                     {
-                        SetCovariates( dataTemp, dataKind );
+                        SetCovariates( QStringList() << dataTemp.GetHeader().first() << dataTemp.GetColumnText( 0 ), dataKind );
                     }
-                    dataTemp.removeFirst();
-                    dataTemp = m_processing.Transpose( dataTemp );
                     if( m_abscissa.isEmpty() )
                     {
-                        m_abscissa = m_processing.QStringListToDouble( dataTemp.first() );
+                        m_abscissa = m_processing.QStringListToDouble( dataTemp.GetHeader().mid( 1 ) );
                         m_nbrPoints = m_abscissa.size();
                     }
-                    dataTemp.removeFirst();
+                    dataDouble = dataTemp.GetDataByRow();
                 }
 
                 if( dataKind == PostHocFDRLpvalues )
                 {
+                    /** Arc length in the 1st column, covariates by column **/
                     if( m_allCovariates.isEmpty() )
                     {
-                        SetCovariates( dataTemp, PostHocFDRLpvalues );
+                        SetCovariates( dataTemp.GetHeader(), PostHocFDRLpvalues );
                     }
-                    dataTemp.removeFirst();
-                    dataTemp = m_processing.Transpose( dataTemp );
                     if( m_abscissa.isEmpty() )
                     {
-                        m_abscissa = m_processing.QStringListToDouble( dataTemp.first() );
+                        m_abscissa = dataTemp.GetColumnValues( 0 );
                         m_nbrPoints = m_abscissa.size();
                     }
-                    dataTemp.removeFirst();
+                    dataDouble = dataTemp.GetDataByColumn();
                 }
 
-                data.insert( index, m_processing.DataToDouble( dataTemp ) );
+                data.insert( index, dataDouble );
             }
         }
     }
@@ -1328,24 +1355,21 @@ void Plot::SetBetasByCovariate()
 void Plot::SetOmnibusLpvalue( const QStringList& omnibusLpvalueFiles, QList< QList< double > >& omnibusLpvaluesData )
 {
     QString currentPath = m_matlabDirectory + "/" + omnibusLpvalueFiles.first();
-    QList< QStringList > dataTemp = m_processing.GetDataFromFile( currentPath );
+    CSVData dataTemp = m_processing.GetNumericDataFromFile( currentPath );
 
-    if( dataTemp.first().first().contains( "arclength", Qt::CaseInsensitive ) )
+    if( !dataTemp.IsEmpty() && dataTemp.GetHeader().first().contains( "arclength", Qt::CaseInsensitive ) )
     {
         if( m_allCovariates.isEmpty() )
         {
-            SetCovariates( dataTemp, OmnibusLpvalues );
+            SetCovariates( dataTemp.GetHeader(), OmnibusLpvalues );
         }
-        dataTemp.removeFirst();
-        dataTemp = m_processing.Transpose( dataTemp );
         if( m_abscissa.isEmpty() )
         {
-            m_abscissa = m_processing.QStringListToDouble( dataTemp.first() );
+            m_abscissa = dataTemp.GetColumnValues( 0 );
             m_nbrPoints = m_abscissa.size();
         }
-        dataTemp.removeFirst();
 
-        omnibusLpvaluesData = m_processing.DataToDouble( dataTemp );
+        omnibusLpvaluesData = dataTemp.GetDataByColumn();
     }
 }
 
@@ -1550,29 +1574,33 @@ void Plot::SetPostHocFDRSigBetasByCovariates()
     }
 }
 
-bool Plot::SetRawDataQCThreshold( const QList< QStringList >& rawData )
+bool Plot::SetRawDataQCThreshold( const DiffusionProfileMatrix& rawData )
 {
-    QList< QStringList > faData = rawData;
-    faData.removeFirst();
-    faData = m_processing.Transpose( faData );
-    faData.removeFirst();
-
-    bool subjectsRemoved;
+    bool subjectsRemoved = false;
     if( !m_matchedSubjects.isEmpty() )
     {
-        QList< QStringList > tempData = m_processing.Transpose( rawData );
-
-        QStringList arcLength = tempData.first();
-        arcLength.removeFirst();
-        m_abscissa = m_processing.QStringListToDouble( arcLength );
+        m_abscissa = rawData.GetArcLength().ToList();
         m_nbrPoints = m_abscissa.size();
 
-        subjectsRemoved = m_processing.RemoveUnmatchedSubjects( tempData, m_subjects, m_matchedSubjects );
-        tempData = m_processing.Transpose( tempData );
-        tempData.removeFirst();
-        tempData = m_processing.Transpose( tempData );
+        /** Only the profiles of the matched subjects are kept **/
+        QSet< int > matchedSubjectIDs = SubjectRegistry::GetInstance().GetIDSet( m_matchedSubjects );
+        QVector< int > subjectIDs = rawData.GetSubjectIDs();
+        QStringList subjects = rawData.GetSubjects();
+        QList< QList< double > > tempDoubleData;
+        m_subjects.clear();
+        for( int subjectIndex = 0; subjectIndex < subjects.size(); subjectIndex++ )
+        {
+            if( matchedSubjectIDs.contains( subjectIDs.at( subjectIndex ) ) )
+            {
+                m_subjects.append( subjects.at( subjectIndex ) );
+                tempDoubleData.append( rawData.GetSubjectProfile( subjectIndex ).ToList() );
+            }
+        }
+
+        QStringList tempSubjects = m_subjects;
+        tempSubjects.sort();
+        subjectsRemoved = tempSubjects == m_matchedSubjects;
 
-        QList< QList< double > > tempDoubleData = m_processing.DataToDouble( tempData );
         m_processing.NANToZeros( tempDoubleData );
         m_dataRawData.insert( m_propertySelected, tempDoubleData );
     }
@@ -1762,18 +1790,18 @@ void Plot::SetProperties( const QStringList& properties )
     emit AllPropertiesUsed( m_properties );
 }
 
-void Plot::SetSubjects( const QList< QStringList >& rawDataSubMatrix )
+void Plot::SetSubjects( const CSVData& rawDataSubMatrix )
 {
-    m_subjects.append( rawDataSubMatrix.first() );
+    m_subjects.append( SubjectRegistry::GetInstance().Intern( rawDataSubMatrix.GetColumnText( 0 ) ) );
 }
 
-bool Plot::IsCovariateBinary( const QList< QStringList >& data, int indexCovariate )
+bool Plot::IsCovariateBinary( const CSVData& data, int indexCovariate )
 {
     bool isBinary = true;
     int row = 1;
-    while( row < data.size() && isBinary )
+    while( row < data.GetNbrRows() && isBinary )
     {
-        if( ( data.at( row ).at( indexCovariate ).toDouble() != 0 ) && ( data.at( row ).at( indexCovariate ).toDouble() != 1 ) )
+        if( ( data.GetValue( row, indexCovariate ) != 0 ) && ( data.GetValue( row, indexCovariate ) != 1 ) )
         {
             isBinary = false;
         }
@@ -1783,9 +1811,21 @@ bool Plot::IsCovariateBinary( const QList< QStringList >& data, int indexCovaria
     return isBinary;
 }
 
-void Plot::SetCovariates( const QList< QStringList >& data, int dataKind )
+void Plot::SetBinaryCovariates( const CSVData& rawDataSubMatrix )
 {
-    QStringList firstRow = data.first();
+    QStringList header = rawDataSubMatrix.GetHeader();
+    for( int i = 1; i < header.size(); i++ )
+    {
+        if( IsCovariateBinary( rawDataSubMatrix, i ) )
+        {
+            m_binaryCovariates.insert( i, header.at( i ) );
+        }
+    }
+}
+
+void Plot::SetCovariates( const QStringList& covariateNames, int dataKind )
+{
+    QStringList firstRow = covariateNames;
     int shift = 0;
     if( dataKind == Betas )
     {
@@ -1808,17 +1848,6 @@ void Plot::SetCovariates( const QList< QStringList >& data, int dataKind )
         }
     }
 
-    if( dataKind == RawData )
-    {
-        for( int i = 1; i < firstRow.size(); i++ )
-        {
-            if( IsCovariateBinary( data, i ) )
-            {
-                m_binaryCovariates.insert( i, firstRow.at( i ) );
-            }
-        }
-    }
-
     emit AllCovariatesUsed( m_allCovariates );
 }
 
@@ -2637,44 +2666,64 @@ void Plot::AddQCThresholdLines( const vtkSmartPointer< vtkTable >& table )
 {
     InitQCThresholdLines();
 
-    QList< double > atlas = m_processing.QStringListToDouble( m_atlasQCThreshold );
-
-    QList< double > refLine = !atlas.isEmpty() ? atlas : m_processing.GetMean( m_dataRawData.value( m_propertySelected ), 0 );
+    QList< double > refLine = GetQCThresholdReference();
 
-    QStringList subjectsCorrelated, subjectsNotCorrelated;
+    /** Lines first displayed already styled: correlated in the calling thread **/
+    int first, last;
+    GetQCThresholdWindow( first, last );
+    m_qcThresholdWorker->SetMetric( m_qcThresholdMetric, m_qcThresholdFunctionalPCA );
+    m_qcThresholdCorrelations.SetCorrelations( m_qcThresholdWorker->Correlate( refLine, m_dataRawData.value( m_propertySelected ), first, last ) );
     for( int i = 0; i < m_nbrPlots; i++ )
     {
         vtkSmartPointer< vtkPlot > currentLine = m_chart->GetPlot( i );
         currentLine->SetInputData( table, 0, i + 1 );
-        QList< int > color;
+        SetQCThresholdLineStyle( currentLine, m_qcThresholdCorrelations.IsCorrelated( i, m_qcThreshold ) );
+    }
 
-        double pearsonCorrelation = m_processing.ApplyPearsonCorrelation( m_dataRawData.value( m_propertySelected ).at( i ), refLine, 0 );
+    AddMean( refLine );
+    AddCrop( false );
 
-        if( pearsonCorrelation < m_qcThreshold )
-        {
-            subjectsNotCorrelated.append( QString( currentLine->GetLabel() ) );
+    EmitSubjectsCorrelated();
+}
 
-            color = m_allColors.value( "Red" );
-            currentLine->GetPen()->SetLineType( vtkPen::DASH_LINE );
+void Plot::SetQCThresholdLineStyle( vtkSmartPointer< vtkPlot > line, bool isCorrelated )
+{
+    QList< int > color = isCorrelated ? m_allColors.value( "Carolina Blue" ) : m_allColors.value( "Red" );
+    line->GetPen()->SetLineType( isCorrelated ? vtkPen::SOLID_LINE : vtkPen::DASH_LINE );
+    line->SetColor(  color.first(), color.at( 1 ), color.at( 2 ), 255 );
+    line->SetWidth( m_lineWidth );
+}
+
+void Plot::EmitSubjectsCorrelated()
+{
+    QStringList subjectsCorrelated, subjectsNotCorrelated;
+    for( int i = 0; i < m_nbrPlots; i++ )
+    {
+        QString subject = QString( m_chart->GetPlot( i )->GetLabel() );
+        if( m_qcThresholdCorrelations.IsCorrelated( i, m_qcThreshold ) )
+        {
+            subjectsCorrelated.append( subject );
         }
         else
         {
-            subjectsCorrelated.append( QString( currentLine->GetLabel() ) );
-
-            color = m_allColors.value( "Carolina Blue" );
-            currentLine->GetPen()->SetLineType( vtkPen::SOLID_LINE );
+            subjectsNotCorrelated.append( subject );
         }
-
-        currentLine->SetColor(  color.first(), color.at( 1 ), color.at( 2 ), 255 );
-        currentLine->SetWidth( m_lineWidth );
     }
 
-    AddMean( refLine );
-    AddCrop( false );
-
     emit UpdateSubjectsCorrelated( subjectsCorrelated, subjectsNotCorrelated );
 }
 
+QList< double > Plot::GetQCThresholdReference()
+{
+    return !m_atlasQCThreshold.isEmpty() ? m_atlasQCThreshold : m_qcThresholdReference.Compute( m_dataRawData.value( m_propertySelected ) );
+}
+
+void Plot::GetQCThresholdWindow( int& first, int& last ) const
+{
+    first = m_croppingEnabled ? m_arcLengthStartIndex : 0;
+    last = m_croppingEnabled ? m_arcLengthEndIndex : m_nbrPoints - 1;
+}
+
 
 void Plot::GetyMinMax()
 {
@@ -2838,6 +2887,20 @@ void Plot::ZoomOut()
 }
 
 
+void Plot::RequestRender()
+{
+    /** Renderings requested meanwhile are done once, at the end of the interval **/
+    if( m_renderTimer->isActive() )
+    {
+        m_isRenderPending = true;
+        return;
+    }
+
+    m_view->Render();
+    m_renderTimer->start();
+}
+
+
 /***************************************************************/
 /************************ Private slots ************************/
 /***************************************************************/
@@ -2853,3 +2916,39 @@ void Plot::OnMouseEvent( QMouseEvent* event )
         ZoomOut();
     }
 }
+
+void Plot::OnQCThresholdCorrelationsComputed( const QVector< double >& correlations )
+{
+    /** Correlations of lines removed meanwhile **/
+    if( correlations.size() != m_nbrPlots )
+    {
+        return;
+    }
+
+    /** Same lines, new correlations: only the lines changing side are restyled **/
+    QCThresholdCorrelations previousCorrelations = m_qcThresholdCorrelations;
+    bool areAllLinesUpdated = previousCorrelations.GetNbrLines() != m_nbrPlots;
+    m_qcThresholdCorrelations.SetCorrelations( correlations );
+    for( int i = 0; i < m_nbrPlots; i++ )
+    {
+        bool isCorrelated = m_qcThresholdCorrelations.IsCorrelated( i, m_qcThreshold );
+        if( areAllLinesUpdated || isCorrelated != previousCorrelations.IsCorrelated( i, m_qcThreshold ) )
+        {
+            SetQCThresholdLineStyle( m_chart->GetPlot( i ), isCorrelated );
+        }
+    }
+
+    EmitSubjectsCorrelated();
+
+    RequestRender();
+}
+
+void Plot::OnRenderTimeout()
+{
+    if( m_isRenderPending )
+    {
+        m_isRenderPending = false;
+        m_view->Render();
+        m_renderTimer->start();
+    }
+}
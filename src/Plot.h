@@ -2,11 +2,16 @@
 #define PLOT_H
 
 #include "Processing.h"
+#include "QCThresholdCorrelations.h"
+#include "QCThresholdWorker.h"
+#include "QCThresholdReference.h"
+#include "QCThreshold.h"
 
 #include <QDir>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QMouseEvent>
+#include <QTimer>
 
 #include <QVTKWidget.h>
 
@@ -52,7 +57,7 @@ public:
 
     bool InitPlot( QString directory, QString fibername, double pvalueThreshold ); // Not Directly Tested
 
-    bool InitQCThresholdPlot( QList< QStringList > rawData, QStringList matchedSubjects ); // Not Directly Tested
+    bool InitQCThresholdPlot( const DiffusionProfileMatrix::ConstPointer& rawData, QStringList matchedSubjects, const QString& property ); // Not Directly Tested
 
     bool DisplayPlot(); // Not Directly Tested
 
@@ -121,7 +126,15 @@ public:
 
     double& SetQCThreshold(); // Tested
 
-    QStringList& SetAtlasQCThreshold(); /// Not tested*
+    QList< double >& SetAtlasQCThreshold(); /// Not tested*
+
+    /** Reference computed from the profiles when no atlas is set **/
+    QCThresholdReference& SetQCThresholdReference(); /// Not tested*
+
+    /** Lines styled by their correlation with the reference, or by their functional PCA outlier score **/
+    QCThreshold::Metric& SetQCThresholdMetric(); /// Not tested*
+
+    FunctionalPCA& SetQCThresholdFunctionalPCA(); /// Not tested*
 
     bool& SetCroppingEnabled();
 
@@ -146,6 +159,9 @@ public:
 
     void ShowHideProfileCropping( bool show );
 
+    /** Lines styled and subjects emitted for the latest changes still computed in the worker thread **/
+    void WaitForQCThresholdCorrelations();
+
 
 
 public slots:
@@ -179,6 +195,11 @@ private:
     QMap< int, vtkSmartPointer< vtkPlot > > m_line;
     QString m_directory, m_matlabDirectory, m_fibername;
 
+    /** Renderings of the QC threshold plot bounded to one per interval (ms) **/
+    static const int m_minRenderInterval;
+    QTimer *m_renderTimer;
+    bool m_isRenderPending;
+
     /********************/
     /**** LINE COLOR ****/
     /********************/
@@ -309,8 +330,15 @@ private:
     /**********************/
     /**** QC THRESHOLD ****/
     /**********************/
-    QStringList m_matchedSubjects, m_atlasQCThreshold;
+    QStringList m_matchedSubjects;
+
+    QList< double > m_atlasQCThreshold;
+    QCThresholdReference m_qcThresholdReference;
+    QCThreshold::Metric m_qcThresholdMetric;
+    FunctionalPCA m_qcThresholdFunctionalPCA;
     double m_qcThreshold;
+    QCThresholdCorrelations m_qcThresholdCorrelations;
+    QCThresholdWorker *m_qcThresholdWorker;
     int m_arcLengthStartIndex, m_arcLengthEndIndex;
     bool m_croppingEnabled;
 
@@ -337,7 +365,7 @@ private:
 
     void SetPostHocFDRSigBetasByCovariates(); /// Not tested*
 
-    bool SetRawDataQCThreshold( const QList<QStringList>& rawData ); // Tested
+    bool SetRawDataQCThreshold( const DiffusionProfileMatrix& rawData ); // Tested
 
 
     void GetRawDataFiles(); // Tested
@@ -357,11 +385,13 @@ private:
 
     void SetProperties( const QStringList& properties ); // Tested
 
-    void SetSubjects( const QList< QStringList >& rawDataSubMatrix ); // Tested
+    void SetSubjects( const CSVData& rawDataSubMatrix ); // Tested
 
-    bool IsCovariateBinary( const QList< QStringList >& data, int indexCovariate );
+    bool IsCovariateBinary( const CSVData& data, int indexCovariate );
 
-    void SetCovariates( const QList< QStringList >& data, int dataKind ); // Tested
+    void SetCovariates( const QStringList& covariateNames, int dataKind ); // Tested
+
+    void SetBinaryCovariates( const CSVData& rawDataSubMatrix ); // Not Directly Tested
 
 
     void GetMeanAndStdDv( const QList< QList< double > >& binaryRawData, QList< double >& tempMean, QList< double >& tempStdDv ); // Tested
@@ -438,6 +468,16 @@ private:
 
     void AddQCThresholdLines( const vtkSmartPointer< vtkTable >& table ); // Not Directly Tested
 
+    /** Atlas if any, reference computed from the profiles of the property selected otherwise **/
+    QList< double > GetQCThresholdReference(); // Not Directly Tested
+
+    /** Arc lengths correlated: the cropped ones when the cropping is enabled **/
+    void GetQCThresholdWindow( int& first, int& last ) const; // Not Directly Tested
+
+    void SetQCThresholdLineStyle( vtkSmartPointer< vtkPlot > line, bool isCorrelated ); // Not Directly Tested
+
+    void EmitSubjectsCorrelated(); // Not Directly Tested
+
 
     void GetyMinMax(); // Tested
 
@@ -465,8 +505,16 @@ private:
     void ZoomOut(); // Not Directly Tested
 
 
+    /** Renders now if the last rendering is older than m_minRenderInterval, at the end of the interval otherwise **/
+    void RequestRender(); // Not Directly Tested
+
+
 private slots:
     void OnMouseEvent( QMouseEvent* event );
+
+    void OnQCThresholdCorrelationsComputed( const QVector< double >& correlations ); // Not Directly Tested
+
+    void OnRenderTimeout(); // Not Directly Tested
 };
 
 #endif // PLOT_H
@@ -1,4 +1,15 @@
 #include "Processing.h"
+#include "DatasetCache.h"
+#include "CSVReader.h"
+#include "CSVWriter.h"
+#include "CompressedFileDevice.h"
+#include "SubjectMatcher.h"
+#include "SubjectRegistry.h"
+#include "SelectionPlan.h"
+#include "PearsonCorrelation.h"
+
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <iostream>
 #include <cmath>
@@ -11,6 +22,7 @@ const QString Processing::m_csvSeparator = QLocale().groupSeparator();
 Processing::Processing( QObject *parent ) :
     QObject( parent )
 {
+    m_isStreamingIngest = false;
 }
 
 
@@ -19,51 +31,55 @@ Processing::Processing( QObject *parent ) :
 /*****************************************************/
 QList< QStringList > Processing::GetDataFromFile( QString filePath )
 {
-    QFile file( filePath );
-    QList< QStringList > fileData;
-    if( file.open( QIODevice::ReadOnly ) )
-    {
-        QTextStream ts( &file );
-        QStringList  tempRows;
+    return DatasetCache::GetInstance().GetTextData( filePath );
+}
 
-        /** Read all the file line by line **/
-        while( !ts.atEnd() )
-        {
-            tempRows.append( ts.readLine() );
-        }
-        file.close();
+CSVData Processing::GetNumericDataFromFile( QString filePath )
+{
+    return DatasetCache::GetInstance().GetData( filePath );
+}
 
-        /** If only one line read, check for the carriage return character "\r" **/
-        if(  tempRows.size() == 1 )
-        {
-            tempRows =  tempRows.first().split( "\r" );
-        }
-        tempRows.removeAll( "" );
+DiffusionProfileMatrix::ConstPointer Processing::GetProfileDataFromFile( QString filePath )
+{
+    return DatasetCache::GetInstance().GetProfileData( filePath );
+}
 
-        /** For each line (== row), dispatch data in columns **/
-        foreach( QString dataRow,  tempRows )
-        {
-            QStringList tempRow = dataRow.split( m_csvSeparator );
-            tempRow.removeAll( "" );
 
-            /** remove quotes if needed **/
-            foreach( QString data, tempRow)
-            {
-                if( data.endsWith( '"' ) )
-                {
-                    data.chop( 1 );
-                }
-                if( data.startsWith( '"' ) )
-                {
-                    data.remove( 0, 1 );
-                }
-            }
+void Processing::SetStreamingIngest( bool isStreamingIngest )
+{
+    m_isStreamingIngest = isStreamingIngest;
+}
 
-            fileData.append( tempRow );
-        }
+bool Processing::IsStreamingIngest() const
+{
+    return m_isStreamingIngest;
+}
+
+CSVData Processing::GetSelectedDataFromFile( QString filePath, const QStringList& subjects, int subjectColumnID, int startProfile, int endProfile )
+{
+    /** Not cached: the selection changes with the subjects and the arc lengths **/
+    return CSVReader( m_csvSeparator ).ReadSelection( filePath, subjects, subjectColumnID, startProfile, endProfile );
+}
+
+DiffusionProfileMatrix::ConstPointer Processing::GetSelectedProfileDataFromFile( QString filePath, const QStringList& subjects )
+{
+    /** As in DiffusionProfileMatrix::HasAtlas(), the atlas is the last column of the file **/
+    QStringList header = CSVReader( m_csvSeparator ).ReadHeader( filePath );
+    QStringList selectedSubjects = subjects;
+    if( header.size() > 1 && header.last().contains( "atlas", Qt::CaseInsensitive ) )
+    {
+        selectedSubjects.append( header.last() );
     }
 
-    return fileData;
+    return DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( GetSelectedDataFromFile( filePath, selectedSubjects, 0, -1, -1 ) ) );
+}
+
+QStringList Processing::GetSubjectsFromProfileFile( QString filePath )
+{
+    QStringList subjectList = CSVReader( m_csvSeparator ).ReadHeader( filePath ).mid( 1 );
+    subjectList.sort();
+
+    return subjectList;
 }
 
 bool Processing::IsMatrixDimensionOK( const QList< QStringList >& data )
@@ -103,39 +119,24 @@ bool Processing::IsSubMatrix( const QList< QStringList >& data )
     return !ok;
 }
 
-bool Processing::AreDuplicatesFound( const QList< QStringList >& data )
+bool Processing::AreDuplicatesFound( const CSVData& data )
 {
-    bool isSubMatrixData = IsSubMatrix( data );
-    QStringList subjects = isSubMatrixData ? Transpose( data ).first() : data.first();
-    int duplicateSubjectsFound = 0;
-
-    duplicateSubjectsFound = subjects.removeDuplicates();
-
-    return duplicateSubjectsFound != 0;
+    /** Duplicates are found while the file is parsed **/
+    return !data.GetDuplicates().isEmpty();
 }
 
-QStringList Processing::GetNANSubjects( const QList< QStringList >& faData, const QStringList& matchedSubjects )
+QStringList Processing::GetNANSubjects( const DiffusionProfileMatrix& faData, const QStringList& matchedSubjects )
 {
-    QList< QStringList > tempData = Transpose( faData );
+    QSet< int > matchedSubjectIDs = SubjectRegistry::GetInstance().GetIDSet( matchedSubjects );
+    QVector< int > subjectIDs = faData.GetSubjectIDs();
+    QStringList subjects = faData.GetSubjects();
     QStringList nanSubjects;
 
-    foreach( QStringList row, tempData )
+    for( int subjectIndex = 0; subjectIndex < subjects.size(); subjectIndex++ )
     {
-        int i = 1;
-        bool found = false;
-        QString currentSubject = row.first();
-
-        if( matchedSubjects.contains( currentSubject ) )
+        if( faData.HasNAN( subjectIndex ) && matchedSubjectIDs.contains( subjectIDs.at( subjectIndex ) ) )
         {
-            while( i < row.size() && found == false )
-            {
-                if( row.at( i ) == "nan" || row.at( i ) == "-nan" )
-                {
-                    nanSubjects.append( row.first() );
-                    found = true;
-                }
-                i++;
-            }
+            nanSubjects.append( subjects.at( subjectIndex ) );
         }
     }
 
@@ -161,17 +162,30 @@ QStringList Processing::GetSubjectsFromFileList( QString filePath )
 {
     QStringList subjectList;
 
+    /** Compressed file read line by line as it is decompressed **/
     QFile file( filePath );
-    if( file.open( QIODevice::ReadOnly ) )
+    CompressedFileDevice decompressedFile( filePath );
+    QIODevice *device = &file;
+    if( CompressedFile::IsCompressed( filePath ) )
+    {
+        device = &decompressedFile;
+    }
+    if( device->open( QIODevice::ReadOnly ) )
     {
-        QTextStream ts( &file );
+        QTextStream ts( device );
 
         /** Read all the file line by line **/
         while( !ts.atEnd() )
         {
             subjectList.append( ts.readLine() );
         }
-        file.close();
+        device->close();
+
+        /** Truncated or corrupted file: handled as a file that cannot be read **/
+        if( decompressedFile.HasError() )
+        {
+            subjectList.clear();
+        }
 
         /** If only one line read, check for the carriage return character "\r" **/
         if(  subjectList.size() == 1 )
@@ -182,7 +196,7 @@ QStringList Processing::GetSubjectsFromFileList( QString filePath )
         subjectList.sort();
     }
 
-    return subjectList;
+    return SubjectRegistry::GetInstance().Intern( subjectList );
 }
 
 QStringList Processing::GetSubjectsFromData(const QList< QStringList >& data, int subjectColumnID )
@@ -207,7 +221,15 @@ QStringList Processing::GetSubjectsFromData(const QList< QStringList >& data, in
     }
     subjectList.sort();
 
-    return subjectList;
+    return SubjectRegistry::GetInstance().Intern( subjectList );
+}
+
+QStringList Processing::GetSubjectsFromData( const CSVData& data, int subjectColumnID )
+{
+    QStringList subjectList = data.IsSubMatrix() ? data.GetColumnText( subjectColumnID ) : data.GetHeader().mid( 1 );
+    subjectList.sort();
+
+    return SubjectRegistry::GetInstance().Intern( subjectList );
 }
 
 QMap< int, QString > Processing::GetCovariatesFromData( QList< QStringList > data, int subjectColumnID )
@@ -225,6 +247,21 @@ QMap< int, QString > Processing::GetCovariatesFromData( QList< QStringList > dat
     return covariates;
 }
 
+QMap< int, QString > Processing::GetCovariatesFromData( const CSVData& data, int subjectColumnID )
+{
+    QMap< int, QString > covariates;
+    QStringList header = data.GetHeader();
+    for( int column = 0; column < header.size(); ++column )
+    {
+        if( column != subjectColumnID )
+        {
+            covariates.insert( column, header.at( column ) );
+        }
+    }
+
+    return covariates;
+}
+
 QList< QStringList > Processing::Transpose( const QList< QStringList >& rawData )
 {
     QList< QStringList > rawDataTransposed;
@@ -243,23 +280,37 @@ QList< QStringList > Processing::Transpose( const QList< QStringList >& rawData
 
 bool Processing::RemoveUnmatchedSubjects( QList< QStringList >& rawData, QStringList& subjects, const QStringList& matchedSubjects )
 {
-    QList< QStringList > tempData;
+    QStringList rowSubjects;
+    rowSubjects.reserve( rawData.size() );
     for( int i = 0; i < rawData.size(); i++ )
     {
-        QString currentSubject = rawData.at( i ).first();
+        rowSubjects.append( rawData.at( i ).first() );
+    }
+
+    /** Rows of the matched subjects kept in the same order, duplicates included **/
+    SelectionPlan selectionPlan;
+    selectionPlan.Build( rowSubjects, matchedSubjects, 0, false );
+    QVector< int > rowsKept = selectionPlan.GetIndices();
 
-        if( matchedSubjects.contains( currentSubject ) )
+    /** Subjects of the rows removed are removed from the list in one pass **/
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QSet< int > removedSubjectIDs;
+    for( int i = 0, keptIndex = 0; i < rowSubjects.size(); i++ )
+    {
+        if( keptIndex < rowsKept.size() && rowsKept.at( keptIndex ) == i )
         {
-            tempData.append( rawData.at( i ) );
+            keptIndex++;
         }
         else
         {
-            subjects.removeAll( currentSubject );
+            removedSubjectIDs.insert( registry.GetID( rowSubjects.at( i ) ) );
         }
     }
-
-    rawData.clear();
-    rawData = tempData;
+    if( !removedSubjectIDs.isEmpty() )
+    {
+        rawData = selectionPlan.Gather( rawData );
+        subjects = registry.Exclude( subjects, removedSubjectIDs );
+    }
 
     QStringList tempSubjects = subjects;
     tempSubjects.sort();
@@ -310,46 +361,7 @@ QList< double > Processing::GetMean( const QList< QList< double > >& rawDataDoub
 
 double Processing::ApplyPearsonCorrelation( const QList< double >& currentLine, const QList< double >& mean, int shift )
 {
-    double pearsonCorrelation = 1.0;
-    int nbrPoints = mean.size();
-
-    if( nbrPoints > 1)
-    {
-        double sumMean = 0;
-        for( int i = 0; i < nbrPoints; i++ )
-        {
-            sumMean += mean.at( i );
-        }
-
-        double sumMeanSquare = 0;
-        for( int i = 0; i < nbrPoints; i++ )
-        {
-            sumMeanSquare += mean.at( i ) * mean.at( i );
-        }
-
-        double sumCurrentLine = 0;
-        for( int i = shift; i < nbrPoints + shift; i++ )
-        {
-            sumCurrentLine += currentLine.at( i );
-        }
-
-        double sumCurrentLineSquare = 0;
-        for( int i = shift; i < nbrPoints + shift; i++ )
-        {
-            sumCurrentLineSquare += currentLine.at( i ) * currentLine.at( i );
-        }
-
-        double meanXcurrentLine = 0;
-        for( int i = 0; i < nbrPoints; i++ )
-        {
-            meanXcurrentLine += mean.at( i ) * currentLine.at( i + shift );
-        }
-
-        pearsonCorrelation = ( meanXcurrentLine - ( sumMean * sumCurrentLine ) / nbrPoints ) /
-                std::sqrt( ( sumMeanSquare - std::pow( sumMean, 2 ) / nbrPoints ) * ( sumCurrentLineSquare - std::pow( sumCurrentLine, 2 ) / nbrPoints ) );
-    }
-
-    return pearsonCorrelation;
+    return PearsonCorrelation( mean ).Correlate( currentLine.mid( shift ) );
 }
 
 
@@ -389,60 +401,19 @@ QMap< int, QStringList > Processing::GetSubjectsFromSelectedFiles( const QMap< i
     return subjectsFromSelectedFiles;
 }
 
-QMap< QString, QMap< int, bool > > Processing::SortSubjects( const QStringList &subjects, const QMap< int, QStringList >& subjectsMap )
+void Processing::MatchSubjects( const QStringList& allSubjectsList, const QMap< int, QStringList >& allSubjects,
+                                QStringList& matchedSubjects, QMap< QString, QList< int > >& unMatchedSubjects )
 {
-    QMap< QString, QMap< int, bool > > sortedSubjects;
-    foreach( QString subject, subjects )
+    SubjectMatcher subjectMatcher;
+    subjectMatcher.SetSubjects( allSubjectsList );
+    QMap< int, QStringList >::ConstIterator iterSubjects = allSubjects.cbegin();
+    while( iterSubjects != allSubjects.cend() )
     {
-        QMap< int, QStringList >::ConstIterator iterSubjects = subjectsMap.cbegin();
-        while( iterSubjects != subjectsMap.cend() )
-        {
-            ( ( sortedSubjects[subject] )[iterSubjects.key()] ) = iterSubjects.value().contains( subject ) ? true : false;
-            ++iterSubjects;
-        }
+        subjectMatcher.SetSource( iterSubjects.key(), iterSubjects.value() );
+        ++iterSubjects;
     }
 
-    return sortedSubjects;
-}
-
-void Processing::AssignSortedSubject( const QMap<QString, QMap< int, bool > >& sortedSubjects, QStringList& matchedSubjects, QMap<QString, QList< int > >& unMatchedSubjects )
-{
-    /** We go through all the sorted subjects **/
-    QMap< QString, QMap< int, bool > >::ConstIterator iterSortedSubjects = sortedSubjects.cbegin();
-    while( iterSortedSubjects != sortedSubjects.cend() )
-    {
-        bool subjectInAll = true;
-
-        /** For each subjects, we check if it is contained in the required files/list **/
-        QMap< int, bool >::ConstIterator iterSubject = iterSortedSubjects.value().cbegin();
-        while( iterSubject != iterSortedSubjects.value().cend() )
-        {
-            subjectInAll = subjectInAll && iterSubject.value();
-            ++iterSubject;
-        }
-
-        /** If the subject is found in all of the required files/list, it is added to the matched subjects QStringList **/
-        if( subjectInAll )
-        {
-            matchedSubjects.append( iterSortedSubjects.key() );
-        }
-        /** Otherwise the subject is added to the unmatched subjects QMap with the index of the diffusion property file where
-         *  the subject has been found in and, if necessary the index of the loaded subject list (-1) **/
-        else
-        {
-            QMap< int, bool >::ConstIterator iterSubject = iterSortedSubjects.value().cbegin();
-            while( iterSubject != iterSortedSubjects.value().cend() )
-            {
-                if( iterSubject.value() )
-                {
-                    ( unMatchedSubjects[iterSortedSubjects.key()] ).append( iterSubject.key() );
-                }
-                ++iterSubject;
-                unMatchedSubjects[iterSortedSubjects.key()];
-            }
-        }
-        ++iterSortedSubjects;
-    }
+    subjectMatcher.Match( matchedSubjects, unMatchedSubjects );
 }
 
 
@@ -455,167 +426,138 @@ QMap< int, QString > Processing::GenerateMatlabInputs( QString outputDir, QStrin
      *  the originals inchanged **/
     QMap< int, QString > matlabInputs;
 
+    MatlabInputSelection selection;
+    selection.covariates = covariates;
+    selection.subjectColumnID = subjectColumnID;
+    selection.subjects = subjects;
+    selection.startProfile = startProfile;
+    selection.endProfile = endProfile;
+
+    /** The files are independent: each one is generated by its own thread, the last one by the calling thread **/
+    QList< QFuture< bool > > futures;
+    QList< int > futureKeys;
+    QStringList futurePaths;
     QMap< int, QString >::ConstIterator iterInput = inputs.cbegin();
     QMap< int, QString >::ConstIterator iterProperty = properties.cbegin();
     while( iterInput != inputs.cend() )
     {
-        QFile matlabInput( outputDir + "/" + fiberName + "_RawData_" + iterProperty.value().toUpper() + ".csv" );
-        matlabInput.open( QIODevice::WriteOnly );
-        QTextStream tsM( &matlabInput );
-
-        QList< QStringList > data = GetDataFromFile( iterInput.value() );
-        int nbRows = data.count();
-        int nbColumns = data.first().count();
-
-        QStringList rowData;
-        QStringList subjectProcessed;
-        if( IsSubMatrix( data ) )
+        QString matlabInput = outputDir + "/" + fiberName + "_RawData_" + iterProperty.value().toUpper() + ".csv";
+        if( futures.size() < inputs.size() - 1 )
         {
-            /** File is SubMatrix -> subject data stored by row.
-             *  Subjects are all in the column subjectColumnID. **/
-
-            for( int row = 0; row < nbRows; row++ )
-            {
-                rowData.clear();
-
-                QString currentSubject = data.at( row ).at( subjectColumnID );
-                /** If subject is not already stored. **/
-                if( !subjectProcessed.contains( currentSubject ) )
-                {
-
-                    /** 1st row is where all covariate names ares.
-                     *  If current subject is among the required subjects or on 1st column**/
-                    if( row == 0 || subjects.contains( currentSubject ) )
-                    {
-                        /** If row == 0 --> Only required covariates are kept. 'Intercept' (-1) is ignored.
-                         *  If subjects.contains( currentSubject ) --> Data in the required covariates columns is kept **/
-                        QMap< int, QString >::ConstIterator iterCovariate = covariates.cbegin();
-                        while( iterCovariate != covariates.cend() )
-                        {
-                            int covariateID = iterCovariate.key();
-                            if( covariateID != -1 )
-                            {
-                                rowData.append( data.at( row ).at( covariateID ) );
-                            }
-                            ++iterCovariate;
-                        }
-                    }
-
-                    /** If not empty, row is added to the new file **/
-                    if( !rowData.isEmpty() )
-                    {
-                        rowData.prepend( currentSubject );
-                        tsM << QObject::tr( qPrintable( rowData.join( m_csvSeparator ) ) ) << endl;
-                    }
-
-                    /** Update the list of subjects added to the new file to avoid duplicates **/
-                    subjectProcessed.append( currentSubject );
-                }
-            }
+            futures.append( QtConcurrent::run( this, &Processing::GenerateMatlabInput, iterInput.value(), matlabInput, &selection ) );
+            futureKeys.append( iterInput.key() );
+            futurePaths.append( matlabInput );
+        }
+        else if( GenerateMatlabInput( iterInput.value(), matlabInput, &selection ) )
+        {
+            matlabInputs.insert( iterInput.key(), matlabInput );
         }
         else
         {
-            /** File is either AD, RD, MD or FA -> subject data stored by column.
-             *  Subjects are all in the 1s row.
-             *  1st column is Arc Length **/
-
-            /** Index of the required columns are saved.
-             *  The column index is saved only if the subject linked to this index is
-             *  among the required subjects and is not a duplicate.
-             *  0 is always saved. **/
-            QList< int > columnIndex;
-            columnIndex.append( 0 );
-            for( int column = 1; column < nbColumns; column++ )
-            {
-                QString currentSubject = data.first().at( column );
-                if( ( subjects.contains( currentSubject ) && !subjectProcessed.contains( currentSubject ) ) )
-                {
-                    columnIndex.append( column );
-                    subjectProcessed.append( currentSubject );
-                }
-            }
-
-            /** Adding 1st row **/
-            foreach ( int index, columnIndex )
-            {
-                rowData << data.at( 0 ).at( index );
-            }
-            tsM << QObject::tr( qPrintable( rowData.join( m_csvSeparator ) ) ) << endl;
-
-            /** Look through the 'original' and copy data to the new one **/
-            int profileFirstIndex = startProfile == -1 ? 1 : startProfile + 1;
-            int profileLastIndex = endProfile == -1 ? nbRows : endProfile + 2;
-            for( int row = profileFirstIndex; row < profileLastIndex; ++row )
-            {
-                rowData.clear();
-                foreach ( int index, columnIndex )
-                {
-                    rowData << data.at( row ).at( index );
-                }
-                tsM << QObject::tr( qPrintable( rowData.join( m_csvSeparator ) ) ) << endl;
-            }
+            std::cerr << "Failed to generate " << matlabInput.toStdString() << " from " << iterInput.value().toStdString() << std::endl;
         }
-        matlabInput.flush();
-        matlabInput.close();
-
-        /** Update QMap where the path of the new files is stored **/
-        matlabInputs.insert( iterInput.key(), matlabInput.fileName() );
 
         ++iterInput;
         ++iterProperty;
     }
 
+    /** Update QMap where the path of the new files is stored, files that could not be generated being left out **/
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        if( futures[ i ].result() )
+        {
+            matlabInputs.insert( futureKeys.at( i ), futurePaths.at( i ) );
+        }
+        else
+        {
+            std::cerr << "Failed to generate " << futurePaths.at( i ).toStdString() << " from " << inputs.value( futureKeys.at( i ) ).toStdString() << std::endl;
+        }
+    }
+
     return matlabInputs;
 }
 
 
-void Processing::ApplyQCThreshold_noGUI( const QList< QStringList >& rawData, bool useAtlas, QStringList& matchedSubjects, QStringList& qcThresholdFailedSubject, const double& qcThreshold )
+bool Processing::GenerateMatlabInput( QString inputPath, QString outputPath, const MatlabInputSelection *selection )
 {
-    QStringList subjectsCorrelated, subjectsNotCorrelated;
-    QStringList subjects = rawData.first();
-
-    /*** Transpose ***/
-    QList< QStringList > rawDataTransposed = Transpose( rawData );
-
-    /*** Remove unmatched subjects ***/
-    RemoveUnmatchedSubjects( rawDataTransposed, subjects, matchedSubjects );
-
-    /*** To Double ***/
-    QList< QList< double > > rawDataDouble = DataToDouble( rawDataTransposed );
+    /** Whole file parsed by the cache, or only the subjects and the arc lengths required read from the 'original' file.
+     *  Either way the cells are copied as written in the 'original' file, read again from it for the data of the cache. **/
+    CSVData data = m_isStreamingIngest ? GetSelectedDataFromFile( inputPath, selection->subjects, selection->subjectColumnID,
+                                                                  selection->startProfile, selection->endProfile )
+                                       : GetNumericDataFromFile( inputPath );
+    if( data.IsEmpty() )
+    {
+        return false;
+    }
 
-    /*** Get Ref ***/
-    QList< double > ref;
-    if( useAtlas )
+    QVector< int > rowIndex;
+    QVector< int > columnIndex;
+    if( data.IsSubMatrix() )
     {
-        if( rawData.first().last().contains( "atlas", Qt::CaseInsensitive ) )
+        /** File is SubMatrix -> subject data stored by row.
+         *  Subjects are all in the column subjectColumnID. **/
+        QStringList rowSubjects = QStringList() << data.GetHeader().value( selection->subjectColumnID )
+                                                << data.GetColumnText( selection->subjectColumnID );
+
+        /** Rows of the required subjects, each subject once, the 1st row (covariate names) being always kept **/
+        SelectionPlan rowPlan;
+        rowPlan.Build( rowSubjects, selection->subjects, 1, true );
+        rowIndex = rowPlan.GetIndices();
+        rowIndex.prepend( 0 );
+
+        /** Only required covariates are kept, after the subjects. 'Intercept' (-1) is ignored. **/
+        QMap< int, QString >::ConstIterator iterCovariate = selection->covariates.cbegin();
+        while( iterCovariate != selection->covariates.cend() )
         {
-            for( int i = 1; i < rawData.size(); i++ )
+            if( iterCovariate.key() != -1 )
             {
-                ref.append( rawData.at( i ).last().toDouble() );
+                columnIndex.append( iterCovariate.key() );
             }
+            ++iterCovariate;
         }
+
+        /** If no covariate is required, no row is added to the new file **/
+        if( columnIndex.isEmpty() )
+        {
+            rowIndex.clear();
+        }
+        columnIndex.prepend( selection->subjectColumnID );
     }
     else
     {
-        ref = GetMean( rawDataDouble, 1 );
+        /** File is either AD, RD, MD or FA -> subject data stored by column.
+         *  Subjects are all in the 1s row.
+         *  1st column is Arc Length **/
+
+        /** Index of the required columns are saved.
+         *  The column index is saved only if the subject linked to this index is
+         *  among the required subjects and is not a duplicate.
+         *  0 is always saved. **/
+        SelectionPlan columnPlan;
+        columnPlan.Build( data.GetHeader(), selection->subjects, 1, true );
+        columnIndex = columnPlan.GetIndices();
+        columnIndex.prepend( 0 );
+
+        /** 1st row, then the rows of the arc lengths required. A selection read from the file holds these rows only. **/
+        int nbRows = data.GetNbrRows();
+        int profileFirstIndex = m_isStreamingIngest || selection->startProfile == -1 ? 1 : selection->startProfile + 1;
+        int profileLastIndex = m_isStreamingIngest || selection->endProfile == -1 ? nbRows : qMin( selection->endProfile + 2, nbRows );
+        rowIndex.reserve( qMax( profileLastIndex - profileFirstIndex, 0 ) + 1 );
+        rowIndex.append( 0 );
+        for( int row = profileFirstIndex; row < profileLastIndex; ++row )
+        {
+            rowIndex.append( row );
+        }
     }
 
-    /*** Apply QCThreshold ***/
-    for( int i = 1; i < rawDataDouble.size(); i++ )
+    /** The cells kept are gathered and written at once **/
+    QFile matlabInput( outputPath );
+    if( !matlabInput.open( QIODevice::WriteOnly ) )
     {
-        double pearsonCorrelation = ApplyPearsonCorrelation( rawDataDouble.at( i ), ref, 1 );
-
-        if( pearsonCorrelation < qcThreshold )
-        {
-            subjectsNotCorrelated.append( rawDataTransposed.at( i ).first() );
-        }
-        else
-        {
-            subjectsCorrelated.append( rawDataTransposed.at( i ).first() );
-        }
+        return false;
     }
+    bool isWritten = CSVWriter( m_csvSeparator ).Write( matlabInput, data, rowIndex, columnIndex ) && matlabInput.flush();
+    matlabInput.close();
 
-    matchedSubjects = subjectsCorrelated;
-    qcThresholdFailedSubject = subjectsNotCorrelated;
+    return isWritten;
 }
-
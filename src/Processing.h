@@ -11,6 +11,7 @@
 #include <QTextStream>
 #include <QCheckBox>
 #include <QMap>
+#include <QSet>
 
 
 class Processing : public QObject
@@ -23,13 +24,33 @@ public:
 
     QList< QStringList > GetDataFromFile( QString filePath ); // Tested
 
+    CSVData GetNumericDataFromFile( QString filePath ); // Not Directly Tested
+
+    DiffusionProfileMatrix::ConstPointer GetProfileDataFromFile( QString filePath ); // Not Directly Tested
+
+
+    /** Streaming ingest: the input files are read block by block and only the subjects and arc lengths selected are kept,
+     *  instead of the whole files (see CSVReader::ReadSelection()). Used by GenerateMatlabInputs() when set. **/
+    void SetStreamingIngest( bool isStreamingIngest ); // Tested
+
+    bool IsStreamingIngest() const; // Tested
+
+    CSVData GetSelectedDataFromFile( QString filePath, const QStringList& subjects, int subjectColumnID, int startProfile, int endProfile ); // Not Directly Tested
+
+    /** Profiles of the subjects, atlas included if the file has one **/
+    DiffusionProfileMatrix::ConstPointer GetSelectedProfileDataFromFile( QString filePath, const QStringList& subjects ); // Tested
+
+    /** Subjects of a profile file, only its 1st row is read **/
+    QStringList GetSubjectsFromProfileFile( QString filePath ); // Tested
+
+
     bool IsMatrixDimensionOK( const QList< QStringList >& data ); // Tested
 
     bool IsSubMatrix(const QList< QStringList >& data ); // Tested
 
-    bool AreDuplicatesFound( const QList< QStringList >& data );
+    bool AreDuplicatesFound( const CSVData& data );
 
-    QStringList GetNANSubjects( const QList< QStringList >& faData, const QStringList& matchedSubjects );
+    QStringList GetNANSubjects( const DiffusionProfileMatrix& faData, const QStringList& matchedSubjects );
 
     void NANToZeros( QList< QList< double > >& faData );
 
@@ -38,8 +59,12 @@ public:
 
     QStringList GetSubjectsFromData( const QList< QStringList >& data, int subjectColumnID ); // Tested
 
+    QStringList GetSubjectsFromData( const CSVData& data, int subjectColumnID ); // Tested
+
     QMap< int, QString > GetCovariatesFromData( QList< QStringList > data, int subjectColumnID ); //Tested
 
+    QMap< int, QString > GetCovariatesFromData( const CSVData& data, int subjectColumnID ); // Tested
+
 
     QList< QStringList > Transpose( const QList< QStringList >& rawData ); // Tested
 
@@ -58,22 +83,36 @@ public:
 
     QMap< int, QStringList > GetSubjectsFromSelectedFiles( const QMap< int, bool >& diffusionPropertiesCheckState, const QMap< int, QStringList >& subjectsMap ); // Tested
 
-    QMap< QString, QMap< int, bool > > SortSubjects( const QStringList& allSubjectsList, const QMap< int, QStringList >& allSubjects ); // Tested
-
-    void AssignSortedSubject( const QMap<QString, QMap< int, bool > >& checkedSubjects, QStringList& matchedSubjects, QMap<QString, QList<int> >& unMatchedSubjects ); // Tested
+    /** Subjects of allSubjectsList found in every list of allSubjects, and the others with the indices of the lists holding them (see SubjectMatcher) **/
+    void MatchSubjects( const QStringList& allSubjectsList, const QMap< int, QStringList >& allSubjects,
+                        QStringList& matchedSubjects, QMap< QString, QList< int > >& unMatchedSubjects ); // Tested
 
 
+    /** Paths of the files generated, by the keys of inputs. Inputs whose file could not be generated are reported and left out. **/
     QMap< int, QString > GenerateMatlabInputs( QString outputDir, QString fiberName,
                                                const QMap< int, QString >& inputs, const QMap< int, QString >& properties,
                                                const QMap< int, QString >& covariates, int subjectColumnID, const QStringList& subjects, int startProfile, int endProfile ); // Tested
 
 
-    void ApplyQCThreshold_noGUI( const QList< QStringList >& rawData, bool useAtlas, QStringList& matchedSubjects, QStringList& qcThresholdFailedSubject, const double& qcThreshold ); // Not Directly Tested
-
-
 private:
+    /** Selection shared by the MATLAB inputs generated at the same time **/
+    struct MatlabInputSelection
+    {
+        QMap< int, QString > covariates;
+        int subjectColumnID;
+        QStringList subjects;
+        int startProfile;
+        int endProfile;
+    };
+
     static const QString m_csvSeparator;
 
+    bool m_isStreamingIngest;
+
+
+    /** Copies the data selected from inputPath to outputPath, returns false if inputPath cannot be read or outputPath written **/
+    bool GenerateMatlabInput( QString inputPath, QString outputPath, const MatlabInputSelection *selection ); // Not Directly Tested
+
 };
 
 #endif // PROCESSING_H
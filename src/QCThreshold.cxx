@@ -0,0 +1,391 @@
+#include "QCThreshold.h"
+#include "PearsonCorrelation.h"
+#include "SubjectRegistry.h"
+
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+
+//#include <QDebug>
+
+
+const double QCThreshold::m_defaultFPCAQCThreshold = 0.01;
+
+QCThreshold::QCThreshold()
+{
+    m_rule = AnyFail;
+    m_metric = Correlation;
+    m_nbrThreads = 0;
+}
+
+
+bool QCThreshold::GetRule( const QString& ruleName, Rule& rule )
+{
+    if( ruleName.compare( "anyFail", Qt::CaseInsensitive ) == 0 )
+    {
+        rule = AnyFail;
+        return true;
+    }
+    if( ruleName.compare( "allFail", Qt::CaseInsensitive ) == 0 )
+    {
+        rule = AllFail;
+        return true;
+    }
+
+    return false;
+}
+
+QString QCThreshold::GetRuleName( Rule rule )
+{
+    return rule == AllFail ? "allFail" : "anyFail";
+}
+
+bool QCThreshold::GetMetric( const QString& metricName, Metric& metric )
+{
+    if( metricName.compare( "correlation", Qt::CaseInsensitive ) == 0 )
+    {
+        metric = Correlation;
+        return true;
+    }
+    if( metricName.compare( "fpca", Qt::CaseInsensitive ) == 0 )
+    {
+        metric = FPCA;
+        return true;
+    }
+
+    return false;
+}
+
+QString QCThreshold::GetMetricName( Metric metric )
+{
+    return metric == FPCA ? "fpca" : "correlation";
+}
+
+double QCThreshold::GetDefaultFPCAQCThreshold()
+{
+    return m_defaultFPCAQCThreshold;
+}
+
+QVector< double > QCThreshold::Correlate( const DiffusionProfileMatrix& rawData, bool useAtlas, const QCThresholdReference& reference,
+                                          const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads )
+{
+    QList< DiffusionProfileMatrix::View > profiles = GetProfiles( rawData, subjectIDs, subjectIndexes );
+
+    /*** Get Ref ***/
+    QList< double > ref;
+    if( useAtlas )
+    {
+        ref = rawData.GetAtlas().ToList();
+    }
+    else
+    {
+        QCThresholdReference subjectsReference = reference;
+        subjectsReference.SetNbrThreads( nbrThreads );
+        ref = subjectsReference.Compute( profiles, rawData.GetNbrArcLengths() );
+    }
+
+    /*** Every subject correlated with the reference at once ***/
+    PearsonCorrelation pearsonCorrelation( ref );
+    pearsonCorrelation.SetNbrThreads( nbrThreads );
+
+    return pearsonCorrelation.Correlate( profiles );
+}
+
+QVector< double > QCThreshold::Score( const DiffusionProfileMatrix& rawData, const FunctionalPCA& functionalPCA,
+                                      const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads )
+{
+    QList< DiffusionProfileMatrix::View > profiles = GetProfiles( rawData, subjectIDs, subjectIndexes );
+
+    FunctionalPCA subjectsFunctionalPCA = functionalPCA;
+    subjectsFunctionalPCA.SetNbrThreads( nbrThreads );
+
+    return subjectsFunctionalPCA.Score( profiles, 0, rawData.GetNbrArcLengths() - 1 );
+}
+
+
+void QCThreshold::SetRule( Rule rule )
+{
+    m_rule = rule;
+}
+
+QCThreshold::Rule QCThreshold::GetRule() const
+{
+    return m_rule;
+}
+
+void QCThreshold::SetReference( const QCThresholdReference& reference )
+{
+    m_reference = reference;
+}
+
+const QCThresholdReference& QCThreshold::GetReference() const
+{
+    return m_reference;
+}
+
+void QCThreshold::SetMetric( Metric metric )
+{
+    m_metric = metric;
+}
+
+QCThreshold::Metric QCThreshold::GetMetric() const
+{
+    return m_metric;
+}
+
+void QCThreshold::SetFunctionalPCA( const FunctionalPCA& functionalPCA )
+{
+    m_functionalPCA = functionalPCA;
+}
+
+const FunctionalPCA& QCThreshold::GetFunctionalPCA() const
+{
+    return m_functionalPCA;
+}
+
+void QCThreshold::SetNbrThreads( int nbrThreads )
+{
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+void QCThreshold::AddProperty( const QString& property, const DiffusionProfileMatrix::ConstPointer& rawData, double qcThreshold, double fpcaQCThreshold, bool useAtlas )
+{
+    PropertyQCThreshold propertyQCThreshold;
+    propertyQCThreshold.property = property;
+    propertyQCThreshold.rawData = rawData;
+    propertyQCThreshold.qcThreshold = qcThreshold;
+    propertyQCThreshold.fpcaQCThreshold = fpcaQCThreshold;
+    propertyQCThreshold.useAtlas = useAtlas;
+
+    int propertyIndex = GetPropertyIndex( property );
+    if( propertyIndex == -1 )
+    {
+        m_properties.append( propertyQCThreshold );
+    }
+    else
+    {
+        m_properties[ propertyIndex ] = propertyQCThreshold;
+    }
+}
+
+void QCThreshold::Clear()
+{
+    m_properties.clear();
+    m_subjects.clear();
+}
+
+QStringList QCThreshold::GetProperties() const
+{
+    QStringList properties;
+    foreach( const PropertyQCThreshold& propertyQCThreshold, m_properties )
+    {
+        properties.append( propertyQCThreshold.property );
+    }
+
+    return properties;
+}
+
+double QCThreshold::GetQCThreshold( const QString& property ) const
+{
+    return GetQCThreshold( property, m_metric );
+}
+
+double QCThreshold::GetQCThreshold( const QString& property, Metric metric ) const
+{
+    int propertyIndex = GetPropertyIndex( property );
+    if( propertyIndex == -1 )
+    {
+        return -1;
+    }
+
+    return metric == FPCA ? m_properties.at( propertyIndex ).fpcaQCThreshold : m_properties.at( propertyIndex ).qcThreshold;
+}
+
+
+void QCThreshold::Apply( const QStringList& subjects )
+{
+    m_subjects = subjects;
+    QSet< int > subjectIDs = SubjectRegistry::GetInstance().GetIDSet( subjects );
+
+    /** Threads shared between the properties, the last property checked by the calling thread **/
+    int nbrThreads = m_nbrThreads > 0 ? m_nbrThreads : QThread::idealThreadCount();
+    int nbrThreadsPerProperty = qMax( nbrThreads / qMax( m_properties.size(), 1 ), 1 );
+    QList< QFuture< void > > futures;
+    for( int propertyIndex = 0; propertyIndex < m_properties.size(); propertyIndex++ )
+    {
+        /** Element taken by the calling thread: the threads never detach m_properties **/
+        PropertyQCThreshold *propertyQCThreshold = &m_properties[ propertyIndex ];
+        if( propertyIndex < m_properties.size() - 1 )
+        {
+            futures.append( QtConcurrent::run( this, &QCThreshold::ApplyProperty, propertyQCThreshold, subjectIDs, nbrThreadsPerProperty ) );
+        }
+        else
+        {
+            ApplyProperty( propertyQCThreshold, subjectIDs, nbrThreadsPerProperty );
+        }
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+}
+
+void QCThreshold::SetResults( const QCThreshold& qcThreshold )
+{
+    m_subjects = qcThreshold.m_subjects;
+    foreach( const PropertyQCThreshold& appliedProperty, qcThreshold.m_properties )
+    {
+        int propertyIndex = GetPropertyIndex( appliedProperty.property );
+        if( propertyIndex != -1 )
+        {
+            m_properties[ propertyIndex ].checkedSubjectIDs = appliedProperty.checkedSubjectIDs;
+            m_properties[ propertyIndex ].failedSubjectIDs = appliedProperty.failedSubjectIDs;
+        }
+    }
+}
+
+void QCThreshold::SetSubjectsNotCorrelated( const QString& property, double qcThreshold, const QStringList& subjectsNotCorrelated )
+{
+    int propertyIndex = GetPropertyIndex( property );
+    if( propertyIndex != -1 )
+    {
+        PropertyQCThreshold& propertyQCThreshold = m_properties[ propertyIndex ];
+        if( m_metric == FPCA )
+        {
+            propertyQCThreshold.fpcaQCThreshold = qcThreshold;
+        }
+        else
+        {
+            propertyQCThreshold.qcThreshold = qcThreshold;
+        }
+        propertyQCThreshold.failedSubjectIDs = SubjectRegistry::GetInstance().GetIDSet( subjectsNotCorrelated ) & propertyQCThreshold.checkedSubjectIDs;
+    }
+}
+
+QStringList QCThreshold::GetSubjectsNotCorrelated( const QString& property ) const
+{
+    int propertyIndex = GetPropertyIndex( property );
+    QStringList subjectsNotCorrelated;
+    if( propertyIndex != -1 )
+    {
+        SubjectRegistry& registry = SubjectRegistry::GetInstance();
+        foreach( const QString& subject, m_subjects )
+        {
+            if( m_properties.at( propertyIndex ).failedSubjectIDs.contains( registry.FindID( subject ) ) )
+            {
+                subjectsNotCorrelated.append( subject );
+            }
+        }
+    }
+
+    return subjectsNotCorrelated;
+}
+
+QStringList QCThreshold::GetSubjectsCorrelated() const
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QStringList subjectsCorrelated;
+    foreach( const QString& subject, m_subjects )
+    {
+        if( !IsNotCorrelated( registry.FindID( subject ) ) )
+        {
+            subjectsCorrelated.append( subject );
+        }
+    }
+
+    return subjectsCorrelated;
+}
+
+QStringList QCThreshold::GetSubjectsNotCorrelated() const
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QStringList subjectsNotCorrelated;
+    foreach( const QString& subject, m_subjects )
+    {
+        if( IsNotCorrelated( registry.FindID( subject ) ) )
+        {
+            subjectsNotCorrelated.append( subject );
+        }
+    }
+
+    return subjectsNotCorrelated;
+}
+
+
+void QCThreshold::ApplyProperty( PropertyQCThreshold *propertyQCThreshold, const QSet< int >& subjectIDs, int nbrThreads )
+{
+    QVector< int > subjectIndexes;
+    QVector< double > correlations = m_metric == FPCA ?
+                Score( *propertyQCThreshold->rawData, m_functionalPCA, subjectIDs, subjectIndexes, nbrThreads ) :
+                Correlate( *propertyQCThreshold->rawData, propertyQCThreshold->useAtlas, m_reference, subjectIDs, subjectIndexes, nbrThreads );
+
+    double qcThreshold = m_metric == FPCA ? propertyQCThreshold->fpcaQCThreshold : propertyQCThreshold->qcThreshold;
+
+    QVector< int > rawDataSubjectIDs = propertyQCThreshold->rawData->GetSubjectIDs();
+    propertyQCThreshold->checkedSubjectIDs.clear();
+    propertyQCThreshold->failedSubjectIDs.clear();
+    for( int i = 0; i < correlations.size(); i++ )
+    {
+        int subjectID = rawDataSubjectIDs.at( subjectIndexes.at( i ) );
+        propertyQCThreshold->checkedSubjectIDs.insert( subjectID );
+        if( correlations.at( i ) < qcThreshold )
+        {
+            propertyQCThreshold->failedSubjectIDs.insert( subjectID );
+        }
+    }
+}
+
+QList< DiffusionProfileMatrix::View > QCThreshold::GetProfiles( const DiffusionProfileMatrix& rawData, const QSet< int >& subjectIDs, QVector< int >& subjectIndexes )
+{
+    QVector< int > rawDataSubjectIDs = rawData.GetSubjectIDs();
+
+    subjectIndexes.clear();
+    QList< DiffusionProfileMatrix::View > profiles;
+    for( int subjectIndex = 0; subjectIndex < rawDataSubjectIDs.size(); subjectIndex++ )
+    {
+        if( subjectIDs.contains( rawDataSubjectIDs.at( subjectIndex ) ) )
+        {
+            subjectIndexes.append( subjectIndex );
+            profiles.append( rawData.GetSubjectProfile( subjectIndex ) );
+        }
+    }
+
+    return profiles;
+}
+
+int QCThreshold::GetPropertyIndex( const QString& property ) const
+{
+    for( int propertyIndex = 0; propertyIndex < m_properties.size(); propertyIndex++ )
+    {
+        if( m_properties.at( propertyIndex ).property == property )
+        {
+            return propertyIndex;
+        }
+    }
+
+    return -1;
+}
+
+bool QCThreshold::IsNotCorrelated( int subjectID ) const
+{
+    /** AllFail: rejected if checked for at least one property and failing all the properties it was checked for **/
+    bool isChecked = false;
+    foreach( const PropertyQCThreshold& propertyQCThreshold, m_properties )
+    {
+        if( propertyQCThreshold.checkedSubjectIDs.contains( subjectID ) )
+        {
+            isChecked = true;
+            bool isFailed = propertyQCThreshold.failedSubjectIDs.contains( subjectID );
+            if( m_rule == AnyFail && isFailed )
+            {
+                return true;
+            }
+            if( m_rule == AllFail && !isFailed )
+            {
+                return false;
+            }
+        }
+    }
+
+    return m_rule == AllFail && isChecked;
+}
@@ -0,0 +1,144 @@
+#ifndef QCTHRESHOLD_H
+#define QCTHRESHOLD_H
+
+#include "DiffusionProfileMatrix.h"
+#include "QCThresholdReference.h"
+#include "FunctionalPCA.h"
+
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QSet>
+
+/** QC threshold applied to several diffusion properties, each with its own thresholds and reference (atlas, or mean, median... of the subjects).
+ *  The subjects are scored by their correlation with the reference, or by their functional PCA outlier score, both between 0 and 1,
+ *  each metric being compared to its own threshold: a correlation close to 1 is expected, an outlier score only has to stay off 0.
+ *  The properties are scored concurrently, then a subject is rejected if it fails the threshold of any property,
+ *  or only if it fails the threshold of every property checked for it. **/
+class QCThreshold
+{
+    friend class TestQCThreshold; /** For unit tests **/
+
+public:
+    enum Rule { AnyFail, AllFail };
+
+    enum Metric { Correlation, FPCA };
+
+    QCThreshold();
+
+
+    /** "anyFail" or "allFail", false if the name is unknown **/
+    static bool GetRule( const QString& ruleName, Rule& rule ); // Tested
+
+    static QString GetRuleName( Rule rule ); // Tested
+
+    /** "correlation" or "fpca", false if the name is unknown **/
+    static bool GetMetric( const QString& metricName, Metric& metric ); // Tested
+
+    static QString GetMetricName( Metric metric ); // Tested
+
+    /** Outlier score under which a subject fails when no threshold is given for the FPCA metric **/
+    static double GetDefaultFPCAQCThreshold(); // Tested
+
+    /** Correlations with the reference of the subjects of rawData found in subjectIDs, and their indexes in rawData.
+     *  reference: computed from the subjects found when the atlas is not used **/
+    static QVector< double > Correlate( const DiffusionProfileMatrix& rawData, bool useAtlas, const QCThresholdReference& reference,
+                                        const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads ); // Tested
+
+    /** Functional PCA outlier scores of the subjects of rawData found in subjectIDs, and their indexes in rawData. The atlas is not used. **/
+    static QVector< double > Score( const DiffusionProfileMatrix& rawData, const FunctionalPCA& functionalPCA,
+                                    const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads ); // Tested
+
+
+    void SetRule( Rule rule ); // Tested
+
+    Rule GetRule() const; // Tested
+
+    /** Reference of the properties not using their atlas, the mean by default **/
+    void SetReference( const QCThresholdReference& reference ); // Tested
+
+    const QCThresholdReference& GetReference() const; // Tested
+
+    /** Correlation with the reference by default **/
+    void SetMetric( Metric metric ); // Tested
+
+    Metric GetMetric() const; // Tested
+
+    /** Settings of the functional PCA used by the FPCA metric **/
+    void SetFunctionalPCA( const FunctionalPCA& functionalPCA ); // Tested
+
+    const FunctionalPCA& GetFunctionalPCA() const; // Tested
+
+    /** 0: as many threads as cores, shared between the properties **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+    /** Profiles correlated with the atlas of rawData if useAtlas, with the reference of the subjects checked otherwise.
+     *  qcThreshold: compared to the correlations, fpcaQCThreshold: compared to the functional PCA outlier scores **/
+    void AddProperty( const QString& property, const DiffusionProfileMatrix::ConstPointer& rawData, double qcThreshold, double fpcaQCThreshold, bool useAtlas ); // Tested
+
+    void Clear(); // Tested
+
+    QStringList GetProperties() const; // Tested
+
+    /** Threshold of the metric used **/
+    double GetQCThreshold( const QString& property ) const; // Tested
+
+    double GetQCThreshold( const QString& property, Metric metric ) const; // Tested
+
+
+    /** Every property checked concurrently. A subject missing from the file of a property is not checked for it. **/
+    void Apply( const QStringList& subjects ); // Tested
+
+    /** Subjects and results of the properties taken from a copy applied meanwhile, e.g. in a worker thread. Settings and thresholds kept. **/
+    void SetResults( const QCThreshold& qcThreshold ); // Tested
+
+    /** Result of a property replaced, e.g. once its threshold is changed in the QC threshold dialog. qcThreshold: threshold of the metric used **/
+    void SetSubjectsNotCorrelated( const QString& property, double qcThreshold, const QStringList& subjectsNotCorrelated ); // Tested
+
+    QStringList GetSubjectsNotCorrelated( const QString& property ) const; // Tested
+
+    /** Subjects given to Apply() split according to the rule, in the same order **/
+    QStringList GetSubjectsCorrelated() const; // Tested
+
+    QStringList GetSubjectsNotCorrelated() const; // Tested
+
+
+private:
+    struct PropertyQCThreshold
+    {
+        QString property;
+        DiffusionProfileMatrix::ConstPointer rawData;
+        double qcThreshold, fpcaQCThreshold;
+        bool useAtlas;
+        QSet< int > checkedSubjectIDs, failedSubjectIDs;
+    };
+
+    QList< PropertyQCThreshold > m_properties;
+
+    QStringList m_subjects;
+
+    Rule m_rule;
+
+    QCThresholdReference m_reference;
+
+    Metric m_metric;
+
+    FunctionalPCA m_functionalPCA;
+
+    int m_nbrThreads;
+
+    static const double m_defaultFPCAQCThreshold;
+
+
+    /** Run concurrently, each call only writes the results of its property **/
+    void ApplyProperty( PropertyQCThreshold *propertyQCThreshold, const QSet< int >& subjectIDs, int nbrThreads ); // Not Directly Tested
+
+    /** Profiles of the subjects of rawData found in subjectIDs, read in place **/
+    static QList< DiffusionProfileMatrix::View > GetProfiles( const DiffusionProfileMatrix& rawData, const QSet< int >& subjectIDs, QVector< int >& subjectIndexes ); // Not Directly Tested
+
+    int GetPropertyIndex( const QString& property ) const; // Not Directly Tested
+
+    bool IsNotCorrelated( int subjectID ) const; // Not Directly Tested
+};
+
+#endif // QCTHRESHOLD_H
@@ -0,0 +1,92 @@
+#include "QCThresholdCorrelations.h"
+
+#include <QPair>
+
+#include <algorithm>
+
+//#include <QDebug>
+
+
+QCThresholdCorrelations::QCThresholdCorrelations()
+{
+}
+
+
+void QCThresholdCorrelations::SetCorrelations( const QVector< double >& correlations )
+{
+    m_correlations = correlations;
+
+    QVector< QPair< double, int > > sortedLines;
+    sortedLines.reserve( correlations.size() );
+    for( int line = 0; line < correlations.size(); line++ )
+    {
+        /** A NaN cannot be ordered: these lines never change side **/
+        if( correlations.at( line ) == correlations.at( line ) )
+        {
+            sortedLines.append( qMakePair( correlations.at( line ), line ) );
+        }
+    }
+    std::sort( sortedLines.begin(), sortedLines.end() );
+
+    m_sortedLines.resize( sortedLines.size() );
+    m_sortedCorrelations.resize( sortedLines.size() );
+    for( int i = 0; i < sortedLines.size(); i++ )
+    {
+        m_sortedCorrelations[ i ] = sortedLines.at( i ).first;
+        m_sortedLines[ i ] = sortedLines.at( i ).second;
+    }
+}
+
+void QCThresholdCorrelations::Clear()
+{
+    m_correlations.clear();
+    m_sortedLines.clear();
+    m_sortedCorrelations.clear();
+}
+
+bool QCThresholdCorrelations::IsEmpty() const
+{
+    return m_correlations.isEmpty();
+}
+
+int QCThresholdCorrelations::GetNbrLines() const
+{
+    return m_correlations.size();
+}
+
+double QCThresholdCorrelations::GetCorrelation( int line ) const
+{
+    return m_correlations.at( line );
+}
+
+
+bool QCThresholdCorrelations::IsCorrelated( int line, double qcThreshold ) const
+{
+    return !( m_correlations.at( line ) < qcThreshold );
+}
+
+int QCThresholdCorrelations::GetNbrNotCorrelated( double qcThreshold ) const
+{
+    return GetSortedIndex( qcThreshold );
+}
+
+QList< int > QCThresholdCorrelations::GetLinesCrossing( double previousQCThreshold, double qcThreshold ) const
+{
+    int first = GetSortedIndex( qMin( previousQCThreshold, qcThreshold ) );
+    int last = GetSortedIndex( qMax( previousQCThreshold, qcThreshold ) );
+
+    QList< int > lines;
+    lines.reserve( last - first );
+    for( int i = first; i < last; i++ )
+    {
+        lines.append( m_sortedLines.at( i ) );
+    }
+
+    return lines;
+}
+
+
+int QCThresholdCorrelations::GetSortedIndex( double qcThreshold ) const
+{
+    return std::lower_bound( m_sortedCorrelations.constBegin(), m_sortedCorrelations.constEnd(), qcThreshold ) - m_sortedCorrelations.constBegin();
+}
@@ -0,0 +1,53 @@
+#ifndef QCTHRESHOLDCORRELATIONS_H
+#define QCTHRESHOLDCORRELATIONS_H
+
+#include <QVector>
+#include <QList>
+
+/** Correlations of the QC threshold lines with their reference, kept once computed for a dataset and a reference.
+ *  The correlations are also sorted: the lines not satisfying a threshold are counted with a binary search,
+ *  and the lines changing side when the threshold moves are the ones between two binary searches.
+ *  A line with a NaN correlation satisfies every threshold, as a NaN is never lower than the threshold. **/
+class QCThresholdCorrelations
+{
+    friend class TestQCThresholdCorrelations; /** For unit tests **/
+
+public:
+    QCThresholdCorrelations();
+
+
+    void SetCorrelations( const QVector< double >& correlations ); // Tested
+
+    /** To call when the lines, their data or the reference change **/
+    void Clear(); // Tested
+
+    bool IsEmpty() const; // Tested
+
+    int GetNbrLines() const; // Tested
+
+    double GetCorrelation( int line ) const; // Tested
+
+
+    bool IsCorrelated( int line, double qcThreshold ) const; // Tested
+
+    int GetNbrNotCorrelated( double qcThreshold ) const; // Tested
+
+    /** Lines correlated with one threshold and not with the other, sorted by correlation **/
+    QList< int > GetLinesCrossing( double previousQCThreshold, double qcThreshold ) const; // Tested
+
+
+private:
+    /** Correlation of each line, in the order of the lines **/
+    QVector< double > m_correlations;
+
+    /** Lines without a NaN correlation, sorted by correlation, and their correlations **/
+    QVector< int > m_sortedLines;
+
+    QVector< double > m_sortedCorrelations;
+
+
+    /** Index in m_sortedCorrelations of the first correlation not lower than qcThreshold **/
+    int GetSortedIndex( double qcThreshold ) const; // Not Directly Tested
+};
+
+#endif // QCTHRESHOLDCORRELATIONS_H
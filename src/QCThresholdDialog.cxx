@@ -1,8 +1,12 @@
 #include "QCThresholdDialog.h"
 #include "ui_QCThresholdDialog.h"
+#include "SubjectRegistry.h"
 
 // #include <QDebug>
 
+
+const int QCThresholdDialog::m_plotUpdateInterval = 40;
+
 QCThresholdDialog::QCThresholdDialog(QWidget *parent) :
     QDialog(parent),
     ui(new Ui::QCThresholdDialog)
@@ -14,6 +18,7 @@ QCThresholdDialog::QCThresholdDialog(QWidget *parent) :
 
 QCThresholdDialog::~QCThresholdDialog()
 {
+    m_qcThresholdWatcher.waitForFinished();
     delete ui;
 }
 
@@ -26,29 +31,61 @@ QCThresholdDialog::~QCThresholdDialog()
 /***************************************************************/
 /********************** Public functions ***********************/
 /***************************************************************/
-bool QCThresholdDialog::InitPlot( const QList< QStringList >& rawData, const QStringList& atlas, const QStringList& matchedSubjects, double qcThreshold, const QString& valueStartArcLength, const QString&  valueEndArcLength )
+bool QCThresholdDialog::InitPlot( const QMap< QString, DiffusionProfileMatrix::ConstPointer >& rawData, bool useAtlas, const QStringList& matchedSubjects,
+                                  const QMap< QString, double >& qcThresholds, const QMap< QString, double >& fpcaQCThresholds, QCThreshold::Rule rule,
+                                  QCThresholdReference::Type referenceType, QCThreshold::Metric metric, const QString& valueStartArcLength, const QString&  valueEndArcLength )
 {
-    m_faData = rawData;
-    m_atlas = atlas;
-    m_matchedSubjects = matchedSubjects;
-
-    m_nanSubjects = m_processing.GetNANSubjects( m_faData, m_matchedSubjects );
+    WaitForQCThreshold();
 
-    ui->QCThresholdDialog_removeNAN_pushButton->setHidden( m_nanSubjects.isEmpty() );
-    ui->QCThresholdDialog_removeNAN_label->setHidden( m_nanSubjects.isEmpty() );
+    m_rawData = rawData;
+    m_useAtlas = useAtlas;
+    m_matchedSubjects = matchedSubjects;
 
-    m_qcThresholdDoubleSpinBox->blockSignals( true );
-    m_qcThresholdDoubleSpinBox->setValue( qcThreshold );
-    m_qcThresholdDoubleSpinBox->blockSignals( false );
+    /** Every property checked concurrently, the one displayed then follows its plot **/
+    m_qcThreshold.Clear();
+    m_qcThreshold.SetRule( rule );
+    QCThresholdReference reference;
+    reference.SetType( referenceType );
+    m_qcThreshold.SetReference( reference );
+    m_qcThreshold.SetMetric( metric );
+    foreach( QString property, m_rawData.keys() )
+    {
+        m_qcThreshold.AddProperty( property, m_rawData.value( property ), qcThresholds.value( property ),
+                                   fpcaQCThresholds.value( property, QCThreshold::GetDefaultFPCAQCThreshold() ), m_useAtlas );
+    }
+    StartQCThreshold();
+
+    QString propertySelected = m_rawData.contains( "FA" ) ? "FA" : m_rawData.keys().first();
+    ui->QCThresholdDialog_property_comboBox->blockSignals( true );
+    ui->QCThresholdDialog_property_comboBox->clear();
+    ui->QCThresholdDialog_property_comboBox->addItems( m_rawData.keys() );
+    ui->QCThresholdDialog_property_comboBox->setCurrentText( propertySelected );
+    ui->QCThresholdDialog_property_comboBox->blockSignals( false );
+    ui->QCThresholdDialog_property_comboBox->setEnabled( m_rawData.size() > 1 );
+
+    ui->QCThresholdDialog_rule_comboBox->blockSignals( true );
+    ui->QCThresholdDialog_rule_comboBox->setCurrentIndex( rule == QCThreshold::AllFail ? 1 : 0 );
+    ui->QCThresholdDialog_rule_comboBox->blockSignals( false );
+    ui->QCThresholdDialog_rule_comboBox->setEnabled( m_rawData.size() > 1 );
+
+    /** Items in the order of QCThresholdReference::Type, the atlas being the reference when used **/
+    ui->QCThresholdDialog_reference_comboBox->blockSignals( true );
+    ui->QCThresholdDialog_reference_comboBox->setCurrentIndex( referenceType );
+    ui->QCThresholdDialog_reference_comboBox->blockSignals( false );
+    ui->QCThresholdDialog_reference_comboBox->setEnabled( !m_useAtlas && metric == QCThreshold::Correlation );
+
+    ui->QCThresholdDialog_metric_comboBox->blockSignals( true );
+    ui->QCThresholdDialog_metric_comboBox->setCurrentIndex( metric );
+    ui->QCThresholdDialog_metric_comboBox->blockSignals( false );
 
     m_arcLengthStartHorizontalSlider->blockSignals( true );
     m_arcLengthEndHorizontalSlider->blockSignals( true );
+    m_propertyData = m_rawData.value( propertySelected );
     SetProfileCropping( valueStartArcLength, valueEndArcLength );
     m_arcLengthStartHorizontalSlider->blockSignals( false );
     m_arcLengthEndHorizontalSlider->blockSignals( false );
 
-    bool qcThresholdDialogReady = m_qcThresholdPlot->InitQCThresholdPlot( m_faData, m_matchedSubjects );
-    DisplayQCThresholdPlot( m_qcThresholdDoubleSpinBox->value() );
+    bool qcThresholdDialogReady = DisplayProperty( propertySelected );
 
     m_updated = false;
 
@@ -56,7 +93,6 @@ bool QCThresholdDialog::InitPlot( const QList< QStringList >& rawData, const QSt
 }
 
 
-
 /***************************************************************/
 /************************ Private slots ************************/
 /***************************************************************/
@@ -71,7 +107,9 @@ void QCThresholdDialog::OnCroppingProfile()
         m_qcThresholdPlot->SetArcLengthStartIndex() = arcLengthStartIndex;
         m_qcThresholdPlot->SetArcLengthEndIndex() = arcLengthEndIndex;
 
-        m_qcThresholdPlot->UpdateCropping();
+        m_isCroppingChanged = true;
+        SchedulePlotUpdate();
+        m_updated = false;
 
         m_currentSliderStartIndex = arcLengthStartIndex;
         m_currentSliderEndIndex = m_arcLengthEndHorizontalSlider->value();
@@ -94,41 +132,83 @@ void QCThresholdDialog::OnCropProfileToggled( bool checked )
     SetCroppingFeatureEnabled( checked );
     m_qcThresholdPlot->SetCroppingEnabled() = checked;
     m_qcThresholdPlot->ShowHideProfileCropping( checked );
+    m_updated = false;
 }
 
 void QCThresholdDialog::OnUpdatingSubjectsCorrelated( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated )
 {
-    m_subjectsCorrelated = subjectsCorrelated;
-    m_subjectsNotCorrelated = subjectsNotCorrelated;
+    Q_UNUSED( subjectsCorrelated );
+    m_plotSubjectsNotCorrelated.insert( m_propertySelected, subjectsNotCorrelated );
+    m_qcThreshold.SetSubjectsNotCorrelated( m_propertySelected, m_qcThresholdDoubleSpinBox->value(), subjectsNotCorrelated );
 
-    QString info = !m_subjectsNotCorrelated.isEmpty() ? QString( "<i><span style=""font-size:8pt;"">" + QString::number( m_subjectsNotCorrelated.size() ) + " subject(s) not satisfying the threshold</span></i>" ) : "";
-    ui->QCThresholdDialog_info_label->setText( tr( qPrintable( info ) ) );
+    /** Other properties still checked in the worker thread: the subjects are updated once they are **/
+    if( !m_isQCThresholdApplying )
+    {
+        UpdateSubjectsCorrelated();
+    }
 }
 
 void QCThresholdDialog::OnUpdatingQCThreshold( double qcThreshold )
 {
-    m_qcThresholdPlot->UpdateQCThreshold( qcThreshold, true );
+    Q_UNUSED( qcThreshold );
+    m_isQCThresholdChanged = true;
+    SchedulePlotUpdate();
     m_updated = false;
 }
 
-void QCThresholdDialog::OnRemoveNAN()
+void QCThresholdDialog::OnPropertySelected( const QString& property )
 {
-    foreach( QString subject, m_nanSubjects )
+    if( m_rawData.contains( property ) && property != m_propertySelected )
     {
-        if( m_matchedSubjects.contains( subject ) )
-        {
-            m_matchedSubjects.removeAll( subject );
-        }
-        if( m_subjectsCorrelated.contains( subject ) )
-        {
-            m_subjectsCorrelated.removeAll( subject );
-        }
-        if( m_subjectsNotCorrelated.contains( subject ) )
-        {
-            m_subjectsNotCorrelated.removeAll( subject );
-        }
+        DisplayProperty( property );
     }
+}
+
+void QCThresholdDialog::OnRuleSelected( int ruleIndex )
+{
+    m_qcThreshold.SetRule( ruleIndex == 1 ? QCThreshold::AllFail : QCThreshold::AnyFail );
+    m_qcThresholdPlot->UpdateQCThreshold( m_qcThresholdDoubleSpinBox->value(), true );
+    m_updated = false;
+}
+
+void QCThresholdDialog::OnReferenceSelected( int referenceIndex )
+{
+    FinishPlotUpdate();
+    QCThresholdReference reference = m_qcThreshold.GetReference();
+    reference.SetType( static_cast< QCThresholdReference::Type >( referenceIndex ) );
+    m_qcThreshold.SetReference( reference );
+
+    /** New reference for every property **/
+    StartQCThreshold();
+    DisplayProperty( m_propertySelected );
+    m_updated = false;
+}
 
+void QCThresholdDialog::OnMetricSelected( int metricIndex )
+{
+    FinishPlotUpdate();
+    QCThreshold::Metric metric = static_cast< QCThreshold::Metric >( metricIndex );
+    m_qcThreshold.SetMetric( metric );
+    /** The functional PCA does not use the reference **/
+    ui->QCThresholdDialog_reference_comboBox->setEnabled( !m_useAtlas && metric == QCThreshold::Correlation );
+
+    /** Every property scored again against the thresholds of the metric, the spin box switched to them **/
+    StartQCThreshold();
+    DisplayProperty( m_propertySelected );
+    m_updated = false;
+}
+
+void QCThresholdDialog::OnRemoveNAN()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QSet< int > nanSubjectIDs = registry.GetIDSet( m_nanSubjects );
+    m_matchedSubjects = registry.Exclude( m_matchedSubjects, nanSubjectIDs );
+    m_subjectsCorrelated = registry.Exclude( m_subjectsCorrelated, nanSubjectIDs );
+    m_subjectsNotCorrelated = registry.Exclude( m_subjectsNotCorrelated, nanSubjectIDs );
+
+    /** The means used as references change for every property **/
+    StartQCThreshold();
+    /** Remaining profiles correlated in the worker thread of the plot, the subjects correlated updated once they are posted **/
     m_qcThresholdPlot->UpdateNAN( m_nanSubjects );
 
     ui->QCThresholdDialog_removeNAN_pushButton->hide();
@@ -139,17 +219,59 @@ void QCThresholdDialog::OnRemoveNAN()
     m_nanSubjects.clear();
 }
 
+void QCThresholdDialog::OnUpdatingPlot()
+{
+    if( m_isQCThresholdChanged )
+    {
+        m_isQCThresholdChanged = false;
+        m_qcThresholdPlot->UpdateQCThreshold( m_qcThresholdDoubleSpinBox->value(), true );
+    }
+    if( m_isCroppingChanged )
+    {
+        m_isCroppingChanged = false;
+        m_qcThresholdPlot->UpdateCropping();
+    }
+}
+
+void QCThresholdDialog::OnQCThresholdApplied()
+{
+    if( !m_isQCThresholdApplying || !m_qcThresholdWatcher.future().isFinished() )
+    {
+        return;
+    }
+    m_isQCThresholdApplying = false;
+
+    /** Results of a newer request replace the ones just computed **/
+    if( m_hasPendingQCThreshold )
+    {
+        m_hasPendingQCThreshold = false;
+        StartQCThreshold();
+        return;
+    }
+
+    m_qcThreshold.SetResults( m_qcThresholdWatcher.result() );
+    foreach( QString property, m_plotSubjectsNotCorrelated.keys() )
+    {
+        m_qcThreshold.SetSubjectsNotCorrelated( property, m_qcThreshold.GetQCThreshold( property ), m_plotSubjectsNotCorrelated.value( property ) );
+    }
+    UpdateSubjectsCorrelated();
+}
+
 void QCThresholdDialog::OnApplyQCThreshold()
 {
-    emit ApplyQCThreshold( m_subjectsCorrelated, m_subjectsNotCorrelated, m_qcThresholdDoubleSpinBox->value(), false );
+    FinishPlotUpdate();
+    WaitForQCThreshold();
+    EmitApplyQCThreshold( false );
     m_updated = true;
 }
 
 void QCThresholdDialog::closeEvent( QCloseEvent *event )
 {
+    FinishPlotUpdate();
+    WaitForQCThreshold();
     if( m_updated )
     {
-        emit ApplyQCThreshold( m_subjectsCorrelated, m_subjectsNotCorrelated, m_qcThresholdDoubleSpinBox->value(), true );
+        EmitApplyQCThreshold( true );
 
         m_subjectsCorrelated.clear();
         m_subjectsNotCorrelated.clear();
@@ -157,8 +279,7 @@ void QCThresholdDialog::closeEvent( QCloseEvent *event )
 
     if( ui->QCThresholdDialog_cropProfile_checkBox->isChecked() )
     {
-        QStringList arcLength = m_processing.Transpose( m_faData ).first();
-        arcLength.removeFirst();
+        QStringList arcLength = m_propertyData->GetArcLengthLabels();
 
         emit UpdateStartArcLength( arcLength.at( m_arcLengthStartHorizontalSlider->value() ) );
         emit UpdateEndArcLength( arcLength.at( m_arcLengthEndHorizontalSlider->maximum() - m_arcLengthEndHorizontalSlider->value() ) );
@@ -181,6 +302,18 @@ void QCThresholdDialog::InitQCThresholdDialog()
     m_qcThresholdPlot->SetQVTKWidget( m_qvtkWidget, true );
     connect( m_qcThresholdPlot, SIGNAL( UpdateSubjectsCorrelated( const QStringList&, const QStringList& ) ), this, SLOT( OnUpdatingSubjectsCorrelated( const QStringList&, const QStringList& ) ) );
 
+    /** Bursts of changes from the spin box and the sliders coalesced: the plot is updated with the last values at the end of the interval **/
+    m_plotUpdateTimer = new QTimer( this );
+    m_plotUpdateTimer->setSingleShot( true );
+    m_plotUpdateTimer->setInterval( m_plotUpdateInterval );
+    connect( m_plotUpdateTimer, SIGNAL( timeout() ), this, SLOT( OnUpdatingPlot() ) );
+    m_isQCThresholdChanged = false;
+    m_isCroppingChanged = false;
+
+    connect( &m_qcThresholdWatcher, SIGNAL( finished() ), this, SLOT( OnQCThresholdApplied() ) );
+    m_isQCThresholdApplying = false;
+    m_hasPendingQCThreshold = false;
+
     m_qcThresholdDoubleSpinBox = new QDoubleSpinBox;
     m_qcThresholdDoubleSpinBox = ui->QCThresholdDialog_qcThreshold_doubleSpinBox;
     connect( m_qcThresholdDoubleSpinBox, SIGNAL( valueChanged( double ) ), this, SLOT( OnUpdatingQCThreshold( double ) ) );
@@ -188,6 +321,11 @@ void QCThresholdDialog::InitQCThresholdDialog()
 
     connect( ui->QCThresholdDialog_removeNAN_pushButton, SIGNAL( clicked() ), this, SLOT( OnRemoveNAN() ) );
 
+    connect( ui->QCThresholdDialog_property_comboBox, SIGNAL( currentIndexChanged( const QString& ) ), this, SLOT( OnPropertySelected( const QString& ) ) );
+    connect( ui->QCThresholdDialog_rule_comboBox, SIGNAL( currentIndexChanged( int ) ), this, SLOT( OnRuleSelected( int ) ) );
+    connect( ui->QCThresholdDialog_reference_comboBox, SIGNAL( currentIndexChanged( int ) ), this, SLOT( OnReferenceSelected( int ) ) );
+    connect( ui->QCThresholdDialog_metric_comboBox, SIGNAL( currentIndexChanged( int ) ), this, SLOT( OnMetricSelected( int ) ) );
+
     m_arcLengthStartHorizontalSlider = new QAbstractSlider;
     m_arcLengthStartHorizontalSlider = ui->QCThresholdDialog_arcLengthStart_horizontalSlider;
     m_arcLengthEndHorizontalSlider = new QAbstractSlider;
@@ -201,6 +339,29 @@ void QCThresholdDialog::InitQCThresholdDialog()
 }
 
 
+bool QCThresholdDialog::DisplayProperty( const QString& property )
+{
+    /** Last changes kept for the property displayed so far **/
+    FinishPlotUpdate();
+
+    m_propertySelected = property;
+    m_propertyData = m_rawData.value( property );
+    m_atlas = m_useAtlas ? m_propertyData->GetAtlas().ToList() : QList< double >();
+
+    m_nanSubjects = m_processing.GetNANSubjects( *m_propertyData, m_matchedSubjects );
+    ui->QCThresholdDialog_removeNAN_pushButton->setHidden( m_nanSubjects.isEmpty() );
+    ui->QCThresholdDialog_removeNAN_label->setHidden( m_nanSubjects.isEmpty() );
+
+    m_qcThresholdDoubleSpinBox->blockSignals( true );
+    m_qcThresholdDoubleSpinBox->setValue( m_qcThreshold.GetQCThreshold( property ) );
+    m_qcThresholdDoubleSpinBox->blockSignals( false );
+
+    bool isPlotReady = m_qcThresholdPlot->InitQCThresholdPlot( m_propertyData, m_matchedSubjects, property );
+    DisplayQCThresholdPlot( m_qcThresholdDoubleSpinBox->value() );
+
+    return isPlotReady;
+}
+
 void QCThresholdDialog::DisplayQCThresholdPlot( double qcThreshold )
 {
     int arcLengthStartIndex = m_arcLengthStartHorizontalSlider->value();
@@ -209,6 +370,9 @@ void QCThresholdDialog::DisplayQCThresholdPlot( double qcThreshold )
     m_qcThresholdPlot->ClearPlot();
     m_qcThresholdPlot->SetQCThreshold() = qcThreshold;
     m_qcThresholdPlot->SetAtlasQCThreshold() = m_atlas;
+    m_qcThresholdPlot->SetQCThresholdReference() = m_qcThreshold.GetReference();
+    m_qcThresholdPlot->SetQCThresholdMetric() = m_qcThreshold.GetMetric();
+    m_qcThresholdPlot->SetQCThresholdFunctionalPCA() = m_qcThreshold.GetFunctionalPCA();
     m_qcThresholdPlot->SetCroppingEnabled() = ui->QCThresholdDialog_cropProfile_checkBox->isChecked();
     if( arcLengthStartIndex < arcLengthEndIndex )
     {
@@ -220,10 +384,89 @@ void QCThresholdDialog::DisplayQCThresholdPlot( double qcThreshold )
 }
 
 
+QMap< QString, double > QCThresholdDialog::GetQCThresholds( QCThreshold::Metric metric ) const
+{
+    QMap< QString, double > qcThresholds;
+    foreach( QString property, m_qcThreshold.GetProperties() )
+    {
+        qcThresholds.insert( property, m_qcThreshold.GetQCThreshold( property, metric ) );
+    }
+
+    return qcThresholds;
+}
+
+void QCThresholdDialog::EmitApplyQCThreshold( bool windowClosed )
+{
+    emit ApplyQCThreshold( m_subjectsCorrelated, m_subjectsNotCorrelated, GetQCThresholds( QCThreshold::Correlation ), GetQCThresholds( QCThreshold::FPCA ),
+                           QCThreshold::GetRuleName( m_qcThreshold.GetRule() ),
+                           QCThresholdReference::GetTypeName( m_qcThreshold.GetReference().GetType() ), QCThreshold::GetMetricName( m_qcThreshold.GetMetric() ), windowClosed );
+}
+
+
+void QCThresholdDialog::SchedulePlotUpdate()
+{
+    /** Not restarted: the plot follows a slider being dragged at the pace of the interval **/
+    if( !m_plotUpdateTimer->isActive() )
+    {
+        m_plotUpdateTimer->start();
+    }
+}
+
+QCThreshold QCThresholdDialog::ComputeQCThreshold( QCThreshold qcThreshold, QStringList subjects )
+{
+    qcThreshold.Apply( subjects );
+
+    return qcThreshold;
+}
+
+void QCThresholdDialog::StartQCThreshold()
+{
+    /** Results posted by the plot until now replaced by the ones of the request **/
+    m_plotSubjectsNotCorrelated.clear();
+    if( m_isQCThresholdApplying )
+    {
+        m_hasPendingQCThreshold = true;
+        return;
+    }
+
+    m_isQCThresholdApplying = true;
+    m_qcThresholdWatcher.setFuture( QtConcurrent::run( &QCThresholdDialog::ComputeQCThreshold, m_qcThreshold, m_matchedSubjects ) );
+}
+
+void QCThresholdDialog::WaitForQCThreshold()
+{
+    /** The finished() signals still queued are ignored once handled here **/
+    while( m_isQCThresholdApplying )
+    {
+        m_qcThresholdWatcher.waitForFinished();
+        OnQCThresholdApplied();
+    }
+}
+
+void QCThresholdDialog::UpdateSubjectsCorrelated()
+{
+    m_subjectsCorrelated = m_qcThreshold.GetSubjectsCorrelated();
+    m_subjectsNotCorrelated = m_qcThreshold.GetSubjectsNotCorrelated();
+
+    QString info = !m_subjectsNotCorrelated.isEmpty() ? QString( "<i><span style=""font-size:8pt;"">" + QString::number( m_subjectsNotCorrelated.size() ) + " subject(s) not satisfying the threshold</span></i>" ) : "";
+    ui->QCThresholdDialog_info_label->setText( tr( qPrintable( info ) ) );
+}
+
+
+void QCThresholdDialog::FinishPlotUpdate()
+{
+    if( m_plotUpdateTimer->isActive() )
+    {
+        m_plotUpdateTimer->stop();
+        OnUpdatingPlot();
+    }
+    m_qcThresholdPlot->WaitForQCThresholdCorrelations();
+}
+
+
 void QCThresholdDialog::SetProfileCropping( const QString& valueStartArcLength, const QString&  valueEndArcLength )
 {
-    QStringList arcLength = m_processing.Transpose( m_faData ).first();
-    arcLength.removeFirst();
+    QStringList arcLength = m_propertyData->GetArcLengthLabels();
 
     m_currentSliderStartIndex = arcLength.indexOf( valueStartArcLength, 0 );
     m_currentSliderEndIndex = arcLength.indexOf( valueEndArcLength, 0 );
@@ -2,6 +2,7 @@
 #define QCTHRESHOLDDIALOG_H
 
 #include "Plot.h"
+#include "QCThreshold.h"
 
 #include <QDialog>
 #include <QLabel>
@@ -10,6 +11,9 @@
 #include <QMessageBox>
 #include <QCloseEvent>
 #include <QAbstractSlider>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 
 namespace Ui {
@@ -33,11 +37,16 @@ public:
     ~QCThresholdDialog();
 
 
-    bool InitPlot( const QList< QStringList >& rawData, const QStringList& atlas, const QStringList& matchedSubjects, double qcThreshold, const QString& valueStartArcLength, const QString&  valueEndArcLength ); // Not Directly Tested
+    /** rawData: profiles of each diffusion property checked, qcThresholds and fpcaQCThresholds: thresholds of each of them for the correlation and the FPCA metric,
+     *  referenceType: reference used without atlas, metric: correlation with the reference or functional PCA outlier score **/
+    bool InitPlot( const QMap< QString, DiffusionProfileMatrix::ConstPointer >& rawData, bool useAtlas, const QStringList& matchedSubjects,
+                   const QMap< QString, double >& qcThresholds, const QMap< QString, double >& fpcaQCThresholds, QCThreshold::Rule rule,
+                   QCThresholdReference::Type referenceType, QCThreshold::Metric metric, const QString& valueStartArcLength, const QString&  valueEndArcLength ); // Not Directly Tested
 
 
 signals:
-    void ApplyQCThreshold( const QStringList&, const QStringList&, double qcThreshold, bool windowClosed );
+    void ApplyQCThreshold( const QStringList&, const QStringList&, const QMap< QString, double >& qcThresholds, const QMap< QString, double >& fpcaQCThresholds,
+                           const QString& rule, const QString& reference, const QString& metric, bool windowClosed );
 
     void NanSujects( const QStringList& );
 
@@ -57,8 +66,20 @@ private slots:
 
     void OnUpdatingQCThreshold( double qcThreshold ); // Not Directly Tested
 
+    void OnPropertySelected( const QString& property ); // Not Directly Tested
+
+    void OnRuleSelected( int ruleIndex ); // Not Directly Tested
+
+    void OnReferenceSelected( int referenceIndex ); // Not Directly Tested
+
+    void OnMetricSelected( int metricIndex ); // Not Directly Tested
+
     void OnRemoveNAN();
 
+    void OnUpdatingPlot(); // Not Directly Tested
+
+    void OnQCThresholdApplied(); // Not Directly Tested
+
     void OnApplyQCThreshold();
 
     void closeEvent( QCloseEvent *event );
@@ -77,21 +98,70 @@ private:
 
     QAbstractSlider *m_arcLengthStartHorizontalSlider, *m_arcLengthEndHorizontalSlider;
 
-    QList< QStringList > m_faData;
+    QMap< QString, DiffusionProfileMatrix::ConstPointer > m_rawData;
+
+    /** Profiles of the property displayed **/
+    DiffusionProfileMatrix::ConstPointer m_propertyData;
+
+    QString m_propertySelected;
+
+    QList< double > m_atlas;
+
+    bool m_useAtlas;
+
+    /** Every property checked, the one displayed updated with its plot **/
+    QCThreshold m_qcThreshold;
+
+    /** Every property checked again in a worker thread on a copy of m_qcThreshold, its results then taken back.
+     *  The requests made meanwhile are coalesced into one, started once the running one is finished. **/
+    QFutureWatcher< QCThreshold > m_qcThresholdWatcher;
+
+    bool m_isQCThresholdApplying, m_hasPendingQCThreshold;
+
+    /** Subjects not correlated posted by the plot for each property since the last request, kept over the results of the worker thread **/
+    QMap< QString, QStringList > m_plotSubjectsNotCorrelated;
 
     QStringList m_matchedSubjects,
-    m_subjectsCorrelated, m_subjectsNotCorrelated, m_atlas,
+    m_subjectsCorrelated, m_subjectsNotCorrelated,
     m_nanSubjects;
 
     int m_currentSliderStartIndex, m_currentSliderEndIndex;
 
     bool m_updated;
 
+    /** Changes of the threshold and of the cropping made within the interval (ms) are applied to the plot at once **/
+    static const int m_plotUpdateInterval;
+
+    QTimer *m_plotUpdateTimer;
+
+    bool m_isQCThresholdChanged, m_isCroppingChanged;
+
 
     void InitQCThresholdDialog();  // Not Directly Tested
 
+    bool DisplayProperty( const QString& property ); // Not Directly Tested
+
     void DisplayQCThresholdPlot( double qcThreshold ); // Not Directly Tested
 
+    QMap< QString, double > GetQCThresholds( QCThreshold::Metric metric ) const; // Not Directly Tested
+
+    void EmitApplyQCThreshold( bool windowClosed ); // Not Directly Tested
+
+    void SchedulePlotUpdate(); // Not Directly Tested
+
+    /** Run in the worker thread **/
+    static QCThreshold ComputeQCThreshold( QCThreshold qcThreshold, QStringList subjects ); // Not Directly Tested
+
+    void StartQCThreshold(); // Not Directly Tested
+
+    /** Blocks until the latest request is applied and its results taken back **/
+    void WaitForQCThreshold(); // Not Directly Tested
+
+    void UpdateSubjectsCorrelated(); // Not Directly Tested
+
+    /** Subjects correlated up to date with the last changes, before they are sent **/
+    void FinishPlotUpdate(); // Not Directly Tested
+
     void SetProfileCropping( const QString& valueStartArcLength, const QString&  valueEndArcLength );
 
     void SetCroppingFeatureEnabled( bool enabled );
@@ -0,0 +1,279 @@
+#include "QCThresholdReference.h"
+
+#include <QStringList>
+#include <QThread>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
+#include <cmath>
+
+//#include <QDebug>
+
+
+const int QCThresholdReference::m_nbrPointsPerBlock = 8;
+const int QCThresholdReference::m_minNbrValuesPerThread = 256 * 1024;
+const double QCThresholdReference::m_huberConstant = 1.345;
+const int QCThresholdReference::m_maxNbrIterations = 50;
+
+QCThresholdReference::QCThresholdReference()
+{
+    m_type = Mean;
+    m_trimmedProportion = 0.1;
+    m_nbrThreads = 0;
+}
+
+
+bool QCThresholdReference::GetType( const QString& typeName, Type& type )
+{
+    QStringList typeNames = QStringList() << "mean" << "median" << "trimmedMean" << "reweighted";
+    for( int i = 0; i < typeNames.size(); i++ )
+    {
+        if( typeName.compare( typeNames.at( i ), Qt::CaseInsensitive ) == 0 )
+        {
+            type = static_cast< Type >( i );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString QCThresholdReference::GetTypeName( Type type )
+{
+    switch( type )
+    {
+    case Median:
+        return "median";
+    case TrimmedMean:
+        return "trimmedMean";
+    case Reweighted:
+        return "reweighted";
+    default:
+        return "mean";
+    }
+}
+
+
+void QCThresholdReference::SetType( Type type )
+{
+    m_type = type;
+}
+
+QCThresholdReference::Type QCThresholdReference::GetType() const
+{
+    return m_type;
+}
+
+void QCThresholdReference::SetTrimmedProportion( double trimmedProportion )
+{
+    m_trimmedProportion = qBound( 0.0, trimmedProportion, 0.5 );
+}
+
+double QCThresholdReference::GetTrimmedProportion() const
+{
+    return m_trimmedProportion;
+}
+
+void QCThresholdReference::SetNbrThreads( int nbrThreads )
+{
+    m_nbrThreads = qMax( nbrThreads, 0 );
+}
+
+
+QList< double > QCThresholdReference::Compute( const QList< VectorView >& profiles, int nbrPoints ) const
+{
+    if( profiles.isEmpty() || nbrPoints <= 0 )
+    {
+        return QList< double >();
+    }
+
+    int nbrThreads = m_nbrThreads > 0 ? m_nbrThreads : QThread::idealThreadCount();
+    qint64 nbrValues = qint64( profiles.size() ) * nbrPoints;
+    int nbrChunks = static_cast< int >( qBound( qint64( 1 ), nbrValues / m_minNbrValuesPerThread, qint64( qMax( nbrThreads, 1 ) ) ) );
+
+    /** Chunks made of whole blocks of arc lengths, the last one computed by the calling thread **/
+    QVector< double > reference( nbrPoints );
+    int nbrBlocks = ( nbrPoints + m_nbrPointsPerBlock - 1 ) / m_nbrPointsPerBlock;
+    int nbrBlocksPerChunk = ( nbrBlocks + nbrChunks - 1 ) / nbrChunks;
+    QList< QFuture< void > > futures;
+    for( int first = 0; first < nbrPoints; first += nbrBlocksPerChunk * m_nbrPointsPerBlock )
+    {
+        int last = qMin( first + nbrBlocksPerChunk * m_nbrPointsPerBlock, nbrPoints );
+        if( last < nbrPoints )
+        {
+            futures.append( QtConcurrent::run( this, &QCThresholdReference::ComputePoints, &profiles, first, last, reference.data() ) );
+        }
+        else
+        {
+            ComputePoints( &profiles, first, last, reference.data() );
+        }
+    }
+    for( int i = 0; i < futures.size(); i++ )
+    {
+        futures[ i ].waitForFinished();
+    }
+
+    return reference.toList();
+}
+
+QList< double > QCThresholdReference::Compute( const QList< QList< double > >& profiles ) const
+{
+    if( profiles.isEmpty() )
+    {
+        return QList< double >();
+    }
+
+    /** Copied one after the other so every profile is contiguous **/
+    int nbrPoints = profiles.first().size();
+    QVector< double > values( profiles.size() * nbrPoints );
+    QList< VectorView > profileViews;
+    for( int i = 0; i < profiles.size(); i++ )
+    {
+        double *profile = values.data() + i * nbrPoints;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile[ point ] = profiles.at( i ).at( point );
+        }
+        profileViews.append( VectorView( profile, nbrPoints, 1 ) );
+    }
+
+    return Compute( profileViews, nbrPoints );
+}
+
+
+void QCThresholdReference::ComputePoints( const QList< VectorView > *profiles, int first, int last, double *reference ) const
+{
+    int nbrProfiles = profiles->size();
+    QVector< double > columns( m_nbrPointsPerBlock * nbrProfiles );
+    QVector< double > deviations( m_type == Reweighted ? nbrProfiles : 0 );
+
+    for( int firstPoint = first; firstPoint < last; firstPoint += m_nbrPointsPerBlock )
+    {
+        /** Each profile read once per block, its values scattered into one column per arc length **/
+        int nbrBlockPoints = qMin( m_nbrPointsPerBlock, last - firstPoint );
+        double *column = columns.data();
+        for( int i = 0; i < nbrProfiles; i++ )
+        {
+            const VectorView& profile = profiles->at( i );
+            const double *values = profile.Data() + firstPoint * profile.Stride();
+            for( int point = 0; point < nbrBlockPoints; point++ )
+            {
+                column[ point * nbrProfiles + i ] = values[ point * profile.Stride() ];
+            }
+        }
+
+        for( int point = 0; point < nbrBlockPoints; point++ )
+        {
+            reference[ firstPoint + point ] = ComputeValue( column + point * nbrProfiles, nbrProfiles, deviations.data() );
+        }
+    }
+}
+
+double QCThresholdReference::ComputeValue( double *values, int nbrValues, double *deviations ) const
+{
+    if( m_type == Mean )
+    {
+        double sum = 0;
+        for( int i = 0; i < nbrValues; i++ )
+        {
+            sum += values[ i ];
+        }
+
+        return sum / nbrValues;
+    }
+
+    /** nth_element needs values that can be ordered **/
+    nbrValues = static_cast< int >( std::remove_if( values, values + nbrValues, IsNAN ) - values );
+    if( nbrValues == 0 )
+    {
+        return 0;
+    }
+
+    switch( m_type )
+    {
+    case Median:
+        return GetMedian( values, nbrValues );
+    case TrimmedMean:
+        return GetTrimmedMean( values, nbrValues );
+    default:
+        return GetReweightedMean( values, nbrValues, deviations );
+    }
+}
+
+bool QCThresholdReference::IsNAN( double value )
+{
+    return value != value;
+}
+
+double QCThresholdReference::GetMedian( double *values, int nbrValues )
+{
+    double *middle = values + nbrValues / 2;
+    std::nth_element( values, middle, values + nbrValues );
+    if( nbrValues % 2 == 1 )
+    {
+        return *middle;
+    }
+
+    /** Even number of values: the other middle value is the largest of the lower half **/
+    return ( *std::max_element( values, middle ) + *middle ) / 2;
+}
+
+double QCThresholdReference::GetTrimmedMean( double *values, int nbrValues ) const
+{
+    int nbrTrimmedValues = qMin( static_cast< int >( m_trimmedProportion * nbrValues ), ( nbrValues - 1 ) / 2 );
+    double *first = values + nbrTrimmedValues;
+    double *last = values + nbrValues - nbrTrimmedValues;
+    if( nbrTrimmedValues > 0 )
+    {
+        /** Smallest values before first, then largest values from last **/
+        std::nth_element( values, first, values + nbrValues );
+        std::nth_element( first, last, values + nbrValues );
+    }
+
+    double sum = 0;
+    for( double *value = first; value < last; value++ )
+    {
+        sum += *value;
+    }
+
+    return sum / ( last - first );
+}
+
+double QCThresholdReference::GetReweightedMean( double *values, int nbrValues, double *deviations )
+{
+    /** Starts from the median, values weighted down beyond m_huberConstant times the median absolute deviation **/
+    double mean = GetMedian( values, nbrValues );
+    for( int i = 0; i < nbrValues; i++ )
+    {
+        deviations[ i ] = std::abs( values[ i ] - mean );
+    }
+    double scale = 1.4826 * GetMedian( deviations, nbrValues );
+    if( scale == 0 )
+    {
+        return mean;
+    }
+
+    double limit = m_huberConstant * scale;
+    for( int iteration = 0; iteration < m_maxNbrIterations; iteration++ )
+    {
+        double sumWeights = 0;
+        double sumWeightedValues = 0;
+        for( int i = 0; i < nbrValues; i++ )
+        {
+            double deviation = std::abs( values[ i ] - mean );
+            double weight = deviation <= limit ? 1 : limit / deviation;
+            sumWeights += weight;
+            sumWeightedValues += weight * values[ i ];
+        }
+
+        double previousMean = mean;
+        mean = sumWeightedValues / sumWeights;
+        if( std::abs( mean - previousMean ) <= 1e-10 * scale )
+        {
+            break;
+        }
+    }
+
+    return mean;
+}
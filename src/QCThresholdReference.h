@@ -0,0 +1,83 @@
+#ifndef QCTHRESHOLDREFERENCE_H
+#define QCTHRESHOLDREFERENCE_H
+
+#include "MatrixView.h"
+
+#include <QString>
+#include <QVector>
+#include <QList>
+
+/** Reference profile of the QC threshold when no atlas is used, computed arc length by arc length from the profiles of the subjects:
+ *  mean, median, trimmed mean, or mean iteratively re-weighted (Huber) so the outliers the QC threshold rejects do not pull it.
+ *  The profiles are read by blocks of arc lengths: each profile is read once per block and its values scattered into one
+ *  contiguous column per arc length, where the order statistics are found by std::nth_element in linear time.
+ *  The blocks of arc lengths can be spread across threads. **/
+class QCThresholdReference
+{
+    friend class TestQCThresholdReference; /** For unit tests **/
+
+public:
+    enum Type { Mean, Median, TrimmedMean, Reweighted };
+
+    QCThresholdReference();
+
+
+    /** "mean", "median", "trimmedMean" or "reweighted", false if the name is unknown **/
+    static bool GetType( const QString& typeName, Type& type ); // Tested
+
+    static QString GetTypeName( Type type ); // Tested
+
+
+    void SetType( Type type ); // Tested
+
+    Type GetType() const; // Tested
+
+    /** Proportion of the values removed at each end by the trimmed mean, 0.1 by default **/
+    void SetTrimmedProportion( double trimmedProportion ); // Tested
+
+    double GetTrimmedProportion() const; // Tested
+
+    /** 0: as many threads as cores. Only large sets of profiles are split between threads. **/
+    void SetNbrThreads( int nbrThreads ); // Tested
+
+
+    /** Reference over the first nbrPoints values of the profiles, empty without profiles.
+     *  Apart from the mean, the nan values are left out. **/
+    QList< double > Compute( const QList< VectorView >& profiles, int nbrPoints ) const; // Tested
+
+    QList< double > Compute( const QList< QList< double > >& profiles ) const; // Tested
+
+
+private:
+    static const int m_nbrPointsPerBlock;
+
+    /** Number of values below which the arc lengths are not split between threads **/
+    static const int m_minNbrValuesPerThread;
+
+    /** Re-weighted mean: tuning constant, in unit of the scale of the values, and maximum number of iterations **/
+    static const double m_huberConstant;
+    static const int m_maxNbrIterations;
+
+
+    Type m_type;
+
+    double m_trimmedProportion;
+
+    int m_nbrThreads;
+
+
+    void ComputePoints( const QList< VectorView > *profiles, int first, int last, double *reference ) const; // Not Directly Tested
+
+    /** values: one column of values, reordered **/
+    double ComputeValue( double *values, int nbrValues, double *deviations ) const; // Not Directly Tested
+
+    static bool IsNAN( double value ); // Not Directly Tested
+
+    static double GetMedian( double *values, int nbrValues ); // Not Directly Tested
+
+    double GetTrimmedMean( double *values, int nbrValues ) const; // Not Directly Tested
+
+    static double GetReweightedMean( double *values, int nbrValues, double *deviations ); // Not Directly Tested
+};
+
+#endif // QCTHRESHOLDREFERENCE_H
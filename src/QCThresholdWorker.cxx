@@ -0,0 +1,185 @@
+#include "QCThresholdWorker.h"
+
+//#include <QDebug>
+
+
+QCThresholdWorker::QCThresholdWorker( QObject *parent ) :
+    QObject( parent )
+{
+    m_isComputing = false;
+    m_hasPendingRequest = false;
+    m_isStale = false;
+    m_metric = QCThreshold::Correlation;
+
+    connect( &m_computationWatcher, SIGNAL( finished() ), this, SLOT( OnComputationFinished() ) );
+}
+
+QCThresholdWorker::~QCThresholdWorker()
+{
+    m_computationWatcher.waitForFinished();
+}
+
+
+void QCThresholdWorker::SetMetric( QCThreshold::Metric metric, const FunctionalPCA& functionalPCA )
+{
+    m_metric = metric;
+    m_functionalPCA = functionalPCA;
+}
+
+QVector< double > QCThresholdWorker::Correlate( const QList< double >& reference, const QList< QList< double > >& profiles, int first, int last )
+{
+    Cancel();
+
+    m_correlation = QSharedPointer< CroppedPearsonCorrelation >( new CroppedPearsonCorrelation() );
+    m_reference = reference;
+    m_profiles = profiles;
+
+    m_correlations = Compute( CreateRequest( true, first, last ) );
+
+    return m_correlations;
+}
+
+void QCThresholdWorker::SetProfiles( const QList< double >& reference, const QList< QList< double > >& profiles, int first, int last )
+{
+    m_correlation = QSharedPointer< CroppedPearsonCorrelation >( new CroppedPearsonCorrelation() );
+    m_reference = reference;
+    m_profiles = profiles;
+
+    Submit( CreateRequest( true, first, last ) );
+}
+
+void QCThresholdWorker::SetCropping( int first, int last )
+{
+    if( m_correlation.isNull() )
+    {
+        return;
+    }
+
+    Submit( CreateRequest( false, first, last ) );
+}
+
+void QCThresholdWorker::Cancel()
+{
+    /** Profiles whose running sums will never be computed **/
+    if( m_hasPendingRequest && m_pendingRequest.hasProfiles && m_pendingRequest.correlation == m_correlation )
+    {
+        m_correlation.clear();
+    }
+    m_hasPendingRequest = false;
+    m_pendingRequest = Request();
+    m_isStale = m_isComputing;
+}
+
+bool QCThresholdWorker::IsComputing() const
+{
+    return m_isComputing;
+}
+
+void QCThresholdWorker::WaitForCorrelations()
+{
+    /** The finished() signals still queued are ignored once handled here **/
+    while( m_isComputing )
+    {
+        m_computationWatcher.waitForFinished();
+        OnComputationFinished();
+    }
+}
+
+QVector< double > QCThresholdWorker::GetCorrelations() const
+{
+    return m_correlations;
+}
+
+
+/***************************************************************/
+/************************ Private slots ************************/
+/***************************************************************/
+void QCThresholdWorker::OnComputationFinished()
+{
+    if( !m_isComputing || !m_computationWatcher.future().isFinished() )
+    {
+        return;
+    }
+    m_isComputing = false;
+
+    /** A newer request replaces the correlations just computed **/
+    if( m_hasPendingRequest )
+    {
+        Request request = m_pendingRequest;
+        m_hasPendingRequest = false;
+        m_pendingRequest = Request();
+        Start( request );
+        return;
+    }
+    if( m_isStale )
+    {
+        m_isStale = false;
+        return;
+    }
+
+    m_correlations = m_computationWatcher.result();
+    emit CorrelationsComputed( m_correlations );
+}
+
+
+/***************************************************************/
+/********************** Private functions **********************/
+/***************************************************************/
+QVector< double > QCThresholdWorker::Compute( Request request )
+{
+    if( request.metric == QCThreshold::FPCA )
+    {
+        return request.functionalPCA.Score( request.profiles, request.first, request.last );
+    }
+
+    /** Running sums not computed yet if the profiles were set with the FPCA metric **/
+    if( request.hasProfiles || request.correlation->GetNbrProfiles() != request.profiles.size() )
+    {
+        request.correlation->SetProfiles( request.reference, request.profiles );
+    }
+
+    return request.correlation->Correlate( request.first, request.last );
+}
+
+QCThresholdWorker::Request QCThresholdWorker::CreateRequest( bool hasProfiles, int first, int last ) const
+{
+    Request request;
+    request.correlation = m_correlation;
+    request.reference = m_reference;
+    request.profiles = m_profiles;
+    request.hasProfiles = hasProfiles;
+    request.first = first;
+    request.last = last;
+    request.metric = m_metric;
+    request.functionalPCA = m_functionalPCA;
+
+    return request;
+}
+
+void QCThresholdWorker::Submit( Request request )
+{
+    if( !m_isComputing )
+    {
+        Start( request );
+        return;
+    }
+
+    /** New window for profiles still waiting for their running sums: the profiles are kept **/
+    if( m_hasPendingRequest && m_pendingRequest.hasProfiles && !request.hasProfiles && m_pendingRequest.correlation == request.correlation )
+    {
+        m_pendingRequest.first = request.first;
+        m_pendingRequest.last = request.last;
+    }
+    else
+    {
+        m_pendingRequest = request;
+    }
+    m_hasPendingRequest = true;
+}
+
+void QCThresholdWorker::Start( const Request& request )
+{
+    m_isComputing = true;
+    m_isStale = false;
+    m_computationWatcher.setFuture( QtConcurrent::run( &QCThresholdWorker::Compute, request ) );
+}
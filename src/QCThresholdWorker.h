@@ -0,0 +1,104 @@
+#ifndef QCTHRESHOLDWORKER_H
+#define QCTHRESHOLDWORKER_H
+
+#include "CroppedPearsonCorrelation.h"
+#include "QCThreshold.h"
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+/** Correlations of the QC threshold plot computed in a worker thread, so the dialog stays responsive while the profiles
+ *  are cropped or the subjects with NaN removed. One computation runs at a time: the requests made meanwhile are coalesced
+ *  into the latest one, the running computation is then stale and its correlations dropped. Only the correlations of the
+ *  latest request are posted back with CorrelationsComputed().
+ *  With the FPCA metric, the functional PCA outlier scores of the profiles are posted instead of their correlations. **/
+class QCThresholdWorker : public QObject
+{
+    friend class TestQCThresholdWorker; /** For unit tests **/
+
+    Q_OBJECT
+
+public:
+    explicit QCThresholdWorker( QObject *parent = 0 );
+
+    ~QCThresholdWorker();
+
+
+    /** Metric of the next requests, correlation by default **/
+    void SetMetric( QCThreshold::Metric metric, const FunctionalPCA& functionalPCA ); // Tested
+
+    /** Computed in the calling thread for the lines first displayed, the computations not finished are dropped **/
+    QVector< double > Correlate( const QList< double >& reference, const QList< QList< double > >& profiles, int first, int last ); // Tested
+
+    /** New profiles: their running sums are computed in the worker thread, then the window between the indexes first and last included is correlated **/
+    void SetProfiles( const QList< double >& reference, const QList< QList< double > >& profiles, int first, int last ); // Tested
+
+    /** Same profiles, new window: ignored if no profiles were set **/
+    void SetCropping( int first, int last ); // Tested
+
+    /** Drops the computations not finished: nothing is posted until the next request **/
+    void Cancel(); // Tested
+
+    bool IsComputing() const; // Tested
+
+    /** Blocks until the latest request is computed and its correlations posted **/
+    void WaitForCorrelations(); // Tested
+
+    /** Last correlations posted **/
+    QVector< double > GetCorrelations() const; // Tested
+
+
+signals:
+    void CorrelationsComputed( const QVector< double >& correlations );
+
+
+private slots:
+    void OnComputationFinished(); // Not Directly Tested
+
+
+private:
+    struct Request
+    {
+        QSharedPointer< CroppedPearsonCorrelation > correlation;
+        QList< double > reference;
+        QList< QList< double > > profiles;
+        /** New profiles: their running sums are computed **/
+        bool hasProfiles;
+        int first, last;
+        QCThreshold::Metric metric;
+        FunctionalPCA functionalPCA;
+    };
+
+    QFutureWatcher< QVector< double > > m_computationWatcher;
+
+    /** Running sums of the last profiles set **/
+    QSharedPointer< CroppedPearsonCorrelation > m_correlation;
+
+    /** Last profiles set and their reference, shared with the requests without copy **/
+    QList< double > m_reference;
+    QList< QList< double > > m_profiles;
+
+    QCThreshold::Metric m_metric;
+
+    FunctionalPCA m_functionalPCA;
+
+    Request m_pendingRequest;
+
+    QVector< double > m_correlations;
+
+    bool m_isComputing, m_hasPendingRequest, m_isStale;
+
+
+    /** Run in the worker thread **/
+    static QVector< double > Compute( Request request ); // Not Directly Tested
+
+    Request CreateRequest( bool hasProfiles, int first, int last ) const; // Not Directly Tested
+
+    void Submit( Request request ); // Not Directly Tested
+
+    void Start( const Request& request ); // Not Directly Tested
+};
+
+#endif // QCTHRESHOLDWORKER_H
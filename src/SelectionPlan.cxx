@@ -0,0 +1,77 @@
+#include "SelectionPlan.h"
+#include "SubjectRegistry.h"
+
+#include <QBitArray>
+
+//#include <QDebug>
+
+
+SelectionPlan::SelectionPlan()
+{
+}
+
+
+void SelectionPlan::Build( const QStringList& candidates, const QStringList& selectedSubjects, int firstCandidate, bool isDeduplicated )
+{
+    m_indices.clear();
+
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QVector< int > selectedIDs = registry.GetIDs( selectedSubjects );
+    QVector< int > candidateIDs = registry.GetIDs( candidates );
+
+    /** Both lists are in the registry now: the selection and the subjects already kept are bits indexed by ID **/
+    QBitArray isSelected( registry.GetNbrSubjects() );
+    QBitArray isKept( isDeduplicated ? isSelected.size() : 0 );
+    foreach( int id, selectedIDs )
+    {
+        isSelected.setBit( id );
+    }
+
+    m_indices.reserve( qMin( candidates.size(), selectedSubjects.size() ) );
+    for( int index = qMax( firstCandidate, 0 ); index < candidateIDs.size(); index++ )
+    {
+        int id = candidateIDs.at( index );
+        if( isSelected.testBit( id ) && ( !isDeduplicated || !isKept.testBit( id ) ) )
+        {
+            m_indices.append( index );
+            if( isDeduplicated )
+            {
+                isKept.setBit( id );
+            }
+        }
+    }
+}
+
+QVector< int > SelectionPlan::GetIndices() const
+{
+    return m_indices;
+}
+
+int SelectionPlan::GetNbrIndices() const
+{
+    return m_indices.size();
+}
+
+QStringList SelectionPlan::Gather( const QStringList& values ) const
+{
+    QStringList selectedValues;
+    selectedValues.reserve( m_indices.size() );
+    foreach( int index, m_indices )
+    {
+        selectedValues.append( values.value( index ) );
+    }
+
+    return selectedValues;
+}
+
+QList< QStringList > SelectionPlan::Gather( const QList< QStringList >& rows ) const
+{
+    QList< QStringList > selectedRows;
+    selectedRows.reserve( m_indices.size() );
+    foreach( int index, m_indices )
+    {
+        selectedRows.append( rows.value( index ) );
+    }
+
+    return selectedRows;
+}
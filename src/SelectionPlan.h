@@ -0,0 +1,35 @@
+#ifndef SELECTIONPLAN_H
+#define SELECTIONPLAN_H
+
+#include <QStringList>
+#include <QVector>
+
+/** Indices of the rows or columns of a file holding the selected subjects, computed once before the file is copied.
+ *  The selected subjects and the candidates are turned into IDs of the SubjectRegistry, so building the plan
+ *  is linear in the number of candidates; applying it is a gather of the indices kept, in increasing order. **/
+class SelectionPlan
+{
+    friend class TestSelectionPlan; /** For unit tests **/
+
+public:
+    explicit SelectionPlan();
+
+    /** Keeps the candidates found in selectedSubjects, from firstCandidate on.
+     *  If isDeduplicated, only the 1st occurrence of a subject is kept. **/
+    void Build( const QStringList& candidates, const QStringList& selectedSubjects, int firstCandidate, bool isDeduplicated ); // Tested
+
+    QVector< int > GetIndices() const; // Tested
+
+    int GetNbrIndices() const; // Tested
+
+    /** Values at the indices kept, empty strings for the indices out of values **/
+    QStringList Gather( const QStringList& values ) const; // Tested
+
+    QList< QStringList > Gather( const QList< QStringList >& rows ) const; // Tested
+
+
+private:
+    QVector< int > m_indices;
+};
+
+#endif // SELECTIONPLAN_H
@@ -0,0 +1,186 @@
+#include "SubjectFilterProxyModel.h"
+
+//#include <QDebug>
+
+
+SubjectFilterProxyModel::SubjectFilterProxyModel( QObject *parent ) :
+    QSortFilterProxyModel( parent )
+{
+    m_subjectModel = 0;
+    m_caseSensitivity = Qt::CaseSensitive;
+}
+
+
+void SubjectFilterProxyModel::setSourceModel( QAbstractItemModel *sourceModel )
+{
+    if( m_subjectModel != 0 )
+    {
+        disconnect( m_subjectModel, 0, this, 0 );
+    }
+    m_subjectModel = qobject_cast< SubjectListModel* >( sourceModel );
+
+    /** Connected before the proxy: the index is up to date when the proxy filters the rows changed **/
+    if( m_subjectModel != 0 )
+    {
+        connect( m_subjectModel, SIGNAL( modelReset() ), this, SLOT( OnModelReset() ) );
+        connect( m_subjectModel, SIGNAL( rowsInserted( const QModelIndex&, int, int ) ), this, SLOT( OnRowsInserted( const QModelIndex&, int, int ) ) );
+        connect( m_subjectModel, SIGNAL( rowsAboutToBeRemoved( const QModelIndex&, int, int ) ), this, SLOT( OnRowsAboutToBeRemoved( const QModelIndex&, int, int ) ) );
+        connect( m_subjectModel, SIGNAL( dataChanged( const QModelIndex&, const QModelIndex&, const QVector< int >& ) ),
+                 this, SLOT( OnDataChanged( const QModelIndex&, const QModelIndex&, const QVector< int >& ) ) );
+    }
+
+    QSortFilterProxyModel::setSourceModel( sourceModel );
+    OnModelReset();
+}
+
+void SubjectFilterProxyModel::SetSearch( const QString& search, Qt::CaseSensitivity caseSensitivity )
+{
+    if( search == m_search && caseSensitivity == m_caseSensitivity )
+    {
+        return;
+    }
+
+    QList< int > foundSubjectIDs;
+    if( !search.isEmpty() )
+    {
+        foundSubjectIDs = caseSensitivity == m_caseSensitivity && SubjectSearchIndex::IsNarrowing( search, m_search, caseSensitivity ) ?
+                    m_searchIndex.Find( search, caseSensitivity, m_foundSubjectIDs ) : m_searchIndex.Find( search, caseSensitivity );
+    }
+    m_search = search;
+    m_caseSensitivity = caseSensitivity;
+    SetFoundSubjects( foundSubjectIDs );
+
+    invalidateFilter();
+}
+
+bool SubjectFilterProxyModel::IsSearching() const
+{
+    return !m_search.isEmpty();
+}
+
+QList< int > SubjectFilterProxyModel::GetFoundSubjectIDs() const
+{
+    return m_foundSubjectIDs;
+}
+
+
+bool SubjectFilterProxyModel::filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const
+{
+    if( m_search.isEmpty() || m_subjectModel == 0 || sourceParent.isValid() )
+    {
+        return true;
+    }
+
+    int subjectID = m_subjectModel->GetSubjectID( sourceRow );
+    return subjectID >= 0 && subjectID < m_isFound.size() && m_isFound.testBit( subjectID );
+}
+
+
+void SubjectFilterProxyModel::OnModelReset()
+{
+    m_searchIndex.Clear();
+    if( m_subjectModel != 0 && m_subjectModel->GetNbrSubjects() != 0 )
+    {
+        IndexRows( 0, m_subjectModel->GetNbrSubjects() - 1 );
+    }
+
+    SetFoundSubjects( m_search.isEmpty() ? QList< int >() : m_searchIndex.Find( m_search, m_caseSensitivity ) );
+}
+
+void SubjectFilterProxyModel::OnRowsInserted( const QModelIndex& parent, int first, int last )
+{
+    if( parent.isValid() )
+    {
+        return;
+    }
+    IndexRows( first, last );
+
+    if( !m_search.isEmpty() )
+    {
+        QList< int > insertedSubjectIDs;
+        for( int row = first; row <= last; row++ )
+        {
+            insertedSubjectIDs.append( m_subjectModel->GetSubjectID( row ) );
+        }
+        AddFoundSubjects( m_searchIndex.Find( m_search, m_caseSensitivity, insertedSubjectIDs ) );
+    }
+}
+
+void SubjectFilterProxyModel::OnRowsAboutToBeRemoved( const QModelIndex& parent, int first, int last )
+{
+    if( parent.isValid() )
+    {
+        return;
+    }
+
+    for( int row = first; row <= last; row++ )
+    {
+        int subjectID = m_subjectModel->GetSubjectID( row );
+        m_searchIndex.Remove( subjectID );
+        if( subjectID < m_isFound.size() && m_isFound.testBit( subjectID ) )
+        {
+            m_isFound.clearBit( subjectID );
+            m_foundSubjectIDs.removeOne( subjectID );
+        }
+    }
+}
+
+void SubjectFilterProxyModel::OnDataChanged( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector< int >& roles )
+{
+    /** Check states changed: nothing to search again **/
+    if( !roles.isEmpty() && !roles.contains( Qt::DisplayRole ) )
+    {
+        return;
+    }
+    IndexRows( topLeft.row(), bottomRight.row() );
+
+    if( !m_search.isEmpty() )
+    {
+        QList< int > changedSubjectIDs;
+        for( int row = topLeft.row(); row <= bottomRight.row(); row++ )
+        {
+            int subjectID = m_subjectModel->GetSubjectID( row );
+            changedSubjectIDs.append( subjectID );
+            if( subjectID < m_isFound.size() && m_isFound.testBit( subjectID ) )
+            {
+                m_isFound.clearBit( subjectID );
+                m_foundSubjectIDs.removeOne( subjectID );
+            }
+        }
+        AddFoundSubjects( m_searchIndex.Find( m_search, m_caseSensitivity, changedSubjectIDs ) );
+    }
+}
+
+
+void SubjectFilterProxyModel::IndexRows( int first, int last )
+{
+    for( int row = first; row <= last; row++ )
+    {
+        m_searchIndex.Insert( m_subjectModel->GetSubjectID( row ), m_subjectModel->index( row ).data().toString() );
+    }
+}
+
+void SubjectFilterProxyModel::SetFoundSubjects( const QList< int >& foundSubjectIDs )
+{
+    m_foundSubjectIDs.clear();
+    m_isFound = QBitArray( SubjectRegistry::GetInstance().GetNbrSubjects() );
+    AddFoundSubjects( foundSubjectIDs );
+}
+
+void SubjectFilterProxyModel::AddFoundSubjects( const QList< int >& foundSubjectIDs )
+{
+    int nbrSubjects = SubjectRegistry::GetInstance().GetNbrSubjects();
+    if( m_isFound.size() < nbrSubjects )
+    {
+        m_isFound.resize( nbrSubjects );
+    }
+
+    foreach( int subjectID, foundSubjectIDs )
+    {
+        if( subjectID >= 0 && subjectID < m_isFound.size() && !m_isFound.testBit( subjectID ) )
+        {
+            m_isFound.setBit( subjectID );
+            m_foundSubjectIDs.append( subjectID );
+        }
+    }
+}
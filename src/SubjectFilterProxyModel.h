@@ -0,0 +1,69 @@
+#ifndef SUBJECTFILTERPROXYMODEL_H
+#define SUBJECTFILTERPROXYMODEL_H
+
+#include "SubjectListModel.h"
+#include "SubjectSearchIndex.h"
+
+#include <QSortFilterProxyModel>
+
+/** Subjects of a SubjectListModel matching the search typed in the subjects tab.
+ *  The subjects found are looked up in a SubjectSearchIndex kept up to date with the rows of the model,
+ *  and a row is shown if the bit of its subject is set: hiding rows does not match their text again.
+ *  A search holding the previous one is only matched against the subjects previously found. **/
+class SubjectFilterProxyModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+
+public:
+    explicit SubjectFilterProxyModel( QObject *parent = 0 );
+
+
+    /** Source expected to be a SubjectListModel **/
+    void setSourceModel( QAbstractItemModel *sourceModel ); // Tested
+
+    /** Every subject shown if the search is empty **/
+    void SetSearch( const QString& search, Qt::CaseSensitivity caseSensitivity ); // Tested
+
+    bool IsSearching() const; // Tested
+
+    /** Subjects found by the current search **/
+    QList< int > GetFoundSubjectIDs() const; // Tested
+
+
+protected:
+    bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const; // Tested
+
+
+private slots:
+    void OnModelReset();
+
+    void OnRowsInserted( const QModelIndex& parent, int first, int last );
+
+    void OnRowsAboutToBeRemoved( const QModelIndex& parent, int first, int last );
+
+    void OnDataChanged( const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector< int >& roles );
+
+
+private:
+    SubjectListModel *m_subjectModel;
+
+    SubjectSearchIndex m_searchIndex;
+
+    QString m_search;
+
+    Qt::CaseSensitivity m_caseSensitivity;
+
+    QList< int > m_foundSubjectIDs;
+
+    /** Indexed by ID **/
+    QBitArray m_isFound;
+
+
+    void IndexRows( int first, int last ); // Not Directly Tested
+
+    void SetFoundSubjects( const QList< int >& foundSubjectIDs ); // Not Directly Tested
+
+    void AddFoundSubjects( const QList< int >& foundSubjectIDs ); // Not Directly Tested
+};
+
+#endif // SUBJECTFILTERPROXYMODEL_H
@@ -0,0 +1,245 @@
+#include "SubjectListModel.h"
+
+#include <QBrush>
+
+#include <algorithm>
+
+//#include <QDebug>
+
+
+SubjectListModel::SubjectListModel( bool isCheckable, QObject *parent ) :
+    QAbstractListModel( parent )
+{
+    m_isCheckable = isCheckable;
+}
+
+
+int SubjectListModel::rowCount( const QModelIndex& parent ) const
+{
+    return parent.isValid() ? 0 : m_subjects.size();
+}
+
+QVariant SubjectListModel::data( const QModelIndex& index, int role ) const
+{
+    if( !index.isValid() || index.row() >= m_subjects.size() )
+    {
+        return QVariant();
+    }
+
+    int row = index.row();
+    bool isChecked = !m_isCheckable || m_isChecked.testBit( m_subjectIDs.at( row ) );
+    switch( role )
+    {
+    case Qt::DisplayRole:
+        return m_texts.at( row );
+    case Qt::CheckStateRole:
+        return m_isCheckable ? QVariant( isChecked ? Qt::Checked : Qt::Unchecked ) : QVariant();
+    case Qt::BackgroundRole:
+        return QBrush( isChecked ? m_checkedColor : m_uncheckedColor );
+    case Qt::ForegroundRole:
+        return m_textColor.isValid() ? QVariant( QBrush( m_textColor ) ) : QVariant();
+    case Qt::UserRole:
+        return m_subjects.at( row );
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags SubjectListModel::flags( const QModelIndex& index ) const
+{
+    if( !index.isValid() )
+    {
+        return Qt::NoItemFlags;
+    }
+
+    /** Check states changed by a click on the row, not by the check box only **/
+    return m_isCheckable ? Qt::ItemIsEnabled : Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+
+void SubjectListModel::SetColors( const QColor& checkedColor, const QColor& uncheckedColor, const QColor& textColor )
+{
+    m_checkedColor = checkedColor;
+    m_uncheckedColor = uncheckedColor;
+    m_textColor = textColor;
+
+    EmitCheckStateChanged();
+}
+
+void SubjectListModel::SetSubjects( const QStringList& subjects, const QStringList& texts )
+{
+    /** Sorted and without duplicates, the text of a subject following it **/
+    QMap< QString, QString > sortedSubjects;
+    for( int i = 0; i < subjects.size(); i++ )
+    {
+        sortedSubjects.insert( subjects.at( i ), texts.isEmpty() ? subjects.at( i ) : texts.value( i ) );
+    }
+
+    beginResetModel();
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    m_subjects = registry.Intern( sortedSubjects.keys() );
+    m_texts = texts.isEmpty() ? m_subjects : sortedSubjects.values();
+    m_subjectIDs = registry.GetIDs( m_subjects );
+
+    m_isDisplayed = QBitArray( registry.GetNbrSubjects() );
+    foreach( int id, m_subjectIDs )
+    {
+        m_isDisplayed.setBit( id );
+    }
+    m_isChecked = m_isDisplayed;
+    endResetModel();
+}
+
+void SubjectListModel::InsertSubject( const QString& subject, const QString& text )
+{
+    int id = SubjectRegistry::GetInstance().GetID( subject );
+    int row = GetRow( id );
+    if( row != -1 )
+    {
+        m_texts[ row ] = text;
+        emit dataChanged( index( row ), index( row ), QVector< int >() << Qt::DisplayRole );
+        return;
+    }
+
+    ResizeBitSets();
+    row = FindRow( subject );
+    beginInsertRows( QModelIndex(), row, row );
+    m_subjects.insert( row, SubjectRegistry::GetInstance().GetName( id ) );
+    m_texts.insert( row, text );
+    m_subjectIDs.insert( row, id );
+    m_isDisplayed.setBit( id );
+    m_isChecked.setBit( id );
+    endInsertRows();
+}
+
+void SubjectListModel::RemoveSubject( int subjectID )
+{
+    int row = GetRow( subjectID );
+    if( row == -1 )
+    {
+        return;
+    }
+
+    beginRemoveRows( QModelIndex(), row, row );
+    m_subjects.removeAt( row );
+    m_texts.removeAt( row );
+    m_subjectIDs.remove( row );
+    m_isDisplayed.clearBit( subjectID );
+    m_isChecked.clearBit( subjectID );
+    endRemoveRows();
+}
+
+int SubjectListModel::GetRow( int subjectID ) const
+{
+    if( subjectID < 0 || subjectID >= m_isDisplayed.size() || !m_isDisplayed.testBit( subjectID ) )
+    {
+        return -1;
+    }
+
+    int row = FindRow( SubjectRegistry::GetInstance().GetName( subjectID ) );
+    return ( row < m_subjectIDs.size() && m_subjectIDs.at( row ) == subjectID ) ? row : -1;
+}
+
+int SubjectListModel::GetSubjectID( int row ) const
+{
+    return m_subjectIDs.value( row, -1 );
+}
+
+QString SubjectListModel::GetSubject( int row ) const
+{
+    return m_subjects.value( row );
+}
+
+int SubjectListModel::GetNbrSubjects() const
+{
+    return m_subjects.size();
+}
+
+
+bool SubjectListModel::IsChecked( int subjectID ) const
+{
+    return subjectID >= 0 && subjectID < m_isChecked.size() && m_isChecked.testBit( subjectID );
+}
+
+void SubjectListModel::SetChecked( int subjectID, bool isChecked )
+{
+    int row = GetRow( subjectID );
+    if( row != -1 && m_isChecked.testBit( subjectID ) != isChecked )
+    {
+        m_isChecked.setBit( subjectID, isChecked );
+        emit dataChanged( index( row ), index( row ), QVector< int >() << Qt::CheckStateRole << Qt::BackgroundRole );
+    }
+}
+
+void SubjectListModel::SetChecked( const QSet< int >& subjectIDs, bool isChecked )
+{
+    /** Subjects not displayed are ignored **/
+    foreach( int id, subjectIDs )
+    {
+        if( id >= 0 && id < m_isDisplayed.size() && m_isDisplayed.testBit( id ) )
+        {
+            m_isChecked.setBit( id, isChecked );
+        }
+    }
+
+    EmitCheckStateChanged();
+}
+
+void SubjectListModel::SetAllChecked( bool isChecked )
+{
+    if( isChecked )
+    {
+        m_isChecked = m_isDisplayed;
+    }
+    else
+    {
+        m_isChecked.fill( false );
+    }
+
+    EmitCheckStateChanged();
+}
+
+int SubjectListModel::GetNbrChecked() const
+{
+    return m_isChecked.count( true );
+}
+
+QStringList SubjectListModel::GetCheckedSubjects() const
+{
+    QStringList checkedSubjects;
+    checkedSubjects.reserve( GetNbrChecked() );
+    for( int row = 0; row < m_subjects.size(); row++ )
+    {
+        if( m_isChecked.testBit( m_subjectIDs.at( row ) ) )
+        {
+            checkedSubjects.append( m_subjects.at( row ) );
+        }
+    }
+
+    return checkedSubjects;
+}
+
+
+int SubjectListModel::FindRow( const QString& subject ) const
+{
+    /** Same order as QStringList::sort() **/
+    return std::lower_bound( m_subjects.constBegin(), m_subjects.constEnd(), subject ) - m_subjects.constBegin();
+}
+
+void SubjectListModel::ResizeBitSets()
+{
+    int nbrSubjects = SubjectRegistry::GetInstance().GetNbrSubjects();
+    if( m_isDisplayed.size() < nbrSubjects )
+    {
+        m_isDisplayed.resize( nbrSubjects );
+        m_isChecked.resize( nbrSubjects );
+    }
+}
+
+void SubjectListModel::EmitCheckStateChanged()
+{
+    if( !m_subjects.isEmpty() )
+    {
+        emit dataChanged( index( 0 ), index( m_subjects.size() - 1 ), QVector< int >() << Qt::CheckStateRole << Qt::BackgroundRole );
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef SUBJECTLISTMODEL_H
+#define SUBJECTLISTMODEL_H
+
+#include "SubjectRegistry.h"
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QBitArray>
+#include <QColor>
+
+/** Subjects displayed in the subject lists, in alphabetical order.
+ *  Only the name, the SubjectRegistry ID and the text of each subject are stored: the rows are
+ *  given to the view when they are painted, no item is created per subject.
+ *  Check states are bits indexed by ID, so checking or unchecking every subject and counting
+ *  the subjects checked are bitset operations. **/
+class SubjectListModel : public QAbstractListModel
+{
+    friend class TestSubjectListModel; /** For unit tests **/
+
+    Q_OBJECT
+
+public:
+    explicit SubjectListModel( bool isCheckable, QObject *parent = 0 );
+
+
+    int rowCount( const QModelIndex& parent = QModelIndex() ) const; // Tested
+
+    QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const; // Tested
+
+    Qt::ItemFlags flags( const QModelIndex& index ) const; // Tested
+
+
+    /** Background of the checked and unchecked subjects, text color not set if invalid **/
+    void SetColors( const QColor& checkedColor, const QColor& uncheckedColor, const QColor& textColor = QColor() ); // Tested
+
+    /** Texts displayed, the subjects if empty. Every subject is checked. **/
+    void SetSubjects( const QStringList& subjects, const QStringList& texts = QStringList() ); // Tested
+
+    /** Inserted at its place in alphabetical order and checked, text updated if already displayed **/
+    void InsertSubject( const QString& subject, const QString& text ); // Tested
+
+    void RemoveSubject( int subjectID ); // Tested
+
+    /** -1 if the subject is not displayed **/
+    int GetRow( int subjectID ) const; // Tested
+
+    int GetSubjectID( int row ) const; // Tested
+
+    QString GetSubject( int row ) const; // Tested
+
+    int GetNbrSubjects() const; // Tested
+
+
+    bool IsChecked( int subjectID ) const; // Tested
+
+    void SetChecked( int subjectID, bool isChecked ); // Tested
+
+    void SetChecked( const QSet< int >& subjectIDs, bool isChecked ); // Tested
+
+    void SetAllChecked( bool isChecked ); // Tested
+
+    int GetNbrChecked() const; // Tested
+
+    /** In alphabetical order **/
+    QStringList GetCheckedSubjects() const; // Tested
+
+
+private:
+    bool m_isCheckable;
+
+    QColor m_checkedColor, m_uncheckedColor, m_textColor;
+
+    QStringList m_subjects, m_texts;
+
+    QVector< int > m_subjectIDs;
+
+    /** Indexed by ID: subjects displayed, and subjects displayed and checked **/
+    QBitArray m_isDisplayed, m_isChecked;
+
+
+    /** Row where the subject is or would be inserted **/
+    int FindRow( const QString& subject ) const; // Not Directly Tested
+
+    /** Bitsets as big as the registry **/
+    void ResizeBitSets(); // Not Directly Tested
+
+    /** Rows repainted after check states changed **/
+    void EmitCheckStateChanged(); // Not Directly Tested
+};
+
+#endif // SUBJECTLISTMODEL_H
@@ -0,0 +1,107 @@
+#include "SubjectMatcher.h"
+
+//#include <QDebug>
+
+
+const int SubjectMatcher::m_nbrBitsPerWord = 64;
+
+SubjectMatcher::SubjectMatcher()
+{
+    m_nbrWords = 0;
+}
+
+
+void SubjectMatcher::SetSubjects( const QStringList& subjects )
+{
+    SubjectRegistry& subjectRegistry = SubjectRegistry::GetInstance();
+    m_subjects = subjects;
+    m_subjects.removeDuplicates();
+    m_subjects.sort();
+
+    QVector< int > ids = subjectRegistry.GetIDs( m_subjects );
+    m_subjects = subjectRegistry.GetNames( ids );
+    m_ranks.fill( -1, subjectRegistry.GetNbrSubjects() );
+    for( int rank = 0; rank < ids.size(); rank++ )
+    {
+        m_ranks[ ids.at( rank ) ] = rank;
+    }
+
+    m_nbrWords = ( m_subjects.size() + m_nbrBitsPerWord - 1 ) / m_nbrBitsPerWord;
+    m_sources.clear();
+}
+
+void SubjectMatcher::SetSource( int sourceIndex, const QStringList& subjects )
+{
+    SetSource( sourceIndex, SubjectRegistry::GetInstance().GetIDs( subjects ) );
+}
+
+void SubjectMatcher::SetSource( int sourceIndex, const QVector< int >& subjectIDs )
+{
+    BitSet& bits = m_sources[ sourceIndex ];
+    bits.fill( 0, m_nbrWords );
+    foreach( int id, subjectIDs )
+    {
+        /** IDs added to the registry after SetSubjects() are not matched **/
+        int rank = ( id >= 0 && id < m_ranks.size() ) ? m_ranks.at( id ) : -1;
+        if( rank != -1 )
+        {
+            bits[ rank / m_nbrBitsPerWord ] |= Q_UINT64_C( 1 ) << ( rank % m_nbrBitsPerWord );
+        }
+    }
+}
+
+int SubjectMatcher::GetNbrSubjects() const
+{
+    return m_subjects.size();
+}
+
+int SubjectMatcher::GetNbrSources() const
+{
+    return m_sources.size();
+}
+
+
+void SubjectMatcher::Match( QStringList& matchedSubjects, QMap< QString, QList< int > >& unMatchedSubjects ) const
+{
+    /** No source: every subject is matched, as before **/
+    BitSet inAllSources( m_nbrWords, ~Q_UINT64_C( 0 ) );
+    BitSet inOneSource( m_nbrWords, 0 );
+    QMap< int, BitSet >::ConstIterator iterSource = m_sources.cbegin();
+    while( iterSource != m_sources.cend() )
+    {
+        const quint64 *bits = iterSource.value().constData();
+        for( int word = 0; word < m_nbrWords; word++ )
+        {
+            inAllSources[ word ] &= bits[ word ];
+            inOneSource[ word ] |= bits[ word ];
+        }
+        ++iterSource;
+    }
+
+    /** Ranks follow the alphabetical order: matched subjects are appended sorted and unmatched subjects are inserted at the end of the map **/
+    for( int rank = 0; rank < m_subjects.size(); rank++ )
+    {
+        int word = rank / m_nbrBitsPerWord;
+        quint64 mask = Q_UINT64_C( 1 ) << ( rank % m_nbrBitsPerWord );
+        if( inAllSources.at( word ) & mask )
+        {
+            matchedSubjects.append( m_subjects.at( rank ) );
+            continue;
+        }
+
+        QList< int > sourceIndices;
+        if( inOneSource.at( word ) & mask )
+        {
+            iterSource = m_sources.cbegin();
+            while( iterSource != m_sources.cend() )
+            {
+                if( iterSource.value().at( word ) & mask )
+                {
+                    sourceIndices.append( iterSource.key() );
+                }
+                ++iterSource;
+            }
+        }
+        unMatchedSubjects.insert( unMatchedSubjects.cend(), m_subjects.at( rank ), sourceIndices );
+    }
+}
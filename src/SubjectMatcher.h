@@ -0,0 +1,58 @@
+#ifndef SUBJECTMATCHER_H
+#define SUBJECTMATCHER_H
+
+#include "SubjectRegistry.h"
+
+#include <QStringList>
+#include <QMap>
+#include <QVector>
+
+/** Matches the subjects of the input files and of the loaded subject list.
+ *  Subjects are ranked in alphabetical order and each source gets a bitset of the ranks it holds:
+ *  subjects found in every source and in at least one source are computed 64 subjects at a time.
+ *  Sources given as IDs of the SubjectRegistry are set without any string comparison. **/
+class SubjectMatcher
+{
+    friend class TestSubjectMatcher; /** For unit tests **/
+
+public:
+    explicit SubjectMatcher();
+
+
+    /** Subjects to match, duplicates ignored. Sources previously set are removed. **/
+    void SetSubjects( const QStringList& subjects ); // Tested
+
+    /** Source index: diffusion property index of the file, -1 for the loaded subject list.
+     *  Subjects not set with SetSubjects() are ignored. **/
+    void SetSource( int sourceIndex, const QStringList& subjects ); // Tested
+
+    void SetSource( int sourceIndex, const QVector< int >& subjectIDs ); // Tested
+
+    int GetNbrSubjects() const; // Tested
+
+    int GetNbrSources() const; // Tested
+
+
+    /** Same results as the former Processing::SortSubjects() and AssignSortedSubject():
+     *  subjects found in every source, in alphabetical order, and the other subjects with the indices of the sources holding them **/
+    void Match( QStringList& matchedSubjects, QMap< QString, QList< int > >& unMatchedSubjects ) const; // Tested
+
+
+private:
+    typedef QVector< quint64 > BitSet;
+
+    static const int m_nbrBitsPerWord;
+
+
+    /** Names sorted: the bit of a subject is its rank in alphabetical order **/
+    QStringList m_subjects;
+
+    /** Rank of each ID of the SubjectRegistry, -1 if the subject is not matched **/
+    QVector< int > m_ranks;
+
+    QMap< int, BitSet > m_sources;
+
+    int m_nbrWords;
+};
+
+#endif // SUBJECTMATCHER_H
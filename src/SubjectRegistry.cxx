@@ -0,0 +1,142 @@
+#include "SubjectRegistry.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+//#include <QDebug>
+
+
+SubjectRegistry::SubjectRegistry()
+{
+}
+
+
+SubjectRegistry& SubjectRegistry::GetInstance()
+{
+    static SubjectRegistry subjectRegistry;
+    return subjectRegistry;
+}
+
+
+int SubjectRegistry::GetID( const QString& subject )
+{
+    {
+        QReadLocker locker( &m_lock );
+        QHash< QString, int >::ConstIterator iterID = m_ids.constFind( subject );
+        if( iterID != m_ids.constEnd() )
+        {
+            return iterID.value();
+        }
+    }
+
+    QWriteLocker locker( &m_lock );
+    return AddSubject( subject );
+}
+
+int SubjectRegistry::FindID( const QString& subject ) const
+{
+    QReadLocker locker( &m_lock );
+    return m_ids.value( subject, -1 );
+}
+
+QString SubjectRegistry::GetName( int id ) const
+{
+    QReadLocker locker( &m_lock );
+    return ( id >= 0 && id < m_names.size() ) ? m_names.at( id ) : QString();
+}
+
+QVector< int > SubjectRegistry::GetIDs( const QStringList& subjects )
+{
+    QVector< int > ids;
+    ids.reserve( subjects.size() );
+
+    /** The lock is taken once for the whole list **/
+    QWriteLocker locker( &m_lock );
+    foreach( QString subject, subjects )
+    {
+        ids.append( AddSubject( subject ) );
+    }
+
+    return ids;
+}
+
+QStringList SubjectRegistry::GetNames( const QVector< int >& ids ) const
+{
+    QStringList names;
+    names.reserve( ids.size() );
+
+    QReadLocker locker( &m_lock );
+    foreach( int id, ids )
+    {
+        names.append( ( id >= 0 && id < m_names.size() ) ? m_names.at( id ) : QString() );
+    }
+
+    return names;
+}
+
+QSet< int > SubjectRegistry::GetIDSet( const QStringList& subjects )
+{
+    QVector< int > ids = GetIDs( subjects );
+    QSet< int > idSet;
+    idSet.reserve( ids.size() );
+    foreach( int id, ids )
+    {
+        idSet.insert( id );
+    }
+
+    return idSet;
+}
+
+QStringList SubjectRegistry::Exclude( const QStringList& subjects, const QSet< int >& excludedIDs ) const
+{
+    QStringList remainingSubjects;
+    remainingSubjects.reserve( subjects.size() );
+
+    QReadLocker locker( &m_lock );
+    foreach( QString subject, subjects )
+    {
+        if( !excludedIDs.contains( m_ids.value( subject, -1 ) ) )
+        {
+            remainingSubjects.append( subject );
+        }
+    }
+
+    return remainingSubjects;
+}
+
+QStringList SubjectRegistry::Intern( const QStringList& subjects )
+{
+    QStringList names;
+    names.reserve( subjects.size() );
+
+    QWriteLocker locker( &m_lock );
+    foreach( QString subject, subjects )
+    {
+        names.append( m_names.at( AddSubject( subject ) ) );
+    }
+
+    return names;
+}
+
+int SubjectRegistry::GetNbrSubjects() const
+{
+    QReadLocker locker( &m_lock );
+    return m_names.size();
+}
+
+
+int SubjectRegistry::AddSubject( const QString& subject )
+{
+    QHash< QString, int >::ConstIterator iterID = m_ids.constFind( subject );
+    if( iterID != m_ids.constEnd() )
+    {
+        return iterID.value();
+    }
+
+    /** The key of the hash and the name of the ID share the same string **/
+    int id = m_names.size();
+    m_names.append( subject );
+    m_ids.insert( m_names.last(), id );
+
+    return id;
+}
@@ -0,0 +1,59 @@
+#ifndef SUBJECTREGISTRY_H
+#define SUBJECTREGISTRY_H
+
+#include <QStringList>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QReadWriteLock>
+
+/** Process-wide pool of the subject names: each distinct name gets a dense ID and is stored once.
+ *  Names returned by Intern() share the pooled string, so the subject lists copied between the
+ *  components (data, subject lists, plots, QC threshold) do not duplicate it.
+ *  Membership tests and joins are done on the IDs. IDs are never reused, the pool only grows. **/
+class SubjectRegistry
+{
+    friend class TestSubjectRegistry; /** For unit tests **/
+
+public:
+    static SubjectRegistry& GetInstance(); // Tested
+
+
+    /** ID of the subject, added to the pool if not found **/
+    int GetID( const QString& subject ); // Tested
+
+    /** -1 if the subject is not in the pool **/
+    int FindID( const QString& subject ) const; // Tested
+
+    QString GetName( int id ) const; // Tested
+
+    QVector< int > GetIDs( const QStringList& subjects ); // Tested
+
+    QStringList GetNames( const QVector< int >& ids ) const; // Tested
+
+    QSet< int > GetIDSet( const QStringList& subjects ); // Tested
+
+    /** Subjects whose ID is not in excludedIDs, in the same order **/
+    QStringList Exclude( const QStringList& subjects, const QSet< int >& excludedIDs ) const; // Tested
+
+    /** The pooled names, in the same order **/
+    QStringList Intern( const QStringList& subjects ); // Tested
+
+    int GetNbrSubjects() const; // Tested
+
+
+private:
+    mutable QReadWriteLock m_lock;
+
+    QHash< QString, int > m_ids;
+
+    QVector< QString > m_names;
+
+
+    explicit SubjectRegistry();
+
+    /** Write lock held by the caller **/
+    int AddSubject( const QString& subject ); // Not Directly Tested
+};
+
+#endif // SUBJECTREGISTRY_H
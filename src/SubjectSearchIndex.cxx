@@ -0,0 +1,197 @@
+#include "SubjectSearchIndex.h"
+
+//#include <QDebug>
+
+
+SubjectSearchIndex::SubjectSearchIndex()
+{
+}
+
+
+void SubjectSearchIndex::Clear()
+{
+    m_texts.clear();
+    m_trigramSubjects.clear();
+}
+
+void SubjectSearchIndex::Insert( int subjectID, const QString& text )
+{
+    if( m_texts.contains( subjectID ) )
+    {
+        if( m_texts.value( subjectID ) == text )
+        {
+            return;
+        }
+        Remove( subjectID );
+    }
+
+    m_texts.insert( subjectID, text );
+    foreach( quint64 trigram, GetTrigrams( text ) )
+    {
+        m_trigramSubjects[ trigram ].insert( subjectID );
+    }
+}
+
+void SubjectSearchIndex::Remove( int subjectID )
+{
+    if( !m_texts.contains( subjectID ) )
+    {
+        return;
+    }
+
+    foreach( quint64 trigram, GetTrigrams( m_texts.take( subjectID ) ) )
+    {
+        QHash< quint64, QSet< int > >::Iterator iterTrigram = m_trigramSubjects.find( trigram );
+        iterTrigram.value().remove( subjectID );
+        if( iterTrigram.value().isEmpty() )
+        {
+            m_trigramSubjects.erase( iterTrigram );
+        }
+    }
+}
+
+int SubjectSearchIndex::GetNbrSubjects() const
+{
+    return m_texts.size();
+}
+
+
+QList< int > SubjectSearchIndex::Find( const QString& search, Qt::CaseSensitivity caseSensitivity ) const
+{
+    /** Smallest set of subjects holding every trigram of the search **/
+    QList< const QSet< int >* > trigramSubjects;
+    foreach( QString literalPart, GetLiteralParts( search ) )
+    {
+        foreach( quint64 trigram, GetTrigrams( literalPart ) )
+        {
+            QHash< quint64, QSet< int > >::ConstIterator iterTrigram = m_trigramSubjects.constFind( trigram );
+            if( iterTrigram == m_trigramSubjects.constEnd() )
+            {
+                return QList< int >();
+            }
+            trigramSubjects.append( &iterTrigram.value() );
+        }
+    }
+
+    if( trigramSubjects.isEmpty() )
+    {
+        return Match( GetRegExp( search, caseSensitivity ), m_texts.keys() );
+    }
+
+    const QSet< int > *smallestSet = trigramSubjects.first();
+    foreach( const QSet< int > *currentSet, trigramSubjects )
+    {
+        if( currentSet->size() < smallestSet->size() )
+        {
+            smallestSet = currentSet;
+        }
+    }
+    QList< int > candidateIDs;
+    foreach( int subjectID, *smallestSet )
+    {
+        bool isCandidate = true;
+        for( int i = 0; i < trigramSubjects.size() && isCandidate; i++ )
+        {
+            isCandidate = trigramSubjects.at( i )->contains( subjectID );
+        }
+        if( isCandidate )
+        {
+            candidateIDs.append( subjectID );
+        }
+    }
+
+    return Match( GetRegExp( search, caseSensitivity ), candidateIDs );
+}
+
+QList< int > SubjectSearchIndex::Find( const QString& search, Qt::CaseSensitivity caseSensitivity, const QList< int >& candidateIDs ) const
+{
+    return Match( GetRegExp( search, caseSensitivity ), candidateIDs );
+}
+
+bool SubjectSearchIndex::IsNarrowing( const QString& search, const QString& previousSearch, Qt::CaseSensitivity caseSensitivity )
+{
+    /** A text holding the search holds the previous search if the previous search is part of it **/
+    return !previousSearch.isEmpty() && !IsWildcard( search ) && !IsWildcard( previousSearch ) &&
+            search.contains( previousSearch, caseSensitivity );
+}
+
+
+bool SubjectSearchIndex::IsWildcard( const QString& search )
+{
+    return search.contains( '*' ) || search.contains( '?' ) || search.contains( '[' );
+}
+
+QStringList SubjectSearchIndex::GetLiteralParts( const QString& search )
+{
+    QStringList literalParts;
+    QString currentPart;
+    for( int i = 0; i < search.size(); i++ )
+    {
+        QChar currentChar = search.at( i );
+        if( currentChar == '*' || currentChar == '?' || currentChar == '[' )
+        {
+            if( !currentPart.isEmpty() )
+            {
+                literalParts.append( currentPart );
+                currentPart.clear();
+            }
+            if( currentChar == '[' )
+            {
+                /** Set left out up to its closing bracket, "[]...]" holding ']' **/
+                int closingBracket = search.indexOf( ']', i + 2 );
+                if( closingBracket == -1 )
+                {
+                    return literalParts;
+                }
+                i = closingBracket;
+            }
+        }
+        else
+        {
+            currentPart.append( currentChar );
+        }
+    }
+    if( !currentPart.isEmpty() )
+    {
+        literalParts.append( currentPart );
+    }
+
+    return literalParts;
+}
+
+QSet< quint64 > SubjectSearchIndex::GetTrigrams( const QString& text )
+{
+    QString lowerText = text.toLower();
+    QSet< quint64 > trigrams;
+    for( int i = 0; i + 2 < lowerText.size(); i++ )
+    {
+        trigrams.insert( ( quint64( lowerText.at( i ).unicode() ) << 32 ) | ( quint64( lowerText.at( i + 1 ).unicode() ) << 16 ) |
+                         quint64( lowerText.at( i + 2 ).unicode() ) );
+    }
+
+    return trigrams;
+}
+
+QRegExp SubjectSearchIndex::GetRegExp( const QString& search, Qt::CaseSensitivity caseSensitivity ) const
+{
+    QRegExp regExp( "*" + search + "*" );
+    regExp.setPatternSyntax( QRegExp::Wildcard );
+    regExp.setCaseSensitivity( caseSensitivity );
+
+    return regExp;
+}
+
+QList< int > SubjectSearchIndex::Match( const QRegExp& regExp, const QList< int >& candidateIDs ) const
+{
+    QList< int > foundIDs;
+    foreach( int subjectID, candidateIDs )
+    {
+        QHash< int, QString >::ConstIterator iterText = m_texts.constFind( subjectID );
+        if( iterText != m_texts.constEnd() && regExp.exactMatch( iterText.value() ) )
+        {
+            foundIDs.append( subjectID );
+        }
+    }
+
+    return foundIDs;
+}
@@ -0,0 +1,62 @@
+#ifndef SUBJECTSEARCHINDEX_H
+#define SUBJECTSEARCHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QRegExp>
+
+/** Trigram index over the texts displayed for the subjects, keyed by SubjectRegistry ID.
+ *  A search matches the texts containing it, with the wildcards of QRegExp::Wildcard ("*search*").
+ *  The trigrams of the literal parts of the search give the candidates, the texts of the candidates
+ *  only are matched: a search does not go through every subject.
+ *  Trigrams are indexed in lower case, so the same index is used whatever the case sensitivity. **/
+class SubjectSearchIndex
+{
+    friend class TestSubjectSearchIndex; /** For unit tests **/
+
+public:
+    explicit SubjectSearchIndex();
+
+
+    void Clear(); // Tested
+
+    /** Text replaced if the subject is already indexed **/
+    void Insert( int subjectID, const QString& text ); // Tested
+
+    void Remove( int subjectID ); // Tested
+
+    int GetNbrSubjects() const; // Tested
+
+
+    /** Subjects whose text matches the search **/
+    QList< int > Find( const QString& search, Qt::CaseSensitivity caseSensitivity ) const; // Tested
+
+    /** Same, among the candidates only **/
+    QList< int > Find( const QString& search, Qt::CaseSensitivity caseSensitivity, const QList< int >& candidateIDs ) const; // Tested
+
+    /** True if every text matching the search also matches the previous search, so the search can be narrowed **/
+    static bool IsNarrowing( const QString& search, const QString& previousSearch, Qt::CaseSensitivity caseSensitivity ); // Tested
+
+
+private:
+    QHash< int, QString > m_texts;
+
+    QHash< quint64, QSet< int > > m_trigramSubjects;
+
+
+    static bool IsWildcard( const QString& search ); // Not Directly Tested
+
+    /** Parts of the search matched literally, the wildcards and the sets [...] left out **/
+    static QStringList GetLiteralParts( const QString& search ); // Tested
+
+    static QSet< quint64 > GetTrigrams( const QString& text ); // Not Directly Tested
+
+    QRegExp GetRegExp( const QString& search, Qt::CaseSensitivity caseSensitivity ) const; // Not Directly Tested
+
+    QList< int > Match( const QRegExp& regExp, const QList< int >& candidateIDs ) const; // Not Directly Tested
+};
+
+#endif // SUBJECTSEARCHINDEX_H
@@ -0,0 +1,48 @@
+#ifndef TESTCSVREADER_H
+#define TESTCSVREADER_H
+
+#include "CSVReader.h"
+#include "Processing.h"
+
+#include <QLocale>
+
+#include <iostream>
+
+
+class TestCSVReader
+{
+public:
+    TestCSVReader();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Read( QString file_N_Path, QString file_R_Path, QString file_RN_Path );
+
+    bool Test_ReadNumericData( QString adFilePath, QString subMatrix0FilePath );
+
+    bool Test_ReadContent();
+
+    bool Test_ReadInParallel( QString adFilePath );
+
+    bool Test_ReadSelection( QString adFilePath, QString subMatrix0FilePath );
+
+    bool Test_ParseNumber();
+
+    bool Test_GetData();
+
+    bool Test_ValidationReport();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    bool IsDataEqualToText( const CSVData& csvData, const QList< QStringList >& textData );
+
+    QByteArray GetBigContent( bool isSubMatrix );
+
+    bool AreValuesEqual( double value1, double value2 );
+};
+
+#endif // TESTCSVREADER_H
@@ -0,0 +1,36 @@
+#ifndef TESTCSVSIDECAR_H
+#define TESTCSVSIDECAR_H
+
+#include "CSVSidecar.h"
+#include "CSVReader.h"
+#include "CSVWriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QLocale>
+#include <QTextStream>
+
+#include <iostream>
+
+
+class TestCSVSidecar
+{
+public:
+    TestCSVSidecar();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_WriteRead( QString adFilePath, QString subMatrix0FilePath, QString tempoDir );
+
+    bool Test_OutdatedSidecar( QString tempoDir );
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    void WriteFile( QString filePath, QString content );
+};
+
+#endif // TESTCSVSIDECAR_H
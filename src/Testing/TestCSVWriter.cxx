@@ -0,0 +1,176 @@
+#include "TestCSVWriter.h"
+
+TestCSVWriter::TestCSVWriter()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestCSVWriter::Test_Gather()
+{
+    CSVData data = GetData();
+    CSVWriter csvWriter( "," );
+
+
+    /** Cells written as they were read: no trailing zero dropped, no exponent changed, quotes kept **/
+    QByteArray buffer;
+    QByteArray expectedSelection = "\"arclength\",Stan,Kyle\n0.100,2.5000e-03,1\n0.300,-0.0,3\n";
+    bool testSelection = csvWriter.Gather( data, QVector< int >() << 0 << 1 << 3, QVector< int >() << 0 << 1 << 3, buffer ) && buffer == expectedSelection;
+
+    /** Plans in any order, indices out of data and cells missing from a ragged row written as empty cells **/
+    QByteArray expectedOrder = "Kyle,\"arclength\",\n,0.200,\n,,\n";
+    bool testOrder = csvWriter.Gather( data, QVector< int >() << 0 << 2 << 7, QVector< int >() << 3 << 0 << 9, buffer ) && buffer == expectedOrder;
+
+    /** Cells with other characters than ASCII copied byte for byte, rows split with the separator they were read with **/
+    bool testEncoding = CSVWriter( ";" ).Gather( data, QVector< int >() << 0, QVector< int >() << 2 << 4, buffer ) && buffer == "Cartman;K\xC3\xA9nny\n";
+
+    bool testEmptyPlans = csvWriter.Gather( data, QVector< int >(), QVector< int >() << 0, buffer ) && buffer.isEmpty() &&
+            csvWriter.Gather( data, QVector< int >() << 0 << 1, QVector< int >(), buffer ) && buffer == "\n\n";
+
+
+    bool testGather_Passed = testSelection && testOrder && testEncoding && testEmptyPlans;
+    if( !testGather_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Gather() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Gather( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Gather() PASSED";
+    }
+
+    return testGather_Passed;
+}
+
+bool TestCSVWriter::Test_GatherFromFile( QString tempoDir )
+{
+    QString dirTest = tempoDir + "/TestCSVWriter/Test_GatherFromFile";
+    QDir().mkpath( dirTest );
+    QString filePath = dirTest + "/ad.csv";
+    QString bigFilePath = dirTest + "/big.csv";
+    CSVReader csvReader( "," );
+    CSVWriter csvWriter( "," );
+
+    /** Byte order mark, "\r\n" rows, an empty row and a ragged row **/
+    QByteArray content = "\xEF\xBB\xBF\"arclength\",Stan,Cartman,Kyle\r\n"
+                         "0.100,2.5000e-03,NaN,1\r\n"
+                         "\r\n"
+                         "0.200,+7\r\n"
+                         "0.300,-0.0,5,3\r\n";
+    WriteFile( filePath, content );
+    QVector< int > rowPlan = QVector< int >() << 0 << 3 << 2;
+    QVector< int > columnPlan = QVector< int >() << 0 << 3;
+    QByteArray expectedText = "\"arclength\",Kyle\n0.300,3\n0.200,\n";
+
+    /** Bigger than a chunk: parsed in parallel **/
+    QByteArray bigContent = "arclength,Stan,Cartman\n";
+    for( int row = 0; row < 50000; row++ )
+    {
+        bigContent += QByteArray::number( row ) + ",0." + QByteArray::number( row ) + "," + QByteArray::number( -row ) + "\n";
+    }
+    WriteFile( bigFilePath, bigContent );
+    CSVReader parallelReader( "," );
+    parallelReader.SetNbrThreads( 4 );
+
+
+    /** Rows read again from the file, at the positions kept when it was parsed **/
+    QByteArray contentText, fileText;
+    CSVData fileData = csvReader.Read( filePath );
+    bool testFile = csvWriter.Gather( csvReader.ReadContent( content ), rowPlan, columnPlan, contentText ) && contentText == expectedText &&
+            csvWriter.Gather( fileData, rowPlan, columnPlan, fileText ) && fileText == expectedText;
+
+    QByteArray parallelText;
+    bool testParallel = csvWriter.Gather( parallelReader.Read( bigFilePath ), QVector< int >() << 0 << 1 << 25000 << 50000, QVector< int >() << 0 << 2,
+                                          parallelText ) && parallelText == "arclength,Cartman\n0,0\n24999,-24999\n49999,-49999\n";
+
+    /** Selection: only the cells selected are kept, rows indexed as in the selection **/
+    QByteArray selectionText;
+    CSVData selection = csvReader.ReadSelection( filePath, QStringList() << "Kyle", 0, -1, -1 );
+    bool testSelection = csvWriter.Gather( selection, rowPlan, QVector< int >() << 0 << 1, selectionText ) && selectionText == expectedText;
+
+    /** File changed since it was parsed: the positions kept no longer match **/
+    WriteFile( filePath, content + "0.400,1,2,3\r\n" );
+    QByteArray changedText = "0.400";
+    bool testChangedFile = !csvWriter.Gather( fileData, rowPlan, columnPlan, changedText ) && changedText.isEmpty();
+
+    QFile::remove( filePath );
+    bool testNoFile = !csvWriter.Gather( fileData, rowPlan, columnPlan, changedText ) && selection.GetFilePath() == filePath &&
+            csvWriter.Gather( selection, rowPlan, QVector< int >() << 0 << 1, selectionText ) && selectionText == expectedText;
+
+
+    bool testGatherFromFile_Passed = testFile && testParallel && testSelection && testChangedFile && testNoFile;
+    if( !testGatherFromFile_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GatherFromFile() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Gather( const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan, QByteArray& buffer )" << std::endl;
+        //        if( !testFile || !testParallel )
+        //        {
+        //            std::cerr << "\t  rows read again from the file differ from the rows parsed" << std::endl;
+        //        }
+        //        if( !testChangedFile || !testNoFile )
+        //        {
+        //            std::cerr << "\t  rows read from a file changed since it was parsed" << std::endl;
+        //        }
+    }
+    else
+    {
+        std::cerr << "Test_GatherFromFile() PASSED";
+    }
+
+    return testGatherFromFile_Passed;
+}
+
+bool TestCSVWriter::Test_Write()
+{
+    CSVData data = GetData();
+    CSVWriter csvWriter( "," );
+    QVector< int > rowPlan = QVector< int >() << 0 << 2;
+    QVector< int > columnPlan = QVector< int >() << 0 << 2;
+
+
+    QBuffer buffer;
+    buffer.open( QIODevice::WriteOnly );
+    bool testWrite = csvWriter.Write( buffer, data, rowPlan, columnPlan ) && buffer.data() == "\"arclength\",Cartman\n0.200,4\n";
+
+    QBuffer closedBuffer;
+    bool testClosedDevice = !csvWriter.Write( closedBuffer, data, rowPlan, columnPlan ) && closedBuffer.data().isEmpty();
+
+
+    bool testWrite_Passed = testWrite && testClosedDevice;
+    if( !testWrite_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Write() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Write( QIODevice& device, const CSVData& data, const QVector< int >& rowPlan, const QVector< int >& columnPlan )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Write() PASSED";
+    }
+
+    return testWrite_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+CSVData TestCSVWriter::GetData()
+{
+    /** Ragged 2nd data row: the last two subjects missing **/
+    return CSVReader( "," ).ReadContent( "\"arclength\",Stan,Cartman,Kyle,K\xC3\xA9nny\n"
+                                         "0.100,2.5000e-03,NaN,1,0.1\n"
+                                         "0.200,+7,4\n"
+                                         "0.300,-0.0,5,3,0.3\n" );
+}
+
+void TestCSVWriter::WriteFile( QString filePath, const QByteArray& content )
+{
+    QFile file( filePath );
+    if( file.open( QIODevice::WriteOnly ) )
+    {
+        file.write( content );
+        file.close();
+    }
+}
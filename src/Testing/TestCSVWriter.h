@@ -0,0 +1,38 @@
+#ifndef TESTCSVWRITER_H
+#define TESTCSVWRITER_H
+
+#include "CSVWriter.h"
+#include "CSVReader.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+
+#include <iostream>
+
+
+class TestCSVWriter
+{
+public:
+    TestCSVWriter();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Gather();
+
+    bool Test_GatherFromFile( QString tempoDir );
+
+    bool Test_Write();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    CSVData GetData();
+
+    void WriteFile( QString filePath, const QByteArray& content );
+};
+
+#endif // TESTCSVWRITER_H
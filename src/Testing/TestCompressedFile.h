@@ -0,0 +1,46 @@
+#ifndef TESTCOMPRESSEDFILE_H
+#define TESTCOMPRESSEDFILE_H
+
+#include "CompressedFile.h"
+#include "CompressedFileDevice.h"
+#include "CSVReader.h"
+#include "CSVWriter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QLocale>
+#include <QTextStream>
+
+#include <zlib.h>
+
+#include <iostream>
+
+
+class TestCompressedFile
+{
+public:
+    TestCompressedFile();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_GetFormat( QString tempoDir );
+
+    bool Test_Read( QString adFilePath, QString tempoDir );
+
+    bool Test_ReadCSV( QString adFilePath, QString subMatrix0FilePath, QString tempoDir );
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    QByteArray ReadFile( QString filePath );
+
+    void WriteFile( QString filePath, const QByteArray& content );
+
+    /** Content split in nbrMembers gzip members written one after the other, as done by pigz **/
+    void WriteGzipFile( QString filePath, const QByteArray& content, int nbrMembers );
+};
+
+#endif // TESTCOMPRESSEDFILE_H
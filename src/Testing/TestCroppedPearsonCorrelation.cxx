@@ -0,0 +1,176 @@
+#include "TestCroppedPearsonCorrelation.h"
+
+TestCroppedPearsonCorrelation::TestCroppedPearsonCorrelation()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestCroppedPearsonCorrelation::Test_SetProfiles()
+{
+    QList< double > reference = QList< double >() << -10 << -11 << -12.5 << -14 << -15 << -4.25;
+    QList< QList< double > > profiles = QList< QList< double > >() << ( QList< double >() << 2 << -8 << -14 << -20 << 0 << -9 << 100 )
+                                                                   << ( QList< double >() << 6 << -12 << -18 << 24 << 0 << -4 << 100 );
+    CroppedPearsonCorrelation croppedPearsonCorrelation;
+
+
+    bool testEmpty = croppedPearsonCorrelation.GetNbrProfiles() == 0 && croppedPearsonCorrelation.Correlate( 0, 5 ).isEmpty();
+
+    /** Only the first reference.size() values of the profiles are used **/
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+    bool testSizes = croppedPearsonCorrelation.GetNbrProfiles() == 2 && croppedPearsonCorrelation.GetNbrPoints() == 6;
+    QVector< double > expectedCorrelations = PearsonCorrelation( reference ).Correlate( profiles );
+    QVector< double > correlations = croppedPearsonCorrelation.Correlate( 0, 5 );
+    bool testWholeProfiles = correlations.size() == 2 && AreEqual( correlations.at( 0 ), expectedCorrelations.at( 0 ) ) &&
+            AreEqual( correlations.at( 1 ), expectedCorrelations.at( 1 ) );
+
+    /** Window clamped to the points available, 1.0 under 2 points **/
+    bool testWindow = AreEqual( croppedPearsonCorrelation.Correlate( 1, -3, 12 ), expectedCorrelations.at( 1 ) ) &&
+            croppedPearsonCorrelation.Correlate( 0, 3, 3 ) == 1.0 && croppedPearsonCorrelation.Correlate( 4, 2 ) == QVector< double >( 2, 1.0 );
+
+    croppedPearsonCorrelation.Clear();
+    bool testClear = croppedPearsonCorrelation.GetNbrProfiles() == 0 && croppedPearsonCorrelation.GetNbrPoints() == 0;
+
+
+    bool testSetProfiles_Passed = testEmpty && testSizes && testWholeProfiles && testWindow && testClear;
+    if( !testSetProfiles_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_SetProfiles() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with SetProfiles( const QList< double >& reference, const QList< QList< double > >& profiles ) and/or Clear()" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_SetProfiles() PASSED";
+    }
+
+    return testSetProfiles_Passed;
+}
+
+bool TestCroppedPearsonCorrelation::Test_Correlate()
+{
+    /** FA like values: small variations around a large mean **/
+    int nbrPoints = 150;
+    QList< double > reference;
+    QList< QList< double > > profiles;
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        reference.append( 0.45 + 0.05 * std::sin( point * 0.07 ) );
+    }
+    for( int i = 0; i < 40; i++ )
+    {
+        QList< double > profile;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile.append( 0.45 + 0.05 * std::sin( point * 0.07 + i * 0.1 ) + 0.002 * ( ( point * ( i + 3 ) ) % 11 ) );
+        }
+        profiles.append( profile );
+    }
+    CroppedPearsonCorrelation croppedPearsonCorrelation;
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+    QList< QPair< int, int > > windows = QList< QPair< int, int > >() << qMakePair( 0, nbrPoints - 1 ) << qMakePair( 10, 20 )
+                                                                    << qMakePair( 37, 141 ) << qMakePair( 0, 1 ) << qMakePair( 148, 149 );
+
+
+    /** Same correlations as the profiles cropped then correlated **/
+    bool testWindows = true;
+    for( int w = 0; w < windows.size(); w++ )
+    {
+        int first = windows.at( w ).first;
+        int last = windows.at( w ).second;
+        QList< QList< double > > croppedProfiles;
+        foreach( const QList< double >& profile, profiles )
+        {
+            croppedProfiles.append( profile.mid( first, last - first + 1 ) );
+        }
+        QVector< double > expectedCorrelations = PearsonCorrelation( reference.mid( first, last - first + 1 ) ).Correlate( croppedProfiles );
+        QVector< double > correlations = croppedPearsonCorrelation.Correlate( first, last );
+
+        testWindows = testWindows && correlations.size() == profiles.size();
+        for( int i = 0; i < profiles.size() && testWindows; i++ )
+        {
+            testWindows = AreEqual( correlations.at( i ), expectedCorrelations.at( i ) ) &&
+                    AreEqual( croppedPearsonCorrelation.Correlate( i, first, last ), expectedCorrelations.at( i ) );
+        }
+    }
+
+
+    bool testCorrelate_Passed = testWindows;
+    if( !testCorrelate_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Correlate() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Correlate( int first, int last ) and/or Correlate( int profile, int first, int last )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Correlate() PASSED";
+    }
+
+    return testCorrelate_Passed;
+}
+
+bool TestCroppedPearsonCorrelation::Test_CorrelateNAN()
+{
+    double nan = std::numeric_limits< double >::quiet_NaN();
+    QList< double > reference = QList< double >() << 0.41 << 0.43 << 0.47 << 0.52 << 0.49 << 0.44 << 0.40 << 0.38;
+    QList< QList< double > > profiles = QList< QList< double > >() << ( QList< double >() << nan << 0.42 << 0.45 << 0.55 << 0.50 << 0.46 << 0.39 << 0.37 )
+                                                                   << ( QList< double >() << 0.40 << 0.44 << 0.46 << 0.51 << 0.48 << 0.45 << nan << 0.36 )
+                                                                   << ( QList< double >() << 0.39 << 0.41 << 0.49 << 0.50 << 0.47 << 0.43 << 0.42 << 0.35 );
+    CroppedPearsonCorrelation croppedPearsonCorrelation;
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+    int first = 1;
+    int last = 5;
+    QList< QList< double > > croppedProfiles;
+    foreach( const QList< double >& profile, profiles )
+    {
+        croppedProfiles.append( profile.mid( first, last - first + 1 ) );
+    }
+    QVector< double > expectedCorrelations = PearsonCorrelation( reference.mid( first, last - first + 1 ) ).Correlate( croppedProfiles );
+
+
+    /** NAN out of the window: same correlations as the window alone **/
+    QVector< double > correlations = croppedPearsonCorrelation.Correlate( first, last );
+    bool testNANOutOfWindow = correlations.size() == 3;
+    for( int i = 0; i < 3 && testNANOutOfWindow; i++ )
+    {
+        testNANOutOfWindow = AreEqual( correlations.at( i ), expectedCorrelations.at( i ) ) &&
+                AreEqual( croppedPearsonCorrelation.Correlate( i, first, last ), expectedCorrelations.at( i ) );
+    }
+
+    /** NAN in the window: only the profile holding it is NAN **/
+    correlations = croppedPearsonCorrelation.Correlate( 0, 5 );
+    bool testNANInWindow = correlations.size() == 3 && std::isnan( correlations.at( 0 ) ) && !std::isnan( correlations.at( 1 ) ) &&
+            !std::isnan( correlations.at( 2 ) ) && std::isnan( croppedPearsonCorrelation.Correlate( 1, 2, 7 ) ) &&
+            !std::isnan( croppedPearsonCorrelation.Correlate( 1, 0, 5 ) );
+
+    /** NAN in the reference: every profile is NAN in the windows holding it, not in the others **/
+    reference[ 7 ] = nan;
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+    correlations = croppedPearsonCorrelation.Correlate( 2, 7 );
+    bool testNANReference = std::isnan( correlations.at( 0 ) ) && std::isnan( correlations.at( 1 ) ) && std::isnan( correlations.at( 2 ) ) &&
+            AreEqual( croppedPearsonCorrelation.Correlate( 2, first, last ), expectedCorrelations.at( 2 ) );
+
+
+    bool testCorrelateNAN_Passed = testNANOutOfWindow && testNANInWindow && testNANReference;
+    if( !testCorrelateNAN_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_CorrelateNAN() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with NAN values in Correlate( int first, int last ) and/or Correlate( int profile, int first, int last )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_CorrelateNAN() PASSED";
+    }
+
+    return testCorrelateNAN_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+bool TestCroppedPearsonCorrelation::AreEqual( double value, double expectedValue )
+{
+    return std::fabs( value - expectedValue ) < 1e-8;
+}
@@ -0,0 +1,34 @@
+#ifndef TESTCROPPEDPEARSONCORRELATION_H
+#define TESTCROPPEDPEARSONCORRELATION_H
+
+#include "CroppedPearsonCorrelation.h"
+#include "PearsonCorrelation.h"
+
+#include <iostream>
+#include <cmath>
+#include <limits>
+
+
+class TestCroppedPearsonCorrelation
+{
+public:
+    TestCroppedPearsonCorrelation();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetProfiles();
+
+    bool Test_Correlate();
+
+    bool Test_CorrelateNAN();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    bool AreEqual( double value, double expectedValue );
+};
+
+#endif // TESTCROPPEDPEARSONCORRELATION_H
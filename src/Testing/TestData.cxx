@@ -19,7 +19,7 @@ bool TestData::Test_InitData()
     foreach ( int index, mData.GetDiffusionPropertiesIndices() )
     {
         resultTest1 = resultTest1 & mData.GetFilename( index ).isEmpty();
-        resultTest2 = resultTest2 & mData.GetFileData( index ).isEmpty();
+        resultTest2 = resultTest2 & mData.IsFileDataEmpty( index );
         resultTest3 = resultTest3 & mData.GetNbrRows( index ) == 0;
         resultTest4 = resultTest4 & mData.GetNbrColumns( index ) == 0;
         resultTest5 = resultTest5 & mData.GetSubjects().value( index ).isEmpty();
@@ -202,40 +202,48 @@ bool TestData::Test_GetSetFileData()
     QStringList row19 = QStringList() << "Se" << "mouvoir" << "dans" << "leurs" << "flancs" << "comme" << "une" << "forme" << "humaine...";
     QStringList row20 = QStringList() << "La" << "lune" << "était" << "sereine" << "et" << "jouait" << "sur" << "les" << "flots.";
 
-    QList< QStringList > fileData1 = QList< QStringList >() << row1 << row2 << row3 << row4;
-    QList< QStringList > fileData2 = QList< QStringList >() << row5 << row6 << row7 << row8;
-    QList< QStringList > fileData3 = QList< QStringList >() << row9 << row10 << row11 << row12;
-    QList< QStringList > fileData4 = QList< QStringList >() << row13 << row14 << row15 << row16;
-    QList< QStringList > fileData5 = QList< QStringList >() << row17 << row18 << row19 << row20;
+    CSVReader csvReader( ";" );
+    CSVData fileData1 = csvReader.ReadContent( QStringList( QStringList() << row1.join( ";" ) << row2.join( ";" ) << row3.join( ";" ) << row4.join( ";" ) ).join( "\n" ).toUtf8() );
+    CSVData fileData2 = csvReader.ReadContent( QStringList( QStringList() << row5.join( ";" ) << row6.join( ";" ) << row7.join( ";" ) << row8.join( ";" ) ).join( "\n" ).toUtf8() );
+    CSVData fileData3 = csvReader.ReadContent( QStringList( QStringList() << row9.join( ";" ) << row10.join( ";" ) << row11.join( ";" ) << row12.join( ";" ) ).join( "\n" ).toUtf8() );
+    CSVData fileData4 = csvReader.ReadContent( QStringList( QStringList() << row13.join( ";" ) << row14.join( ";" ) << row15.join( ";" ) << row16.join( ";" ) ).join( "\n" ).toUtf8() );
+    CSVData fileData5 = csvReader.ReadContent( QStringList( QStringList() << row17.join( ";" ) << row18.join( ";" ) << row19.join( ";" ) << row20.join( ";" ) ).join( "\n" ).toUtf8() );
 
 
     mData.InitData();
 
-    mData.SetFileData( 0 ) = fileData1;
-    bool resultTest1 = mData.GetFileData( 0 ) == fileData1;
+    mData.SetFileData( 0, fileData1 );
+    bool resultTest1 = mData.GetProfileData( 0 )->GetSubjects() == row1.mid( 1 ) &&
+            mData.GetProfileData( 0 )->GetArcLengthLabels() == ( QStringList() << row2.first() << row3.first() << row4.first() );
 
-    mData.SetFileData( 0 ) = fileData2;
-    bool resultTest2 = mData.GetFileData( 0 ) == fileData2;
+    mData.SetFileData( 0, fileData2 );
+    bool resultTest2 = mData.GetProfileData( 0 )->GetSubjects() == row5.mid( 1 ) && !mData.IsFileDataEmpty( 0 );
 
-    mData.SetFileData( 0 ).clear();
-    bool resultTest3 = mData.GetFileData( 0 ).isEmpty();
+    mData.ClearData( 0 );
+    bool resultTest3 = mData.GetProfileData( 0 )->IsEmpty() && mData.IsFileDataEmpty( 0 );
 
-    mData.SetFileData( 1 ) = fileData3;
-    bool resultTest4 = mData.GetFileData( 1 ) == fileData3;
+    DiffusionProfileMatrix::ConstPointer profileData3( new DiffusionProfileMatrix( fileData3 ) );
+    mData.SetProfileData( 1 ) = profileData3;
+    bool resultTest4 = mData.GetProfileData( 1 ) == profileData3;
 
-    mData.SetFileData( 2 ) = fileData4;
-    bool resultTest5 = mData.GetFileData( 2 ) == fileData4;
+    mData.SetFileData( 2, fileData4 );
+    bool resultTest5 = mData.GetProfileData( 2 )->GetSubjects() == row13.mid( 1 ) &&
+            mData.GetProfileData( 2 )->GetArcLengthLabels() == ( QStringList() << row14.first() << row15.first() << row16.first() ) &&
+            mData.GetSubMatrixData().IsEmpty();
 
-    mData.SetFileData( 3 ) = fileData5;
-    bool resultTest6 = mData.GetFileData( 3 ) == fileData5;
+    mData.SetFileData( 4, fileData5 );
+    bool resultTest6 = mData.GetSubMatrixData() == fileData5 && mData.IsFileDataEmpty( 3 ) && !mData.IsFileDataEmpty( 4 );
+
+    mData.SetSubMatrixData().Clear();
+    bool resultTest7 = mData.IsFileDataEmpty( 4 );
 
 
     bool testGetSetFileData_Passed = resultTest1 && resultTest2 && resultTest3 &&
-            resultTest4 && resultTest5 && resultTest6;
+            resultTest4 && resultTest5 && resultTest6 && resultTest7;
     if( !testGetSetFileData_Passed )
     {
         std::cerr << "/!\\/!\\ Test_GetSetFileData() FAILED /!\\/!\\";
-//        std::cerr << std::endl << "\t+ pb with GetFileData( int diffusionPropertyIndex ) and/or SetFileData( int diffusionPropertyIndex )" << std::endl;
+//        std::cerr << std::endl << "\t+ pb with GetProfileData( int diffusionPropertyIndex ) and/or SetFileData( int diffusionPropertyIndex, const CSVData& fileData )" << std::endl;
     }
     else
     {
@@ -248,7 +256,7 @@ bool TestData::Test_GetSetFileData()
 bool TestData::Test_GetSetAtlas()
 {
     Data mData;
-    QStringList atlas = QStringList() << "a" << "b" << "c" << "d" << "e" << "f";
+    QList< double > atlas = QList< double >() << 0.1 << 0.2 << 0.3 << 0.4 << 0.5 << 0.6;
 
 
     mData.SetAtlas() = atlas;
@@ -587,9 +595,11 @@ bool TestData::Test_ClearFileInformation()
     QStringList row11 = QStringList() << "Et" << "quand" << "j'arriverai," << "je" << "mettrai" << "sur" << "ta" << "tombe";
     QStringList row12 = QStringList() << "Un" << "bouquet" << "de" << "houx" << "vert" << "et" << "de" << "bruyère" << "en" << "fleur.";
 
-    QList< QStringList > fileData = QList< QStringList >() << row1 << row2 << row3 << row4 << row5 << row6 << row7 << row8 << row9 << row10 << row11 << row12;
-    int nbrRows = fileData.size();
-    int nbrColumns = fileData.first().size();
+    QStringList rows = QStringList() << row1.join( ";" ) << row2.join( ";" ) << row3.join( ";" ) << row4.join( ";" ) << row5.join( ";" ) << row6.join( ";" )
+                                     << row7.join( ";" ) << row8.join( ";" ) << row9.join( ";" ) << row10.join( ";" ) << row11.join( ";" ) << row12.join( ";" );
+    CSVData fileData = CSVReader( ";" ).ReadContent( rows.join( "\n" ).toUtf8() );
+    int nbrRows = fileData.GetNbrRows();
+    int nbrColumns = fileData.GetNbrColumns();
     QStringList subjects = QStringList() << "Rachel" << "Ross" << "Monica" << "Chandler" << "Phoebe" << "Gunther";
     int nbrSubjects = subjects.size();
 
@@ -607,7 +617,7 @@ bool TestData::Test_ClearFileInformation()
     foreach ( int index, mData.GetDiffusionPropertiesIndices() )
     {
         mData.SetFilename( index ) = filename;
-        mData.SetFileData( index ) = fileData;
+        mData.SetFileData( index, fileData );
         mData.SetNbrRows( index ) = nbrRows;
         mData.SetNbrColumns( index ) = nbrColumns;
         mData.SetSubjects( index ) = subjects;
@@ -622,7 +632,7 @@ bool TestData::Test_ClearFileInformation()
     foreach ( int index, mData.GetDiffusionPropertiesIndices() )
     {
         resultTest1 = mData.GetFilename( index ).isEmpty();
-        resultTest2 = mData.GetFileData( index ).isEmpty();
+        resultTest2 = mData.IsFileDataEmpty( index );
         resultTest3 = mData.GetNbrRows( index ) == 0;
         resultTest4 = mData.GetNbrColumns( index ) == 0;
         resultTest5 = mData.GetNbrSubjects( index ) == 0;
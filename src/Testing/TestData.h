@@ -2,6 +2,7 @@
 #define TESTDATA_H
 
 #include "Data.h"
+#include "CSVReader.h"
 
 #include <iostream>
 
@@ -0,0 +1,211 @@
+#include "TestDatasetCache.h"
+
+#include <QLocale>
+
+TestDatasetCache::TestDatasetCache()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestDatasetCache::Test_GetData( QString tempoDir )
+{
+    QString dirTest = tempoDir + "/TestDatasetCache/Test_GetData";
+    QDir().mkpath( dirTest );
+    QString filePath = dirTest + "/fa.csv";
+    QString separator = QLocale().groupSeparator();
+    WriteFile( filePath, QStringList( QStringList() << "arclength" << "Subj1" << "Subj2" ).join( separator ) + "\n" +
+               QStringList( QStringList() << "-1" << "0.1" << "0.2" ).join( separator ) + "\n" );
+    DatasetCache& datasetCache = DatasetCache::GetInstance();
+
+
+    datasetCache.Clear();
+    CSVData data1 = datasetCache.GetData( filePath );
+    bool testFirstRead = !data1.IsEmpty() && datasetCache.GetNbrMisses() == 1 && datasetCache.GetNbrHits() == 0;
+
+    CSVData data2 = datasetCache.GetData( dirTest + "/../Test_GetData/fa.csv" );
+    bool testSecondRead = data2 == data1 && datasetCache.GetNbrMisses() == 1 && datasetCache.GetNbrHits() == 1;
+
+    /** Text rows read from the file, not cached: the data cached is not parsed again **/
+    QList< QStringList > textData = datasetCache.GetTextData( filePath );
+    bool testTextData = textData.size() == 2 && textData.first() == data1.GetHeader() && datasetCache.GetNbrMisses() == 1;
+
+    bool testNoFile = datasetCache.GetData( dirTest + "/noFile.csv" ).IsEmpty() && datasetCache.GetTextData( dirTest + "/noFile.csv" ).isEmpty() &&
+            datasetCache.GetNbrMisses() == 1;
+
+    /** Changing the number of threads does not change the data read **/
+    int nbrThreads = datasetCache.GetNbrThreads();
+    datasetCache.SetNbrThreads( 3 );
+    bool testNbrThreads = datasetCache.GetNbrThreads() == 3 && datasetCache.GetData( filePath ) == data1;
+    datasetCache.SetNbrThreads( nbrThreads );
+
+    /** Entry of an input replaced: the file is read again next time **/
+    int nbrMisses = datasetCache.GetNbrMisses();
+    datasetCache.Remove( filePath );
+    bool testRemove = datasetCache.GetData( filePath ) == data1 && datasetCache.GetNbrMisses() == nbrMisses + 1;
+
+    datasetCache.Clear();
+    bool testClear = datasetCache.GetNbrMisses() == 0 && datasetCache.GetNbrHits() == 0;
+
+
+    bool testGetData_Passed = testFirstRead && testSecondRead && testTextData && testNoFile && testNbrThreads && testRemove && testClear;
+    if( !testGetData_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GetData() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetData( const QString& filePath ), GetTextData( const QString& filePath ) and/or Remove( const QString& filePath )" << std::endl;
+        //        if( !testSecondRead )
+        //        {
+        //            std::cerr << "\t  file parsed again while already in cache" << std::endl;
+        //        }
+    }
+    else
+    {
+        std::cerr << "Test_GetData() PASSED";
+    }
+
+    return testGetData_Passed;
+}
+
+bool TestDatasetCache::Test_GetProfileData( QString tempoDir )
+{
+    QString dirTest = tempoDir + "/TestDatasetCache/Test_GetProfileData";
+    QDir().mkpath( dirTest );
+    QString filePath = dirTest + "/fa.csv";
+    QString separator = QLocale().groupSeparator();
+    WriteFile( filePath, QStringList( QStringList() << "arclength" << "Subj1" << "Subj2" ).join( separator ) + "\n" +
+               QStringList( QStringList() << "-1" << "0.1" << "0.2" ).join( separator ) + "\n" +
+               QStringList( QStringList() << "0" << "0.3" << "0.4" ).join( separator ) + "\n" );
+    DatasetCache& datasetCache = DatasetCache::GetInstance();
+
+
+    datasetCache.Clear();
+    DiffusionProfileMatrix::ConstPointer profileData1 = datasetCache.GetProfileData( filePath );
+    DiffusionProfileMatrix::ConstPointer profileData2 = datasetCache.GetProfileData( filePath );
+    bool testShared = profileData1 == profileData2 && profileData1->GetNbrArcLengths() == 2 &&
+            profileData1->GetSubjects() == ( QStringList() << "Subj1" << "Subj2" );
+    bool testCounters = datasetCache.GetNbrMisses() == 1 && datasetCache.GetNbrHits() == 1;
+    bool testNoFile = datasetCache.GetProfileData( dirTest + "/noFile.csv" )->IsEmpty();
+
+    /** The profile matrix is not kept alive by the cache once released, the data it is derived from is **/
+    QWeakPointer< const DiffusionProfileMatrix > releasedProfileData = profileData1;
+    profileData1.clear();
+    profileData2.clear();
+    bool testReleased = releasedProfileData.isNull() && datasetCache.GetProfileData( filePath )->GetNbrArcLengths() == 2 &&
+            datasetCache.GetNbrMisses() == 1;
+
+
+    bool testGetProfileData_Passed = testShared && testCounters && testNoFile && testReleased;
+    if( !testGetProfileData_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GetProfileData() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetProfileData( const QString& filePath )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_GetProfileData() PASSED";
+    }
+
+    return testGetProfileData_Passed;
+}
+
+bool TestDatasetCache::Test_FileChanged( QString tempoDir )
+{
+    QString dirTest = tempoDir + "/TestDatasetCache/Test_FileChanged";
+    QDir().mkpath( dirTest );
+    QString filePath = dirTest + "/fa.csv";
+    QString separator = QLocale().groupSeparator();
+    QString header = QStringList( QStringList() << "arclength" << "Subj1" << "Subj2" ).join( separator ) + "\n";
+    WriteFile( filePath, header + QStringList( QStringList() << "-1" << "0.1" << "0.2" ).join( separator ) + "\n" );
+    DatasetCache& datasetCache = DatasetCache::GetInstance();
+
+
+    datasetCache.Clear();
+    DiffusionProfileMatrix::ConstPointer profileData1 = datasetCache.GetProfileData( filePath );
+
+    /** One more row: the size of the file changes **/
+    WriteFile( filePath, header + QStringList( QStringList() << "-1" << "0.1" << "0.2" ).join( separator ) + "\n" +
+               QStringList( QStringList() << "0" << "0.3" << "0.4" ).join( separator ) + "\n" );
+    DiffusionProfileMatrix::ConstPointer profileData2 = datasetCache.GetProfileData( filePath );
+    bool testReloaded = profileData1 != profileData2 && profileData1->GetNbrArcLengths() == 1 && profileData2->GetNbrArcLengths() == 2 &&
+            datasetCache.GetNbrMisses() == 2;
+
+    QFile::remove( filePath );
+    bool testRemoved = datasetCache.GetData( filePath ).IsEmpty();
+
+
+    bool testFileChanged_Passed = testReloaded && testRemoved;
+    if( !testFileChanged_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_FileChanged() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ cached data not invalidated when the file changed" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_FileChanged() PASSED";
+    }
+
+    return testFileChanged_Passed;
+}
+
+bool TestDatasetCache::Test_Sidecar( QString tempoDir )
+{
+    QString dirTest = tempoDir + "/TestDatasetCache/Test_Sidecar";
+    QDir().mkpath( dirTest );
+    QString filePath = dirTest + "/fa.csv";
+    QString separator = QLocale().groupSeparator();
+    WriteFile( filePath, QStringList( QStringList() << "arclength" << "Subj1" << "Subj2" ).join( separator ) + "\n" +
+               QStringList( QStringList() << "-1" << "0.1" << "0.2" ).join( separator ) + "\n" );
+    QFile::remove( CSVSidecar::GetSidecarPath( filePath ) );
+    DatasetCache& datasetCache = DatasetCache::GetInstance();
+    qint64 minSidecarFileSize = datasetCache.m_minSidecarFileSize;
+
+
+    /** Small file: no sidecar **/
+    datasetCache.Clear();
+    datasetCache.GetData( filePath );
+    bool testSmallFile = !QFile::exists( CSVSidecar::GetSidecarPath( filePath ) );
+
+    /** Sidecar written with the 1st parsing, loaded once the memory cache is cleared **/
+    datasetCache.m_minSidecarFileSize = 0;
+    datasetCache.Clear();
+    CSVData parsedData = datasetCache.GetData( filePath );
+    bool testWritten = QFile::exists( CSVSidecar::GetSidecarPath( filePath ) ) && datasetCache.GetNbrSidecarLoads() == 0;
+    datasetCache.Clear();
+    CSVData sidecarData = datasetCache.GetData( filePath );
+    bool testLoaded = sidecarData == parsedData && datasetCache.GetNbrSidecarLoads() == 1 && datasetCache.GetNbrMisses() == 1;
+
+    datasetCache.m_minSidecarFileSize = minSidecarFileSize;
+    datasetCache.Clear();
+
+
+    bool testSidecar_Passed = testSmallFile && testWritten && testLoaded;
+    if( !testSidecar_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Sidecar() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with the binary sidecar of GetData( const QString& filePath )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Sidecar() PASSED";
+    }
+
+    return testSidecar_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+void TestDatasetCache::WriteFile( QString filePath, QString content )
+{
+    QFile file( filePath );
+    if( file.open( QIODevice::WriteOnly ) )
+    {
+        QTextStream ts( &file );
+        ts << content;
+        ts.flush();
+        file.close();
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef TESTDATASETCACHE_H
+#define TESTDATASETCACHE_H
+
+#include "DatasetCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include <iostream>
+
+
+class TestDatasetCache
+{
+public:
+    TestDatasetCache();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_GetData( QString tempoDir );
+
+    bool Test_GetProfileData( QString tempoDir );
+
+    bool Test_FileChanged( QString tempoDir );
+
+    bool Test_Sidecar( QString tempoDir );
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    void WriteFile( QString filePath, QString content );
+};
+
+#endif // TESTDATASETCACHE_H
@@ -0,0 +1,40 @@
+#ifndef TESTDIFFUSIONPROFILEMATRIX_H
+#define TESTDIFFUSIONPROFILEMATRIX_H
+
+#include "DiffusionProfileMatrix.h"
+#include "CSVReader.h"
+
+#include <QLocale>
+
+#include <iostream>
+
+
+class TestDiffusionProfileMatrix
+{
+public:
+    TestDiffusionProfileMatrix();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_DiffusionProfileMatrix( QString adFilePath );
+
+    bool Test_GetArcLength();
+
+    bool Test_GetSubjects();
+
+    bool Test_GetAtlas();
+
+    bool Test_GetViews();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    DiffusionProfileMatrix GetProfileMatrix( const QByteArray& content );
+
+    bool AreValuesEqual( double value1, double value2 );
+};
+
+#endif // TESTDIFFUSIONPROFILEMATRIX_H
@@ -65,8 +65,8 @@ bool TestEditInputDialog::Test_OnDelete( QString adFilePath )
     data.InitData();
     editInputDialog->SetData( &data );
     indexAD = data.GetAxialDiffusivityIndex();
-    data.SetFileData( indexAD ) = processing.GetDataFromFile( adFilePath );
-    expectedFileData = data.GetFileData( indexAD );
+    data.SetFileData( indexAD, processing.GetNumericDataFromFile( adFilePath ) );
+    expectedFileData = processing.GetDataFromFile( adFilePath );
 
     editInputDialog->DisplayDataEdition( indexAD );
 
@@ -120,8 +120,8 @@ bool TestEditInputDialog::Test_LoadDisplayData( QString adFilePath, QString subM
     QSharedPointer< EditInputDialog > editInputDialog = QSharedPointer< EditInputDialog >( new EditInputDialog );
     Data data;
     Processing processing;
-    QList< QStringList > adData;
-    QList< QStringList > subMatrixData;
+    CSVData adData;
+    CSVData subMatrixData;
     int indexAD;
     int indexSubMatrix;
     int IDRow = 2;
@@ -132,10 +132,10 @@ bool TestEditInputDialog::Test_LoadDisplayData( QString adFilePath, QString subM
     editInputDialog->SetData( &data );
     indexAD = data.GetAxialDiffusivityIndex();
     indexSubMatrix = data.GetSubMatrixIndex();
-    data.SetFileData( indexAD ) = processing.GetDataFromFile( adFilePath );
-    data.SetFileData( indexSubMatrix ) = processing.GetDataFromFile( subMatrixFilePath );
-    adData = data.GetFileData( indexAD );
-    subMatrixData = data.GetFileData( indexSubMatrix );
+    adData = processing.GetNumericDataFromFile( adFilePath );
+    subMatrixData = processing.GetNumericDataFromFile( subMatrixFilePath );
+    data.SetFileData( indexAD, adData );
+    data.SetFileData( indexSubMatrix, subMatrixData );
 
     /************************************************/
     /******************** Test 1 ********************/
@@ -161,7 +161,7 @@ bool TestEditInputDialog::Test_LoadDisplayData( QString adFilePath, QString subM
     /******************** Test 3 ********************/
     /************************************************/
     /** AD, RD, MD or FA file in wrong QLineEdit **/
-    data.SetFileData( indexSubMatrix ) = adData;
+    data.SetFileData( indexSubMatrix, adData );
     editInputDialog->ResetTableWidget();
     //    editInputDialog->SetData( &data );
     editInputDialog->DisplayDataEdition( indexSubMatrix );
@@ -172,7 +172,7 @@ bool TestEditInputDialog::Test_LoadDisplayData( QString adFilePath, QString subM
     /******************** Test 4 ********************/
     /************************************************/
     /** subMatrix file in right QLineEdit **/
-    data.SetFileData( indexSubMatrix ) = subMatrixData;
+    data.SetFileData( indexSubMatrix, subMatrixData );
     editInputDialog->ResetTableWidget();
     editInputDialog->DisplayDataEdition( indexSubMatrix );
 
@@ -195,7 +195,7 @@ bool TestEditInputDialog::Test_LoadDisplayData( QString adFilePath, QString subM
     /******************** Test 6 ********************/
     /************************************************/
     /** indexSubMatrixfile in wrong QLineEdit **/
-    data.SetFileData( indexAD )= subMatrixData;
+    data.SetFileData( indexAD, subMatrixData );
     editInputDialog->ResetTableWidget();
     editInputDialog->DisplayDataEdition( indexAD );
 
@@ -264,7 +264,7 @@ bool TestEditInputDialog::Test_SaveFile( QString adFilePath, QString newADFile,
     data.InitData();
     editInputDialog->SetData( &data );
     indexAD = data.GetAxialDiffusivityIndex();
-    data.SetFileData( indexAD ) = processing.GetDataFromFile( adFilePath );
+    data.SetFileData( indexAD, processing.GetNumericDataFromFile( adFilePath ) );
     defaultSavedFilePath = dirTest + "/new" + data.GetDiffusionPropertyName( indexAD ).toUpper() + "File.csv";
 
     editInputDialog->DisplayDataEdition( indexAD );
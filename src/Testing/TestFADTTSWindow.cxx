@@ -216,31 +216,34 @@ bool TestFADTTSWindow::Test_OnQCThresholdApplied()
     QStringList subjectsNotCorrelated = QStringList() << "Joel Berry II" << "Kennedy Meeks" << "Justin Jackson";
     QStringList checkedMatchedSubjects;
     double qcThreshold = 0.74;
+    QMap< QString, double > qcThresholds;
+    qcThresholds.insert( "FA", qcThreshold );
+    qcThresholds.insert( "MD", 0.6 );
+    QMap< QString, double > fpcaQCThresholds;
+    fpcaQCThresholds.insert( "FA", 0.02 );
+    fpcaQCThresholds.insert( "MD", 0.01 );
 
 
     fadttsWindow->DisplaySortedSubjects( matchedSubjectList, QMap< QString, QList< int > >() );
-    fadttsWindow->OnQCThresholdApplied( subjectsCorrelated, subjectsNotCorrelated, qcThreshold, true );
+    fadttsWindow->OnQCThresholdApplied( subjectsCorrelated, subjectsNotCorrelated, qcThresholds, fpcaQCThresholds, "allFail", "median", "fpca", true );
 
     bool testFailedQCThresholdSubjects = fadttsWindow->m_failedQCThresholdSubjects == subjectsNotCorrelated;
 
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
-    {
-        QListWidgetItem *currentItem = fadttsWindow->m_matchedSubjectListWidget->item( i );
-        if( currentItem->checkState() == Qt::Checked )
-        {
-            checkedMatchedSubjects.append( currentItem->text() );
-        }
-    }
-    bool testCheckedMatchedSubjects = checkedMatchedSubjects == subjectsCorrelated;
+    checkedMatchedSubjects = fadttsWindow->m_matchedSubjectModel->GetCheckedSubjects();
+    bool testCheckedMatchedSubjects = checkedMatchedSubjects == ( QStringList() << "Brice Johnson" << "Marcus Paige" );
 
-    bool testQCThreshold = fadttsWindow->m_qcThreshold == qcThreshold;
+    /** FPCA metric applied: FA's FPCA threshold reported, the spin box keeping the correlation threshold **/
+    bool testQCThreshold = fadttsWindow->m_qcThreshold == 0.02 && fadttsWindow->para_subjectTab_qcThreshold_doubleSpinBox->value() == qcThreshold &&
+            fadttsWindow->m_qcThresholds == qcThresholds && fadttsWindow->m_fpcaQCThresholds == fpcaQCThresholds &&
+            fadttsWindow->m_qcThresholdRule == QCThreshold::AllFail && fadttsWindow->m_qcThresholdReference == QCThresholdReference::Median &&
+            fadttsWindow->m_qcThresholdMetric == QCThreshold::FPCA;
 
 
     bool testOnQCThresholdApplied_Passed = testFailedQCThresholdSubjects && testCheckedMatchedSubjects && testQCThreshold;
     if( !testOnQCThresholdApplied_Passed )
     {
         std::cerr << "/!\\/!\\ Test_OnQCThresholdApplied() FAILED /!\\/!\\";
-//        std::cerr << std::endl << "\t+ pb with OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, double qcThreshold )" << std::endl;
+//        std::cerr << std::endl << "\t+ pb with OnQCThresholdApplied( const QStringList& subjectsCorrelated, const QStringList& subjectsNotCorrelated, const QMap< QString, double >& qcThresholds, const QMap< QString, double >& fpcaQCThresholds, const QString& rule, const QString& reference, const QString& metric, bool windowClosed )" << std::endl;
 //        if( testFailedQCThresholdSubjects )
 //        {
 //            std::cerr << "\t  wrong m_failedQCThresholdSubjects" << std::endl;
@@ -467,35 +470,23 @@ bool TestFADTTSWindow::Test_DisplaySubjectInformation()
     QStringList unMatchedSubjects = QStringList() << "Yoda" << "Luke" << "Darth Vader" << "Han Solo" << "Chewbacca" << "R2D2" << "C3PO" << "Obi-Wan" << "Leila";
 
 
-    foreach( QString subject, matchedSubjects )
-    {
-        QListWidgetItem *item = new QListWidgetItem( subject, fadttsWindow->m_matchedSubjectListWidget );
-        fadttsWindow->m_matchedSubjectListWidget->addItem( item );
-    }
-    foreach( QString subject, unMatchedSubjects )
-    {
-        QListWidgetItem *item = new QListWidgetItem( subject, fadttsWindow->m_unmatchedSubjectListWidget );
-        fadttsWindow->m_matchedSubjectListWidget->addItem( item );
-    }
+    fadttsWindow->m_matchedSubjectModel->SetSubjects( matchedSubjects );
+    fadttsWindow->m_unmatchedSubjectModel->SetSubjects( unMatchedSubjects );
     fadttsWindow->DisplaySubjectInformation();
     bool testMatchedSubjectsUnMatchedSubjects = fadttsWindow->subjectTab_matchedSubjectsInformation_label->text() == "9/18 matched"
             && fadttsWindow->subjectTab_unmatchedSubjectsInformation_label->text() == "9/18 unmatched";
 
-    fadttsWindow->m_matchedSubjectListWidget->clear();
+    fadttsWindow->m_matchedSubjectModel->SetSubjects( QStringList() );
     fadttsWindow->DisplaySubjectInformation();
     bool testUnMatchedSubjects = fadttsWindow->subjectTab_matchedSubjectsInformation_label->text() == "WARNING No matched! 0/9"
             && fadttsWindow->subjectTab_unmatchedSubjectsInformation_label->text() == "9/9 unmatched";
 
-    fadttsWindow->m_unmatchedSubjectListWidget->clear();
+    fadttsWindow->m_unmatchedSubjectModel->SetSubjects( QStringList() );
     fadttsWindow->DisplaySubjectInformation();
     bool testNoSubject = fadttsWindow->subjectTab_matchedSubjectsInformation_label->text().isEmpty()
             && fadttsWindow->subjectTab_unmatchedSubjectsInformation_label->text().isEmpty();
 
-    foreach( QString subject, matchedSubjects )
-    {
-        QListWidgetItem *item = new QListWidgetItem( subject, fadttsWindow->m_matchedSubjectListWidget );
-        fadttsWindow->m_matchedSubjectListWidget->addItem( item );
-    }
+    fadttsWindow->m_matchedSubjectModel->SetSubjects( matchedSubjects );
     fadttsWindow->DisplaySubjectInformation();
     bool testMatchedSubjects = fadttsWindow->subjectTab_matchedSubjectsInformation_label->text() == "All subjects matched 9/9"
             && fadttsWindow->subjectTab_unmatchedSubjectsInformation_label->text() == "";
@@ -537,21 +528,16 @@ bool TestFADTTSWindow::Test_DisplayNbrSubjectSelected()
     QStringList matchedSubjects = QStringList() << "Stan" << "Kyle" << "Kenny" << "Cartman" << "Chef" << "Butters" << "Wendy" << "Craig" << "Pip";
 
 
-    foreach( QString subject, matchedSubjects )
-    {
-        QListWidgetItem *item = new QListWidgetItem( subject, fadttsWindow->m_matchedSubjectListWidget );
-        item->setCheckState( Qt::Checked );
-        fadttsWindow->m_matchedSubjectListWidget->addItem( item );
-    }
+    fadttsWindow->m_matchedSubjectModel->SetSubjects( matchedSubjects );
     fadttsWindow->DisplayNbrSubjectSelected();
     bool testAllSubjects = fadttsWindow->subjectTab_checkedSubjectsInformation_label->text() == "9/9 subjects selected";
 
-    fadttsWindow->m_matchedSubjectListWidget->item( 1 )->setCheckState( Qt::Unchecked );
-    fadttsWindow->m_matchedSubjectListWidget->item( 2 )->setCheckState( Qt::Unchecked );
+    fadttsWindow->m_matchedSubjectModel->SetChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 1 ), false );
+    fadttsWindow->m_matchedSubjectModel->SetChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 2 ), false );
     fadttsWindow->DisplayNbrSubjectSelected();
     bool testSubjects = fadttsWindow->subjectTab_checkedSubjectsInformation_label->text() == "7/9 subjects selected";
 
-    fadttsWindow->m_matchedSubjectListWidget->clear();
+    fadttsWindow->m_matchedSubjectModel->SetSubjects( QStringList() );
     fadttsWindow->DisplayNbrSubjectSelected();
     bool testNoSubjects = fadttsWindow->subjectTab_checkedSubjectsInformation_label->text().isEmpty();
 
@@ -607,24 +593,24 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
 
     fadttsWindow->DisplaySortedSubjects( matchedSubjects, QMap< QString, QList< int > >() );
 
-    nbrMatchedSubjects1 = fadttsWindow->m_matchedSubjectListWidget->count();
+    nbrMatchedSubjects1 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetMatchedSubjects1 = nbrMatchedSubjects1 == expectedNbrMatchedSubjects;
 
-    nbrUnmatchedSubjects1 = fadttsWindow->m_unmatchedSubjectListWidget->count();
+    nbrUnmatchedSubjects1 = fadttsWindow->m_unmatchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetUnmatchedSubjects1 = nbrUnmatchedSubjects1 == 0;
 
     for( int i = 0; i < expectedNbrMatchedSubjects; i++ )
     {
-        QListWidgetItem *item = fadttsWindow->m_matchedSubjectListWidget->item( i );
-        if( item->checkState() != Qt::Checked )
+        QModelIndex index = fadttsWindow->m_matchedSubjectModel->index( i );
+        if( index.data( Qt::CheckStateRole ).toInt() != Qt::Checked )
         {
             testCheckState1 = false;
         }
-        if( item->backgroundColor() != fadttsWindow->m_green )
+        if( index.data( Qt::BackgroundRole ).value< QBrush >().color() != fadttsWindow->m_green )
         {
             testBackgroundColorSubjectsMatched1 = false;
         }
-        if( item->flags() != Qt::ItemIsEnabled )
+        if( index.flags() != Qt::ItemIsEnabled )
         {
             testFlagsSubjectsMatched1 = false;
         }
@@ -654,24 +640,24 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
 
     fadttsWindow->DisplaySortedSubjects( matchedSubjects, unMatchedSubjects );
 
-    nbrMatchedSubjects2 = fadttsWindow->m_matchedSubjectListWidget->count();
+    nbrMatchedSubjects2 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetMatchedSubjects2 = nbrMatchedSubjects2 == expectedNbrMatchedSubjects;
 
-    nbrUnmatchedSubjects2 = fadttsWindow->m_unmatchedSubjectListWidget->count();
+    nbrUnmatchedSubjects2 = fadttsWindow->m_unmatchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetUnmatchedSubjects2 = nbrUnmatchedSubjects2 == expectedNbrUnmatchedSubjects;
 
     for( int i = 0; i < expectedNbrMatchedSubjects; i++ )
     {
-        QListWidgetItem *item = fadttsWindow->m_matchedSubjectListWidget->item( i );
-        if( item->checkState() != Qt::Checked )
+        QModelIndex index = fadttsWindow->m_matchedSubjectModel->index( i );
+        if( index.data( Qt::CheckStateRole ).toInt() != Qt::Checked )
         {
             testCheckState2 = false;
         }
-        if( item->backgroundColor() != fadttsWindow->m_green )
+        if( index.data( Qt::BackgroundRole ).value< QBrush >().color() != fadttsWindow->m_green )
         {
             testBackgroundColorSubjectsMatched2 = false;
         }
-        if( item->flags() != Qt::ItemIsEnabled )
+        if( index.flags() != Qt::ItemIsEnabled )
         {
             testFlagsSubjectsMatched2 = false;
         }
@@ -681,17 +667,17 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
     for( int i = 0; i < expectedNbrUnmatchedSubjects; i++ )
     {
         QString expectedText = iterUnmatchedSubjects.key() + " --> " + expectedTextUnmatchedSubjects.at( i ).join( ", " );
-        QListWidgetItem *item = fadttsWindow->m_unmatchedSubjectListWidget->item( i );
+        QModelIndex index = fadttsWindow->m_unmatchedSubjectModel->index( i );
 
-        if( item->text() != expectedText )
+        if( index.data().toString() != expectedText )
         {
             testTextUnmatchedSubjects2 = false;
         }
-        if( item->backgroundColor() != fadttsWindow->m_red )
+        if( index.data( Qt::BackgroundRole ).value< QBrush >().color() != fadttsWindow->m_red )
         {
             testBackgroundColorSubjectsUnmatched2 = false;
         }
-        if( item->flags() == Qt::ItemIsEnabled )
+        if( index.flags() == Qt::ItemIsEnabled )
         {
             testFlagsSubjectsUnmatched2 = false;
         }
@@ -719,27 +705,27 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
 
     fadttsWindow->DisplaySortedSubjects( QStringList(), unMatchedSubjects );
 
-    nbrMatchedSubjects3 = fadttsWindow->m_matchedSubjectListWidget->count();
+    nbrMatchedSubjects3 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetMatchedSubjects3 = nbrMatchedSubjects3 == 0;
 
-    nbrUnmatchedSubjects3 = fadttsWindow->m_unmatchedSubjectListWidget->count();
+    nbrUnmatchedSubjects3 = fadttsWindow->m_unmatchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetUnmatchedSubjects3 = nbrUnmatchedSubjects3 == expectedNbrUnmatchedSubjects;
 
     QMap< QString, QList< int > >::ConstIterator iterUnmatchedSubjectsBis = unMatchedSubjects.begin();
     for( int i = 0; i < expectedNbrUnmatchedSubjects; i++ )
     {
         QString expectedText = iterUnmatchedSubjectsBis.key() + " --> " + expectedTextUnmatchedSubjects.at( i ).join( ", " );
-        QListWidgetItem *item = fadttsWindow->m_unmatchedSubjectListWidget->item( i );
+        QModelIndex index = fadttsWindow->m_unmatchedSubjectModel->index( i );
 
-        if( item->text() != expectedText )
+        if( index.data().toString() != expectedText )
         {
             testTextUnmatchedSubjects3 = false;
         }
-        if( item->backgroundColor() != fadttsWindow->m_red )
+        if( index.data( Qt::BackgroundRole ).value< QBrush >().color() != fadttsWindow->m_red )
         {
             testBackgroundColorSubjectsUnmatched3 = false;
         }
-        if( item->flags() == Qt::ItemIsEnabled )
+        if( index.flags() == Qt::ItemIsEnabled )
         {
             testFlagsSubjectsUnmatched3 = false;
         }
@@ -764,10 +750,10 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
 
     fadttsWindow->DisplaySortedSubjects( QStringList(), QMap< QString, QList< int > >() );
 
-    nbrMatchedSubjects4 = fadttsWindow->m_matchedSubjectListWidget->count();
+    nbrMatchedSubjects4 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetMatchedSubjects4 = nbrMatchedSubjects4 == 0;
 
-    nbrUnmatchedSubjects4 = fadttsWindow->m_unmatchedSubjectListWidget->count();
+    nbrUnmatchedSubjects4 = fadttsWindow->m_unmatchedSubjectModel->GetNbrSubjects();
     bool testSizeListWidgetUnmatchedSubjects4 = nbrUnmatchedSubjects4 == 0;
 
     QString matchedSubjectsInformationDisplayed4 = fadttsWindow->subjectTab_matchedSubjectsInformation_label->text();
@@ -917,12 +903,58 @@ bool TestFADTTSWindow::Test_DisplaySortedSubjects()
     return testDisplaySortedSubjects_Passed;
 }
 
+bool TestFADTTSWindow::Test_UpdateSortedSubjects()
+{
+    QSharedPointer< FADTTSWindow > fadttsWindow = QSharedPointer< FADTTSWindow >( new FADTTSWindow );
+    IncrementalSubjectMatcher& subjectMatcher = fadttsWindow->m_subjectMatcher;
+    subjectMatcher.SetSource( 0, QStringList() << "Stan" << "Kyle" << "Kenny" );
+    subjectMatcher.SetSource( 1, QStringList() << "Kyle" << "Kenny" << "Cartman" );
+    fadttsWindow->DisplaySortedSubjects( subjectMatcher.GetMatchedSubjects(), subjectMatcher.GetUnMatchedSubjects() );
+    SubjectListModel *matchedModel = fadttsWindow->m_matchedSubjectModel;
+    SubjectListModel *unmatchedModel = fadttsWindow->m_unmatchedSubjectModel;
+    matchedModel->SetChecked( matchedModel->GetSubjectID( 0 ), false );
+    fadttsWindow->m_failedQCThresholdSubjects = QStringList() << "Kenny";
+
+
+    /** Same source with Stan: Stan matched, Kenny still unchecked **/
+    fadttsWindow->UpdateSortedSubjects( subjectMatcher.SetSource( 1, QStringList() << "Kyle" << "Kenny" << "Stan" ) );
+    bool testSourceChanged = matchedModel->GetNbrSubjects() == 3 && unmatchedModel->GetNbrSubjects() == 0 &&
+            matchedModel->GetSubject( 0 ) == "Kenny" && !matchedModel->IsChecked( matchedModel->GetSubjectID( 0 ) ) &&
+            matchedModel->GetSubject( 2 ) == "Stan" && matchedModel->IsChecked( matchedModel->GetSubjectID( 2 ) ) &&
+            fadttsWindow->m_failedQCThresholdSubjects == ( QStringList() << "Kenny" );
+
+    /** New source with Kyle only: the other subjects become unmatched, in alphabetical order **/
+    fadttsWindow->UpdateSortedSubjects( subjectMatcher.SetSource( 2, QStringList() << "Kyle" << "Butters" ) );
+    bool testSourceAdded = matchedModel->GetNbrSubjects() == 1 && matchedModel->GetSubject( 0 ) == "Kyle" && unmatchedModel->GetNbrSubjects() == 3 &&
+            unmatchedModel->index( 0 ).data().toString() == "Butters --> MD" && unmatchedModel->index( 1 ).data().toString() == "Kenny --> AD, RD" &&
+            unmatchedModel->index( 2 ).data().toString() == "Stan --> AD, RD" && fadttsWindow->m_failedQCThresholdSubjects.isEmpty();
+
+    fadttsWindow->UpdateSortedSubjects( subjectMatcher.RemoveSource( 2 ) );
+    bool testSourceRemoved = matchedModel->GetNbrSubjects() == 3 && unmatchedModel->GetNbrSubjects() == 0 &&
+            matchedModel->GetSubject( 1 ) == "Kyle" && matchedModel->IsChecked( matchedModel->GetSubjectID( 1 ) ) &&
+            matchedModel->GetNbrChecked() == 3;
+
+
+    bool testUpdateSortedSubjects_Passed = testSourceChanged && testSourceAdded && testSourceRemoved;
+    if( !testUpdateSortedSubjects_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_UpdateSortedSubjects() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with UpdateSortedSubjects( const QSet< int >& changedSubjectIDs )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_UpdateSortedSubjects() PASSED";
+    }
+
+    return testUpdateSortedSubjects_Passed;
+}
+
 bool TestFADTTSWindow::Test_SetCheckStateAllVisibleSubjects()
 {
     QSharedPointer< FADTTSWindow > fadttsWindow = QSharedPointer< FADTTSWindow >( new FADTTSWindow );
     QStringList matchedSubjects = QStringList() << "Stan" << "Kyle" << "Kenny" << "stanley" << "Stanny" << "Butters" << "Wendy" << "Craig" << "Pip";
-    QStringList expectedCheckedSubjects1 = QStringList() << "Kyle" << "Kenny" << "Butters" << "Wendy" << "Craig" << "Pip";
-    QStringList expectedCheckedSubjects2 = QStringList() << "Stan" << "stanley" << "Stanny";
+    QStringList expectedCheckedSubjects1 = QStringList() << "Butters" << "Craig" << "Kenny" << "Kyle" << "Pip" << "Wendy";
+    QStringList expectedCheckedSubjects2 = QStringList() << "Stan" << "Stanny" << "stanley";
     QStringList expectedUncheckedSubjects1 = expectedCheckedSubjects2;
     QStringList expectedUncheckedSubjects2 = expectedCheckedSubjects1;
     QStringList checkedSubjects1;
@@ -939,16 +971,15 @@ bool TestFADTTSWindow::Test_SetCheckStateAllVisibleSubjects()
     fadttsWindow->SetCheckStateAllVisibleSubjects( Qt::Unchecked );
     fadttsWindow->subjectTab_search_lineEdit->setText( "" );
     fadttsWindow->OnSearch();
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
+    for( int i = 0; i < fadttsWindow->m_matchedSubjectModel->GetNbrSubjects(); i++ )
     {
-        QListWidgetItem *item = fadttsWindow->m_matchedSubjectListWidget->item( i );
-        if( item->checkState() == Qt::Checked )
+        if( fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( i ) ) )
         {
-            checkedSubjects1.append( item->text() );
+            checkedSubjects1.append( fadttsWindow->m_matchedSubjectModel->GetSubject( i ) );
         }
         else
         {
-            uncheckedSubjects1.append( item->text() );
+            uncheckedSubjects1.append( fadttsWindow->m_matchedSubjectModel->GetSubject( i ) );
         }
     }
 
@@ -958,16 +989,15 @@ bool TestFADTTSWindow::Test_SetCheckStateAllVisibleSubjects()
     fadttsWindow->SetCheckStateAllVisibleSubjects( Qt::Checked );
     fadttsWindow->subjectTab_search_lineEdit->setText( "" );
     fadttsWindow->OnSearch();
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
+    for( int i = 0; i < fadttsWindow->m_matchedSubjectModel->GetNbrSubjects(); i++ )
     {
-        QListWidgetItem *item = fadttsWindow->m_matchedSubjectListWidget->item( i );
-        if( item->checkState() == Qt::Checked )
+        if( fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( i ) ) )
         {
-            checkedSubjects2.append( item->text() );
+            checkedSubjects2.append( fadttsWindow->m_matchedSubjectModel->GetSubject( i ) );
         }
         else
         {
-            uncheckedSubjects2.append( item->text() );
+            uncheckedSubjects2.append( fadttsWindow->m_matchedSubjectModel->GetSubject( i ) );
         }
     }
 
@@ -1061,12 +1091,25 @@ bool TestFADTTSWindow::Test_SearchSubjects()
     QString expectedInfo5 = "found 0";
     bool testInfo5 = fadttsWindow->subjectTab_nbrFound_label->text() == expectedInfo5;
 
+    /** Search narrowed while typing, subjects inserted meanwhile searched too **/
+    fadttsWindow->m_caseSensitivity = Qt::CaseInsensitive;
+    fadttsWindow->subjectTab_search_lineEdit->setText( "sta" );
+    fadttsWindow->OnSearch();
+    fadttsWindow->subjectTab_search_lineEdit->setText( "stann" );
+    fadttsWindow->OnSearch();
+    bool testNarrowing = fadttsWindow->subjectTab_nbrFound_label->text() == "found 1" && fadttsWindow->m_matchedSubjectProxyModel->rowCount() == 1 &&
+            fadttsWindow->m_unmatchedSubjectProxyModel->rowCount() == 0;
+    fadttsWindow->m_matchedSubjectModel->InsertSubject( "Stannis", "Stannis" );
+    fadttsWindow->m_matchedSubjectModel->InsertSubject( "Jon Snow", "Jon Snow" );
+    bool testInsertion = fadttsWindow->m_matchedSubjectProxyModel->rowCount() == 2 &&
+            fadttsWindow->m_matchedSubjectProxyModel->index( 0, 0 ).data().toString() == "Stannis";
+
 
-    bool testSearchSubjects_Passed = testInfo1 && testInfo2 && testInfo3 && testInfo4 && testInfo5;
+    bool testSearchSubjects_Passed = testInfo1 && testInfo2 && testInfo3 && testInfo4 && testInfo5 && testNarrowing && testInsertion;
     if( !testSearchSubjects_Passed )
     {
         std::cerr << "/!\\/!\\ Test_SearchSubjects() FAILED /!\\/!\\";
-//        std::cerr << std::endl << "\t+ pb with SearchSubjects( QListWidget *list )" << std::endl;
+//        std::cerr << std::endl << "\t+ pb with SearchSubjects( SubjectFilterProxyModel *proxyModel )" << std::endl;
     }
     else
     {
@@ -1109,7 +1152,8 @@ bool TestFADTTSWindow::Test_GetCheckedMatchedSubjects()
 
 
     fadttsWindow->DisplaySortedSubjects( subjectsExpected, QMap< QString, QList< int > >() );
-    fadttsWindow->m_matchedSubjectListWidget->item( 0 )->setCheckState( Qt::Unchecked );
+    fadttsWindow->m_matchedSubjectModel->SetChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 0 ), false );
+    subjectsExpected.sort();
     subjectsExpected.removeFirst();
     subjects = fadttsWindow->GetCheckedMatchedSubjects();
 
@@ -1130,25 +1174,24 @@ bool TestFADTTSWindow::Test_GetCheckedMatchedSubjects()
 bool TestFADTTSWindow::Test_GetPropertyRawData()
 {
     QSharedPointer< FADTTSWindow > fadttsWindow = QSharedPointer< FADTTSWindow >( new FADTTSWindow );
-    QMap< QString, QList< QStringList > > fileDataExpected, fileData;
-    fileDataExpected.insert( "AD", QList< QStringList >() << ( QStringList() << "AD1" << "AD2" << "AD3" << "AD4" ) );
-    fileDataExpected.insert( "RD", QList< QStringList >() << ( QStringList() << "RD1" << "RD2" << "RD3" << "RD4" ) );
-    fileDataExpected.insert( "MD", QList< QStringList >() << ( QStringList() << "MD1" << "MD2" << "MD3" << "MD4" ) );
-    fileDataExpected.insert( "FA", QList< QStringList >() << ( QStringList() << "FA1" << "FA2" << "FA3" << "FA4" ) );
-    fileDataExpected.insert( "SUBMATRIX", QList< QStringList >() << ( QStringList() << "submatrix1" << "submatrix2" << "submatrix3" << "submatrix4" ) );
+    CSVReader csvReader( "," );
+    QMap< QString, DiffusionProfileMatrix::ConstPointer > fileDataExpected, fileData;
+    fileDataExpected.insert( "AD", DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( csvReader.ReadContent( "AD1,AD2,AD3,AD4" ) ) ) );
+    fileDataExpected.insert( "RD", DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( csvReader.ReadContent( "RD1,RD2,RD3,RD4" ) ) ) );
+    fileDataExpected.insert( "MD", DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( csvReader.ReadContent( "MD1,MD2,MD3,MD4" ) ) ) );
+    fileDataExpected.insert( "FA", DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( csvReader.ReadContent( "FA1,FA2,FA3,FA4" ) ) ) );
 
 
     fadttsWindow->m_propertySelected.insert( 1, "RD" );
     fadttsWindow->m_propertySelected.insert( 2, "MD" );
     fadttsWindow->m_propertySelected.insert( 3, "FA" );
-    fadttsWindow->m_data.SetFileData( 0 ) = fileDataExpected.value( "AD" );
-    fadttsWindow->m_data.SetFileData( 1 ) = fileDataExpected.value( "RD" );
-    fadttsWindow->m_data.SetFileData( 2 ) = fileDataExpected.value( "MD" );
-    fadttsWindow->m_data.SetFileData( 3 ) = fileDataExpected.value( "FA" );
-    fadttsWindow->m_data.SetFileData( 4 ) = fileDataExpected.value( "SUBMATRIX" );
+    fadttsWindow->m_data.SetProfileData( 0 ) = fileDataExpected.value( "AD" );
+    fadttsWindow->m_data.SetProfileData( 1 ) = fileDataExpected.value( "RD" );
+    fadttsWindow->m_data.SetProfileData( 2 ) = fileDataExpected.value( "MD" );
+    fadttsWindow->m_data.SetProfileData( 3 ) = fileDataExpected.value( "FA" );
+    fadttsWindow->m_data.SetFileData( 4, csvReader.ReadContent( "submatrix1,submatrix2,submatrix3,submatrix4" ) );
     fileData = fadttsWindow->GetPropertyRawData();
     fileDataExpected.remove( "AD" );
-    fileDataExpected.remove( "SUBMATRIX" );
 
 
     bool testGetPropertyRawData_Passed = fileData == fileDataExpected;
@@ -1200,13 +1243,13 @@ bool TestFADTTSWindow::Test_OnInputToggled()
 
     fadttsWindow->OnInputToggled();
 
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
+    for( int i = 0; i < fadttsWindow->m_matchedSubjectModel->GetNbrSubjects(); i++ )
     {
-        matchedSubjects.append( fadttsWindow->m_matchedSubjectListWidget->item( i )->text() );
+        matchedSubjects.append( fadttsWindow->m_matchedSubjectModel->index( i ).data().toString() );
     }
-    for( int i = 0; i < fadttsWindow->m_unmatchedSubjectListWidget->count(); i++ )
+    for( int i = 0; i < fadttsWindow->m_unmatchedSubjectModel->GetNbrSubjects(); i++ )
     {
-        unmatchedSubjects.append( fadttsWindow->m_unmatchedSubjectListWidget->item( i )->text() );
+        unmatchedSubjects.append( fadttsWindow->m_unmatchedSubjectModel->index( i ).data().toString() );
     }
 
     bool testMatchedSubjects = matchedSubjects == expectedMatchedSubjects;
@@ -1220,12 +1263,12 @@ bool TestFADTTSWindow::Test_OnInputToggled()
 //        std::cerr << std::endl << "\t+ pb with OnInputToggled()" << std::endl;
 //        if( !testMatchedSubjects )
 //        {
-//            std::cerr << "\t  wrong m_matchedSubjectListWidget" << std::endl;
+//            std::cerr << "\t  wrong m_matchedSubjectModel" << std::endl;
 //            DisplayError_QStringList( expectedMatchedSubjects, matchedSubjects, "matched subjects" );
 //        }
 //        if( !testUnmatchedSubjects )
 //        {
-//            std::cerr << "\t  wrong m_unmatchedSubjectListWidget" << std::endl;
+//            std::cerr << "\t  wrong m_unmatchedSubjectModel" << std::endl;
 //            DisplayError_QStringList( expectedUnmatchedSubjects, unmatchedSubjects, "unmatched subjects" );
 //        }
     }
@@ -1274,36 +1317,36 @@ bool TestFADTTSWindow::Test_OnSubjectClicked()
 
     fadttsWindow->DisplaySortedSubjects( matchedSubjects, QMap< QString, QList< int > >() );
 
-    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectListWidget->item( 0 ) );
-    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectListWidget->item( 2 ) );
-    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectListWidget->item( 2 ) );
-    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectListWidget->item( 3 ) );
+    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectProxyModel->index( 0, 0 ) );
+    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectProxyModel->index( 2, 0 ) );
+    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectProxyModel->index( 2, 0 ) );
+    fadttsWindow->OnSubjectClicked( fadttsWindow->m_matchedSubjectProxyModel->index( 3, 0 ) );
 
-    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectListWidget->item( 0 )->checkState() == Qt::Unchecked;
-    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectListWidget->item( 1 )->checkState() == Qt::Checked;
-    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectListWidget->item( 2 )->checkState() == Qt::Checked;
-    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectListWidget->item( 3 )->checkState() == Qt::Unchecked;
-    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectListWidget->item( 4 )->checkState() == Qt::Checked;
+    testCheckState = testCheckState && !fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 0 ) );
+    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 1 ) );
+    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 2 ) );
+    testCheckState = testCheckState && !fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 3 ) );
+    testCheckState = testCheckState && fadttsWindow->m_matchedSubjectModel->IsChecked( fadttsWindow->m_matchedSubjectModel->GetSubjectID( 4 ) );
 
-    testColor = testColor && fadttsWindow->m_matchedSubjectListWidget->item( 0 )->backgroundColor() == fadttsWindow->m_grey;
-    testColor = testColor && fadttsWindow->m_matchedSubjectListWidget->item( 1 )->backgroundColor() == fadttsWindow->m_green;
-    testColor = testColor && fadttsWindow->m_matchedSubjectListWidget->item( 2 )->backgroundColor() == fadttsWindow->m_green;
-    testColor = testColor && fadttsWindow->m_matchedSubjectListWidget->item( 3 )->backgroundColor() == fadttsWindow->m_grey;
-    testColor = testColor && fadttsWindow->m_matchedSubjectListWidget->item( 4 )->backgroundColor() == fadttsWindow->m_green;
+    testColor = testColor && fadttsWindow->m_matchedSubjectModel->index( 0 ).data( Qt::BackgroundRole ).value< QBrush >().color() == fadttsWindow->m_grey;
+    testColor = testColor && fadttsWindow->m_matchedSubjectModel->index( 1 ).data( Qt::BackgroundRole ).value< QBrush >().color() == fadttsWindow->m_green;
+    testColor = testColor && fadttsWindow->m_matchedSubjectModel->index( 2 ).data( Qt::BackgroundRole ).value< QBrush >().color() == fadttsWindow->m_green;
+    testColor = testColor && fadttsWindow->m_matchedSubjectModel->index( 3 ).data( Qt::BackgroundRole ).value< QBrush >().color() == fadttsWindow->m_grey;
+    testColor = testColor && fadttsWindow->m_matchedSubjectModel->index( 4 ).data( Qt::BackgroundRole ).value< QBrush >().color() == fadttsWindow->m_green;
 
 
     bool testOnSubjectClicked_Passed = testCheckState && testColor;
     if( !testOnSubjectClicked_Passed )
     {
         std::cerr << "/!\\/!\\ Test_OnSubjectClicked() FAILED /!\\/!\\";
-//        std::cerr << std::endl << "\t+ pb with OnSubjectClicked( QListWidgetItem *item )" << std::endl;
+//        std::cerr << std::endl << "\t+ pb with OnSubjectClicked( const QModelIndex& index )" << std::endl;
 //        if( !testCheckState )
 //        {
-//            std::cerr << "\t  wrong m_matchedSubjectListWidget item check state" << std::endl;
+//            std::cerr << "\t  wrong m_matchedSubjectModel item check state" << std::endl;
 //        }
 //        if( !testColor )
 //        {
-//            std::cerr << "\t  wrong m_matchedSubjectListWidget item background color" << std::endl;
+//            std::cerr << "\t  wrong m_matchedSubjectModel item background color" << std::endl;
 //        }
     }
     else
@@ -1325,22 +1368,19 @@ bool TestFADTTSWindow::Test_OnSettingSubjectList( QString subjectListPath )
 
 
     fadttsWindow->OnSettingSubjectList( wrongPath );
-    bool testMatchedSubjects1 = fadttsWindow->m_matchedSubjectListWidget->count() == 0;
+    bool testMatchedSubjects1 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects() == 0;
     bool testLoadedSubjects1 = fadttsWindow->m_loadedSubjects.isEmpty();
     bool testSubjectsLoaded1 = !fadttsWindow->m_areSubjectsLoaded;
 
     fadttsWindow->OnSettingSubjectList( subjectListPath );
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
-    {
-        matchedSubjects.append( fadttsWindow->m_matchedSubjectListWidget->item( i )->text() );
-    }
+    matchedSubjects = fadttsWindow->m_matchedSubjectModel->GetCheckedSubjects();
     bool testMatchedSubjects2 = matchedSubjects == expectedMatchedSubjects;
     bool testLoadedSubjects2 = fadttsWindow->m_loadedSubjects == expectedMatchedSubjects;
     bool testSubjectsLoaded2 = fadttsWindow->m_areSubjectsLoaded;
 
     fadttsWindow->OnResetSubjectList();
     fadttsWindow->OnSettingSubjectList( fadttsWindow->m_subjectFileLineEdit->text() );
-    bool testMatchedSubjects3 = fadttsWindow->m_matchedSubjectListWidget->count() == 0;
+    bool testMatchedSubjects3 = fadttsWindow->m_matchedSubjectModel->GetNbrSubjects() == 0;
     bool testLoadedSubjects3 = fadttsWindow->m_loadedSubjects.isEmpty();
     bool testSubjectsLoaded3 = !fadttsWindow->m_areSubjectsLoaded;
 
@@ -1609,15 +1649,15 @@ bool TestFADTTSWindow::Test_UpdateInputFileInformation( QString rdFilePath, QStr
 
 
     fadttsWindow->m_data.SetFilename( 1 ) = rdFilePath;
-    fadttsWindow->m_data.SetFileData( 1 ) = fadttsWindow->m_processing.GetDataFromFile( rdFilePath );
+    fadttsWindow->m_data.SetFileData( 1, fadttsWindow->m_processing.GetNumericDataFromFile( rdFilePath ) );
     fadttsWindow->UpdateInputFileInformation( 1 );
 
     fadttsWindow->m_data.SetFilename( 3 ) = faFilePath;
-    fadttsWindow->m_data.SetFileData( 3 ) = fadttsWindow->m_processing.GetDataFromFile( faFilePath );
+    fadttsWindow->m_data.SetFileData( 3, fadttsWindow->m_processing.GetNumericDataFromFile( faFilePath ) );
     fadttsWindow->UpdateInputFileInformation( 3 );
 
     fadttsWindow->m_data.SetFilename( 4 ) = subMatrixFilePath;
-    fadttsWindow->m_data.SetFileData( 4 ) = fadttsWindow->m_processing.GetDataFromFile( subMatrixFilePath );
+    fadttsWindow->m_data.SetFileData( 4, fadttsWindow->m_processing.GetNumericDataFromFile( subMatrixFilePath ) );
     fadttsWindow->UpdateInputFileInformation( 4 );
 
     bool testUpdateRD = QFileInfo( QFile( fadttsWindow->m_data.GetFilename( 1 ) ) ).fileName() == "test_RawData_RD.csv"
@@ -1721,7 +1761,7 @@ bool TestFADTTSWindow::Test_SetInfoSubjectColumnID( QString subMatrixFilePath )
 
 
     fadttsWindow->m_data.SetFilename( 4 ) = subMatrixFilePath;
-    fadttsWindow->m_data.SetFileData( 4 ) = fadttsWindow->m_processing.GetDataFromFile( subMatrixFilePath );
+    fadttsWindow->m_data.SetFileData( 4, fadttsWindow->m_processing.GetNumericDataFromFile( subMatrixFilePath ) );
     fadttsWindow->SetInfoSubjectColumnID();
     bool testID = fadttsWindow->inputTab_subjectColumnID_label->text() == "<b><i><span style=""font-size:7pt;"">1</span></i></b>";
 
@@ -1768,8 +1808,9 @@ bool TestFADTTSWindow::Test_OnSettingInputFile( QString rdFilePath, QString subM
     /******************************************/
     fadttsWindow->m_inputTabInputFileLineEditMap.value( 1 )->setText( rdFilePath );
     fadttsWindow->OnSettingInputFile( 1 );
+    fadttsWindow->WaitForInputFiles();
     bool testRDFilename = fadttsWindow->m_data.GetFilename( 1 ) == QFile( rdFilePath ).fileName();
-    bool testRDData = fadttsWindow->m_data.GetFileData( 1 ) == fadttsWindow->m_processing.GetDataFromFile( rdFilePath );
+    bool testRDData = fadttsWindow->m_data.GetProfileData( 1 )->GetSubjects() == fadttsWindow->m_processing.GetNumericDataFromFile( rdFilePath ).GetHeader().mid( 1 );
     bool testRDNbrRows = fadttsWindow->m_data.GetNbrRows( 1 ) == 80;
     bool testRDNbrColumns = fadttsWindow->m_data.GetNbrColumns( 1 ) == 11;
     bool testRDSubjects = fadttsWindow->m_data.GetSubjects().value( 1 ) ==
@@ -1778,7 +1819,9 @@ bool TestFADTTSWindow::Test_OnSettingInputFile( QString rdFilePath, QString subM
     bool testRDNbrSubjects = fadttsWindow->m_data.GetNbrSubjects( 1 ) == 10;
     bool testRDCurrentDir = fadttsWindow->m_currentInputFileDir == QFileInfo( QFile( rdFilePath ) ).absolutePath();
 
-    bool testRDFile = testRDFilename && testRDData && testRDNbrRows && testRDNbrColumns && testRDSubjects && testRDNbrSubjects && testRDCurrentDir;
+    bool testRDLoaded = fadttsWindow->m_loadingInputFiles.isEmpty() && fadttsWindow->m_inputTabLoadingProgressBarMap.value( 1 )->isHidden();
+
+    bool testRDFile = testRDFilename && testRDData && testRDNbrRows && testRDNbrColumns && testRDSubjects && testRDNbrSubjects && testRDCurrentDir && testRDLoaded;
 
 
     /******************************************/
@@ -1786,8 +1829,9 @@ bool TestFADTTSWindow::Test_OnSettingInputFile( QString rdFilePath, QString subM
     /******************************************/
     fadttsWindow->m_inputTabInputFileLineEditMap.value( 1 )->setText( "/path/rdFile.csv" );
     fadttsWindow->OnSettingInputFile( 1 );
+    fadttsWindow->WaitForInputFiles();
     bool testWrongRDFilename = fadttsWindow->m_data.GetFilename( 1 ).isEmpty();
-    bool testWrongRDData = fadttsWindow->m_data.GetFileData( 1 ).isEmpty();
+    bool testWrongRDData = fadttsWindow->m_data.IsFileDataEmpty( 1 );
     bool testWrongRDNbrRows = fadttsWindow->m_data.GetNbrRows( 1 ) == 0;
     bool testWrongRDNbrColumns = fadttsWindow->m_data.GetNbrColumns( 1 ) == 0;
     bool testWrongRDSubjects = fadttsWindow->m_data.GetSubjects().value( 1 ).isEmpty();
@@ -1802,8 +1846,9 @@ bool TestFADTTSWindow::Test_OnSettingInputFile( QString rdFilePath, QString subM
     /******************************************/
     fadttsWindow->m_inputTabInputFileLineEditMap.value( 4 )->setText( subMatrixFilePath );
     fadttsWindow->OnSettingInputFile( 4 );
+    fadttsWindow->WaitForInputFiles();
     bool testSubMatrixFilename = fadttsWindow->m_data.GetFilename( 4 ) == QFile( subMatrixFilePath ).fileName();
-    bool testSubMatrixData = fadttsWindow->m_data.GetFileData( 4 ) == fadttsWindow->m_processing.GetDataFromFile( subMatrixFilePath );
+    bool testSubMatrixData = fadttsWindow->m_data.GetSubMatrixData() == fadttsWindow->m_processing.GetNumericDataFromFile( subMatrixFilePath );
     bool testSubMatrixNbrRows = fadttsWindow->m_data.GetNbrRows( 4 ) == 11;
     bool testSubMatrixNbrColumns = fadttsWindow->m_data.GetNbrColumns( 4 ) == 4;
     bool testSubMatrixSubjects = fadttsWindow->m_data.GetSubjects().value( 4 ) ==
@@ -1820,8 +1865,9 @@ bool TestFADTTSWindow::Test_OnSettingInputFile( QString rdFilePath, QString subM
     /******************************************/
     fadttsWindow->m_inputTabInputFileLineEditMap.value( 4 )->setText( "" );
     fadttsWindow->OnSettingInputFile( 4 );
+    fadttsWindow->WaitForInputFiles();
     bool testNoSubMatrixFilename = fadttsWindow->m_data.GetFilename( 4 ).isEmpty();
-    bool testNoSubMatrixData = fadttsWindow->m_data.GetFileData( 4 ).isEmpty();
+    bool testNoSubMatrixData = fadttsWindow->m_data.IsFileDataEmpty( 4 );
     bool testNoSubMatrixNbrRows = fadttsWindow->m_data.GetNbrRows( 4 ) == 0;
     bool testNoSubMatrixNbrColumns = fadttsWindow->m_data.GetNbrColumns( 4 ) == 0;
     bool testNoSubMatrixSubjects = fadttsWindow->m_data.GetSubjects().value( 4 ).isEmpty();
@@ -1898,11 +1944,12 @@ bool TestFADTTSWindow::Test_OnUpdatingSubjectColumnID( QString subMatrixRawDataP
 
 
     fadttsWindow->m_inputTabInputFileLineEditMap.value( 4 )->setText( subMatrixRawDataPath );
+    fadttsWindow->WaitForInputFiles();
     fadttsWindow->OnUpdatingSubjectColumnID( 2 );
 
-    for( int i = 0; i < fadttsWindow->m_matchedSubjectListWidget->count(); i++ )
+    for( int i = 0; i < fadttsWindow->m_matchedSubjectModel->GetNbrSubjects(); i++ )
     {
-        subjects.append( fadttsWindow->m_matchedSubjectListWidget->item( i )->text() );
+        subjects.append( fadttsWindow->m_matchedSubjectModel->GetSubject( i ) );
     }
     bool testSubjects = subjects == expectedSubjects;
 
@@ -2,6 +2,7 @@
 #define TESTFADTTSWINDOW_H
 
 #include "FADTTSWindow.h"
+#include "CSVReader.h"
 
 #include <QCryptographicHash>
 #include <QSet>
@@ -48,6 +49,8 @@ public:
 
     bool Test_DisplaySortedSubjects();
 
+    bool Test_UpdateSortedSubjects();
+
     bool Test_SetCheckStateAllVisibleSubjects();
 
     bool Test_SearchSubjects();
@@ -0,0 +1,150 @@
+#include "TestFunctionalPCA.h"
+
+TestFunctionalPCA::TestFunctionalPCA()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestFunctionalPCA::Test_SetNbrComponents()
+{
+    FunctionalPCA functionalPCA;
+    bool testDefault = functionalPCA.GetNbrComponents() == 3;
+
+    functionalPCA.SetNbrComponents( 5 );
+    bool testSet = functionalPCA.GetNbrComponents() == 5;
+
+    functionalPCA.SetNbrComponents( 0 );
+    bool testMin = functionalPCA.GetNbrComponents() == 1;
+
+
+    bool testSetNbrComponents_Passed = testDefault && testSet && testMin;
+    if( !testSetNbrComponents_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_SetNbrComponents() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with SetNbrComponents( int nbrComponents )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_SetNbrComponents() PASSED";
+    }
+
+    return testSetNbrComponents_Passed;
+}
+
+bool TestFunctionalPCA::Test_Score()
+{
+    QList< QList< double > > profiles = GetProfiles( 200, 50 );
+    FunctionalPCA functionalPCA;
+    functionalPCA.SetNbrThreads( 1 );
+
+
+    /** Scaled and bumped profiles rejected, the others between 0 and 1 and mostly kept **/
+    QVector< double > scores = functionalPCA.Score( profiles, 0, 49 );
+    QVector< double > otherScores;
+    for( int i = 0; i < scores.size(); i++ )
+    {
+        if( i != 3 && i != 5 )
+        {
+            otherScores.append( scores.at( i ) );
+        }
+    }
+    std::sort( otherScores.begin(), otherScores.end() );
+    bool testOutliers = scores.size() == 200 && scores.at( 3 ) < 1e-3 && scores.at( 5 ) < 1e-3 &&
+            otherScores.first() >= 0 && otherScores.last() <= 1 && otherScores.at( 99 ) > 0.1;
+
+    /** Window: same scores as the cropped profiles **/
+    QList< QList< double > > croppedProfiles;
+    foreach( const QList< double >& profile, profiles )
+    {
+        croppedProfiles.append( profile.mid( 10, 30 ) );
+    }
+    bool testWindow = AreEqual( functionalPCA.Score( profiles, 10, 39 ), functionalPCA.Score( croppedProfiles, 0, 29 ), 0 );
+
+    /** Profile with a nan value left out **/
+    QList< QList< double > > nanProfiles = profiles;
+    nanProfiles[ 7 ][ 20 ] = std::numeric_limits< double >::quiet_NaN();
+    QVector< double > nanScores = functionalPCA.Score( nanProfiles, 0, 49 );
+    bool testNAN = std::isnan( nanScores.at( 7 ) ) && nanScores.at( 3 ) < 1e-3 && !std::isnan( nanScores.at( 8 ) );
+
+    /** Less than 2 profiles: no outlier **/
+    bool testFewProfiles = functionalPCA.Score( profiles.mid( 3, 1 ), 0, 49 ) == ( QVector< double >() << 1.0 ) &&
+            functionalPCA.Score( QList< QList< double > >(), 0, 49 ).isEmpty();
+
+    /** Profiles split between threads: same scores **/
+    QList< QList< double > > bigProfiles = GetProfiles( 12000, 50 );
+    FunctionalPCA threadedFunctionalPCA;
+    threadedFunctionalPCA.SetNbrThreads( 4 );
+    bool testThreads = AreEqual( threadedFunctionalPCA.Score( bigProfiles, 0, 49 ), functionalPCA.Score( bigProfiles, 0, 49 ), 1e-9 );
+
+
+    bool testScore_Passed = testOutliers && testWindow && testNAN && testFewProfiles && testThreads;
+    if( !testScore_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Score() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Score( const QList< QList< double > >& profiles, int first, int last )" << std::endl;
+        //        if( !testOutliers )
+        //        {
+        //            std::cerr << "\t  scaled and/or bumped profiles not rejected" << std::endl;
+        //        }
+    }
+    else
+    {
+        std::cerr << "Test_Score() PASSED";
+    }
+
+    return testScore_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+QList< QList< double > > TestFunctionalPCA::GetProfiles( int nbrProfiles, int nbrPoints )
+{
+    QList< QList< double > > profiles;
+    for( int i = 0; i < nbrProfiles; i++ )
+    {
+        double firstComponent = ( ( i * 37 ) % 101 ) / 101.0 - 0.5;
+        double secondComponent = ( ( i * 53 ) % 97 ) / 97.0 - 0.5;
+        QList< double > profile;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            double t = point / ( nbrPoints - 1.0 );
+            double noise = ( ( i * 7919 + point * 104729 ) % 1009 ) / 1009.0 - 0.5;
+            double value = 0.5 + 0.1 * std::sin( 6.283 * t ) + 0.04 * firstComponent * std::cos( 3.1416 * t ) +
+                    0.03 * secondComponent * std::sin( 3.1416 * t ) + 0.002 * noise;
+            if( i == 3 )
+            {
+                value *= 1.3;
+            }
+            if( i == 5 && point >= 20 && point < 24 )
+            {
+                value += 0.03;
+            }
+            profile.append( value );
+        }
+        profiles.append( profile );
+    }
+
+    return profiles;
+}
+
+bool TestFunctionalPCA::AreEqual( const QVector< double >& scores, const QVector< double >& expectedScores, double tolerance )
+{
+    if( scores.size() != expectedScores.size() )
+    {
+        return false;
+    }
+    for( int i = 0; i < scores.size(); i++ )
+    {
+        if( std::abs( scores.at( i ) - expectedScores.at( i ) ) > tolerance )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef TESTFUNCTIONALPCA_H
+#define TESTFUNCTIONALPCA_H
+
+#include "FunctionalPCA.h"
+
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+class TestFunctionalPCA
+{
+public:
+    TestFunctionalPCA();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetNbrComponents();
+
+    bool Test_Score();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    /** Profiles varying along 2 components plus noise: the 4th scaled up, the 6th with a local bump **/
+    QList< QList< double > > GetProfiles( int nbrProfiles, int nbrPoints );
+
+    bool AreEqual( const QVector< double >& scores, const QVector< double >& expectedScores, double tolerance );
+};
+
+#endif // TESTFUNCTIONALPCA_H
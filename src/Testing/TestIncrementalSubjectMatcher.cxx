@@ -0,0 +1,153 @@
+#include "TestIncrementalSubjectMatcher.h"
+
+TestIncrementalSubjectMatcher::TestIncrementalSubjectMatcher()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestIncrementalSubjectMatcher::Test_SetSource()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    IncrementalSubjectMatcher subjectMatcher;
+    QStringList adSubjects = QStringList() << "Stan" << "Kyle" << "Kenny" << "Kyle";
+
+
+    QSet< int > changedIDs1 = subjectMatcher.SetSource( 0, adSubjects );
+    bool testFirstSource = changedIDs1 == registry.GetIDSet( adSubjects ) && subjectMatcher.IsMatched( registry.FindID( "Kyle" ) ) &&
+            subjectMatcher.m_counts.at( registry.FindID( "Kyle" ) ) == 1 && subjectMatcher.GetSourceIndices() == ( QList< int >() << 0 );
+
+    /** Stan and Kenny are not matched anymore, Cartman is unmatched, Kyle is still matched but its sources changed **/
+    QSet< int > changedIDs2 = subjectMatcher.SetSource( -1, QStringList() << "Kyle" << "Cartman" );
+    bool testSecondSource = changedIDs2 == registry.GetIDSet( QStringList() << "Stan" << "Kenny" << "Kyle" << "Cartman" ) &&
+            subjectMatcher.IsMatched( registry.FindID( "Kyle" ) ) && !subjectMatcher.IsMatched( registry.FindID( "Stan" ) ) &&
+            subjectMatcher.GetSubjectSources( registry.FindID( "Kyle" ) ) == ( QList< int >() << -1 << 0 ) &&
+            subjectMatcher.GetSubjectSources( registry.FindID( "Cartman" ) ) == ( QList< int >() << -1 );
+
+    /** Same list: nothing to update **/
+    bool testSameSource = subjectMatcher.SetSource( 0, adSubjects ).isEmpty();
+
+    /** Only the subjects of the source replaced and the subjects whose state changed **/
+    QSet< int > changedIDs3 = subjectMatcher.SetSource( -1, QStringList() << "Kyle" << "Stan" );
+    bool testReplacedSource = changedIDs3 == registry.GetIDSet( QStringList() << "Kyle" << "Cartman" << "Stan" ) &&
+            subjectMatcher.IsMatched( registry.FindID( "Stan" ) ) && subjectMatcher.m_counts.at( registry.FindID( "Cartman" ) ) == 0;
+
+
+    bool testSetSource_Passed = testFirstSource && testSecondSource && testSameSource && testReplacedSource;
+    if( !testSetSource_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_SetSource() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with SetSource( int sourceIndex, const QStringList& subjects )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_SetSource() PASSED";
+    }
+
+    return testSetSource_Passed;
+}
+
+bool TestIncrementalSubjectMatcher::Test_RemoveSource()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    IncrementalSubjectMatcher subjectMatcher;
+    subjectMatcher.SetSource( 0, QStringList() << "Stan" << "Kyle" << "Kenny" );
+    subjectMatcher.SetSource( 1, QStringList() << "Stan" << "Kyle" );
+    subjectMatcher.SetSource( 2, QStringList() << "Kyle" << "Butters" );
+
+
+    /** Stan held by the other sources: matched again **/
+    QSet< int > changedIDs1 = subjectMatcher.RemoveSource( 2 );
+    bool testRemoved = changedIDs1 == registry.GetIDSet( QStringList() << "Kyle" << "Butters" << "Stan" ) &&
+            subjectMatcher.GetMatchedSubjects() == ( QStringList() << "Kyle" << "Stan" ) &&
+            subjectMatcher.GetUnMatchedSubjects().keys() == ( QStringList() << "Kenny" );
+
+    bool testNoSource = subjectMatcher.RemoveSource( 2 ).isEmpty();
+
+    subjectMatcher.RemoveSource( 0 );
+    QSet< int > changedIDs2 = subjectMatcher.RemoveSource( 1 );
+    bool testLastSource = changedIDs2 == registry.GetIDSet( QStringList() << "Kyle" << "Stan" ) &&
+            subjectMatcher.GetMatchedSubjects().isEmpty() && subjectMatcher.GetUnMatchedSubjects().isEmpty() &&
+            subjectMatcher.GetSourceIndices().isEmpty() && subjectMatcher.m_subjectIDs.isEmpty();
+
+
+    bool testRemoveSource_Passed = testRemoved && testNoSource && testLastSource;
+    if( !testRemoveSource_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_RemoveSource() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with RemoveSource( int sourceIndex )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_RemoveSource() PASSED";
+    }
+
+    return testRemoveSource_Passed;
+}
+
+bool TestIncrementalSubjectMatcher::Test_Match()
+{
+    /** Sources toggled one after the other: same results as matching every source at once **/
+    QMap< int, QStringList > sources;
+    for( int sourceIndex = -1; sourceIndex < 5; sourceIndex++ )
+    {
+        for( int i = 0; i < 200; i++ )
+        {
+            if( ( i + 2 ) % ( sourceIndex + 3 ) != 0 )
+            {
+                sources[ sourceIndex ].append( "Subj" + QString::number( i ) );
+            }
+        }
+    }
+    IncrementalSubjectMatcher incrementalSubjectMatcher;
+    QList< QList< int > > toggledSources = QList< QList< int > >() << ( QList< int >() << 0 << 1 << 2 << 3 << 4 << -1 )
+                                                                   << ( QList< int >() << 0 << 2 << 4 )
+                                                                   << ( QList< int >() << 1 << 3 << -1 )
+                                                                   << ( QList< int >() << 3 );
+
+
+    bool testMatch = true;
+    foreach( QList< int > sourceIndices, toggledSources )
+    {
+        QStringList allSubjects;
+        SubjectMatcher subjectMatcher;
+        foreach( int sourceIndex, incrementalSubjectMatcher.GetSourceIndices() )
+        {
+            if( !sourceIndices.contains( sourceIndex ) )
+            {
+                incrementalSubjectMatcher.RemoveSource( sourceIndex );
+            }
+        }
+        foreach( int sourceIndex, sourceIndices )
+        {
+            incrementalSubjectMatcher.SetSource( sourceIndex, sources.value( sourceIndex ) );
+            allSubjects.append( sources.value( sourceIndex ) );
+        }
+        subjectMatcher.SetSubjects( allSubjects );
+        foreach( int sourceIndex, sourceIndices )
+        {
+            subjectMatcher.SetSource( sourceIndex, sources.value( sourceIndex ) );
+        }
+
+        QStringList expectedMatchedSubjects;
+        QMap< QString, QList< int > > expectedUnMatchedSubjects;
+        subjectMatcher.Match( expectedMatchedSubjects, expectedUnMatchedSubjects );
+        testMatch = testMatch && incrementalSubjectMatcher.GetMatchedSubjects() == expectedMatchedSubjects &&
+                incrementalSubjectMatcher.GetUnMatchedSubjects() == expectedUnMatchedSubjects;
+    }
+
+
+    if( !testMatch )
+    {
+        std::cerr << "/!\\/!\\ Test_Match() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetMatchedSubjects() and/or GetUnMatchedSubjects()" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Match() PASSED";
+    }
+
+    return testMatch;
+}
@@ -0,0 +1,25 @@
+#ifndef TESTINCREMENTALSUBJECTMATCHER_H
+#define TESTINCREMENTALSUBJECTMATCHER_H
+
+#include "IncrementalSubjectMatcher.h"
+#include "SubjectMatcher.h"
+
+#include <iostream>
+
+
+class TestIncrementalSubjectMatcher
+{
+public:
+    TestIncrementalSubjectMatcher();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetSource();
+
+    bool Test_RemoveSource();
+
+    bool Test_Match();
+};
+
+#endif // TESTINCREMENTALSUBJECTMATCHER_H
@@ -0,0 +1,122 @@
+#include "TestMatrixView.h"
+
+namespace
+{
+    /** 2 rows, 3 columns **/
+    const double s_rowMajorValues[] = { 1, 2, 3,
+                                        4, 5, 6 };
+
+    const double s_columnMajorValues[] = { 1, 4,
+                                           2, 5,
+                                           3, 6 };
+}
+
+TestMatrixView::TestMatrixView()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestMatrixView::Test_VectorView()
+{
+    VectorView view( s_rowMajorValues + 1, 2, 3 );
+
+
+    bool testAccess = view.Size() == 2 && !view.IsEmpty() && view.At( 0 ) == 2 && view[ 1 ] == 5 &&
+            view.ToList() == ( QList< double >() << 2 << 5 );
+    bool testMid = view.Mid( 1 ).ToList() == ( QList< double >() << 5 ) && view.Mid( 2 ).IsEmpty() && view.Mid( -1 ).IsEmpty();
+    bool testEmpty = VectorView().IsEmpty() && VectorView().ToList().isEmpty();
+
+
+    bool testVectorView_Passed = testAccess && testMid && testEmpty;
+    if( !testVectorView_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_VectorView() FAILED /!\\/!\\";
+    }
+    else
+    {
+        std::cerr << "Test_VectorView() PASSED";
+    }
+
+    return testVectorView_Passed;
+}
+
+bool TestMatrixView::Test_RowMajor()
+{
+    MatrixView view = MatrixView::RowMajor( s_rowMajorValues, 2, 3 );
+
+
+    bool testDimensions = view.GetNbrRows() == 2 && view.GetNbrColumns() == 3 && view.IsRowMajor() && !view.IsEmpty();
+    bool testAccess = view.At( 0, 2 ) == 3 && view.At( 1, 0 ) == 4 &&
+            view.GetRow( 1 ).ToList() == ( QList< double >() << 4 << 5 << 6 ) &&
+            view.GetColumn( 1 ).ToList() == ( QList< double >() << 2 << 5 );
+    bool testOutOfRange = view.GetRow( 2 ).IsEmpty() && view.GetColumn( -1 ).IsEmpty() && MatrixView().IsEmpty();
+
+
+    bool testRowMajor_Passed = testDimensions && testAccess && testOutOfRange;
+    if( !testRowMajor_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_RowMajor() FAILED /!\\/!\\";
+    }
+    else
+    {
+        std::cerr << "Test_RowMajor() PASSED";
+    }
+
+    return testRowMajor_Passed;
+}
+
+bool TestMatrixView::Test_ColumnMajor()
+{
+    MatrixView rowMajorView = MatrixView::RowMajor( s_rowMajorValues, 2, 3 );
+    MatrixView columnMajorView = MatrixView::ColumnMajor( s_columnMajorValues, 2, 3 );
+
+
+    bool testDimensions = columnMajorView.GetNbrRows() == 2 && columnMajorView.GetNbrColumns() == 3 && !columnMajorView.IsRowMajor();
+    bool testSameMatrix = columnMajorView.ToList() == rowMajorView.ToList() &&
+            columnMajorView.GetColumn( 2 ).ToList() == rowMajorView.GetColumn( 2 ).ToList();
+
+
+    bool testColumnMajor_Passed = testDimensions && testSameMatrix;
+    if( !testColumnMajor_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_ColumnMajor() FAILED /!\\/!\\";
+    }
+    else
+    {
+        std::cerr << "Test_ColumnMajor() PASSED";
+    }
+
+    return testColumnMajor_Passed;
+}
+
+bool TestMatrixView::Test_Transposed()
+{
+    MatrixView view = MatrixView::RowMajor( s_rowMajorValues, 2, 3 );
+    MatrixView transposedView = view.Transposed();
+    QList< QList< double > > expectedTransposedValues = QList< QList< double > >() << ( QList< double >() << 1 << 4 )
+                                                                                   << ( QList< double >() << 2 << 5 )
+                                                                                   << ( QList< double >() << 3 << 6 );
+
+
+    bool testTransposed = transposedView.GetNbrRows() == 3 && transposedView.GetNbrColumns() == 2 && !transposedView.IsRowMajor() &&
+            transposedView.ToList() == expectedTransposedValues && transposedView.At( 2, 1 ) == view.At( 1, 2 );
+    bool testTransposedTwice = transposedView.Transposed().ToList() == view.ToList() && transposedView.Transposed().IsRowMajor();
+    bool testColumnMajor = MatrixView::ColumnMajor( s_columnMajorValues, 2, 3 ).Transposed().IsRowMajor();
+
+
+    bool testTransposed_Passed = testTransposed && testTransposedTwice && testColumnMajor;
+    if( !testTransposed_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Transposed() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Transposed()" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Transposed() PASSED";
+    }
+
+    return testTransposed_Passed;
+}
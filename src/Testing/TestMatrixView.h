@@ -0,0 +1,26 @@
+#ifndef TESTMATRIXVIEW_H
+#define TESTMATRIXVIEW_H
+
+#include "MatrixView.h"
+
+#include <iostream>
+
+
+class TestMatrixView
+{
+public:
+    TestMatrixView();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_VectorView();
+
+    bool Test_RowMajor();
+
+    bool Test_ColumnMajor();
+
+    bool Test_Transposed();
+};
+
+#endif // TESTMATRIXVIEW_H
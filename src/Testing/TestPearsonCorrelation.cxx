@@ -0,0 +1,144 @@
+#include "TestPearsonCorrelation.h"
+
+TestPearsonCorrelation::TestPearsonCorrelation()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestPearsonCorrelation::Test_Correlate()
+{
+    QList< double > reference = QList< double >() << -10 << -11 << -12.5 << -14 << -15 << -4.25;
+    QList< QList< double > > profiles = QList< QList< double > >() << ( QList< double >() << 2 << -8 << -14 << -20 << 0 << -9 )
+                                                                   << ( QList< double >() << 3 << -9 << -15 << -21 << 0 << -10 )
+                                                                   << ( QList< double >() << 5 << -11 << -17 << -23 << 0 << -12.5 )
+                                                                   << ( QList< double >() << 6 << -12 << -18 << 24 << 0 << -4 );
+    PearsonCorrelation pearsonCorrelation( reference );
+
+
+    QVector< double > correlations = pearsonCorrelation.Correlate( profiles );
+    bool testCorrelations = correlations.size() == profiles.size() && pearsonCorrelation.GetNbrPoints() == 6;
+    for( int i = 0; i < profiles.size() && testCorrelations; i++ )
+    {
+        testCorrelations = AreEqual( correlations.at( i ), ComputePearsonCorrelation( profiles.at( i ), reference ) ) &&
+                AreEqual( pearsonCorrelation.Correlate( profiles.at( i ) ), correlations.at( i ) );
+    }
+
+    /** Profiles read in place or through a stride **/
+    QVector< double > columnMajor;
+    for( int point = 0; point < reference.size(); point++ )
+    {
+        for( int i = 0; i < profiles.size(); i++ )
+        {
+            columnMajor.append( profiles.at( i ).at( point ) );
+        }
+    }
+    QVector< double > rowMajor = profiles.at( 1 ).toVector();
+    QList< VectorView > views = QList< VectorView >() << VectorView( columnMajor.constData(), reference.size(), profiles.size() )
+                                                      << VectorView( rowMajor.constData(), rowMajor.size(), 1 );
+    QVector< double > viewCorrelations = pearsonCorrelation.Correlate( views );
+    bool testViews = AreEqual( viewCorrelations.at( 0 ), correlations.at( 0 ) ) && AreEqual( viewCorrelations.at( 1 ), correlations.at( 1 ) );
+
+    /** Same reference: correlation of 1, and 1 if the reference is too short **/
+    bool testSpecialCases = AreEqual( pearsonCorrelation.Correlate( reference ), 1.0 ) &&
+            PearsonCorrelation( QList< double >() << 3 ).Correlate( profiles.first() ) == 1.0 &&
+            PearsonCorrelation( QList< double >() ).Correlate( profiles ) == QVector< double >( 4, 1.0 ) &&
+            pearsonCorrelation.Correlate( QList< QList< double > >() ).isEmpty();
+
+
+    bool testCorrelate_Passed = testCorrelations && testViews && testSpecialCases;
+    if( !testCorrelate_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Correlate() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Correlate( const QList< QList< double > >& profiles )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Correlate() PASSED";
+    }
+
+    return testCorrelate_Passed;
+}
+
+bool TestPearsonCorrelation::Test_CorrelateBlocks()
+{
+    /** More profiles and points than in a block, and enough values to be split between threads **/
+    int nbrProfiles = 300;
+    int nbrPoints = 5003;
+    QList< double > reference;
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        reference.append( std::sin( point * 0.01 ) );
+    }
+    QList< QList< double > > profiles;
+    for( int i = 0; i < nbrProfiles; i++ )
+    {
+        QList< double > profile;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile.append( std::sin( point * 0.01 + i * 0.005 ) * ( 1 + i % 7 ) + std::cos( point * 0.37 * ( i % 3 ) ) * 0.1 + i );
+        }
+        profiles.append( profile );
+    }
+    PearsonCorrelation pearsonCorrelation( reference );
+
+
+    pearsonCorrelation.SetNbrThreads( 1 );
+    QVector< double > correlations1 = pearsonCorrelation.Correlate( profiles );
+    pearsonCorrelation.SetNbrThreads( 4 );
+    QVector< double > correlations4 = pearsonCorrelation.Correlate( profiles );
+    pearsonCorrelation.SetNbrThreads( -1 );
+    bool testNbrThreads = pearsonCorrelation.GetNbrThreads() == 0;
+
+    bool testCorrelations = correlations1.size() == nbrProfiles && correlations4 == correlations1;
+    for( int i = 0; i < nbrProfiles && testCorrelations; i++ )
+    {
+        testCorrelations = AreEqual( correlations1.at( i ), ComputePearsonCorrelation( profiles.at( i ), reference ) );
+    }
+
+
+    bool testCorrelateBlocks_Passed = testNbrThreads && testCorrelations;
+    if( !testCorrelateBlocks_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_CorrelateBlocks() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Correlate( const QList< QList< double > >& profiles ) and/or SetNbrThreads( int nbrThreads )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_CorrelateBlocks() PASSED";
+    }
+
+    return testCorrelateBlocks_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+double TestPearsonCorrelation::ComputePearsonCorrelation( const QList< double >& profile, const QList< double >& reference )
+{
+    int nbrPoints = reference.size();
+    double sumReference = 0;
+    double sumReferenceSquare = 0;
+    double sumProfile = 0;
+    double sumProfileSquare = 0;
+    double sumProduct = 0;
+    for( int i = 0; i < nbrPoints; i++ )
+    {
+        sumReference += reference.at( i );
+        sumReferenceSquare += reference.at( i ) * reference.at( i );
+        sumProfile += profile.at( i );
+        sumProfileSquare += profile.at( i ) * profile.at( i );
+        sumProduct += reference.at( i ) * profile.at( i );
+    }
+
+    return ( sumProduct - ( sumReference * sumProfile ) / nbrPoints ) /
+            std::sqrt( ( sumReferenceSquare - std::pow( sumReference, 2 ) / nbrPoints ) * ( sumProfileSquare - std::pow( sumProfile, 2 ) / nbrPoints ) );
+}
+
+bool TestPearsonCorrelation::AreEqual( double value, double expectedValue )
+{
+    return std::fabs( value - expectedValue ) < 1e-8;
+}
@@ -0,0 +1,33 @@
+#ifndef TESTPEARSONCORRELATION_H
+#define TESTPEARSONCORRELATION_H
+
+#include "PearsonCorrelation.h"
+
+#include <iostream>
+#include <cmath>
+
+
+class TestPearsonCorrelation
+{
+public:
+    TestPearsonCorrelation();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Correlate();
+
+    bool Test_CorrelateBlocks();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    /** Five passes, as the QC threshold used to compute it **/
+    double ComputePearsonCorrelation( const QList< double >& profile, const QList< double >& reference );
+
+    bool AreEqual( double value, double expectedValue );
+};
+
+#endif // TESTPEARSONCORRELATION_H
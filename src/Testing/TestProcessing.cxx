@@ -210,9 +210,12 @@ bool TestProcessing::Test_GetSubjectsFromData( QString adFilePath, QString subMa
     bool testADSubjects = adSubjects == expectedADSubjects;
     bool testSubMatrix0Subjects = subMatrix0Subjects == expectedSubMatrix0Subjects;
     bool testSubMatrix3Subjects = subMatrix3Subjects == expectedSubMatrix3Subjects;
+    bool testNumericData = processing.GetSubjectsFromData( processing.GetNumericDataFromFile( adFilePath ), 2 ) == expectedADSubjects &&
+            processing.GetSubjectsFromData( processing.GetNumericDataFromFile( subMatrix0FilePath ), 0 ) == expectedSubMatrix0Subjects &&
+            processing.GetSubjectsFromData( processing.GetNumericDataFromFile( subMatrix3FilePath ), 3 ) == expectedSubMatrix3Subjects;
 
 
-    bool testGetSubjectsFromData_Passed = testADSubjects && testSubMatrix0Subjects && testSubMatrix3Subjects;
+    bool testGetSubjectsFromData_Passed = testADSubjects && testSubMatrix0Subjects && testSubMatrix3Subjects && testNumericData;
     if( !testGetSubjectsFromData_Passed )
     {
         std::cerr << "/!\\/!\\ Test_GetSubjectsFromData() FAILED /!\\/!\\";
@@ -260,9 +263,11 @@ bool TestProcessing::Test_GetCovariatesFromFileData( QString subMatrix0FilePath,
 
     bool resultTest1 = covariates0 == covariatesExpected0;
     bool resultTest2 = covariates3 == covariatesExpected3;
+    bool resultTest3 = processing.GetCovariatesFromData( processing.GetNumericDataFromFile( subMatrix0FilePath ), 0 ) == covariatesExpected0 &&
+            processing.GetCovariatesFromData( processing.GetNumericDataFromFile( subMatrix3FilePath ), 3 ) == covariatesExpected3;
 
 
-    bool testGetCovariatesFromFileData_Passed = resultTest1 && resultTest2;
+    bool testGetCovariatesFromFileData_Passed = resultTest1 && resultTest2 && resultTest3;
     if( !testGetCovariatesFromFileData_Passed )
     {
         std::cerr << "/!\\/!\\ Test_GetCovariatesFromFileData() FAILED /!\\/!\\";
@@ -389,60 +394,7 @@ bool TestProcessing::Test_GetSubjectsFromSelectedFiles()
     return testGetSubjectsFromSelectedFiles_Passed;
 }
 
-bool TestProcessing::Test_SortSubjects()
-{
-    Processing processing;
-    QStringList loadedSubjects = QStringList() << "Stan" << "Kyle" << "Kenny" << "Cartman";
-    loadedSubjects.sort();
-    QStringList subjectsInAll = QStringList() << "neo-0004-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0011-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0012-2_dwi_35_all_QCed_VC_DTI_embed"
-                                              << "neo-0019-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0029-3_dwi_35_all_QCed_VC_DTI_embed" << "neo-0038-2_dwi_35_all_QCed_VC_DTI_embed"
-                                              << "neo-0042-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0066-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0071-1_dwi_35_all_QCed_VC_DTI_embed"
-                                              << "neo-0087-1_dwi_35_all_QCed_VC_DTI_embed" << loadedSubjects;
-    subjectsInAll.sort();
-    QStringList allSubjects = QStringList() << subjectsInAll << loadedSubjects << "randomSubject_ad" << "randomSubject_COMP_3";
-    allSubjects.sort();
-    QStringList adSubjects = QStringList() << "neo-0004-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0011-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0012-2_dwi_35_all_QCed_VC_DTI_embed"
-                                           << "neo-0019-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0029-3_dwi_35_all_QCed_VC_DTI_embed" << "neo-0038-2_dwi_35_all_QCed_VC_DTI_embed"
-                                           << "neo-0042-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0066-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0071-1_dwi_35_all_QCed_VC_DTI_embed"
-                                           << "neo-0087-1_dwi_35_all_QCed_VC_DTI_embed" << "randomSubject_ad";
-    adSubjects.sort();
-    QStringList subMatrixSubjects = QStringList() << "neo-0004-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0011-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0012-2_dwi_35_all_QCed_VC_DTI_embed"
-                                                  << "neo-0019-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0029-3_dwi_35_all_QCed_VC_DTI_embed" << "neo-0038-2_dwi_35_all_QCed_VC_DTI_embed"
-                                                  << "neo-0042-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0066-2-1_dwi_35_all_QCed_VC_DTI_embed" << "neo-0071-1_dwi_35_all_QCed_VC_DTI_embed"
-                                                  << "neo-0087-1_dwi_35_all_QCed_VC_DTI_embed" << "randomSubject_COMP_3";
-    subMatrixSubjects.sort();
-    QMap< int, QStringList > selectedSubjects;
-    selectedSubjects.insert( -1, loadedSubjects );
-    selectedSubjects.insert( 0, adSubjects );
-    selectedSubjects.insert( 4, subMatrixSubjects );
-    QMap< QString, QMap< int, bool > > expectedSortedSubjects;
-    foreach( QString subj, allSubjects )
-    {
-        ( expectedSortedSubjects[subj] )[-1] = loadedSubjects.contains( subj ) ? true : false;
-        ( expectedSortedSubjects[subj] )[0] = adSubjects.contains( subj ) ? true : false;
-        ( expectedSortedSubjects[subj] )[4] = subMatrixSubjects.contains( subj ) ? true : false;
-    }
-    QMap< QString, QMap< int, bool > > sortedSubjects = processing.SortSubjects( allSubjects, selectedSubjects );
-
-
-    bool testSortSubjects_Passed = sortedSubjects == expectedSortedSubjects;
-    if( !testSortSubjects_Passed )
-    {
-        std::cerr << "/!\\/!\\ Test_SortSubjects() FAILED /!\\/!\\";
-        //        std::cerr << "\t+ pb with SortSubjects( const QStringList subjects, const QMap< int, QStringList > subjectsMap )" << std::endl;
-        //        std::cerr << "\t+ Incorrect sorted subject list generated" << std::endl;
-        //        std::cerr << "\t  Diffusion property (index: ad <-> 0, rd <-> 1, md <-> 2, fa <-> 3, subMatrix <-> 4)" << std::endl;
-        //        DisplayError_SortedSubjects( expectedSortedSubjects, sortedSubjects );
-    }
-    else
-    {
-        std::cerr << "Test_SortSubjects() PASSED";
-    }
-
-    return testSortSubjects_Passed;
-}
-
-bool TestProcessing::Test_AssignSortedSubject()
+bool TestProcessing::Test_MatchSubjects()
 {
     Processing processing;
     QStringList loadedSubjects = QStringList() << "neo-0004-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0011-2_dwi_35_all_QCed_VC_DTI_embed" << "neo-0012-2_dwi_35_all_QCed_VC_DTI_embed"
@@ -471,7 +423,6 @@ bool TestProcessing::Test_AssignSortedSubject()
     selectedSubjects.insert( -1, loadedSubjects );
     selectedSubjects.insert( 0, adSubjects );
     selectedSubjects.insert( 4, subMatrixSubjects );
-    QMap< QString, QMap< int, bool > > sortedSubjects = processing.SortSubjects( allSubjects, selectedSubjects );
     QMap< QString, QList< int > > expectedUnMatchedSubjects;
     QStringList expectedMatchedSubjects;
     QStringList matchedSubjects;
@@ -503,18 +454,18 @@ bool TestProcessing::Test_AssignSortedSubject()
         }
     }
 
-    processing.AssignSortedSubject( sortedSubjects, matchedSubjects, unMatchedSubjects );
+    processing.MatchSubjects( allSubjects, selectedSubjects, matchedSubjects, unMatchedSubjects );
 
 
     bool testMatchedSubjects = matchedSubjects == expectedMatchedSubjects;
     bool testUnMatchedSubjects = unMatchedSubjects == expectedUnMatchedSubjects;
 
 
-    bool testAssignSortedSubject_Passed = testMatchedSubjects && testUnMatchedSubjects;
-    if( !testAssignSortedSubject_Passed )
+    bool testMatchSubjects_Passed = testMatchedSubjects && testUnMatchedSubjects;
+    if( !testMatchSubjects_Passed )
     {
-        std::cerr << "/!\\/!\\ Test_AssignSortedSubject() FAILED /!\\/!\\";
-        //        std::cerr << "\t+ pb with AssignSortedSubject( const QMap< QString, QMap< int, bool > > sortedSubjects,"
+        std::cerr << "/!\\/!\\ Test_MatchSubjects() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with MatchSubjects( const QStringList& allSubjectsList, const QMap< int, QStringList >& allSubjects,"
         //                     " QStringList& matchedSubjects, QMap< QString, QList< int > >& unMatchedSubjects )" << std::endl;
         //        if( !testMatchedSubjects )
         //        {
@@ -530,10 +481,10 @@ bool TestProcessing::Test_AssignSortedSubject()
     }
     else
     {
-        std::cerr << "Test_AssignSortedSubject() PASSED";
+        std::cerr << "Test_MatchSubjects() PASSED";
     }
 
-    return testAssignSortedSubject_Passed;
+    return testMatchSubjects_Passed;
 }
 
 
@@ -779,6 +730,36 @@ bool TestProcessing::Test_GenerateMatlabInputFiles( QString adFilePath, QString
                                                                                   covariatesTest2, covariatesColumnIdTest2, subjects, -1, -1 );
 
 
+    /************************************************/
+    /******************** Test 3 ********************/
+    /************************************************/
+    // Last arc length beyond the file: same file as without limit
+    QMap< int, QString > filesTest3;
+    filesTest3.insert( 0, adFilePath );
+    QMap< int, QString > propertiesTest3;
+    propertiesTest3.insert( 0, "ad" );
+
+    QMap< int, QString > matlabInputFilesTest3 = processing.GenerateMatlabInputs( dirTest, "GenerateMatlabInputsTest3", filesTest3, propertiesTest3,
+                                                                                  covariatesTest1, covariatesColumnIdTest1, subjects, -1, 100000 );
+    bool endProfileClamped = CompareFile( adMatlabFilePath, matlabInputFilesTest3.value( 0 ) );
+
+
+    /************************************************/
+    /******************** Test 4 ********************/
+    /************************************************/
+    // Input that cannot be read: its file left out, the others still generated
+    QMap< int, QString > filesTest4;
+    filesTest4.insert( 0, adFilePath );
+    filesTest4.insert( 1, dirTest + "/missing.csv" );
+    QMap< int, QString > propertiesTest4;
+    propertiesTest4.insert( 0, "ad" );
+    propertiesTest4.insert( 1, "rd" );
+
+    QMap< int, QString > matlabInputFilesTest4 = processing.GenerateMatlabInputs( dirTest, "GenerateMatlabInputsTest4", filesTest4, propertiesTest4,
+                                                                                  covariatesTest1, covariatesColumnIdTest1, subjects, -1, -1 );
+    bool failedInputOmitted = matlabInputFilesTest4.keys() == ( QList< int >() << 0 ) && CompareFile( adMatlabFilePath, matlabInputFilesTest4.value( 0 ) );
+
+
     QMap< int, QString >::ConstIterator iterMatlabInputTest1 = matlabInputFilesTest1.cbegin();
     while( iterMatlabInputTest1 != matlabInputFilesTest1.cend() )
     {
@@ -810,7 +791,7 @@ bool TestProcessing::Test_GenerateMatlabInputFiles( QString adFilePath, QString
     }
 
 
-    bool testGenerateMatlabInputs_Passed = adFilesMatched && subMatrix0FileFilesMatched && subMatrix3FileFilesMatched;
+    bool testGenerateMatlabInputs_Passed = adFilesMatched && subMatrix0FileFilesMatched && subMatrix3FileFilesMatched && endProfileClamped && failedInputOmitted;
     if( !testGenerateMatlabInputs_Passed )
     {
         std::cerr << "/!\\/!\\ Test_GenerateMatlabInputs() FAILED /!\\/!\\";
@@ -829,6 +810,10 @@ bool TestProcessing::Test_GenerateMatlabInputFiles( QString adFilePath, QString
         //        {
         //            std::cerr << "\t  batlab input for subMatrix file not generated correctly when subjects not on 1st column" << std::endl;
         //        }
+        //        if( !endProfileClamped )
+        //        {
+        //            std::cerr << "\t  rows added to the matlab input when the last arc length is beyond the file" << std::endl;
+        //        }
     }
     else
     {
@@ -838,6 +823,62 @@ bool TestProcessing::Test_GenerateMatlabInputFiles( QString adFilePath, QString
     return testGenerateMatlabInputs_Passed;
 }
 
+bool TestProcessing::Test_StreamingIngest( QString adFilePath, QString subMatrix0FilePath, QString adMatlabFilePath,
+                                           QString subMatrix0MatlabFilePath, QString subjectsFilePath, QString outputDir )
+{
+    Processing processing;
+    QString dirTest = outputDir + "/TestProcessing/Test_StreamingIngest";
+    QDir().mkpath( dirTest );
+    QStringList subjects = processing.GetSubjectsFromFileList( subjectsFilePath );
+    QMap< int, QString > files;
+    files.insert( 0, adFilePath );
+    files.insert( 4, subMatrix0FilePath );
+    QMap< int, QString > properties;
+    properties.insert( 0, "ad" );
+    properties.insert( 4, "subMatrix" );
+    QMap< int, QString > covariates;
+    covariates.insert( -1, "Intercept" );
+    covariates.insert( 1, "Gender" );
+    covariates.insert( 2, "DaysSinceBirth" );
+    covariates.insert( 3, "Scanner" );
+
+
+    bool testSetStreamingIngest = !processing.IsStreamingIngest();
+    processing.SetStreamingIngest( true );
+    testSetStreamingIngest = testSetStreamingIngest && processing.IsStreamingIngest();
+
+    /** Same inputs as Test_GenerateMatlabInputFiles(), test 1 **/
+    QMap< int, QString > matlabInputFiles = processing.GenerateMatlabInputs( dirTest, "StreamingIngestTest", files, properties,
+                                                                             covariates, 0, subjects, -1, -1 );
+    /** Cells copied as written: same files as the whole files read **/
+    bool testProfileFile = matlabInputFiles.keys() == files.keys() && CompareFile( adMatlabFilePath, matlabInputFiles.value( 0 ) );
+    bool testSubMatrixFile = CompareFile( subMatrix0MatlabFilePath, matlabInputFiles.value( 4 ) );
+
+    QStringList adSubjects = processing.GetSubjectsFromProfileFile( adFilePath );
+    DiffusionProfileMatrix::ConstPointer profileData = processing.GetSelectedProfileDataFromFile( adFilePath, subjects );
+    bool testProfileData = adSubjects == processing.GetSubjectsFromData( processing.GetNumericDataFromFile( adFilePath ), 0 ) &&
+            profileData->GetNbrArcLengths() == processing.GetProfileDataFromFile( adFilePath )->GetNbrArcLengths() &&
+            profileData->GetNbrSubjects() <= subjects.size() + 1;
+    foreach( QString subject, profileData->GetSubjects() )
+    {
+        testProfileData = testProfileData && ( subjects.contains( subject ) || subject.contains( "atlas", Qt::CaseInsensitive ) );
+    }
+
+
+    bool testStreamingIngest_Passed = testSetStreamingIngest && testProfileFile && testSubMatrixFile && testProfileData;
+    if( !testStreamingIngest_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_StreamingIngest() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GenerateMatlabInputs() when SetStreamingIngest( true )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_StreamingIngest() PASSED";
+    }
+
+    return testStreamingIngest_Passed;
+}
+
 
 
 /**********************************************************************/
@@ -884,39 +925,6 @@ void TestProcessing::DisplayError_GetSubjectsFromSelectedFiles( QMap< int, QStri
     }
 }
 
-void TestProcessing::DisplayError_SortedSubjects( QMap< QString, QMap< int, bool > > expectedSortedSubjects, QMap< QString, QMap< int, bool > > sortedSubjects )
-{
-    QMap< QString, QMap< int, bool > >::ConstIterator iterExpectedSortedSubjects = expectedSortedSubjects.cbegin();
-    std::cerr << "\t  - sorted subjects expected" << std::endl;
-    while( iterExpectedSortedSubjects != expectedSortedSubjects.cend() )
-    {
-        std::cerr << "\t      " << iterExpectedSortedSubjects.key().toStdString() << " --> ";
-        QMap< int, bool >::ConstIterator iterExpectedFile = iterExpectedSortedSubjects.value().cbegin();
-        while( iterExpectedFile != iterExpectedSortedSubjects.value().cend() )
-        {
-            std::cerr << " index: " << iterExpectedFile.key() << " [" << ( iterExpectedFile.value() == 1 ? "True" : "False" ) << "]";
-            ++iterExpectedFile;
-        }
-        std::cerr << std::endl;
-        ++iterExpectedSortedSubjects;
-    }
-
-    QMap< QString, QMap< int, bool > >::ConstIterator iterSortedSubjects = sortedSubjects.cbegin();
-    std::cerr << "\t  - sorted subjects displayed" << std::endl;
-    while( iterSortedSubjects != sortedSubjects.cend() )
-    {
-        std::cerr << "\t      " << iterSortedSubjects.key().toStdString() << " --> ";
-        QMap< int, bool >::ConstIterator iterFile = iterSortedSubjects.value().cbegin();
-        while( iterFile != iterSortedSubjects.value().cend() )
-        {
-            std::cerr << " index: " << iterFile.key() << " [" << ( iterFile.value() == 1 ? "True" : "False" ) << "]";
-            ++iterFile;
-        }
-        std::cerr << std::endl;
-        ++iterSortedSubjects;
-    }
-}
-
 void TestProcessing::DisplayError_UnMatchedSubjects( QMap< QString, QList< int > > unMatchedSubjectsExpected, QMap< QString, QList< int > > unMatchedSubjectsDisplayed )
 {
     QMap< QString, QList< int > >::ConstIterator iterExpectedUnMatched = unMatchedSubjectsExpected.cbegin();
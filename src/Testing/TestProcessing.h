@@ -2,9 +2,11 @@
 #define TESTPROCESSING_H
 
 #include "Processing.h"
+#include "CSVReader.h"
 
 #include <QDir>
 #include <QCryptographicHash>
+#include <QLocale>
 #include <QSet>
 
 #include <iostream>
@@ -50,14 +52,15 @@ public:
 
     bool Test_GetSubjectsFromSelectedFiles();
 
-    bool Test_SortSubjects();
-
-    bool Test_AssignSortedSubject();
+    bool Test_MatchSubjects();
 
 
     bool Test_GenerateMatlabInputFiles( QString adFilePath, QString subMatrix0FilePath, QString subMatrix3FilePath, QString adMatlabFilePath,
                                         QString subMatrix0MatlabFilePath, QString subjectsFilePath, QString outputDir );
 
+    bool Test_StreamingIngest( QString adFilePath, QString subMatrix0FilePath, QString adMatlabFilePath,
+                               QString subMatrix0MatlabFilePath, QString subjectsFilePath, QString outputDir );
+
 
 private:
     /**********************************************************************/
@@ -67,8 +70,6 @@ private:
 
     void DisplayError_GetSubjectsFromSelectedFiles( QMap< int, QStringList > expectedSubjects, QMap< int, QStringList > selectedSubjects );
 
-    void DisplayError_SortedSubjects( QMap< QString, QMap< int, bool > > expectedSortedSubjects, QMap< QString, QMap< int, bool > > sortedSubjects );
-
     void DisplayError_UnMatchedSubjects( QMap< QString, QList< int > > unMatchedSubjectsExpected, QMap< QString, QList< int > > unMatchedSubjectsDisplayed );
 
     void DisplayError_GetCovariates( QMap< int, QString > covariatesExpected, QMap< int, QString > covariatesDisplayed );
@@ -0,0 +1,161 @@
+#include "TestQCThreshold.h"
+
+TestQCThreshold::TestQCThreshold()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestQCThreshold::Test_Correlate()
+{
+    DiffusionProfileMatrix::ConstPointer rawData = GetProfileData( QStringList() << "Marcus Paige" << "Brice Johnson" << "Joel Berry II",
+                                                                   QList< bool >() << true << false << true );
+    QSet< int > subjectIDs = SubjectRegistry::GetInstance().GetIDSet( QStringList() << "Joel Berry II" << "Brice Johnson" << "Kennedy Meeks" );
+    QVector< int > subjectIndexes;
+
+
+    QVector< double > correlations = QCThreshold::Correlate( *rawData, true, QCThresholdReference(), subjectIDs, subjectIndexes, 1 );
+    bool testAtlas = subjectIndexes == ( QVector< int >() << 1 << 2 ) && correlations.size() == 2 &&
+            qAbs( correlations.at( 0 ) + 1 ) < 1e-8 && qAbs( correlations.at( 1 ) - 1 ) < 1e-8;
+
+    /** Mean of the subjects checked only, Marcus Paige left out: it goes up as Joel Berry II **/
+    correlations = QCThreshold::Correlate( *rawData, false, QCThresholdReference(), subjectIDs, subjectIndexes, 0 );
+    bool testMean = subjectIndexes == ( QVector< int >() << 1 << 2 ) && correlations.size() == 2 &&
+            qAbs( correlations.at( 0 ) + 1 ) < 1e-8 && qAbs( correlations.at( 1 ) - 1 ) < 1e-8;
+
+    /** Median of the 3 subjects: 0.3, 0.4, 0.3, 0.4, 0.5, no longer a straight line as their mean **/
+    QCThresholdReference medianReference;
+    medianReference.SetType( QCThresholdReference::Median );
+    QCThreshold qcThreshold;
+    qcThreshold.SetReference( medianReference );
+    QSet< int > allSubjectIDs = SubjectRegistry::GetInstance().GetIDSet( QStringList() << "Marcus Paige" << "Brice Johnson" << "Joel Berry II" );
+    correlations = QCThreshold::Correlate( *rawData, false, qcThreshold.GetReference(), allSubjectIDs, subjectIndexes, 0 );
+    double expectedCorrelation = 0.4 / std::sqrt( 0.28 );
+    bool testMedian = correlations.size() == 3 && qAbs( correlations.at( 0 ) - expectedCorrelation ) < 1e-8 &&
+            qAbs( correlations.at( 1 ) + expectedCorrelation ) < 1e-8 && qAbs( correlations.at( 2 ) - expectedCorrelation ) < 1e-8;
+
+    QCThreshold::Rule rule = QCThreshold::AnyFail;
+    bool testRule = QCThreshold::GetRule( "allFail", rule ) && rule == QCThreshold::AllFail && QCThreshold::GetRule( "ANYFAIL", rule ) && rule == QCThreshold::AnyFail &&
+            !QCThreshold::GetRule( "noneFail", rule ) && QCThreshold::GetRuleName( QCThreshold::AllFail ) == "allFail";
+
+    /** Functional PCA outlier scores: same subjects, the atlas not used **/
+    FunctionalPCA functionalPCA;
+    functionalPCA.SetNbrComponents( 1 );
+    qcThreshold.SetFunctionalPCA( functionalPCA );
+    qcThreshold.SetMetric( QCThreshold::FPCA );
+    QVector< double > scores = QCThreshold::Score( *rawData, qcThreshold.GetFunctionalPCA(), subjectIDs, subjectIndexes, 0 );
+    bool testScore = subjectIndexes == ( QVector< int >() << 1 << 2 ) && scores.size() == 2 &&
+            scores.at( 0 ) >= 0 && scores.at( 0 ) <= 1 && scores.at( 1 ) >= 0 && scores.at( 1 ) <= 1 &&
+            qcThreshold.GetMetric() == QCThreshold::FPCA && qcThreshold.GetFunctionalPCA().GetNbrComponents() == 1;
+
+    QCThreshold::Metric metric = QCThreshold::Correlation;
+    bool testMetric = QCThreshold::GetMetric( "FPCA", metric ) && metric == QCThreshold::FPCA && QCThreshold::GetMetric( "correlation", metric ) && metric == QCThreshold::Correlation &&
+            !QCThreshold::GetMetric( "distance", metric ) && QCThreshold::GetMetricName( QCThreshold::FPCA ) == "fpca" &&
+            QCThreshold::GetDefaultFPCAQCThreshold() == 0.01;
+
+
+    bool testCorrelate_Passed = testAtlas && testMean && testMedian && testRule && testScore && testMetric;
+    if( !testCorrelate_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Correlate() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Correlate( const DiffusionProfileMatrix& rawData, bool useAtlas, const QCThresholdReference& reference, const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads )" << std::endl;
+        //        std::cerr << "\t  and/or Score( const DiffusionProfileMatrix& rawData, const FunctionalPCA& functionalPCA, const QSet< int >& subjectIDs, QVector< int >& subjectIndexes, int nbrThreads )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Correlate() PASSED";
+    }
+
+    return testCorrelate_Passed;
+}
+
+bool TestQCThreshold::Test_Apply()
+{
+    /** S1 passes both, S2 fails FA, S3 fails MD, S4 fails both, S5 only in FA, S6 in no file **/
+    QStringList subjects = QStringList() << "S1" << "S2" << "S3" << "S4" << "S5" << "S6";
+    DiffusionProfileMatrix::ConstPointer faData = GetProfileData( subjects.mid( 0, 5 ), QList< bool >() << true << false << true << false << true );
+    DiffusionProfileMatrix::ConstPointer mdData = GetProfileData( subjects.mid( 0, 4 ), QList< bool >() << true << true << false << false );
+    QCThreshold qcThreshold;
+    qcThreshold.SetNbrThreads( 2 );
+    qcThreshold.AddProperty( "FA", faData, 0.5, 0, true );
+    qcThreshold.AddProperty( "MD", mdData, 0.2, 0, true );
+
+
+    qcThreshold.Apply( subjects );
+    bool testProperties = qcThreshold.GetProperties() == ( QStringList() << "FA" << "MD" ) && qcThreshold.GetQCThreshold( "MD" ) == 0.2 &&
+            qcThreshold.GetQCThreshold( "RD" ) == -1 &&
+            qcThreshold.GetSubjectsNotCorrelated( "FA" ) == ( QStringList() << "S2" << "S4" ) &&
+            qcThreshold.GetSubjectsNotCorrelated( "MD" ) == ( QStringList() << "S3" << "S4" );
+
+    bool testAnyFail = qcThreshold.GetRule() == QCThreshold::AnyFail &&
+            qcThreshold.GetSubjectsNotCorrelated() == ( QStringList() << "S2" << "S3" << "S4" ) &&
+            qcThreshold.GetSubjectsCorrelated() == ( QStringList() << "S1" << "S5" << "S6" );
+
+    qcThreshold.SetRule( QCThreshold::AllFail );
+    bool testAllFail = qcThreshold.GetSubjectsNotCorrelated() == ( QStringList() << "S4" ) &&
+            qcThreshold.GetSubjectsCorrelated() == ( QStringList() << "S1" << "S2" << "S3" << "S5" << "S6" );
+
+    /** Result of a property set by the dialog, subjects missing from its file ignored **/
+    qcThreshold.SetRule( QCThreshold::AnyFail );
+    qcThreshold.SetSubjectsNotCorrelated( "MD", 0.9, QStringList() << "S1" << "S5" );
+    bool testSetSubjectsNotCorrelated = qcThreshold.GetQCThreshold( "MD" ) == 0.9 && qcThreshold.GetSubjectsNotCorrelated( "MD" ) == ( QStringList() << "S1" ) &&
+            qcThreshold.GetSubjectsNotCorrelated() == ( QStringList() << "S1" << "S2" << "S4" );
+
+    /** Outlier scores compared to their own thresholds, nobody under 0: the correlation thresholds kept for later **/
+    qcThreshold.SetMetric( QCThreshold::FPCA );
+    qcThreshold.Apply( subjects );
+    bool testFPCAQCThreshold = qcThreshold.GetSubjectsNotCorrelated().isEmpty() && qcThreshold.GetQCThreshold( "MD" ) == 0 &&
+            qcThreshold.GetQCThreshold( "MD", QCThreshold::Correlation ) == 0.9;
+    qcThreshold.SetSubjectsNotCorrelated( "FA", 0.05, QStringList() << "S3" );
+    testFPCAQCThreshold = testFPCAQCThreshold && qcThreshold.GetQCThreshold( "FA", QCThreshold::FPCA ) == 0.05 &&
+            qcThreshold.GetQCThreshold( "FA", QCThreshold::Correlation ) == 0.5 && qcThreshold.GetSubjectsNotCorrelated() == ( QStringList() << "S3" );
+
+    /** Results of a copy applied with other subjects taken back, the threshold set meanwhile kept **/
+    QCThreshold appliedQCThreshold = qcThreshold;
+    appliedQCThreshold.SetMetric( QCThreshold::Correlation );
+    appliedQCThreshold.Apply( QStringList() << "S1" << "S2" << "S3" );
+    qcThreshold.SetSubjectsNotCorrelated( "FA", 0.06, QStringList() );
+    qcThreshold.SetResults( appliedQCThreshold );
+    bool testSetResults = qcThreshold.GetSubjectsNotCorrelated() == ( QStringList() << "S2" << "S3" ) &&
+            qcThreshold.GetSubjectsCorrelated() == ( QStringList() << "S1" ) && qcThreshold.GetQCThreshold( "FA" ) == 0.06;
+
+    qcThreshold.Clear();
+    bool testClear = qcThreshold.GetProperties().isEmpty() && qcThreshold.GetSubjectsCorrelated().isEmpty();
+
+
+    bool testApply_Passed = testProperties && testAnyFail && testAllFail && testSetSubjectsNotCorrelated && testFPCAQCThreshold && testSetResults && testClear;
+    if( !testApply_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Apply() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Apply( const QStringList& subjects ) and/or the rules combining the properties" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Apply() PASSED";
+    }
+
+    return testApply_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+DiffusionProfileMatrix::ConstPointer TestQCThreshold::GetProfileData( const QStringList& subjects, const QList< bool >& isGoingUp )
+{
+    QStringList rows = QStringList() << "arclength;" + subjects.join( ";" ) + ";Atlas";
+    for( int arcLength = 0; arcLength < 5; arcLength++ )
+    {
+        QStringList row = QStringList() << QString::number( arcLength );
+        for( int i = 0; i < subjects.size(); i++ )
+        {
+            row.append( QString::number( isGoingUp.at( i ) ? 0.1 * ( arcLength + 1 ) * ( i + 1 ) : 0.1 * ( 5 - arcLength ) ) );
+        }
+        row.append( QString::number( 0.5 + 0.05 * arcLength ) );
+        rows.append( row.join( ";" ) );
+    }
+
+    return DiffusionProfileMatrix::ConstPointer( new DiffusionProfileMatrix( CSVReader( ";" ).ReadContent( rows.join( "\n" ).toUtf8() ) ) );
+}
@@ -0,0 +1,33 @@
+#ifndef TESTQCTHRESHOLD_H
+#define TESTQCTHRESHOLD_H
+
+#include "QCThreshold.h"
+#include "CSVReader.h"
+#include "SubjectRegistry.h"
+
+#include <iostream>
+#include <cmath>
+
+
+class TestQCThreshold
+{
+public:
+    TestQCThreshold();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Correlate();
+
+    bool Test_Apply();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    /** Profiles going up correlate at 1 with the atlas, the ones going down at -1 **/
+    DiffusionProfileMatrix::ConstPointer GetProfileData( const QStringList& subjects, const QList< bool >& isGoingUp );
+};
+
+#endif // TESTQCTHRESHOLD_H
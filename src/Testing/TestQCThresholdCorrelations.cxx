@@ -0,0 +1,95 @@
+#include "TestQCThresholdCorrelations.h"
+
+TestQCThresholdCorrelations::TestQCThresholdCorrelations()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestQCThresholdCorrelations::Test_SetCorrelations()
+{
+    double nan = std::numeric_limits< double >::quiet_NaN();
+    QVector< double > correlations = QVector< double >() << 0.9 << 0.2 << nan << 0.75 << 0.2 << 0.99;
+    QCThresholdCorrelations qcThresholdCorrelations;
+
+
+    bool testEmpty = qcThresholdCorrelations.IsEmpty() && qcThresholdCorrelations.GetNbrLines() == 0 && qcThresholdCorrelations.GetNbrNotCorrelated( 0.5 ) == 0;
+
+    qcThresholdCorrelations.SetCorrelations( correlations );
+    bool testCorrelations = !qcThresholdCorrelations.IsEmpty() && qcThresholdCorrelations.GetNbrLines() == 6 &&
+            qcThresholdCorrelations.GetCorrelation( 3 ) == 0.75 &&
+            qcThresholdCorrelations.m_sortedLines == ( QVector< int >() << 1 << 4 << 3 << 0 << 5 );
+
+    /** Same comparison as the QC threshold: a line with a correlation equal to the threshold satisfies it, a NaN always does **/
+    bool testIsCorrelated = qcThresholdCorrelations.IsCorrelated( 0, 0.9 ) && !qcThresholdCorrelations.IsCorrelated( 3, 0.8 ) &&
+            qcThresholdCorrelations.IsCorrelated( 2, 0.8 ) && qcThresholdCorrelations.IsCorrelated( 2, 1.0 );
+
+    bool testNbrNotCorrelated = qcThresholdCorrelations.GetNbrNotCorrelated( 0.2 ) == 0 && qcThresholdCorrelations.GetNbrNotCorrelated( 0.5 ) == 2 &&
+            qcThresholdCorrelations.GetNbrNotCorrelated( 0.9 ) == 3 && qcThresholdCorrelations.GetNbrNotCorrelated( 1.0 ) == 5;
+
+    qcThresholdCorrelations.Clear();
+    bool testClear = qcThresholdCorrelations.IsEmpty() && qcThresholdCorrelations.GetNbrNotCorrelated( 1.0 ) == 0;
+
+
+    bool testSetCorrelations_Passed = testEmpty && testCorrelations && testIsCorrelated && testNbrNotCorrelated && testClear;
+    if( !testSetCorrelations_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_SetCorrelations() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with SetCorrelations( const QVector< double >& correlations ), IsCorrelated( int line, double qcThreshold ) and/or GetNbrNotCorrelated( double qcThreshold )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_SetCorrelations() PASSED";
+    }
+
+    return testSetCorrelations_Passed;
+}
+
+bool TestQCThresholdCorrelations::Test_GetLinesCrossing()
+{
+    double nan = std::numeric_limits< double >::quiet_NaN();
+    QVector< double > correlations;
+    for( int line = 0; line < 1000; line++ )
+    {
+        correlations.append( line % 7 == 0 ? nan : ( ( line * 37 ) % 1000 ) / 1000.0 );
+    }
+    QCThresholdCorrelations qcThresholdCorrelations;
+    qcThresholdCorrelations.SetCorrelations( correlations );
+    QList< double > qcThresholds = QList< double >() << 0.5 << 0.52 << 0.3 << 0.3 << 0.995 << -1 << 0.7;
+
+
+    /** Lines crossing: the ones whose side changes between two thresholds, and only these **/
+    bool testCrossing = true;
+    for( int i = 1; i < qcThresholds.size(); i++ )
+    {
+        QList< int > expectedLines;
+        for( int line = 0; line < correlations.size(); line++ )
+        {
+            if( qcThresholdCorrelations.IsCorrelated( line, qcThresholds.at( i - 1 ) ) != qcThresholdCorrelations.IsCorrelated( line, qcThresholds.at( i ) ) )
+            {
+                expectedLines.append( line );
+            }
+        }
+        QList< int > lines = qcThresholdCorrelations.GetLinesCrossing( qcThresholds.at( i - 1 ), qcThresholds.at( i ) );
+        qSort( lines );
+        testCrossing = testCrossing && lines == expectedLines;
+    }
+
+    bool testSameThreshold = qcThresholdCorrelations.GetLinesCrossing( 0.3, 0.3 ).isEmpty();
+
+
+    bool testGetLinesCrossing_Passed = testCrossing && testSameThreshold;
+    if( !testGetLinesCrossing_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GetLinesCrossing() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetLinesCrossing( double previousQCThreshold, double qcThreshold )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_GetLinesCrossing() PASSED";
+    }
+
+    return testGetLinesCrossing_Passed;
+}
@@ -0,0 +1,23 @@
+#ifndef TESTQCTHRESHOLDCORRELATIONS_H
+#define TESTQCTHRESHOLDCORRELATIONS_H
+
+#include "QCThresholdCorrelations.h"
+
+#include <iostream>
+#include <limits>
+
+
+class TestQCThresholdCorrelations
+{
+public:
+    TestQCThresholdCorrelations();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetCorrelations();
+
+    bool Test_GetLinesCrossing();
+};
+
+#endif // TESTQCTHRESHOLDCORRELATIONS_H
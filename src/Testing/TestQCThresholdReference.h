@@ -0,0 +1,34 @@
+#ifndef TESTQCTHRESHOLDREFERENCE_H
+#define TESTQCTHRESHOLDREFERENCE_H
+
+#include "QCThresholdReference.h"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+
+class TestQCThresholdReference
+{
+public:
+    TestQCThresholdReference();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_GetType();
+
+    bool Test_Compute();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    QList< double > Compute( QCThresholdReference::Type type, const QList< QList< double > >& profiles );
+
+    bool AreEqual( const QList< double >& values, const QList< double >& expectedValues, double tolerance );
+};
+
+#endif // TESTQCTHRESHOLDREFERENCE_H
@@ -0,0 +1,171 @@
+#include "TestQCThresholdWorker.h"
+
+TestQCThresholdWorker::TestQCThresholdWorker()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestQCThresholdWorker::Test_Correlate()
+{
+    QList< double > reference;
+    QList< QList< double > > profiles;
+    GetProfiles( reference, profiles );
+    CroppedPearsonCorrelation croppedPearsonCorrelation;
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+    QCThresholdWorker qcThresholdWorker;
+
+
+    /** Computed in the calling thread **/
+    QVector< double > correlations = qcThresholdWorker.Correlate( reference, profiles, 0, reference.size() - 1 );
+    bool testCorrelate = AreEqual( correlations, croppedPearsonCorrelation.Correlate( 0, reference.size() - 1 ) ) &&
+            qcThresholdWorker.GetCorrelations() == correlations && !qcThresholdWorker.IsComputing();
+
+    /** Same profiles set in the worker thread **/
+    qcThresholdWorker.SetProfiles( reference, profiles, 10, 40 );
+    ProcessEvents( qcThresholdWorker );
+    bool testSetProfiles = AreEqual( qcThresholdWorker.GetCorrelations(), croppedPearsonCorrelation.Correlate( 10, 40 ) );
+
+    /** Profiles set then cropped before their running sums are computed: both kept **/
+    qcThresholdWorker.SetProfiles( reference, profiles.mid( 2 ), 0, 5 );
+    qcThresholdWorker.SetProfiles( reference, profiles.mid( 1 ), 0, 5 );
+    qcThresholdWorker.SetCropping( 20, 60 );
+    ProcessEvents( qcThresholdWorker );
+    bool testPendingProfiles = AreEqual( qcThresholdWorker.GetCorrelations(), croppedPearsonCorrelation.Correlate( 20, 60 ).mid( 1 ) );
+
+
+    bool testCorrelate_Passed = testCorrelate && testSetProfiles && testPendingProfiles;
+    if( !testCorrelate_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Correlate() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Correlate( const QList< double >& reference, const QList< QList< double > >& profiles, int first, int last ) and/or SetProfiles( ... )" << std::endl;
+        //        if( !testPendingProfiles )
+        //        {
+        //            std::cerr << "\t  profiles waiting for their running sums not kept when cropped" << std::endl;
+        //        }
+    }
+    else
+    {
+        std::cerr << "Test_Correlate() PASSED";
+    }
+
+    return testCorrelate_Passed;
+}
+
+bool TestQCThresholdWorker::Test_SetCropping()
+{
+    QList< double > reference;
+    QList< QList< double > > profiles;
+    GetProfiles( reference, profiles );
+    CroppedPearsonCorrelation croppedPearsonCorrelation;
+    croppedPearsonCorrelation.SetProfiles( reference, profiles );
+
+
+    /** Ignored without profiles **/
+    QCThresholdWorker emptyWorker;
+    emptyWorker.SetCropping( 0, 10 );
+    bool testNoProfiles = !emptyWorker.IsComputing() && emptyWorker.GetCorrelations().isEmpty();
+
+    /** Burst of windows: only the last one posted **/
+    QCThresholdWorker qcThresholdWorker;
+    qcThresholdWorker.Correlate( reference, profiles, 0, reference.size() - 1 );
+    for( int first = 0; first < 50; first++ )
+    {
+        qcThresholdWorker.SetCropping( first, first + 30 );
+    }
+    ProcessEvents( qcThresholdWorker );
+    bool testLastWindow = AreEqual( qcThresholdWorker.GetCorrelations(), croppedPearsonCorrelation.Correlate( 49, 79 ) );
+
+    /** Canceled: nothing posted **/
+    QVector< double > previousCorrelations = qcThresholdWorker.GetCorrelations();
+    qcThresholdWorker.SetCropping( 5, 15 );
+    qcThresholdWorker.SetCropping( 6, 16 );
+    qcThresholdWorker.Cancel();
+    ProcessEvents( qcThresholdWorker );
+    bool testCancel = qcThresholdWorker.GetCorrelations() == previousCorrelations;
+
+    /** Blocking wait, as before the subjects are sent **/
+    qcThresholdWorker.SetCropping( 100, 140 );
+    qcThresholdWorker.SetCropping( 90, 130 );
+    qcThresholdWorker.WaitForCorrelations();
+    bool testWait = !qcThresholdWorker.IsComputing() && AreEqual( qcThresholdWorker.GetCorrelations(), croppedPearsonCorrelation.Correlate( 90, 130 ) );
+
+    /** FPCA metric: outlier scores of the window, then correlations again from the running sums kept **/
+    FunctionalPCA functionalPCA;
+    qcThresholdWorker.SetMetric( QCThreshold::FPCA, functionalPCA );
+    qcThresholdWorker.SetCropping( 20, 120 );
+    ProcessEvents( qcThresholdWorker );
+    bool testFunctionalPCA = AreEqual( qcThresholdWorker.GetCorrelations(), functionalPCA.Score( profiles, 20, 120 ) );
+    qcThresholdWorker.SetMetric( QCThreshold::Correlation, functionalPCA );
+    qcThresholdWorker.SetCropping( 20, 120 );
+    ProcessEvents( qcThresholdWorker );
+    testFunctionalPCA = testFunctionalPCA && AreEqual( qcThresholdWorker.GetCorrelations(), croppedPearsonCorrelation.Correlate( 20, 120 ) );
+
+
+    bool testSetCropping_Passed = testNoProfiles && testLastWindow && testCancel && testWait && testFunctionalPCA;
+    if( !testSetCropping_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_SetCropping() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with SetCropping( int first, int last ), Cancel(), WaitForCorrelations() and/or SetMetric( QCThreshold::Metric metric, const FunctionalPCA& functionalPCA )" << std::endl;
+        //        if( !testLastWindow )
+        //        {
+        //            std::cerr << "\t  correlations posted not the ones of the last window" << std::endl;
+        //        }
+    }
+    else
+    {
+        std::cerr << "Test_SetCropping() PASSED";
+    }
+
+    return testSetCropping_Passed;
+}
+
+
+/**********************************************************************/
+/********************** Functions Used For Testing ********************/
+/**********************************************************************/
+void TestQCThresholdWorker::GetProfiles( QList< double >& reference, QList< QList< double > >& profiles )
+{
+    int nbrPoints = 150;
+    for( int point = 0; point < nbrPoints; point++ )
+    {
+        reference.append( 0.45 + 0.05 * std::sin( point * 0.07 ) );
+    }
+    for( int i = 0; i < 40; i++ )
+    {
+        QList< double > profile;
+        for( int point = 0; point < nbrPoints; point++ )
+        {
+            profile.append( 0.45 + 0.05 * std::sin( point * 0.07 + i * 0.1 ) + 0.002 * ( ( point * ( i + 3 ) ) % 11 ) );
+        }
+        profiles.append( profile );
+    }
+}
+
+bool TestQCThresholdWorker::AreEqual( const QVector< double >& correlations, const QVector< double >& expectedCorrelations )
+{
+    if( correlations.size() != expectedCorrelations.size() )
+    {
+        return false;
+    }
+    for( int i = 0; i < correlations.size(); i++ )
+    {
+        if( std::abs( correlations.at( i ) - expectedCorrelations.at( i ) ) > 1e-9 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestQCThresholdWorker::ProcessEvents( const QCThresholdWorker& qcThresholdWorker )
+{
+    while( qcThresholdWorker.IsComputing() )
+    {
+        QCoreApplication::processEvents( QEventLoop::AllEvents, 10 );
+    }
+    QCoreApplication::processEvents();
+}
@@ -0,0 +1,37 @@
+#ifndef TESTQCTHRESHOLDWORKER_H
+#define TESTQCTHRESHOLDWORKER_H
+
+#include "QCThresholdWorker.h"
+
+#include <QCoreApplication>
+
+#include <iostream>
+#include <cmath>
+
+
+class TestQCThresholdWorker
+{
+public:
+    TestQCThresholdWorker();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Correlate();
+
+    bool Test_SetCropping();
+
+
+private:
+    /**********************************************************************/
+    /********************** Functions Used For Testing ********************/
+    /**********************************************************************/
+    void GetProfiles( QList< double >& reference, QList< QList< double > >& profiles );
+
+    bool AreEqual( const QVector< double >& correlations, const QVector< double >& expectedCorrelations );
+
+    /** Waits for the worker in the event loop, as the dialog would **/
+    void ProcessEvents( const QCThresholdWorker& qcThresholdWorker );
+};
+
+#endif // TESTQCTHRESHOLDWORKER_H
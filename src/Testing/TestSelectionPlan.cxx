@@ -0,0 +1,86 @@
+#include "TestSelectionPlan.h"
+
+TestSelectionPlan::TestSelectionPlan()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestSelectionPlan::Test_Build()
+{
+    QStringList candidates = QStringList() << "arclength" << "Stan" << "Kyle" << "Stan" << "Kenny" << "Kyle";
+    QStringList selectedSubjects = QStringList() << "Kyle" << "Stan" << "Cartman";
+    SelectionPlan selectionPlan;
+
+
+    selectionPlan.Build( candidates, selectedSubjects, 1, true );
+    bool testDeduplicated = selectionPlan.GetIndices() == ( QVector< int >() << 1 << 2 ) && selectionPlan.GetNbrIndices() == 2;
+
+    selectionPlan.Build( candidates, selectedSubjects, 2, false );
+    bool testDuplicates = selectionPlan.GetIndices() == ( QVector< int >() << 2 << 3 << 5 );
+
+    selectionPlan.Build( candidates, QStringList(), 0, true );
+    bool testNoSubject = selectionPlan.GetNbrIndices() == 0;
+
+    /** More than 50,000 subjects: one pass over the candidates **/
+    QStringList manyCandidates;
+    QStringList manySelectedSubjects;
+    for( int i = 0; i < 50000; i++ )
+    {
+        manyCandidates.append( "Subj" + QString::number( i ) );
+        if( i % 2 == 0 )
+        {
+            manySelectedSubjects.prepend( "Subj" + QString::number( i ) );
+        }
+    }
+    manyCandidates.append( QStringList( manyCandidates ) );
+    selectionPlan.Build( manyCandidates, manySelectedSubjects, 0, true );
+    bool testManySubjects = selectionPlan.GetNbrIndices() == 25000 && selectionPlan.GetIndices().first() == 0 &&
+            selectionPlan.GetIndices().last() == 49998;
+
+
+    bool testBuild_Passed = testDeduplicated && testDuplicates && testNoSubject && testManySubjects;
+    if( !testBuild_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Build() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Build( const QStringList& candidates, const QStringList& selectedSubjects, int firstCandidate, bool isDeduplicated )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Build() PASSED";
+    }
+
+    return testBuild_Passed;
+}
+
+bool TestSelectionPlan::Test_Gather()
+{
+    SelectionPlan selectionPlan;
+    selectionPlan.Build( QStringList() << "Stan" << "Kyle" << "Kenny", QStringList() << "Kenny" << "Stan", 0, true );
+    QList< QStringList > rows = QList< QStringList >() << ( QStringList() << "Stan" << "1" )
+                                                       << ( QStringList() << "Kyle" << "2" )
+                                                       << ( QStringList() << "Kenny" << "3" );
+    QList< QStringList > expectedRows = QList< QStringList >() << ( QStringList() << "Stan" << "1" )
+                                                               << ( QStringList() << "Kenny" << "3" );
+
+
+    bool testGatherValues = selectionPlan.Gather( QStringList() << "a" << "b" << "c" ) == ( QStringList() << "a" << "c" );
+    bool testGatherRows = selectionPlan.Gather( rows ) == expectedRows;
+    bool testOutOfValues = selectionPlan.Gather( QStringList() << "a" ) == ( QStringList() << "a" << "" );
+
+
+    bool testGather_Passed = testGatherValues && testGatherRows && testOutOfValues;
+    if( !testGather_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Gather() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Gather( const QStringList& values ) and/or Gather( const QList< QStringList >& rows )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Gather() PASSED";
+    }
+
+    return testGather_Passed;
+}
@@ -0,0 +1,22 @@
+#ifndef TESTSELECTIONPLAN_H
+#define TESTSELECTIONPLAN_H
+
+#include "SelectionPlan.h"
+
+#include <iostream>
+
+
+class TestSelectionPlan
+{
+public:
+    TestSelectionPlan();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_Build();
+
+    bool Test_Gather();
+};
+
+#endif // TESTSELECTIONPLAN_H
@@ -0,0 +1,26 @@
+#ifndef TESTSUBJECTLISTMODEL_H
+#define TESTSUBJECTLISTMODEL_H
+
+#include "SubjectListModel.h"
+
+#include <QBrush>
+
+#include <iostream>
+
+
+class TestSubjectListModel
+{
+public:
+    TestSubjectListModel();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetSubjects();
+
+    bool Test_InsertRemoveSubject();
+
+    bool Test_CheckState();
+};
+
+#endif // TESTSUBJECTLISTMODEL_H
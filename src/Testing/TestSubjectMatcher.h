@@ -0,0 +1,22 @@
+#ifndef TESTSUBJECTMATCHER_H
+#define TESTSUBJECTMATCHER_H
+
+#include "SubjectMatcher.h"
+
+#include <iostream>
+
+
+class TestSubjectMatcher
+{
+public:
+    TestSubjectMatcher();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_SetSubjects();
+
+    bool Test_Match();
+};
+
+#endif // TESTSUBJECTMATCHER_H
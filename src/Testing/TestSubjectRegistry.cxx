@@ -0,0 +1,105 @@
+#include "TestSubjectRegistry.h"
+
+TestSubjectRegistry::TestSubjectRegistry()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestSubjectRegistry::Test_GetID()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    int nbrSubjects = registry.GetNbrSubjects();
+
+
+    int idStan = registry.GetID( "Test_GetID_Stan" );
+    int idKyle = registry.GetID( "Test_GetID_Kyle" );
+    bool testGetID = &registry == &SubjectRegistry::GetInstance() && idStan == nbrSubjects && idKyle == nbrSubjects + 1 &&
+            registry.GetID( "Test_GetID_Stan" ) == idStan && registry.GetNbrSubjects() == nbrSubjects + 2;
+
+    bool testFindID = registry.FindID( "Test_GetID_Kyle" ) == idKyle && registry.FindID( "Test_GetID_Kenny" ) == -1 &&
+            registry.GetNbrSubjects() == nbrSubjects + 2;
+
+    bool testGetName = registry.GetName( idStan ) == "Test_GetID_Stan" && registry.GetName( -1 ).isNull() &&
+            registry.GetName( registry.GetNbrSubjects() ).isNull();
+
+
+    bool testGetID_Passed = testGetID && testFindID && testGetName;
+    if( !testGetID_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GetID() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetID( const QString& subject ), FindID( const QString& subject ) and/or GetName( int id )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_GetID() PASSED";
+    }
+
+    return testGetID_Passed;
+}
+
+bool TestSubjectRegistry::Test_GetIDs()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QStringList subjects = QStringList() << "Test_GetIDs_Stan" << "Test_GetIDs_Kyle" << "Test_GetIDs_Stan";
+
+
+    QVector< int > ids = registry.GetIDs( subjects );
+    bool testGetIDs = ids.size() == 3 && ids.at( 0 ) == ids.at( 2 ) && ids.at( 0 ) != ids.at( 1 ) &&
+            ids.at( 1 ) == registry.FindID( "Test_GetIDs_Kyle" );
+
+    bool testGetNames = registry.GetNames( ids ) == subjects && registry.GetNames( QVector< int >() << -1 ).first().isNull();
+
+    QSet< int > idSet = registry.GetIDSet( subjects );
+    bool testGetIDSet = idSet.size() == 2 && idSet.contains( ids.at( 0 ) ) && idSet.contains( ids.at( 1 ) );
+
+    QStringList remainingSubjects = registry.Exclude( subjects << "Test_GetIDs_Kenny", QSet< int >() << ids.at( 0 ) );
+    bool testExclude = remainingSubjects == ( QStringList() << "Test_GetIDs_Kyle" << "Test_GetIDs_Kenny" ) &&
+            registry.FindID( "Test_GetIDs_Kenny" ) == -1;
+
+
+    bool testGetIDs_Passed = testGetIDs && testGetNames && testGetIDSet && testExclude;
+    if( !testGetIDs_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_GetIDs() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with GetIDs( const QStringList& subjects ), GetNames( const QVector< int >& ids ), GetIDSet( const QStringList& subjects ) and/or Exclude( const QStringList& subjects, const QSet< int >& excludedIDs )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_GetIDs() PASSED";
+    }
+
+    return testGetIDs_Passed;
+}
+
+bool TestSubjectRegistry::Test_Intern()
+{
+    SubjectRegistry& registry = SubjectRegistry::GetInstance();
+    QString stan = QString( "Test_Intern_" ) + "Stan";
+    QString otherStan = QString( "Test_Intern_" ) + "Stan";
+
+
+    QStringList firstList = registry.Intern( QStringList() << stan << "Test_Intern_Kyle" );
+    QStringList secondList = registry.Intern( QStringList() << otherStan );
+
+    /** Both lists hold the pooled string: same data, not two copies **/
+    bool testIntern = firstList == ( QStringList() << "Test_Intern_Stan" << "Test_Intern_Kyle" ) && secondList.first() == stan &&
+            secondList.first().constData() == firstList.first().constData() &&
+            secondList.first().constData() == registry.m_names.at( registry.FindID( stan ) ).constData() &&
+            otherStan.constData() != stan.constData();
+
+
+    if( !testIntern )
+    {
+        std::cerr << "/!\\/!\\ Test_Intern() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Intern( const QStringList& subjects )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Intern() PASSED";
+    }
+
+    return testIntern;
+}
@@ -0,0 +1,24 @@
+#ifndef TESTSUBJECTREGISTRY_H
+#define TESTSUBJECTREGISTRY_H
+
+#include "SubjectRegistry.h"
+
+#include <iostream>
+
+
+class TestSubjectRegistry
+{
+public:
+    TestSubjectRegistry();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_GetID();
+
+    bool Test_GetIDs();
+
+    bool Test_Intern();
+};
+
+#endif // TESTSUBJECTREGISTRY_H
@@ -0,0 +1,120 @@
+#include "TestSubjectSearchIndex.h"
+
+#include <QtAlgorithms>
+
+TestSubjectSearchIndex::TestSubjectSearchIndex()
+{
+}
+
+
+/**********************************************************************/
+/*************************** Tests ************************************/
+/**********************************************************************/
+bool TestSubjectSearchIndex::Test_InsertRemove()
+{
+    SubjectSearchIndex searchIndex;
+
+
+    searchIndex.Insert( 0, "Stan" );
+    searchIndex.Insert( 1, "Kyle" );
+    searchIndex.Insert( 1, "Kyle --> AD" );
+    bool testInsert = searchIndex.GetNbrSubjects() == 2 && searchIndex.Find( "kyle", Qt::CaseInsensitive ) == ( QList< int >() << 1 ) &&
+            searchIndex.Find( "AD", Qt::CaseSensitive ) == ( QList< int >() << 1 );
+
+    /** Trigrams no longer used are removed **/
+    searchIndex.Remove( 1 );
+    searchIndex.Remove( 5 );
+    bool testRemove = searchIndex.GetNbrSubjects() == 1 && searchIndex.Find( "Kyle", Qt::CaseSensitive ).isEmpty() &&
+            searchIndex.m_trigramSubjects.size() == 2;
+
+    searchIndex.Clear();
+    bool testClear = searchIndex.GetNbrSubjects() == 0 && searchIndex.Find( "", Qt::CaseSensitive ).isEmpty();
+
+
+    bool testInsertRemove_Passed = testInsert && testRemove && testClear;
+    if( !testInsertRemove_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_InsertRemove() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Insert( int subjectID, const QString& text ) and/or Remove( int subjectID )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_InsertRemove() PASSED";
+    }
+
+    return testInsertRemove_Passed;
+}
+
+bool TestSubjectSearchIndex::Test_Find()
+{
+    SubjectSearchIndex searchIndex;
+    QStringList texts = QStringList() << "Stan" << "Kyle" << "Kenny" << "stanley" << "Stanny" << "Butters" << "Wendy" << "Craig" << "Pip"
+                                      << "R2D2 --> loaded subjects, RD";
+    for( int i = 0; i < texts.size(); i++ )
+    {
+        searchIndex.Insert( i, texts.at( i ) );
+    }
+
+
+    QList< int > found1 = searchIndex.Find( "tan", Qt::CaseInsensitive );
+    qSort( found1 );
+    QList< int > found2 = searchIndex.Find( "Stan", Qt::CaseSensitive );
+    qSort( found2 );
+    bool testLiteral = found1 == ( QList< int >() << 0 << 3 << 4 ) && found2 == ( QList< int >() << 0 << 4 ) &&
+            searchIndex.Find( "pip", Qt::CaseSensitive ).isEmpty() && searchIndex.Find( "pip", Qt::CaseInsensitive ) == ( QList< int >() << 8 );
+
+    /** Searches shorter than a trigram go through every subject **/
+    QList< int > found3 = searchIndex.Find( "y", Qt::CaseSensitive );
+    qSort( found3 );
+    bool testShortSearch = found3 == ( QList< int >() << 1 << 2 << 3 << 4 << 6 );
+
+    /** Same wildcards as QRegExp::Wildcard **/
+    QList< int > found4 = searchIndex.Find( "K*y", Qt::CaseSensitive );
+    qSort( found4 );
+    bool testWildcards = found4 == ( QList< int >() << 1 << 2 ) && searchIndex.Find( "St?nny", Qt::CaseSensitive ) == ( QList< int >() << 4 ) &&
+            searchIndex.Find( "[CK]2D", Qt::CaseSensitive ).isEmpty() && searchIndex.Find( "[RC]2D2", Qt::CaseSensitive ) == ( QList< int >() << 9 ) &&
+            searchIndex.Find( "--> load", Qt::CaseSensitive ) == ( QList< int >() << 9 );
+
+    bool testLiteralParts = SubjectSearchIndex::GetLiteralParts( "K*yl?e[abc]nny[]x]z[open" ) == ( QStringList() << "K" << "yl" << "e" << "nny" << "z" );
+
+    /** Among the candidates only **/
+    bool testCandidates = searchIndex.Find( "tan", Qt::CaseInsensitive, QList< int >() << 3 << 5 << 12 ) == ( QList< int >() << 3 );
+
+
+    bool testFind_Passed = testLiteral && testShortSearch && testWildcards && testLiteralParts && testCandidates;
+    if( !testFind_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_Find() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with Find( const QString& search, Qt::CaseSensitivity caseSensitivity )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_Find() PASSED";
+    }
+
+    return testFind_Passed;
+}
+
+bool TestSubjectSearchIndex::Test_IsNarrowing()
+{
+    bool testNarrowing = SubjectSearchIndex::IsNarrowing( "Stann", "Stan", Qt::CaseSensitive ) &&
+            SubjectSearchIndex::IsNarrowing( "xSTANy", "stan", Qt::CaseInsensitive );
+
+    bool testNotNarrowing = !SubjectSearchIndex::IsNarrowing( "xSTANy", "stan", Qt::CaseSensitive ) &&
+            !SubjectSearchIndex::IsNarrowing( "Sta", "Stan", Qt::CaseSensitive ) && !SubjectSearchIndex::IsNarrowing( "Stan", "", Qt::CaseSensitive ) &&
+            !SubjectSearchIndex::IsNarrowing( "[St]an", "St", Qt::CaseSensitive ) && !SubjectSearchIndex::IsNarrowing( "Stan", "S*n", Qt::CaseSensitive );
+
+
+    bool testIsNarrowing_Passed = testNarrowing && testNotNarrowing;
+    if( !testIsNarrowing_Passed )
+    {
+        std::cerr << "/!\\/!\\ Test_IsNarrowing() FAILED /!\\/!\\";
+        //        std::cerr << "\t+ pb with IsNarrowing( const QString& search, const QString& previousSearch, Qt::CaseSensitivity caseSensitivity )" << std::endl;
+    }
+    else
+    {
+        std::cerr << "Test_IsNarrowing() PASSED";
+    }
+
+    return testIsNarrowing_Passed;
+}
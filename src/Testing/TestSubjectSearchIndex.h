@@ -0,0 +1,24 @@
+#ifndef TESTSUBJECTSEARCHINDEX_H
+#define TESTSUBJECTSEARCHINDEX_H
+
+#include "SubjectSearchIndex.h"
+
+#include <iostream>
+
+
+class TestSubjectSearchIndex
+{
+public:
+    TestSubjectSearchIndex();
+
+    /**********************************************************************/
+    /*************************** Test Functions ***************************/
+    /**********************************************************************/
+    bool Test_InsertRemove();
+
+    bool Test_Find();
+
+    bool Test_IsNarrowing();
+};
+
+#endif // TESTSUBJECTSEARCHINDEX_H
@@ -0,0 +1,101 @@
+#include "TestCSVReader.h"
+
+/*
+ * argv[1] = testGetDataFromFile_N
+ * argv[2] = testGetDataFromFile_R
+ * argv[3] = testGetDataFromFile_RN
+ *
+ * argv[4] = adFilePath
+ * argv[5] = subMatrix0FilePath
+ */
+
+int main( int argc, char *argv[] )
+{
+    TestCSVReader testCSVReader;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Reading *****************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Reading *****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_Read( argv[1], argv[2], argv[3] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ReadNumericData( argv[4], argv[5] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ReadContent() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ReadInParallel( argv[4] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ReadSelection( argv[4], argv[5] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ParseNumber() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+    std::cerr << std::endl;
+    /**************** Accessors ****************/
+    std::cerr << std::endl << "/**************** Accessors ****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_GetData() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVReader.Test_ValidationReport() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,52 @@
+#include "TestCSVSidecar.h"
+
+/*
+ * argv[1] = adFilePath
+ * argv[2] = subMatrix0FilePath
+ *
+ * argv[3] = tempDir
+ */
+
+int main( int argc, char *argv[] )
+{
+    TestCSVSidecar testCSVSidecar;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Sidecar *****************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Sidecar *****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVSidecar.Test_WriteRead( argv[1], argv[2], argv[3] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVSidecar.Test_OutdatedSidecar( argv[3] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,56 @@
+#include "TestCSVWriter.h"
+
+/*
+ * argv[1] = tempDir
+ */
+
+int main( int argc, char *argv[] )
+{
+    TestCSVWriter testCSVWriter;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** CSV Writer ***************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** CSV Writer ***************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVWriter.Test_Gather() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVWriter.Test_GatherFromFile( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testCSVWriter.Test_Write() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
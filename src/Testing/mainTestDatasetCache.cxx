@@ -0,0 +1,64 @@
+#include "TestDatasetCache.h"
+
+/*
+ * argv[1] = tempDir
+ */
+
+int main( int argc, char *argv[] )
+{
+    TestDatasetCache testDatasetCache;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /****************** Cache ******************/
+    std::cerr << std::endl << std::endl << std::endl << "/****************** Cache ******************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDatasetCache.Test_GetData( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDatasetCache.Test_GetProfileData( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDatasetCache.Test_FileChanged( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDatasetCache.Test_Sidecar( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,75 @@
+#include "TestDiffusionProfileMatrix.h"
+
+/*
+ * argv[1] = adFilePath
+ */
+
+int main( int argc, char *argv[] )
+{
+    TestDiffusionProfileMatrix testDiffusionProfileMatrix;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /************** Initialization **************/
+    std::cerr << std::endl << std::endl << std::endl << "/************** Initialization **************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDiffusionProfileMatrix.Test_DiffusionProfileMatrix( argv[1] ) )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+    std::cerr << std::endl;
+    /**************** Accessors ****************/
+    std::cerr << std::endl << "/**************** Accessors ****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDiffusionProfileMatrix.Test_GetArcLength() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDiffusionProfileMatrix.Test_GetSubjects() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDiffusionProfileMatrix.Test_GetAtlas() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testDiffusionProfileMatrix.Test_GetViews() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -143,6 +143,13 @@ int main( int argc, char *argv[] )
     }
     nbrTests++;
 
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testFADTTSWindow.Test_UpdateSortedSubjects() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
     std::cerr << std::endl << nbrTests + 1 << "- ";
     if( testFADTTSWindow.Test_SetCheckStateAllVisibleSubjects() )
     {
@@ -0,0 +1,52 @@
+#include "TestIncrementalSubjectMatcher.h"
+
+int main( int argc, char *argv[] )
+{
+    TestIncrementalSubjectMatcher testIncrementalSubjectMatcher;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Matching ****************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Matching ****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testIncrementalSubjectMatcher.Test_SetSource() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testIncrementalSubjectMatcher.Test_RemoveSource() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testIncrementalSubjectMatcher.Test_Match() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,60 @@
+#include "TestMatrixView.h"
+
+int main( int argc, char *argv[] )
+{
+    TestMatrixView testMatrixView;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /****************** Views ******************/
+    std::cerr << std::endl << std::endl << std::endl << "/****************** Views ******************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testMatrixView.Test_VectorView() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testMatrixView.Test_RowMajor() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testMatrixView.Test_ColumnMajor() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testMatrixView.Test_Transposed() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
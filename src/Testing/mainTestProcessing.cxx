@@ -132,25 +132,25 @@ int main( int argc, char *argv[] )
     nbrTests++;
 
     std::cerr << std::endl << nbrTests + 1 << "- ";
-    if( testProcessing.Test_SortSubjects() )
+    if( testProcessing.Test_MatchSubjects() )
     {
         nbrTestsPassed++;
     }
     nbrTests++;
 
+
+    std::cerr << std::endl;
+    /***************** Others ******************/
+    std::cerr << std::endl << "/***************** Others ******************/";
     std::cerr << std::endl << nbrTests + 1 << "- ";
-    if( testProcessing.Test_AssignSortedSubject() )
+    if( testProcessing.Test_GenerateMatlabInputFiles( argv[4], argv[5], argv[6], argv[7], argv[8], argv[9], argv[10] ) )
     {
         nbrTestsPassed++;
     }
     nbrTests++;
 
-
-    std::cerr << std::endl;
-    /***************** Others ******************/
-    std::cerr << std::endl << "/***************** Others ******************/";
     std::cerr << std::endl << nbrTests + 1 << "- ";
-    if( testProcessing.Test_GenerateMatlabInputFiles( argv[4], argv[5], argv[6], argv[7], argv[8], argv[9], argv[10] ) )
+    if( testProcessing.Test_StreamingIngest( argv[4], argv[5], argv[7], argv[8], argv[9], argv[10] ) )
     {
         nbrTestsPassed++;
     }
@@ -0,0 +1,45 @@
+#include "TestQCThresholdCorrelations.h"
+
+int main( int argc, char *argv[] )
+{
+    TestQCThresholdCorrelations testQCThresholdCorrelations;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** QC Threshold *************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** QC Threshold *************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testQCThresholdCorrelations.Test_SetCorrelations() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testQCThresholdCorrelations.Test_GetLinesCrossing() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
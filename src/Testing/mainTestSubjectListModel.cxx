@@ -0,0 +1,52 @@
+#include "TestSubjectListModel.h"
+
+int main( int argc, char *argv[] )
+{
+    TestSubjectListModel testSubjectListModel;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Subjects ****************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Subjects ****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectListModel.Test_SetSubjects() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectListModel.Test_InsertRemoveSubject() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectListModel.Test_CheckState() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
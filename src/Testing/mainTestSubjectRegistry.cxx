@@ -0,0 +1,52 @@
+#include "TestSubjectRegistry.h"
+
+int main( int argc, char *argv[] )
+{
+    TestSubjectRegistry testSubjectRegistry;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Registry ****************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Registry ****************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectRegistry.Test_GetID() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectRegistry.Test_GetIDs() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectRegistry.Test_Intern() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}
@@ -0,0 +1,52 @@
+#include "TestSubjectSearchIndex.h"
+
+int main( int argc, char *argv[] )
+{
+    TestSubjectSearchIndex testSubjectSearchIndex;
+    int nbrTests = 0;
+    int nbrTestsPassed = 0;
+
+
+    /***************** Search *******************/
+    std::cerr << std::endl << std::endl << std::endl << "/***************** Search *******************/";
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectSearchIndex.Test_InsertRemove() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectSearchIndex.Test_Find() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+    std::cerr << std::endl << nbrTests + 1 << "- ";
+    if( testSubjectSearchIndex.Test_IsNarrowing() )
+    {
+        nbrTestsPassed++;
+    }
+    nbrTests++;
+
+
+
+    std::cerr << std::endl << std::endl << std::endl << std::endl << std::endl;
+    std::cerr << "                   Tests Summary                " << std::endl;
+    std::cerr << "*************************************************" << std::endl;
+    std::cerr << "* " << 100*nbrTestsPassed/nbrTests << "% tests passed, " <<
+                 ( nbrTests - nbrTestsPassed ) << " test(s) failed out of " <<
+                 nbrTests << " *" << std::endl;
+    std::cerr << "*************************************************";
+    std::cerr << std::endl << std::endl << std::endl;
+
+    if( nbrTestsPassed == nbrTests )
+    {
+        return 0;
+    }
+    else
+    {
+        return -1;
+    }
+}